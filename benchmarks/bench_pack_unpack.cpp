@@ -0,0 +1,269 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <opine/opine.hpp>
+#include <string>
+#include <vector>
+
+// Pack, unpack and round_mantissa throughput, per format, type selection
+// policy and rounding policy
+//
+// Each benchmark processes batch_size pseudo-random encodings per iteration,
+// one element at a time (unpack, pack, round_mantissa: every result passes
+// through benchmark::DoNotOptimize) or batched (unpack_n, pack_n,
+// round_mantissa_n: plain loops over spans). Reported per benchmark:
+//
+//   items_per_second   elements per second
+//   time_per_element   seconds per element (printed as e.g. 1.5ns)
+//
+// Names are <operation>/<format>/<type policy>/<rounding policy>, e.g.
+// unpack_n/fp16_e5m10/LeastWidth/RNE; use --benchmark_filter to select.
+//
+// The configurations are a CartesianProduct (core/type_list.hpp), compiled
+// in OPINE_SHARDS translation units that each register their shard_t.
+
+#ifndef OPINE_SHARD_INDEX
+#define OPINE_SHARD_INDEX 0
+#define OPINE_SHARD_COUNT 1
+#endif
+
+namespace {
+
+using namespace opine;
+
+constexpr std::size_t batch_size = 4096;
+
+// Benchmark name parts; variable templates, so that shards which use
+// only some of them do not warn about the rest
+template <typename TypePolicy> constexpr const char *type_policy_name = "";
+template <>
+constexpr const char *type_policy_name<type_policies::ExactWidth> =
+    "ExactWidth";
+template <>
+constexpr const char *type_policy_name<type_policies::LeastWidth> =
+    "LeastWidth";
+template <>
+constexpr const char *type_policy_name<type_policies::Fastest> = "Fastest";
+
+template <typename RoundingPolicy>
+constexpr const char *rounding_policy_name = "";
+template <>
+constexpr const char
+    *rounding_policy_name<rounding_policies::ToNearestTiesToEven> = "RNE";
+template <>
+constexpr const char *rounding_policy_name<rounding_policies::TowardZero> =
+    "RTZ";
+
+// fp{total_bits}_e{exp_bits}m{mant_bits}, as in core/format.hpp
+template <typename Format> std::string format_name() {
+  return "fp" + std::to_string(Format::total_bits) + "_e" +
+         std::to_string(Format::exp_bits) + "m" +
+         std::to_string(Format::mant_bits);
+}
+
+// Pseudo-random encodings of a format (all classes: normals, denormals,
+// zeros, Inf, NaN)
+template <typename Format>
+std::vector<typename Format::storage_type> random_encodings() {
+  constexpr std::uint64_t mask =
+      Format::total_bits >= 64 ? ~std::uint64_t{0}
+                               : (std::uint64_t{1} << Format::total_bits) - 1;
+  std::vector<typename Format::storage_type> bits(batch_size);
+  std::uint64_t state = 0x9E3779B97F4A7C15u;
+  for (auto &value : bits) {
+    state = state * 6364136223846793005u + 1442695040888963407u; // PCG LCG
+    value = static_cast<typename Format::storage_type>((state >> 7) & mask);
+  }
+  return bits;
+}
+
+// Pseudo-random unrounded values: unpacked encodings with random guard bits,
+// so that packing exercises the rounding paths
+template <typename Format, typename RoundingPolicy>
+std::vector<UnpackedFloat<Format, RoundingPolicy>> random_unpacked() {
+  using mantissa_type = unpacked_mantissa_t<Format, RoundingPolicy>;
+  constexpr int guard_bits = RoundingPolicy::guard_bits;
+
+  const auto bits = random_encodings<Format>();
+  std::vector<UnpackedFloat<Format, RoundingPolicy>> values(bits.size());
+  for (std::size_t i = 0; i < bits.size(); ++i) {
+    values[i] = unpack<Format, RoundingPolicy>(bits[i]);
+    if constexpr (guard_bits > 0) {
+      const auto guard = static_cast<mantissa_type>(
+          (i * 2654435761u >> 13) & ((1u << guard_bits) - 1));
+      values[i].mantissa = static_cast<mantissa_type>(values[i].mantissa |
+                                                      guard);
+    }
+  }
+  return values;
+}
+
+void report(benchmark::State &state) {
+  const auto items = static_cast<std::int64_t>(state.iterations()) *
+                     static_cast<std::int64_t>(batch_size);
+  state.SetItemsProcessed(items);
+  state.counters["time_per_element"] = benchmark::Counter(
+      static_cast<double>(items),
+      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+template <typename Format, typename RoundingPolicy>
+void bm_unpack(benchmark::State &state) {
+  const auto bits = random_encodings<Format>();
+  for (auto _ : state) {
+    for (const auto value : bits) {
+      benchmark::DoNotOptimize(unpack<Format, RoundingPolicy>(value));
+    }
+  }
+  report(state);
+}
+
+template <typename Format, typename RoundingPolicy>
+void bm_unpack_n(benchmark::State &state) {
+  const auto bits = random_encodings<Format>();
+  auto sign = std::make_unique<bool[]>(batch_size);
+  std::vector<typename Format::exponent_type> exponent(batch_size);
+  std::vector<unpacked_mantissa_t<Format, RoundingPolicy>> mantissa(
+      batch_size);
+  for (auto _ : state) {
+    unpack_n<Format, RoundingPolicy>(bits, {sign.get(), batch_size}, exponent,
+                                     mantissa);
+    benchmark::DoNotOptimize(sign.get());
+    benchmark::DoNotOptimize(exponent.data());
+    benchmark::DoNotOptimize(mantissa.data());
+    benchmark::ClobberMemory();
+  }
+  report(state);
+}
+
+template <typename Format, typename RoundingPolicy>
+void bm_pack(benchmark::State &state) {
+  const auto values = random_unpacked<Format, RoundingPolicy>();
+  for (auto _ : state) {
+    for (const auto &value : values) {
+      benchmark::DoNotOptimize(pack(value));
+    }
+  }
+  report(state);
+}
+
+template <typename Format, typename RoundingPolicy>
+void bm_pack_n(benchmark::State &state) {
+  const auto values = random_unpacked<Format, RoundingPolicy>();
+  auto sign = std::make_unique<bool[]>(batch_size);
+  std::vector<typename Format::exponent_type> exponent(batch_size);
+  std::vector<unpacked_mantissa_t<Format, RoundingPolicy>> mantissa(
+      batch_size);
+  for (std::size_t i = 0; i < batch_size; ++i) {
+    sign[i] = values[i].sign;
+    exponent[i] = values[i].exponent;
+    mantissa[i] = values[i].mantissa;
+  }
+  std::vector<typename Format::storage_type> bits(batch_size);
+  for (auto _ : state) {
+    pack_n<Format, RoundingPolicy>({sign.get(), batch_size}, exponent,
+                                   mantissa, bits);
+    benchmark::DoNotOptimize(bits.data());
+    benchmark::ClobberMemory();
+  }
+  report(state);
+}
+
+template <typename Format, typename RoundingPolicy>
+void bm_round_mantissa(benchmark::State &state) {
+  const auto values = random_unpacked<Format, RoundingPolicy>();
+  for (auto _ : state) {
+    for (const auto &value : values) {
+      benchmark::DoNotOptimize(RoundingPolicy::template round_mantissa<Format>(
+          value.mantissa, value.sign));
+    }
+  }
+  report(state);
+}
+
+template <typename Format, typename RoundingPolicy>
+void bm_round_mantissa_n(benchmark::State &state) {
+  const auto values = random_unpacked<Format, RoundingPolicy>();
+  std::vector<unpacked_mantissa_t<Format, RoundingPolicy>> mantissa(
+      batch_size);
+  auto sign = std::make_unique<bool[]>(batch_size);
+  for (std::size_t i = 0; i < batch_size; ++i) {
+    sign[i] = values[i].sign;
+    mantissa[i] = values[i].mantissa;
+  }
+  std::vector<rounding_policies::rounded_mantissa_t<Format>> rounded(
+      batch_size);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batch_size; ++i) {
+      rounded[i] = RoundingPolicy::template round_mantissa<Format>(
+          mantissa[i], sign[i]);
+    }
+    benchmark::DoNotOptimize(rounded.data());
+    benchmark::ClobberMemory();
+  }
+  report(state);
+}
+
+template <typename Format, typename RoundingPolicy, typename TypePolicy>
+void register_format() {
+  const std::string suffix = "/" + format_name<Format>() + "/" +
+                             type_policy_name<TypePolicy> + "/" +
+                             rounding_policy_name<RoundingPolicy>;
+  benchmark::RegisterBenchmark(("unpack" + suffix).c_str(),
+                               bm_unpack<Format, RoundingPolicy>);
+  benchmark::RegisterBenchmark(("unpack_n" + suffix).c_str(),
+                               bm_unpack_n<Format, RoundingPolicy>);
+  benchmark::RegisterBenchmark(("pack" + suffix).c_str(),
+                               bm_pack<Format, RoundingPolicy>);
+  benchmark::RegisterBenchmark(("pack_n" + suffix).c_str(),
+                               bm_pack_n<Format, RoundingPolicy>);
+  benchmark::RegisterBenchmark(("round_mantissa" + suffix).c_str(),
+                               bm_round_mantissa<Format, RoundingPolicy>);
+  benchmark::RegisterBenchmark(("round_mantissa_n" + suffix).c_str(),
+                               bm_round_mantissa_n<Format, RoundingPolicy>);
+}
+
+// The predefined IEEE format shapes (core/format.hpp), each built with
+// every type policy
+template <int ExpBits, int MantBits> struct IEEEShape {
+  template <typename TypePolicy>
+  using format = IEEE_Format<ExpBits, MantBits, TypePolicy>;
+};
+
+using Configurations =
+    CartesianProduct<TypeList<IEEEShape<5, 2>, IEEEShape<4, 3>,
+                              IEEEShape<5, 10>, IEEEShape<8, 23>,
+                              IEEEShape<11, 52>>,
+                     TypeList<type_policies::ExactWidth,
+                              type_policies::LeastWidth,
+                              type_policies::Fastest>,
+                     TypeList<rounding_policies::ToNearestTiesToEven,
+                              rounding_policies::TowardZero>>;
+
+// Register this shard's configurations (the build compiles this file once
+// per shard, see opine_add_sharded_executable)
+const bool registered = [] {
+  for_each_type<shard_t<Configurations, OPINE_SHARD_INDEX, OPINE_SHARD_COUNT>>(
+      []<typename Config>() {
+        []<typename Shape, typename TypePolicy, typename RoundingPolicy>(
+            TypeList<Shape, TypePolicy, RoundingPolicy> *) {
+          register_format<typename Shape::template format<TypePolicy>,
+                          RoundingPolicy, TypePolicy>();
+        }(static_cast<Config *>(nullptr));
+      });
+  return true;
+}();
+
+} // namespace
+
+#if OPINE_SHARD_INDEX == 0
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
+#endif
@@ -0,0 +1,158 @@
+// One benchmark kernel for the 6502 cycle harness (see CMakeLists.txt)
+//
+// Built once per (kernel, format) with
+//
+//   -DOPINE_MOS_KERNEL=<kernel struct below, e.g. Multiply>
+//   -DOPINE_MOS_FORMAT=<format alias, e.g. fp8_e4m3>
+//
+// main() calls run_kernel() on operand_count operand triples and exits. The
+// simulator's total cycle count, minus that of the Baseline kernel of the
+// same format (same loop, same operands, no work), divided by operand_count,
+// is the cost of one operation. Operands and results live in mutable,
+// externally visible arrays, so nothing is constant-folded or dropped.
+
+#include <opine/core/format.hpp>
+#include <opine/operations/arithmetic.hpp>
+#include <opine/operations/pack_unpack.hpp>
+#include <opine/policies/rounding.hpp>
+
+#include <stdint.h>
+
+#ifndef OPINE_MOS_KERNEL
+#error "OPINE_MOS_KERNEL must name a kernel"
+#endif
+#ifndef OPINE_MOS_FORMAT
+#error "OPINE_MOS_FORMAT must name a format"
+#endif
+
+namespace {
+
+using namespace opine;
+
+using format = OPINE_MOS_FORMAT;
+using storage_type = format::storage_type;
+using rounding_policy = rounding_policies::ToNearestTiesToEven;
+using unpacked_type = UnpackedFloat<format, rounding_policy>;
+
+constexpr int operand_count = 16;
+
+// Every kernel maps three storage operands to one result
+struct Baseline {
+  static storage_type run(storage_type a, storage_type, storage_type) {
+    return a;
+  }
+};
+
+struct Unpack {
+  static unpacked_type run(storage_type a, storage_type, storage_type) {
+    return unpack<format, rounding_policy>(a);
+  }
+};
+
+// unpack() + pack(), the round trip of a storage-level operation; subtract
+// Unpack for the cost of pack() alone
+struct RoundTrip {
+  static storage_type run(storage_type a, storage_type, storage_type) {
+    return pack(unpack<format, rounding_policy>(a));
+  }
+};
+
+struct Add {
+  static storage_type run(storage_type a, storage_type b, storage_type) {
+    return pack(add(unpack<format, rounding_policy>(a),
+                    unpack<format, rounding_policy>(b)));
+  }
+};
+
+struct Multiply {
+  static storage_type run(storage_type a, storage_type b, storage_type) {
+    return pack(multiply(unpack<format, rounding_policy>(a),
+                         unpack<format, rounding_policy>(b)));
+  }
+};
+
+struct Divide {
+  static storage_type run(storage_type a, storage_type b, storage_type) {
+    return pack(divide(unpack<format, rounding_policy>(a),
+                       unpack<format, rounding_policy>(b)));
+  }
+};
+
+struct Fma {
+  static storage_type run(storage_type a, storage_type b, storage_type c) {
+    return pack(fma(unpack<format, rounding_policy>(a),
+                    unpack<format, rounding_policy>(b),
+                    unpack<format, rounding_policy>(c)));
+  }
+};
+
+// The toolchain's own float operations (compiler-rt libcalls, or a
+// hand-written override linked in through OPINE_MOS_EXTRA_SOURCES), for
+// comparison with the fp32_e8m23 kernels above
+struct FloatAdd {
+  static float run(storage_type a, storage_type b, storage_type) {
+    return __builtin_bit_cast(float, static_cast<uint32_t>(a)) +
+           __builtin_bit_cast(float, static_cast<uint32_t>(b));
+  }
+};
+
+struct FloatMultiply {
+  static float run(storage_type a, storage_type b, storage_type) {
+    return __builtin_bit_cast(float, static_cast<uint32_t>(a)) *
+           __builtin_bit_cast(float, static_cast<uint32_t>(b));
+  }
+};
+
+struct FloatDivide {
+  static float run(storage_type a, storage_type b, storage_type) {
+    return __builtin_bit_cast(float, static_cast<uint32_t>(a)) /
+           __builtin_bit_cast(float, static_cast<uint32_t>(b));
+  }
+};
+
+using kernel = OPINE_MOS_KERNEL;
+using result_type = decltype(kernel::run(0, 0, 0));
+
+// Finite, nonzero operands spread over the format's range: normals with
+// varied exponents and mantissas, and a few denormals
+constexpr storage_type make_operand(int i) {
+  constexpr int exp_max = (1 << format::exp_bits) - 1;
+  uint32_t state = 0x2545F491u + static_cast<uint32_t>(i) * 2654435761u;
+  state ^= state >> 15;
+  state *= 0x2C1B3C6Du;
+  state ^= state >> 12;
+
+  const int exponent =
+      i % 8 == 7 ? 0 : 1 + static_cast<int>(state % (exp_max - 1));
+  const auto mantissa = static_cast<storage_type>(
+      (static_cast<storage_type>(state >> 3) |
+       static_cast<storage_type>(exponent == 0 ? 1 : 0)) &
+      ((storage_type{1} << format::mant_bits) - 1));
+  return static_cast<storage_type>(
+      (static_cast<storage_type>(i & 1) << format::sign_offset) |
+      (static_cast<storage_type>(exponent) << format::exp_offset) |
+      (mantissa << format::mant_offset));
+}
+
+} // namespace
+
+// Mutable and externally visible: the optimizer must read it at run time
+storage_type opine_mos_operands[3 * operand_count];
+result_type opine_mos_results[operand_count];
+
+[[gnu::noinline]] result_type run_kernel(storage_type a, storage_type b,
+                                         storage_type c) {
+  return kernel::run(a, b, c);
+}
+
+int main() {
+  for (int i = 0; i < 3 * operand_count; ++i) {
+    opine_mos_operands[i] = make_operand(i);
+  }
+  for (int i = 0; i < operand_count; ++i) {
+    opine_mos_results[i] =
+        run_kernel(opine_mos_operands[3 * i], opine_mos_operands[3 * i + 1],
+                   opine_mos_operands[3 * i + 2]);
+  }
+  return 0;
+}
@@ -0,0 +1,80 @@
+# Runs the harness programs under mos-sim and writes the report table
+#
+# Inputs: MOS_SIM, MOS_SIZE, OUTPUT, and ENTRIES, a list of
+# "<kernel>|<format>|<program>" with one Baseline entry per format. Cycles
+# per operation and code bytes are reported relative to the Baseline of the
+# same format (kernel.cpp: operand_count operations per program).
+
+set(operand_count 16)
+
+# Total cycles of one run (mos-sim --cycles prints the count on exit)
+function(run_cycles program out_var)
+    execute_process(
+        COMMAND ${MOS_SIM} --cycles ${program}
+        OUTPUT_VARIABLE stdout
+        ERROR_VARIABLE stderr
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${program} failed (${result}): ${stderr}")
+    endif()
+    if(NOT "${stdout}${stderr}" MATCHES "[Cc]ycles[^0-9]*([0-9]+)")
+        message(FATAL_ERROR "No cycle count from ${program}")
+    endif()
+    set(${out_var} ${CMAKE_MATCH_1} PARENT_SCOPE)
+endfunction()
+
+# Code and data bytes of the program (text + data, from llvm-size)
+function(code_bytes program out_var)
+    set(elf ${program})
+    if(EXISTS ${program}.elf)
+        set(elf ${program}.elf)
+    endif()
+    execute_process(
+        COMMAND ${MOS_SIZE} --format=berkeley ${elf}
+        OUTPUT_VARIABLE stdout
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "llvm-size failed on ${elf}")
+    endif()
+    string(REGEX MATCH "\n[ \t]*([0-9]+)[ \t]+([0-9]+)" row "${stdout}")
+    math(EXPR bytes "${CMAKE_MATCH_1} + ${CMAKE_MATCH_2}")
+    set(${out_var} ${bytes} PARENT_SCOPE)
+endfunction()
+
+# Baselines first
+foreach(entry IN LISTS ENTRIES)
+    string(REPLACE "|" ";" fields "${entry}")
+    list(GET fields 0 kernel)
+    list(GET fields 1 format)
+    list(GET fields 2 program)
+    if(kernel STREQUAL "Baseline")
+        run_cycles(${program} cycles)
+        code_bytes(${program} bytes)
+        set(baseline_cycles_${format} ${cycles})
+        set(baseline_bytes_${format} ${bytes})
+    endif()
+endforeach()
+
+set(report "| Kernel | Format | Cycles/op | Code bytes |\n")
+string(APPEND report "|--------|--------|-----------|------------|\n")
+foreach(entry IN LISTS ENTRIES)
+    string(REPLACE "|" ";" fields "${entry}")
+    list(GET fields 0 kernel)
+    list(GET fields 1 format)
+    list(GET fields 2 program)
+    if(NOT kernel STREQUAL "Baseline")
+        run_cycles(${program} cycles)
+        code_bytes(${program} bytes)
+        math(EXPR per_op
+             "(${cycles} - ${baseline_cycles_${format}}) / ${operand_count}")
+        math(EXPR extra_bytes "${bytes} - ${baseline_bytes_${format}}")
+        string(APPEND report
+               "| ${kernel} | ${format} | ${per_op} | ${extra_bytes} |\n")
+    endif()
+endforeach()
+
+file(WRITE ${OUTPUT} "${report}")
+message("${report}")
+message("Written to ${OUTPUT}")
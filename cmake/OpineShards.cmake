@@ -0,0 +1,32 @@
+# opine_add_sharded_executable(<target> <source>)
+#
+# Builds <source> OPINE_SHARDS times, each copy with OPINE_SHARD_INDEX set to
+# its index and OPINE_SHARD_COUNT to OPINE_SHARDS, and links the copies into
+# one executable. A source that instantiates only
+# shard_t<Configurations, OPINE_SHARD_INDEX, OPINE_SHARD_COUNT>
+# (core/type_list.hpp) is thereby compiled in OPINE_SHARDS pieces of bounded
+# time and memory. Shard 0 defines main().
+#
+# With Ninja, OPINE_SHARD_JOBS > 0 caps the number of shards compiled at
+# once, whatever -j is.
+function(opine_add_sharded_executable target source)
+    get_filename_component(source_path ${source} ABSOLUTE)
+    math(EXPR last "${OPINE_SHARDS} - 1")
+
+    set(sources)
+    foreach(index RANGE ${last})
+        set(shard_source
+            ${CMAKE_CURRENT_BINARY_DIR}/${target}_shard${index}.cpp)
+        file(CONFIGURE OUTPUT ${shard_source} CONTENT
+"#define OPINE_SHARD_INDEX ${index}
+#define OPINE_SHARD_COUNT ${OPINE_SHARDS}
+#include \"${source_path}\"
+")
+        list(APPEND sources ${shard_source})
+    endforeach()
+
+    add_executable(${target} ${sources})
+    if(OPINE_SHARD_JOBS GREATER 0)
+        set_property(TARGET ${target} PROPERTY JOB_POOL_COMPILE opine_shards)
+    endif()
+endfunction()
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace opine::inline v1 {
+
+// Alignment of the container buffers (MicroscaledArray, PackedArray)
+inline constexpr std::size_t cache_line_size = 64;
+
+namespace detail {
+
+template <typename T, std::size_t Alignment> struct aligned_allocator {
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  aligned_allocator() = default;
+  template <typename U>
+  constexpr aligned_allocator(
+      const aligned_allocator<U, Alignment> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+  }
+
+  void deallocate(T *p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t{Alignment});
+  }
+
+  friend bool operator==(const aligned_allocator &,
+                         const aligned_allocator &) = default;
+};
+
+} // namespace detail
+
+} // namespace opine::inline v1
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <opine/core/unpacked.hpp>
+
+namespace opine::inline v1 {
+
+// Class of an extended value
+//
+// ExtendedFloat has no reserved exponents, so the special values are a
+// separate field. Finite means finite and nonzero.
+enum class FloatClass : std::uint8_t { Zero, Finite, Infinite, NaN };
+
+// Unpacked representation with an unbiased, widened exponent
+//
+// UnpackedFloat keeps the exponent as the biased field of the format, so
+// every operation re-biases it and checks it against the format's range
+// (overflow, denormal results). ExtendedFloat holds a signed exponent with
+// headroom beyond the format's range and a significand that is always
+// normalized:
+//
+//   value = mantissa * 2^(exponent - lead_position)
+//
+// The mantissa has UnpackedFloat's layout ([implicit bit][M stored bits]
+// [G guard bits, lowest one sticky]) with the leading bit always set for
+// finite values: unpacking pre-normalizes denormals. Arithmetic on extended
+// values (operations/extended.hpp) needs no bias adjustment, no denormal
+// shifts and no range checks; all of that happens once, in pack().
+//
+// The exponent has 8 bits more than the format's exponent field. Chains
+// whose intermediate exponents stay within 2^(exp_bits + 6) in magnitude
+// (128 times the format's largest exponent) are exact up to the guard bits,
+// where UnpackedFloat would have overflowed or lost bits to the denormal
+// range; beyond that the exponent wraps.
+//
+// NaNs keep their mantissa as a payload (IEEE formats); the exponent of
+// zeros, infinities and NaNs is 0.
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          denormal_policies::DenormalPolicy DenormalPolicy =
+              denormal_policies::DefaultDenormalPolicy>
+struct ExtendedFloat {
+  static_assert(Format::has_implicit_bit,
+                "Extended values require a format with an implicit bit");
+
+  using unpacked_type = UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>;
+
+  static constexpr int mantissa_bits = unpacked_type::mantissa_bits;
+  using mantissa_type = typename unpacked_type::mantissa_type;
+
+  // Position of the leading (implicit) bit of finite mantissas
+  static constexpr int lead_position =
+      Format::mant_bits + RoundingPolicy::guard_bits;
+
+  static constexpr int exponent_bits = Format::exp_bits + 8;
+  using exponent_type = int_t<exponent_bits, typename Format::type_policy>;
+
+  FloatClass kind;
+  bool sign;
+  exponent_type exponent;
+  mantissa_type mantissa;
+};
+
+} // namespace opine::inline v1
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <opine/core/types.hpp>
+#include <opine/policies/special_values.hpp>
 
 namespace opine::inline v1 {
 
 // Format descriptor for IEEE 754-like floating point formats
-// Supports arbitrary bit layouts with optional padding
+// Supports arbitrary bit layouts with optional padding, and the special-value
+// encodings of special_value_policies (IEEE Inf/NaN by default)
 template <int SignBits,        // Number of sign bits (typically 1)
           int SignOffset,      // Bit position of sign field (from LSB)
           int ExpBits,         // Number of exponent bits
@@ -16,7 +18,9 @@ template <int SignBits,        // Number of sign bits (typically 1)
           int TotalBits,       // Total storage size in bits
           bool HasImplicitBit, // true if format has implicit leading 1
           int ExponentBias = -1, // Exponent bias (-1 = auto: 2^(ExpBits-1) - 1)
-          typename TypePolicy = DefaultTypeSelectionPolicy>
+          typename TypePolicy = DefaultTypeSelectionPolicy,
+          special_value_policies::SpecialValuePolicy SpecialValues =
+              special_value_policies::DefaultSpecialValuePolicy>
 struct FormatDescriptor {
   // Format specification
   static constexpr int sign_bits = SignBits;
@@ -35,6 +39,16 @@ struct FormatDescriptor {
   // Type policy for type selection
   using type_policy = TypePolicy;
 
+  // Special-value encodings (Inf, NaN, signed zero)
+  using special_values = SpecialValues;
+
+  // The same layout with other special-value encodings
+  template <special_value_policies::SpecialValuePolicy Other>
+  using with_special_values =
+      FormatDescriptor<SignBits, SignOffset, ExpBits, ExpOffset, MantBits,
+                       MantOffset, TotalBits, HasImplicitBit, ExponentBias,
+                       TypePolicy, Other>;
+
   // Storage and field types
   using storage_type = uint_t<TotalBits, TypePolicy>;
   using exponent_type = uint_t<ExpBits, TypePolicy>;
@@ -64,7 +78,9 @@ struct FormatDescriptor {
 // Convenience alias for standard IEEE 754 layouts (no padding)
 // Bit layout: [Sign (MSB)][Exponent][Mantissa (LSB)]
 template <int ExpBits, int MantBits,
-          typename TypePolicy = DefaultTypeSelectionPolicy>
+          typename TypePolicy = DefaultTypeSelectionPolicy,
+          special_value_policies::SpecialValuePolicy SpecialValues =
+              special_value_policies::DefaultSpecialValuePolicy>
 using IEEE_Format = FormatDescriptor<1,                  // SignBits
                                      ExpBits + MantBits, // SignOffset (at MSB)
                                      ExpBits,            // ExpBits
@@ -74,7 +90,7 @@ using IEEE_Format = FormatDescriptor<1,                  // SignBits
                                      1 + ExpBits + MantBits, // TotalBits
                                      true, // HasImplicitBit (standard IEEE)
                                      -1,   // Auto bias
-                                     TypePolicy>;
+                                     TypePolicy, SpecialValues>;
 
 // Common format definitions
 // Naming convention: fp{total_bits}_e{exp_bits}m{mant_bits}
@@ -85,4 +101,72 @@ using fp16_e5m10 = IEEE_Format<5, 10>;   // IEEE 754 binary16 (half precision)
 using fp32_e8m23 = IEEE_Format<8, 23>;   // IEEE 754 binary32 (single precision)
 using fp64_e11m52 = IEEE_Format<11, 52>; // IEEE 754 binary64 (double precision)
 
+// Microscaling element formats (OCP MX: MXFP6, MXFP4), with the same
+// special-value encodings as the formats above
+using fp6_e3m2 = IEEE_Format<3, 2>;
+using fp6_e2m3 = IEEE_Format<2, 3>;
+using fp4_e2m1 = IEEE_Format<2, 1>;
+
+// Formats without infinities
+// Suffixes follow the ml_dtypes names: fn = finite (no Inf), uz = unsigned
+// zero (no -0)
+//
+// OCP FP8 E4M3: NaN is S.1111.111, largest finite 448
+using fp8_e4m3fn =
+    IEEE_Format<4, 3, DefaultTypeSelectionPolicy,
+                special_value_policies::FiniteNaN>;
+// fnuz: NaN is 0x80 (the -0 encoding), the bias one larger than IEEE's
+using fp8_e4m3fnuz =
+    FormatDescriptor<1, 7, 4, 3, 3, 0, 8, true, 8, DefaultTypeSelectionPolicy,
+                     special_value_policies::FNUZ>;
+using fp8_e5m2fnuz =
+    FormatDescriptor<1, 7, 5, 2, 2, 0, 8, true, 16,
+                     DefaultTypeSelectionPolicy, special_value_policies::FNUZ>;
+// OCP MX element encodings: every encoding finite
+using fp6_e3m2fn =
+    IEEE_Format<3, 2, DefaultTypeSelectionPolicy,
+                special_value_policies::FiniteOnly>;
+using fp6_e2m3fn =
+    IEEE_Format<2, 3, DefaultTypeSelectionPolicy,
+                special_value_policies::FiniteOnly>;
+using fp4_e2m1fn =
+    IEEE_Format<2, 1, DefaultTypeSelectionPolicy,
+                special_value_policies::FiniteOnly>;
+
+// A format's fields as run-time values, for formats only known at run time
+// (from a tensor file header, say): two formats with equal RuntimeFormat
+// values encode every number the same way. The type policy is not part of
+// it, since it changes the storage types, not the encodings.
+struct RuntimeFormat {
+  int sign_bits = 0;
+  int sign_offset = 0;
+  int exp_bits = 0;
+  int exp_offset = 0;
+  int mant_bits = 0;
+  int mant_offset = 0;
+  int total_bits = 0;
+  bool has_implicit_bit = false;
+  int exp_bias = 0;
+  special_value_policies::SpecialValueEncoding special_values =
+      special_value_policies::SpecialValueEncoding::IEEE;
+  bool saturate = false;
+
+  friend constexpr bool operator==(const RuntimeFormat &,
+                                   const RuntimeFormat &) = default;
+};
+
+template <typename Format> constexpr RuntimeFormat runtime_format() {
+  return {Format::sign_bits,
+          Format::sign_offset,
+          Format::exp_bits,
+          Format::exp_offset,
+          Format::mant_bits,
+          Format::mant_offset,
+          Format::total_bits,
+          Format::has_implicit_bit,
+          Format::exp_bias,
+          Format::special_values::encoding,
+          Format::special_values::saturate};
+}
+
 } // namespace opine::inline v1
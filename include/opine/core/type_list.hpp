@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace opine::inline v1 {
+
+// Compile-time lists of types, for enumerating policy combinations
+//
+// A configuration is a TypeList of one type per dimension; CartesianProduct
+// is the TypeList of every configuration:
+//
+//   using Configurations = CartesianProduct<
+//       TypeList<fp8_e5m2, fp8_e4m3>,
+//       TypeList<rounding_policies::TowardZero,
+//                rounding_policies::ToNearestTiesToEven>>;
+//   // TypeList<TypeList<fp8_e5m2, TowardZero>, ... 4 configurations>
+//
+// filter_t drops invalid (or unaffordable) configurations, shard_t keeps
+// every Count-th one so the instantiations can be split across translation
+// units, and for_each_type instantiates a generic lambda for each:
+//
+//   for_each_type<shard_t<filter_t<Valid, Configurations>, 0, 4>>(
+//       []<typename Config>() { ... });
+//
+// Only the configurations a translation unit iterates over are
+// instantiated, so the compile time and memory of each unit are bounded by
+// its shard.
+
+template <typename... Ts> struct TypeList {
+  static constexpr std::size_t size = sizeof...(Ts);
+};
+
+namespace detail {
+
+// Concatenation as a fold over an operator, so that long lists (the
+// filtered configurations) need no template recursion
+template <typename... As, typename... Bs>
+TypeList<As..., Bs...> operator+(TypeList<As...>, TypeList<Bs...>);
+
+template <typename... Lists> struct concat {
+  using type = decltype((TypeList<>{} + ... + Lists{}));
+};
+
+// Prepend T to each configuration of a TypeList of configurations
+template <typename T, typename Configurations> struct prepend_each;
+
+template <typename T, typename... Configs>
+struct prepend_each<T, TypeList<Configs...>> {
+  template <typename Config> struct prepend;
+  template <typename... Ts> struct prepend<TypeList<Ts...>> {
+    using type = TypeList<T, Ts...>;
+  };
+  using type = TypeList<typename prepend<Configs>::type...>;
+};
+
+template <typename... Lists> struct cartesian_product;
+
+template <> struct cartesian_product<> {
+  using type = TypeList<TypeList<>>;
+};
+
+template <typename... Ts, typename... Rest>
+struct cartesian_product<TypeList<Ts...>, Rest...> {
+  using type = typename concat<typename prepend_each<
+      Ts, typename cartesian_product<Rest...>::type>::type...>::type;
+};
+
+template <template <typename> class Predicate, typename List> struct filter;
+
+template <template <typename> class Predicate, typename... Ts>
+struct filter<Predicate, TypeList<Ts...>> {
+  using type = typename concat<
+      std::conditional_t<Predicate<Ts>::value, TypeList<Ts>, TypeList<>>...>::
+      type;
+};
+
+template <typename List, std::size_t Index, std::size_t Count,
+          typename Indices>
+struct shard;
+
+template <typename... Ts, std::size_t Index, std::size_t Count,
+          std::size_t... Is>
+struct shard<TypeList<Ts...>, Index, Count, std::index_sequence<Is...>> {
+  using type = typename concat<
+      std::conditional_t<Is % Count == Index, TypeList<Ts>, TypeList<>>...>::
+      type;
+};
+
+template <template <typename...> class Template, typename List> struct apply;
+
+template <template <typename...> class Template, typename... Ts>
+struct apply<Template, TypeList<Ts...>> {
+  using type = Template<Ts...>;
+};
+
+} // namespace detail
+
+// Concatenation of TypeLists
+template <typename... Lists>
+using concat_t = typename detail::concat<Lists...>::type;
+
+// Every combination of one type from each list, the first list varying
+// slowest
+template <typename... Lists>
+using CartesianProduct = typename detail::cartesian_product<Lists...>::type;
+
+// The types T of List with Predicate<T>::value
+template <template <typename> class Predicate, typename List>
+using filter_t = typename detail::filter<Predicate, List>::type;
+
+// Elements Index, Index + Count, Index + 2 Count, ... of List: shards
+// 0 .. Count - 1 partition List
+template <typename List, std::size_t Index, std::size_t Count>
+using shard_t =
+    typename detail::shard<List, Index, Count,
+                           std::make_index_sequence<List::size>>::type;
+
+// Template<Ts...> for a TypeList<Ts...> (a configuration's policies as the
+// arguments of a test or benchmark template)
+template <template <typename...> class Template, typename List>
+using apply_t = typename detail::apply<Template, List>::type;
+
+// Call f.template operator()<T>() for every T of List, in order
+template <typename List, typename F> constexpr void for_each_type(F &&f) {
+  [&]<typename... Ts>(TypeList<Ts...> *) {
+    (f.template operator()<Ts>(), ...);
+  }(static_cast<List *>(nullptr));
+}
+
+} // namespace opine::inline v1
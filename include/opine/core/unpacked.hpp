@@ -1,6 +1,7 @@
 #pragma once
 
 #include <opine/core/format.hpp>
+#include <opine/policies/denormal.hpp>
 #include <opine/policies/rounding.hpp>
 
 namespace opine::inline v1 {
@@ -19,8 +20,14 @@ namespace opine::inline v1 {
 //
 // Guard bits are initially zero after unpacking and get populated during
 // arithmetic operations (multiply, add, etc.)
+//
+// The denormal policy does not change the layout. It tells unpack(), pack()
+// and the arithmetic whether denormals can occur, so that with flushing
+// configured the code for them is compiled out.
 template <typename Format,
-          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          denormal_policies::DenormalPolicy DenormalPolicy =
+              denormal_policies::DefaultDenormalPolicy>
 struct UnpackedFloat {
   // Sign: true = negative, false = positive
   bool sign;
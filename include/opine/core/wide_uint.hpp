@@ -0,0 +1,476 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace opine::inline v1 {
+
+// Multi-limb unsigned integers, for integer widths over 64 bits without
+// _BitInt
+//
+// The type policies (policies/type_selection.hpp) return WideUint<Bits> for
+// Bits > 64 when the compiler has no _BitInt, so fp64 with guard bits (56-bit
+// significands, 112-bit products) and wider formats build with GCC and MSVC
+// too. WideUint behaves like unsigned _BitInt(Bits): arithmetic is modulo
+// 2^Bits, shifts by at least Bits give 0, integers convert to it implicitly
+// (negative ones modulo 2^Bits, as for unsigned types) and it converts to
+// integers explicitly, keeping the low bits. Conversions between widths are
+// implicit when they widen.
+//
+// The value is an array of 64-bit limbs, least significant first. Limb
+// operations use what the compiler offers (unsigned __int128, _umul128 and
+// _udiv128, add-with-carry builtins), so a 64 x 64 -> 128-bit product is one
+// multiply instruction; multiply_wide() gives that product directly, which
+// is what significand multiplication needs. Two-limb shifts and products
+// (the fp64 widths) are native 128-bit operations where the compiler has
+// unsigned __int128.
+
+namespace detail {
+
+#if defined(__SIZEOF_INT128__)
+__extension__ using uint128_type = unsigned __int128;
+#endif
+
+struct limb_pair {
+  std::uint64_t low;
+  std::uint64_t high;
+};
+
+// Full 128-bit product of two limbs
+constexpr limb_pair multiply_limbs(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  const uint128_type product = static_cast<uint128_type>(a) * b;
+  return {static_cast<std::uint64_t>(product),
+          static_cast<std::uint64_t>(product >> 64)};
+#else
+  if (!std::is_constant_evaluated()) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    std::uint64_t high = 0;
+    const std::uint64_t low = _umul128(a, b, &high);
+    return {low, high};
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    return {a * b, __umulh(a, b)};
+#endif
+  }
+  // Four 32 x 32 -> 64-bit products
+  const std::uint64_t a_low = a & 0xFFFFFFFFu;
+  const std::uint64_t a_high = a >> 32;
+  const std::uint64_t b_low = b & 0xFFFFFFFFu;
+  const std::uint64_t b_high = b >> 32;
+  const std::uint64_t low_low = a_low * b_low;
+  const std::uint64_t cross = (low_low >> 32) + (a_high * b_low & 0xFFFFFFFFu) +
+                              a_low * b_high;
+  return {(cross << 32) | (low_low & 0xFFFFFFFFu),
+          a_high * b_high + (a_high * b_low >> 32) + (cross >> 32)};
+#endif
+}
+
+// a + b + carry, setting carry to the carry out
+constexpr std::uint64_t add_limbs(std::uint64_t a, std::uint64_t b,
+                                  bool &carry) {
+#if defined(__GNUC__) || defined(__clang__)
+  std::uint64_t sum = 0;
+  const bool first = __builtin_add_overflow(a, b, &sum);
+  const bool second =
+      __builtin_add_overflow(sum, static_cast<std::uint64_t>(carry), &sum);
+  carry = first || second;
+  return sum;
+#else
+  if (!std::is_constant_evaluated()) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long long sum = 0;
+    carry = _addcarry_u64(carry, a, b, &sum) != 0;
+    return sum;
+#endif
+  }
+  const std::uint64_t sum = a + b + (carry ? 1 : 0);
+  carry = sum < a || (carry && sum == a);
+  return sum;
+#endif
+}
+
+// a - b - borrow, setting borrow to the borrow out
+constexpr std::uint64_t subtract_limbs(std::uint64_t a, std::uint64_t b,
+                                       bool &borrow) {
+#if defined(__GNUC__) || defined(__clang__)
+  std::uint64_t difference = 0;
+  const bool first = __builtin_sub_overflow(a, b, &difference);
+  const bool second = __builtin_sub_overflow(
+      difference, static_cast<std::uint64_t>(borrow), &difference);
+  borrow = first || second;
+  return difference;
+#else
+  if (!std::is_constant_evaluated()) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long long difference = 0;
+    borrow = _subborrow_u64(borrow, a, b, &difference) != 0;
+    return difference;
+#endif
+  }
+  const std::uint64_t difference = a - b - (borrow ? 1 : 0);
+  borrow = a < b || (borrow && a == b);
+  return difference;
+#endif
+}
+
+// (high:low) / divisor and the remainder, for high < divisor
+constexpr std::uint64_t divide_limbs(std::uint64_t high, std::uint64_t low,
+                                     std::uint64_t divisor,
+                                     std::uint64_t &remainder) {
+#if defined(__SIZEOF_INT128__)
+  const uint128_type dividend = (static_cast<uint128_type>(high) << 64) | low;
+  remainder = static_cast<std::uint64_t>(dividend % divisor);
+  return static_cast<std::uint64_t>(dividend / divisor);
+#else
+  if (!std::is_constant_evaluated()) {
+#if defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+    return _udiv128(high, low, divisor, &remainder);
+#endif
+  }
+  // Restoring division, one quotient bit per step
+  std::uint64_t quotient = 0;
+  for (int i = 63; i >= 0; --i) {
+    const bool overflow = (high >> 63) != 0;
+    high = (high << 1) | ((low >> i) & 1);
+    quotient <<= 1;
+    if (overflow || high >= divisor) {
+      high -= divisor;
+      quotient |= 1;
+    }
+  }
+  remainder = high;
+  return quotient;
+#endif
+}
+
+} // namespace detail
+
+template <int Bits> class WideUint {
+  static_assert(Bits > 0, "WideUint needs at least 1 bit");
+
+public:
+  using limb_type = std::uint64_t;
+  static constexpr int bits = Bits;
+  static constexpr int limb_count = (Bits + 63) / 64;
+
+  constexpr WideUint() = default;
+
+  // Integers modulo 2^Bits
+  template <std::integral T> constexpr WideUint(T value) {
+    limbs_[0] = static_cast<limb_type>(value);
+    if constexpr (std::is_signed_v<T>) {
+      if (value < 0) {
+        for (int i = 1; i < limb_count; ++i) {
+          limbs_[i] = ~limb_type{0};
+        }
+      }
+    }
+    mask_top();
+  }
+
+  // Other widths, keeping the low Bits bits
+  template <int OtherBits>
+  constexpr explicit(OtherBits > Bits)
+      WideUint(const WideUint<OtherBits> &other) {
+    for (int i = 0; i < limb_count && i < WideUint<OtherBits>::limb_count;
+         ++i) {
+      limbs_[i] = other.limb(i);
+    }
+    mask_top();
+  }
+
+  // The low bits, as for a conversion between unsigned types
+  template <std::integral T> constexpr explicit operator T() const {
+    if constexpr (std::is_same_v<T, bool>) {
+      return *this != WideUint{};
+    } else {
+      return static_cast<T>(limbs_[0]);
+    }
+  }
+
+  constexpr limb_type limb(int index) const { return limbs_[index]; }
+
+  // Number of bits needed to represent the value (0 for 0)
+  constexpr int bit_width() const {
+    for (int i = limb_count - 1; i >= 0; --i) {
+      if (limbs_[i] != 0) {
+        return 64 * i + std::bit_width(limbs_[i]);
+      }
+    }
+    return 0;
+  }
+
+  friend constexpr WideUint operator+(WideUint a, const WideUint &b) {
+    bool carry = false;
+    for (int i = 0; i < limb_count; ++i) {
+      a.limbs_[i] = detail::add_limbs(a.limbs_[i], b.limbs_[i], carry);
+    }
+    a.mask_top();
+    return a;
+  }
+
+  friend constexpr WideUint operator-(WideUint a, const WideUint &b) {
+    bool borrow = false;
+    for (int i = 0; i < limb_count; ++i) {
+      a.limbs_[i] = detail::subtract_limbs(a.limbs_[i], b.limbs_[i], borrow);
+    }
+    a.mask_top();
+    return a;
+  }
+
+  // Schoolbook product, the limbs above Bits dropped
+  friend constexpr WideUint operator*(const WideUint &a, const WideUint &b) {
+    WideUint product;
+#if defined(__SIZEOF_INT128__)
+    if constexpr (limb_count == 2) {
+      product.set_uint128(a.uint128() * b.uint128());
+      product.mask_top();
+      return product;
+    }
+#endif
+    for (int i = 0; i < limb_count; ++i) {
+      limb_type carry = 0;
+      for (int j = 0; i + j < limb_count; ++j) {
+        const auto partial = detail::multiply_limbs(a.limbs_[i], b.limbs_[j]);
+        bool overflow = false;
+        const limb_type sum =
+            detail::add_limbs(product.limbs_[i + j], partial.low, overflow);
+        bool overflow_carry = false;
+        product.limbs_[i + j] = detail::add_limbs(sum, carry, overflow_carry);
+        carry = partial.high + (overflow ? 1 : 0) + (overflow_carry ? 1 : 0);
+      }
+    }
+    product.mask_top();
+    return product;
+  }
+
+  friend constexpr WideUint operator/(const WideUint &a, const WideUint &b) {
+    WideUint quotient;
+    WideUint remainder;
+    divide(a, b, quotient, remainder);
+    return quotient;
+  }
+
+  friend constexpr WideUint operator%(const WideUint &a, const WideUint &b) {
+    WideUint quotient;
+    WideUint remainder;
+    divide(a, b, quotient, remainder);
+    return remainder;
+  }
+
+  friend constexpr WideUint operator&(WideUint a, const WideUint &b) {
+    for (int i = 0; i < limb_count; ++i) {
+      a.limbs_[i] &= b.limbs_[i];
+    }
+    return a;
+  }
+
+  friend constexpr WideUint operator|(WideUint a, const WideUint &b) {
+    for (int i = 0; i < limb_count; ++i) {
+      a.limbs_[i] |= b.limbs_[i];
+    }
+    return a;
+  }
+
+  friend constexpr WideUint operator^(WideUint a, const WideUint &b) {
+    for (int i = 0; i < limb_count; ++i) {
+      a.limbs_[i] ^= b.limbs_[i];
+    }
+    return a;
+  }
+
+  friend constexpr WideUint operator~(WideUint a) {
+    for (int i = 0; i < limb_count; ++i) {
+      a.limbs_[i] = ~a.limbs_[i];
+    }
+    a.mask_top();
+    return a;
+  }
+
+  friend constexpr WideUint operator-(const WideUint &a) {
+    return WideUint{} - a;
+  }
+
+  template <std::integral Shift>
+  friend constexpr WideUint operator<<(const WideUint &a, Shift shift) {
+    WideUint result;
+    if (shift < 0 || shift >= Bits) {
+      return result;
+    }
+#if defined(__SIZEOF_INT128__)
+    if constexpr (limb_count == 2) {
+      result.set_uint128(a.uint128() << shift);
+      result.mask_top();
+      return result;
+    }
+#endif
+    const int limb_shift = static_cast<int>(shift) / 64;
+    const int bit_shift = static_cast<int>(shift) % 64;
+    for (int i = limb_count - 1; i >= limb_shift; --i) {
+      limb_type limb = a.limbs_[i - limb_shift] << bit_shift;
+      if (bit_shift != 0 && i - limb_shift > 0) {
+        limb |= a.limbs_[i - limb_shift - 1] >> (64 - bit_shift);
+      }
+      result.limbs_[i] = limb;
+    }
+    result.mask_top();
+    return result;
+  }
+
+  template <std::integral Shift>
+  friend constexpr WideUint operator>>(const WideUint &a, Shift shift) {
+    WideUint result;
+    if (shift < 0 || shift >= Bits) {
+      return result;
+    }
+#if defined(__SIZEOF_INT128__)
+    if constexpr (limb_count == 2) {
+      result.set_uint128(a.uint128() >> shift);
+      return result;
+    }
+#endif
+    const int limb_shift = static_cast<int>(shift) / 64;
+    const int bit_shift = static_cast<int>(shift) % 64;
+    for (int i = 0; i + limb_shift < limb_count; ++i) {
+      limb_type limb = a.limbs_[i + limb_shift] >> bit_shift;
+      if (bit_shift != 0 && i + limb_shift + 1 < limb_count) {
+        limb |= a.limbs_[i + limb_shift + 1] << (64 - bit_shift);
+      }
+      result.limbs_[i] = limb;
+    }
+    return result;
+  }
+
+  constexpr WideUint &operator+=(const WideUint &b) {
+    return *this = *this + b;
+  }
+  constexpr WideUint &operator-=(const WideUint &b) {
+    return *this = *this - b;
+  }
+  constexpr WideUint &operator*=(const WideUint &b) {
+    return *this = *this * b;
+  }
+  constexpr WideUint &operator/=(const WideUint &b) {
+    return *this = *this / b;
+  }
+  constexpr WideUint &operator%=(const WideUint &b) {
+    return *this = *this % b;
+  }
+  constexpr WideUint &operator&=(const WideUint &b) {
+    return *this = *this & b;
+  }
+  constexpr WideUint &operator|=(const WideUint &b) {
+    return *this = *this | b;
+  }
+  constexpr WideUint &operator^=(const WideUint &b) {
+    return *this = *this ^ b;
+  }
+  template <std::integral Shift> constexpr WideUint &operator<<=(Shift shift) {
+    return *this = *this << shift;
+  }
+  template <std::integral Shift> constexpr WideUint &operator>>=(Shift shift) {
+    return *this = *this >> shift;
+  }
+  constexpr WideUint &operator++() { return *this += 1; }
+  constexpr WideUint &operator--() { return *this -= 1; }
+  constexpr WideUint operator++(int) {
+    const WideUint old = *this;
+    ++*this;
+    return old;
+  }
+  constexpr WideUint operator--(int) {
+    const WideUint old = *this;
+    --*this;
+    return old;
+  }
+
+  friend constexpr bool operator==(const WideUint &,
+                                   const WideUint &) = default;
+
+  friend constexpr std::strong_ordering operator<=>(const WideUint &a,
+                                                    const WideUint &b) {
+    for (int i = limb_count - 1; i >= 0; --i) {
+      if (a.limbs_[i] != b.limbs_[i]) {
+        return a.limbs_[i] <=> b.limbs_[i];
+      }
+    }
+    return std::strong_ordering::equal;
+  }
+
+private:
+  static constexpr limb_type top_mask =
+      Bits % 64 == 0 ? ~limb_type{0}
+                     : (limb_type{1} << (Bits % 64)) - 1;
+
+  constexpr void mask_top() { limbs_[limb_count - 1] &= top_mask; }
+
+#if defined(__SIZEOF_INT128__)
+  // Two limbs as one native 128-bit integer
+  constexpr detail::uint128_type uint128() const {
+    return (static_cast<detail::uint128_type>(limbs_[1]) << 64) | limbs_[0];
+  }
+  constexpr void set_uint128(detail::uint128_type value) {
+    limbs_[0] = static_cast<limb_type>(value);
+    limbs_[1] = static_cast<limb_type>(value >> 64);
+  }
+#endif
+
+  // Quotient and remainder (both 0 for a zero divisor): short division when
+  // the divisor fits in a limb (significand quotients), restoring division
+  // otherwise
+  static constexpr void divide(const WideUint &a, const WideUint &b,
+                               WideUint &quotient, WideUint &remainder) {
+    quotient = WideUint{};
+    remainder = WideUint{};
+    const int divisor_bits = b.bit_width();
+    if (divisor_bits == 0) {
+      return;
+    }
+    if (divisor_bits <= 64) {
+      limb_type rest = 0;
+      for (int i = limb_count - 1; i >= 0; --i) {
+        quotient.limbs_[i] =
+            detail::divide_limbs(rest, a.limbs_[i], b.limbs_[0], rest);
+      }
+      remainder.limbs_[0] = rest;
+      return;
+    }
+    // One more bit: the shifted remainder may exceed Bits
+    using rest_type = WideUint<Bits + 1>;
+    const rest_type divisor(b);
+    rest_type rest;
+    for (int i = a.bit_width() - 1; i >= 0; --i) {
+      rest = (rest << 1) | rest_type((a.limbs_[i / 64] >> (i % 64)) & 1);
+      if (rest >= divisor) {
+        rest = rest - divisor;
+        quotient.limbs_[i / 64] |= limb_type{1} << (i % 64);
+      }
+    }
+    remainder = WideUint(rest);
+  }
+
+  std::array<limb_type, limb_count> limbs_{};
+};
+
+// True for WideUint types
+template <typename T> inline constexpr bool is_wide_uint = false;
+template <int Bits> inline constexpr bool is_wide_uint<WideUint<Bits>> = true;
+
+// Full product of two integers of at most 64 bits: one multiply instruction
+// where the platform has a 64 x 64 -> 128-bit multiply
+template <int Bits>
+constexpr WideUint<Bits> multiply_wide(std::uint64_t a, std::uint64_t b) {
+  static_assert(Bits > 64, "multiply_wide() returns more than 64 bits");
+  const auto product = detail::multiply_limbs(a, b);
+  return (WideUint<Bits>(product.high) << 64) | WideUint<Bits>(product.low);
+}
+
+} // namespace opine::inline v1
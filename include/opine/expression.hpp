@@ -0,0 +1,201 @@
+#pragma once
+
+#include <concepts>
+#include <opine/core/extended.hpp>
+#include <opine/core/unpacked.hpp>
+#include <opine/operations/arithmetic.hpp>
+#include <opine/operations/extended.hpp>
+#include <opine/operations/normalize.hpp>
+#include <opine/policies/evaluation.hpp>
+#include <type_traits>
+
+namespace opine::inline v1 {
+
+// Expression templates for FloatEngine
+//
+// The arithmetic operators on FloatEngine values build expression nodes
+// instead of computing results. An expression is evaluated when it is
+// converted to a FloatEngine (assignment, construction, compound
+// assignment): every node computes on UnpackedFloat values, and only the
+// final result is packed. So
+//
+//   fp8 r = a * b + c * d;
+//
+// unpacks four operands, performs three unpacked operations and packs once.
+// Whether intermediates are rounded is the configuration's evaluation policy
+// (policies/evaluation.hpp): RoundOnce keeps them unrounded, RoundEveryStep
+// applies round() after each operation for IEEE 754 results, ExtendedRange
+// computes on ExtendedFloat values instead and applies the format's range
+// only to the result.
+//
+// Nodes hold their operands by value (a FloatEngine is just its storage), so
+// an expression saved with auto stays valid after its operands go away.
+
+// Value type expressions of a configuration evaluate to: UnpackedFloat, or
+// ExtendedFloat under an ExtendedRange evaluation policy
+template <typename Config>
+using intermediate_t = std::conditional_t<
+    evaluation_policies::uses_extended_range<
+        typename Config::evaluation_policy>,
+    ExtendedFloat<typename Config::format, typename Config::rounding_policy,
+                  typename Config::denormal_policy>,
+    UnpackedFloat<typename Config::format, typename Config::rounding_policy,
+                  typename Config::denormal_policy>>;
+
+// Concept: anything that evaluates to the intermediate type of its
+// configuration
+//
+// Satisfied by FloatEngine (the leaves) and by the expression nodes.
+template <typename E>
+concept FloatExpression = requires(const E &expression) {
+  typename E::config;
+  {
+    expression.evaluate()
+  } -> std::same_as<intermediate_t<typename E::config>>;
+};
+
+// Concept: two expressions over the same configuration
+template <typename L, typename R>
+concept SameConfigExpressions =
+    FloatExpression<L> && FloatExpression<R> &&
+    std::same_as<typename L::config, typename R::config>;
+
+namespace detail {
+
+struct add_op {
+  template <typename T> static constexpr T apply(const T &a, const T &b) {
+    return opine::add(a, b);
+  }
+};
+
+struct subtract_op {
+  template <typename T> static constexpr T apply(const T &a, const T &b) {
+    return opine::subtract(a, b);
+  }
+};
+
+struct multiply_op {
+  template <typename T> static constexpr T apply(const T &a, const T &b) {
+    return opine::multiply(a, b);
+  }
+};
+
+struct divide_op {
+  template <typename T> static constexpr T apply(const T &a, const T &b) {
+    return opine::divide(a, b);
+  }
+};
+
+} // namespace detail
+
+// Binary operation node
+template <typename Op, FloatExpression L, FloatExpression R>
+  requires SameConfigExpressions<L, R>
+class BinaryExpression {
+public:
+  using config = typename L::config;
+  using intermediate_type = intermediate_t<config>;
+
+  constexpr BinaryExpression(const L &lhs, const R &rhs)
+      : lhs_(lhs), rhs_(rhs) {}
+
+  constexpr intermediate_type evaluate() const {
+    const auto result = Op::apply(lhs_.evaluate(), rhs_.evaluate());
+    if constexpr (config::evaluation_policy::round_every_step) {
+      return opine::round(result);
+    } else {
+      return result;
+    }
+  }
+
+private:
+  L lhs_;
+  R rhs_;
+};
+
+// Fused multiply-add node: a * b + c, one operation (one rounding in either
+// evaluation mode)
+template <FloatExpression A, FloatExpression B, FloatExpression C>
+  requires SameConfigExpressions<A, B> && SameConfigExpressions<A, C>
+class FmaExpression {
+public:
+  using config = typename A::config;
+  using intermediate_type = intermediate_t<config>;
+
+  constexpr FmaExpression(const A &a, const B &b, const C &c)
+      : a_(a), b_(b), c_(c) {}
+
+  constexpr intermediate_type evaluate() const {
+    const auto result = opine::fma(a_.evaluate(), b_.evaluate(), c_.evaluate());
+    if constexpr (config::evaluation_policy::round_every_step) {
+      return opine::round(result);
+    } else {
+      return result;
+    }
+  }
+
+private:
+  A a_;
+  B b_;
+  C c_;
+};
+
+// Negation node: flips the sign, exact in either evaluation mode
+template <FloatExpression E> class NegateExpression {
+public:
+  using config = typename E::config;
+  using intermediate_type = intermediate_t<config>;
+
+  constexpr explicit NegateExpression(const E &operand) : operand_(operand) {}
+
+  constexpr intermediate_type evaluate() const {
+    auto result = operand_.evaluate();
+    if constexpr (!config::format::special_values::has_negative_zero) {
+      // As in subtract(): the sign of +0 and NaN is part of their encoding
+      if (is_zero(result) || is_nan(result)) {
+        return result;
+      }
+    }
+    result.sign = !result.sign;
+    return result;
+  }
+
+private:
+  E operand_;
+};
+
+template <FloatExpression L, FloatExpression R>
+  requires SameConfigExpressions<L, R>
+constexpr auto operator+(const L &lhs, const R &rhs) {
+  return BinaryExpression<detail::add_op, L, R>(lhs, rhs);
+}
+
+template <FloatExpression L, FloatExpression R>
+  requires SameConfigExpressions<L, R>
+constexpr auto operator-(const L &lhs, const R &rhs) {
+  return BinaryExpression<detail::subtract_op, L, R>(lhs, rhs);
+}
+
+template <FloatExpression L, FloatExpression R>
+  requires SameConfigExpressions<L, R>
+constexpr auto operator*(const L &lhs, const R &rhs) {
+  return BinaryExpression<detail::multiply_op, L, R>(lhs, rhs);
+}
+
+template <FloatExpression L, FloatExpression R>
+  requires SameConfigExpressions<L, R>
+constexpr auto operator/(const L &lhs, const R &rhs) {
+  return BinaryExpression<detail::divide_op, L, R>(lhs, rhs);
+}
+
+template <FloatExpression E> constexpr auto operator-(const E &operand) {
+  return NegateExpression<E>(operand);
+}
+
+template <FloatExpression A, FloatExpression B, FloatExpression C>
+  requires SameConfigExpressions<A, B> && SameConfigExpressions<A, C>
+constexpr auto fma(const A &a, const B &b, const C &c) {
+  return FmaExpression<A, B, C>(a, b, c);
+}
+
+} // namespace opine::inline v1
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <opine/core/prefix.hpp>
+#include <opine/float_engine.hpp>
+#include <opine/operations/classify.hpp>
+#include <opine/policies/rounding.hpp>
+#include <opine/policies/special_values.hpp>
+#include <type_traits>
+
+// Storage-level operations implemented outside C++
+//
+// An implementation policy (float_engine.hpp) derives from DefaultOps and
+// replaces individual operations with calls to extern functions: hand-written
+// assembly, ROM entry points behind a small trampoline, or a runtime library.
+// call_extern<Function>() passes the storage operands in the function's own
+// parameter types, so an inlined operation compiles to the bare call:
+//
+//   extern "C" float OPINE_C_NAME(mulsf3)(float, float);
+//
+//   template <typename Config> struct FastOps : DefaultOps<Config> {
+//     using storage_type = typename DefaultOps<Config>::storage_type;
+//     static storage_type multiply(storage_type a, storage_type b) {
+//       return call_extern<OPINE_C_NAME(mulsf3), storage_type>(a, b);
+//     }
+//   };
+//
+//   using fp32 = FloatEngine<FloatConfig<fp32_e8m23, RNE, RoundOnce, FastOps>>;
+//
+// RuntimeLibraryOps does this for the binary32 and binary64 arithmetic of
+// the soft-float ABI (addsf3, mulsf3, adddf3, ...).
+
+// C entry points of RuntimeLibraryOps
+//
+// OPINE_C_NAME(mulsf3) is __opine_mulsf3 by default; with OPINE_C_PREFIX
+// defined as __ it is the runtime library's own __mulsf3 (compiler-rt,
+// libgcc, or a replacement such as docs/reference/mulsf3.s).
+extern "C" {
+float OPINE_C_NAME(addsf3)(float, float);
+float OPINE_C_NAME(subsf3)(float, float);
+float OPINE_C_NAME(mulsf3)(float, float);
+float OPINE_C_NAME(divsf3)(float, float);
+double OPINE_C_NAME(adddf3)(double, double);
+double OPINE_C_NAME(subdf3)(double, double);
+double OPINE_C_NAME(muldf3)(double, double);
+double OPINE_C_NAME(divdf3)(double, double);
+}
+
+namespace opine::inline v1 {
+
+namespace detail {
+
+// Unsigned integer of the same size as T
+template <typename T>
+using same_size_uint = std::conditional_t<
+    sizeof(T) == 1, std::uint8_t,
+    std::conditional_t<
+        sizeof(T) == 2, std::uint16_t,
+        std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+// Storage bits as an extern parameter: integers by value, anything else
+// (float, double) by bit pattern
+template <typename T, typename Storage>
+constexpr T from_storage(Storage bits) {
+  if constexpr (std::is_integral_v<T>) {
+    return static_cast<T>(bits);
+  } else {
+    return std::bit_cast<T>(static_cast<same_size_uint<T>>(bits));
+  }
+}
+
+template <typename Storage, typename T> constexpr Storage to_storage(T value) {
+  if constexpr (std::is_integral_v<T>) {
+    return static_cast<Storage>(value);
+  } else {
+    return static_cast<Storage>(std::bit_cast<same_size_uint<T>>(value));
+  }
+}
+
+template <typename Function> struct extern_call;
+
+template <typename R, typename... Args> struct extern_call<R (*)(Args...)> {
+  template <auto Function, typename Storage, typename... Operands>
+  static Storage call(Operands... operands) {
+    static_assert(sizeof...(Operands) == sizeof...(Args),
+                  "One storage operand per parameter");
+    return to_storage<Storage>(Function(from_storage<Args>(operands)...));
+  }
+};
+
+// Formats whose storage and special values are exactly an IEEE 754
+// interchange format: Inf and NaN results, overflow to Inf
+template <typename Format, int ExpBits, int MantBits>
+inline constexpr bool is_interchange_format =
+    Format::is_standard_layout() && Format::exp_bits == ExpBits &&
+    Format::mant_bits == MantBits && Format::has_implicit_bit &&
+    Format::exp_bias == (1 << (ExpBits - 1)) - 1 &&
+    special_encoding<Format> ==
+        special_value_policies::SpecialValueEncoding::IEEE &&
+    !Format::special_values::saturate;
+
+} // namespace detail
+
+// Call an extern function on storage operands
+//
+// Function takes one parameter per operand and returns the result; floating
+// point parameters and results carry the storage bits (float for binary32,
+// double for binary64), integer ones the storage value.
+template <auto Function, typename Storage, typename... Operands>
+Storage call_extern(Operands... operands) {
+  return detail::extern_call<decltype(Function)>::template call<Function,
+                                                                Storage>(
+      operands...);
+}
+
+// Implementation policy: the soft-float runtime library
+//
+// add, subtract, multiply and divide of binary32 and binary64 formats call
+// OPINE_C_NAME(addsf3), ... (see above), which round to nearest, ties to
+// even, with gradual underflow and IEEE special values; other formats
+// (saturating or without Inf, say), rounding and denormal
+// policies, and the remaining operations, use DefaultOps.
+template <typename Config> struct RuntimeLibraryOps : DefaultOps<Config> {
+  using base = DefaultOps<Config>;
+  using format = typename base::format;
+  using storage_type = typename base::storage_type;
+
+  static constexpr bool is_binary32 =
+      detail::is_interchange_format<format, 8, 23>;
+  static constexpr bool is_binary64 =
+      detail::is_interchange_format<format, 11, 52>;
+  static constexpr bool uses_library =
+      (is_binary32 || is_binary64) &&
+      std::is_same_v<typename base::rounding_policy,
+                     rounding_policies::ToNearestTiesToEven> &&
+      !base::denormal_policy::flush_inputs &&
+      !base::denormal_policy::flush_outputs;
+
+  static constexpr storage_type add(storage_type a, storage_type b) {
+    if constexpr (uses_library && is_binary32) {
+      return call_extern<OPINE_C_NAME(addsf3), storage_type>(a, b);
+    } else if constexpr (uses_library) {
+      return call_extern<OPINE_C_NAME(adddf3), storage_type>(a, b);
+    } else {
+      return base::add(a, b);
+    }
+  }
+
+  static constexpr storage_type subtract(storage_type a, storage_type b) {
+    if constexpr (uses_library && is_binary32) {
+      return call_extern<OPINE_C_NAME(subsf3), storage_type>(a, b);
+    } else if constexpr (uses_library) {
+      return call_extern<OPINE_C_NAME(subdf3), storage_type>(a, b);
+    } else {
+      return base::subtract(a, b);
+    }
+  }
+
+  static constexpr storage_type multiply(storage_type a, storage_type b) {
+    if constexpr (uses_library && is_binary32) {
+      return call_extern<OPINE_C_NAME(mulsf3), storage_type>(a, b);
+    } else if constexpr (uses_library) {
+      return call_extern<OPINE_C_NAME(muldf3), storage_type>(a, b);
+    } else {
+      return base::multiply(a, b);
+    }
+  }
+
+  static constexpr storage_type divide(storage_type a, storage_type b) {
+    if constexpr (uses_library && is_binary32) {
+      return call_extern<OPINE_C_NAME(divsf3), storage_type>(a, b);
+    } else if constexpr (uses_library) {
+      return call_extern<OPINE_C_NAME(divdf3), storage_type>(a, b);
+    } else {
+      return base::divide(a, b);
+    }
+  }
+};
+
+} // namespace opine::inline v1
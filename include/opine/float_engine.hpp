@@ -0,0 +1,233 @@
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <opine/core/format.hpp>
+#include <opine/core/unpacked.hpp>
+#include <opine/expression.hpp>
+#include <opine/operations/arithmetic.hpp>
+#include <opine/operations/compare.hpp>
+#include <opine/operations/pack_unpack.hpp>
+#include <opine/policies/denormal.hpp>
+#include <opine/policies/evaluation.hpp>
+#include <opine/policies/rounding.hpp>
+
+namespace opine::inline v1 {
+
+template <typename Config> struct DefaultOps;
+
+// Configuration bundle for FloatEngine
+//
+// Groups the policies a float type is built from. Further policy groups are
+// added here as members with defaults, so existing configurations keep
+// compiling. The special values (Inf, NaN, signed zero) are part of the
+// format: Format::special_values.
+//
+// Implementation is the implementation policy: a class template over the
+// configuration providing the storage-level operations (see DefaultOps and
+// extern_ops.hpp). DenormalPolicy selects gradual underflow or flushing
+// (policies/denormal.hpp) for every unpack, operation and pack.
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          evaluation_policies::EvaluationPolicy EvaluationPolicy =
+              evaluation_policies::DefaultEvaluationPolicy,
+          template <typename> typename Implementation = DefaultOps,
+          denormal_policies::DenormalPolicy DenormalPolicy =
+              denormal_policies::DefaultDenormalPolicy>
+struct FloatConfig {
+  using format = Format;
+  using rounding_policy = RoundingPolicy;
+  using evaluation_policy = EvaluationPolicy;
+  using denormal_policy = DenormalPolicy;
+  using implementation = Implementation<FloatConfig>;
+};
+
+// Concept: an implementation of the storage-level operations
+//
+// Implementations derive from DefaultOps<Config> and redefine the
+// operations they replace; the others are inherited.
+template <typename Ops>
+concept StorageOps = requires(typename Ops::storage_type a,
+                              typename Ops::unpacked_type u) {
+  { Ops::unpack(a) } -> std::same_as<typename Ops::unpacked_type>;
+  { Ops::pack(u) } -> std::same_as<typename Ops::storage_type>;
+  { Ops::add(a, a) } -> std::same_as<typename Ops::storage_type>;
+  { Ops::subtract(a, a) } -> std::same_as<typename Ops::storage_type>;
+  { Ops::multiply(a, a) } -> std::same_as<typename Ops::storage_type>;
+  { Ops::divide(a, a) } -> std::same_as<typename Ops::storage_type>;
+  { Ops::fma(a, a, a) } -> std::same_as<typename Ops::storage_type>;
+};
+
+// Default implementation of the storage-level operations: pure C++
+//
+// Each operation unpacks its operands, computes the unrounded result with the
+// UnpackedFloat arithmetic (operations/arithmetic.hpp) and packs it, so the
+// result is rounded exactly once.
+template <typename Config> struct DefaultOps {
+  using format = typename Config::format;
+  using rounding_policy = typename Config::rounding_policy;
+  using denormal_policy = typename Config::denormal_policy;
+  using storage_type = typename format::storage_type;
+  using unpacked_type = UnpackedFloat<format, rounding_policy, denormal_policy>;
+
+  static constexpr unpacked_type unpack(storage_type bits) {
+    return opine::unpack<format, rounding_policy, denormal_policy>(bits);
+  }
+
+  static constexpr storage_type pack(const unpacked_type &value) {
+    return opine::pack<format, rounding_policy, denormal_policy>(value);
+  }
+
+  static constexpr storage_type add(storage_type a, storage_type b) {
+    return pack(opine::add(unpack(a), unpack(b)));
+  }
+
+  static constexpr storage_type subtract(storage_type a, storage_type b) {
+    return pack(opine::subtract(unpack(a), unpack(b)));
+  }
+
+  static constexpr storage_type multiply(storage_type a, storage_type b) {
+    return pack(opine::multiply(unpack(a), unpack(b)));
+  }
+
+  static constexpr storage_type divide(storage_type a, storage_type b) {
+    return pack(opine::divide(unpack(a), unpack(b)));
+  }
+
+  static constexpr storage_type fma(storage_type a, storage_type b,
+                                    storage_type c) {
+    return pack(opine::fma(unpack(a), unpack(b), unpack(c)));
+  }
+};
+
+// A floating point type generated from a configuration
+//
+// Holds one value in its storage format. The arithmetic operators build
+// expressions (expression.hpp) that are evaluated on unpacked values and
+// packed once, when assigned to a FloatEngine; the configuration's
+// evaluation policy decides whether intermediates are rounded. The static
+// storage-level operations round each result, one operation at a time.
+//
+// Everything goes through the configuration's implementation policy: the
+// storage-level operations, and the unpack() and pack() of expression
+// leaves and results. Expression nodes themselves compute with the
+// UnpackedFloat arithmetic.
+//
+// Usage:
+//   using RNE = rounding_policies::ToNearestTiesToEven;
+//   using fp8 = FloatEngine<FloatConfig<fp8_e4m3, RNE>>;
+//   fp8 c = fp8::from_bits(0x38) * fp8::from_bits(0x40);  // 1.0 * 2.0
+template <typename Config> class FloatEngine {
+public:
+  using config = Config;
+  using format = typename Config::format;
+  using rounding_policy = typename Config::rounding_policy;
+  using denormal_policy = typename Config::denormal_policy;
+  using storage_type = typename format::storage_type;
+  using unpacked_type = UnpackedFloat<format, rounding_policy, denormal_policy>;
+  using ops = typename Config::implementation;
+
+  static_assert(StorageOps<ops>,
+                "Implementation policy must provide the storage-level "
+                "operations (derive it from DefaultOps)");
+
+  constexpr FloatEngine() = default;
+
+  // Evaluate an expression and pack the result (the only rounding in
+  // RoundOnce mode)
+  template <FloatExpression E>
+    requires std::same_as<typename E::config, Config>
+  constexpr FloatEngine(const E &expression)
+      : bits_(ops::pack(unpacked_result(expression.evaluate()))) {}
+
+  static constexpr FloatEngine from_bits(storage_type bits) {
+    FloatEngine result;
+    result.bits_ = bits;
+    return result;
+  }
+
+  static constexpr FloatEngine from_unpacked(const unpacked_type &value) {
+    return from_bits(ops::pack(value));
+  }
+
+  constexpr storage_type bits() const { return bits_; }
+
+  constexpr unpacked_type unpacked() const {
+    return ops::unpack(bits_);
+  }
+
+  // Storage-level operations
+  static constexpr storage_type add(storage_type a, storage_type b) {
+    return ops::add(a, b);
+  }
+  static constexpr storage_type subtract(storage_type a, storage_type b) {
+    return ops::subtract(a, b);
+  }
+  static constexpr storage_type multiply(storage_type a, storage_type b) {
+    return ops::multiply(a, b);
+  }
+  static constexpr storage_type divide(storage_type a, storage_type b) {
+    return ops::divide(a, b);
+  }
+  static constexpr storage_type fma(storage_type a, storage_type b,
+                                    storage_type c) {
+    return ops::fma(a, b, c);
+  }
+
+  // Expression leaf: the value, unpacked (and extended under ExtendedRange)
+  constexpr intermediate_t<Config> evaluate() const {
+    if constexpr (evaluation_policies::uses_extended_range<
+                      typename Config::evaluation_policy>) {
+      return extend(unpacked());
+    } else {
+      return unpacked();
+    }
+  }
+
+  // IEEE 754 comparison (compare()): NaN is unordered, -0 == +0
+  friend constexpr bool operator==(const FloatEngine &a,
+                                   const FloatEngine &b) {
+    return compare(a.unpacked(), b.unpacked()) == 0;
+  }
+  friend constexpr std::partial_ordering operator<=>(const FloatEngine &a,
+                                                     const FloatEngine &b) {
+    return compare(a.unpacked(), b.unpacked());
+  }
+
+  template <FloatExpression E>
+    requires std::same_as<typename E::config, Config>
+  constexpr FloatEngine &operator+=(const E &other) {
+    return *this = *this + other;
+  }
+  template <FloatExpression E>
+    requires std::same_as<typename E::config, Config>
+  constexpr FloatEngine &operator-=(const E &other) {
+    return *this = *this - other;
+  }
+  template <FloatExpression E>
+    requires std::same_as<typename E::config, Config>
+  constexpr FloatEngine &operator*=(const E &other) {
+    return *this = *this * other;
+  }
+  template <FloatExpression E>
+    requires std::same_as<typename E::config, Config>
+  constexpr FloatEngine &operator/=(const E &other) {
+    return *this = *this / other;
+  }
+
+private:
+  // An expression result as the implementation's pack() takes it
+  static constexpr unpacked_type
+  unpacked_result(const intermediate_t<Config> &value) {
+    if constexpr (evaluation_policies::uses_extended_range<
+                      typename Config::evaluation_policy>) {
+      return to_unpacked(value);
+    } else {
+      return value;
+    }
+  }
+
+  storage_type bits_{};
+};
+
+} // namespace opine::inline v1
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <opine/core/format.hpp>
+#include <opine/core/type_list.hpp>
+#include <opine/microscaling.hpp>
+#include <opine/operations/convert_n.hpp>
+#include <opine/packed_array.hpp>
+#include <opine/policies/conversion.hpp>
+#include <opine/policies/table.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace opine::inline v1 {
+
+// Bulk kernels for formats chosen at run time
+//
+// Opt-in: this header is not part of opine.hpp, because it instantiates the
+// bulk kernels of every predefined format (each translation unit that uses
+// a registry compiles all of them).
+//
+// Formats are template parameters everywhere else, but a server may only
+// learn a tensor's format from a file header. A registry instantiates, for
+// every format of a TypeList (PredefinedFormats by default), kernels that
+// convert between it and one Working format the caller computes in, and
+// exposes them as a table of function pointers looked up by RuntimeFormat.
+// Dispatch is per span, not per element: one lookup, then one indirect call
+// per batch, each running the same convert_n() loop (tables, widening) as a
+// compile-time call would.
+//
+// Usage:
+//   TensorFile file("weights.opine");
+//   const auto *kernels = find_format_kernels<fp32_e8m23>(file.format());
+//   if (kernels == nullptr) { ... unsupported format ... }
+//   std::vector<std::uint32_t> weights(file.size());
+//   kernels->decode(file.data_bytes(), weights);
+//
+// MX formats have their own registry, keyed by element format and block
+// size (find_mx_kernels()).
+
+// Formats with registered kernels: those of core/format.hpp
+using PredefinedFormats =
+    TypeList<fp8_e5m2, fp8_e4m3, fp16_e5m10, fp32_e8m23, fp64_e11m52,
+             fp6_e3m2, fp6_e2m3, fp4_e2m1, fp8_e4m3fn, fp8_e4m3fnuz,
+             fp8_e5m2fnuz, fp6_e3m2fn, fp6_e2m3fn, fp4_e2m1fn>;
+
+// MX formats with registered kernels: those of microscaling.hpp
+using PredefinedMxFormats = TypeList<MXFP8_E4M3, MXFP8_E5M2, MXFP6_E3M2,
+                                     MXFP6_E2M3, MXFP4_E2M1>;
+
+// Name of a format in the core/format.hpp convention,
+// fp{total_bits}_e{exp_bits}m{mant_bits} with an fn or fnuz suffix
+// (formats that differ only in padding, bias or saturation share a name)
+inline std::string format_name(const RuntimeFormat &format) {
+  using special_value_policies::SpecialValueEncoding;
+  const std::string name = "fp" + std::to_string(format.total_bits) + "_e" +
+                           std::to_string(format.exp_bits) + "m" +
+                           std::to_string(format.mant_bits);
+  switch (format.special_values) {
+  case SpecialValueEncoding::FiniteNaN:
+  case SpecialValueEncoding::Finite:
+    return name + "fn";
+  case SpecialValueEncoding::FNUZ:
+    return name + "fnuz";
+  default:
+    return name;
+  }
+}
+
+// Kernels of one format, converting to and from Working encodings
+//
+// Every kernel converts min(input, output) elements and returns the count.
+// Storage-layout bytes hold one storage_type per element (storage_bytes
+// each, aligned for it); packed words are PackedArray words, size elements
+// in all, of which the kernels touch [first, first + count).
+template <typename Working> struct FormatKernels {
+  using working_storage = typename Working::storage_type;
+  using word_type = std::uint64_t;
+
+  RuntimeFormat format;
+  std::size_t storage_bytes;
+
+  std::size_t (*decode)(std::span<const std::byte> src,
+                        std::span<working_storage> dst);
+  std::size_t (*encode)(std::span<const working_storage> src,
+                        std::span<std::byte> dst);
+  std::size_t (*decode_packed)(std::span<const word_type> words,
+                               std::size_t size, std::size_t first,
+                               std::span<working_storage> out);
+  std::size_t (*encode_packed)(std::span<const working_storage> in,
+                               std::size_t first,
+                               std::span<word_type> words);
+};
+
+// Kernels of one MX format, converting to and from Working encodings
+//
+// Scales and elements are in the MicroscaledArray layout. dequantize()
+// decodes the first min(size, out.size()) elements; quantize() fills the
+// blocks of src.size() elements (as many as scales and elements hold) and
+// returns the number of elements quantized.
+template <typename Working> struct MxKernels {
+  using working_storage = typename Working::storage_type;
+
+  RuntimeFormat element_format;
+  std::size_t block_size;
+  std::size_t block_bytes;
+
+  std::size_t (*dequantize)(std::size_t size,
+                            std::span<const std::uint8_t> scales,
+                            std::span<const std::uint8_t> elements,
+                            std::span<working_storage> out);
+  std::size_t (*quantize)(std::span<const working_storage> src,
+                          std::span<std::uint8_t> scales,
+                          std::span<std::uint8_t> elements);
+};
+
+namespace detail {
+
+template <typename Format, typename Working, typename ConversionPolicy,
+          typename TablePolicy>
+struct format_kernels_of {
+  using storage_type = typename Format::storage_type;
+  using working_storage = typename Working::storage_type;
+  using word_type = std::uint64_t;
+  using packing = word_packing<Format::total_bits>;
+
+  static std::size_t decode(std::span<const std::byte> src,
+                            std::span<working_storage> dst) {
+    return convert_n<Working, Format, ConversionPolicy, TablePolicy>(
+        std::span<const storage_type>(
+            reinterpret_cast<const storage_type *>(src.data()),
+            src.size() / sizeof(storage_type)),
+        dst);
+  }
+
+  static std::size_t encode(std::span<const working_storage> src,
+                            std::span<std::byte> dst) {
+    return convert_n<Format, Working, ConversionPolicy, TablePolicy>(
+        src, std::span<storage_type>(
+                 reinterpret_cast<storage_type *>(dst.data()),
+                 dst.size() / sizeof(storage_type)));
+  }
+
+  // Packed kernels go through a stack buffer of packed_chunk encodings
+  static std::size_t decode_packed(std::span<const word_type> words,
+                                   std::size_t size, std::size_t first,
+                                   std::span<working_storage> out) {
+    const PackedView<Format> view(words, size);
+    const std::size_t n = first < size ? std::min(out.size(), size - first)
+                                       : 0;
+    std::array<storage_type, packed_chunk> chunk;
+    for (std::size_t i = 0; i < n; i += packed_chunk) {
+      const std::size_t m = std::min(packed_chunk, n - i);
+      view.load(first + i, std::span(chunk).first(m));
+      convert_n<Working, Format, ConversionPolicy, TablePolicy>(
+          std::span<const storage_type>(chunk).first(m), out.subspan(i, m));
+    }
+    return n;
+  }
+
+  static std::size_t encode_packed(std::span<const working_storage> in,
+                                   std::size_t first,
+                                   std::span<word_type> words) {
+    const std::size_t capacity =
+        words.size() / packing::group_words * packing::group;
+    const std::size_t n =
+        first < capacity ? std::min(in.size(), capacity - first) : 0;
+    std::array<storage_type, packed_chunk> chunk;
+    for (std::size_t i = 0; i < n; i += packed_chunk) {
+      const std::size_t m = std::min(packed_chunk, n - i);
+      convert_n<Format, Working, ConversionPolicy, TablePolicy>(
+          in.subspan(i, m), std::span(chunk).first(m));
+      pack_words<Format>(std::span<const storage_type>(chunk).first(m),
+                         first + i, words);
+    }
+    return n;
+  }
+
+  static constexpr FormatKernels<Working> kernels() {
+    return {runtime_format<Format>(), sizeof(storage_type), &decode,
+            &encode,                  &decode_packed,       &encode_packed};
+  }
+};
+
+template <typename MxFormat, typename Working, typename ConversionPolicy>
+struct mx_kernels_of {
+  using working_storage = typename Working::storage_type;
+  static constexpr std::size_t block_size = MxFormat::block_size;
+  static constexpr std::size_t block_bytes = MxFormat::block_bytes;
+
+  static std::size_t dequantize(std::size_t size,
+                                std::span<const std::uint8_t> scales,
+                                std::span<const std::uint8_t> elements,
+                                std::span<working_storage> out) {
+    const std::size_t blocks =
+        std::min({MicroscaledView<MxFormat>::block_count(size), scales.size(),
+                  elements.size() / block_bytes});
+    const std::size_t n =
+        std::min({size, out.size(), blocks * block_size});
+    return MicroscaledView<MxFormat>(n, scales, elements)
+        .template dequantize<Working, ConversionPolicy>(out);
+  }
+
+  static std::size_t quantize(std::span<const working_storage> src,
+                              std::span<std::uint8_t> scales,
+                              std::span<std::uint8_t> elements) {
+    const std::size_t blocks =
+        std::min({MicroscaledView<MxFormat>::block_count(src.size()),
+                  scales.size(), elements.size() / block_bytes});
+    for (std::size_t block = 0; block < blocks; ++block) {
+      const std::size_t offset = block * block_size;
+      scales[block] = quantize_block<MxFormat, Working, ConversionPolicy>(
+          src.subspan(offset, std::min(block_size, src.size() - offset)),
+          std::span<std::uint8_t, block_bytes>(
+              elements.data() + block * block_bytes, block_bytes));
+    }
+    return std::min(src.size(), blocks * block_size);
+  }
+
+  static constexpr MxKernels<Working> kernels() {
+    return {runtime_format<typename MxFormat::element_format>(), block_size,
+            block_bytes, &dequantize, &quantize};
+  }
+};
+
+template <typename Working, typename ConversionPolicy, typename TablePolicy,
+          typename Formats>
+inline constexpr auto format_kernel_table =
+    []<typename... Fs>(TypeList<Fs...> *) {
+      return std::array<FormatKernels<Working>, sizeof...(Fs)>{
+          format_kernels_of<Fs, Working, ConversionPolicy,
+                            TablePolicy>::kernels()...};
+    }(static_cast<Formats *>(nullptr));
+
+template <typename Working, typename ConversionPolicy, typename MxFormats>
+inline constexpr auto mx_kernel_table =
+    []<typename... Mxs>(TypeList<Mxs...> *) {
+      return std::array<MxKernels<Working>, sizeof...(Mxs)>{
+          mx_kernels_of<Mxs, Working, ConversionPolicy>::kernels()...};
+    }(static_cast<MxFormats *>(nullptr));
+
+} // namespace detail
+
+// Registry: the kernels of every format of Formats
+template <typename Working,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy,
+          typename Formats = PredefinedFormats>
+constexpr std::span<const FormatKernels<Working>> format_kernels() {
+  return detail::format_kernel_table<Working, ConversionPolicy, TablePolicy,
+                                     Formats>;
+}
+
+// Kernels of a format, or nullptr if it is not registered
+template <typename Working,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy,
+          typename Formats = PredefinedFormats>
+constexpr const FormatKernels<Working> *
+find_format_kernels(const RuntimeFormat &format) {
+  for (const auto &kernels :
+       format_kernels<Working, ConversionPolicy, TablePolicy, Formats>()) {
+    if (kernels.format == format) {
+      return &kernels;
+    }
+  }
+  return nullptr;
+}
+
+// Kernels of the format named name (format_name()), or nullptr
+template <typename Working,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy,
+          typename Formats = PredefinedFormats>
+const FormatKernels<Working> *find_format_kernels(std::string_view name) {
+  for (const auto &kernels :
+       format_kernels<Working, ConversionPolicy, TablePolicy, Formats>()) {
+    if (format_name(kernels.format) == name) {
+      return &kernels;
+    }
+  }
+  return nullptr;
+}
+
+// Registry: the kernels of every MX format of MxFormats
+template <typename Working,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename MxFormats = PredefinedMxFormats>
+constexpr std::span<const MxKernels<Working>> mx_kernels() {
+  return detail::mx_kernel_table<Working, ConversionPolicy, MxFormats>;
+}
+
+// Kernels of the MX format with these elements and blocks, or nullptr
+template <typename Working,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename MxFormats = PredefinedMxFormats>
+constexpr const MxKernels<Working> *
+find_mx_kernels(const RuntimeFormat &element_format, std::size_t block_size) {
+  for (const auto &kernels :
+       mx_kernels<Working, ConversionPolicy, MxFormats>()) {
+    if (kernels.element_format == element_format &&
+        kernels.block_size == block_size) {
+      return &kernels;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace opine::inline v1
@@ -0,0 +1,578 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <opine/core/aligned_allocator.hpp>
+#include <opine/core/format.hpp>
+#include <opine/core/unpacked.hpp>
+#include <opine/operations/classify.hpp>
+#include <opine/operations/convert.hpp>
+#include <opine/operations/normalize.hpp>
+#include <opine/operations/pack_unpack.hpp>
+#include <opine/policies/conversion.hpp>
+#include <opine/policies/instrumentation.hpp>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace opine::inline v1 {
+
+// Microscaling (MX) formats (OCP Microscaling Formats Specification v1.0)
+//
+// A block of block_size elements shares one E8M0 scale, an 8-bit biased
+// power-of-two exponent:
+//
+//   value[i] = 2^(scale - 127) * element[i]
+//
+// Scale 0xFF is NaN and makes the whole block NaN. MX formats are containers,
+// not numeric types: MicroscaledArray stores the scales and the packed
+// elements, quantize() fills it from a wider format and the dequantize
+// functions convert back.
+//
+// Layout: two 64-byte aligned buffers, one scale byte per block and
+// block_bytes of elements per block. Elements are packed LSB first, element i
+// of a block in bits [i * element_bits, (i + 1) * element_bits) of the
+// block's little-endian bytes (32 fp4 elements are 16 bytes, 32 fp6 elements
+// 24). Every block starts on a byte boundary, so blocks are independent:
+// quantize_blocks() on disjoint block ranges may run on different threads.
+
+// MX format: an element format and a block size
+template <typename ElementFormat, std::size_t BlockSize = 32>
+struct MicroscalingFormat {
+  using element_format = ElementFormat;
+  static constexpr std::size_t block_size = BlockSize;
+  static constexpr int element_bits = ElementFormat::total_bits;
+  static constexpr std::size_t block_bytes = BlockSize * element_bits / 8;
+
+  // Exponent of the largest finite element binade; quantize() scales each
+  // block so that its largest magnitude falls into it
+  static constexpr int element_emax =
+      detail::max_finite_exponent<ElementFormat>() - ElementFormat::exp_bias;
+
+  static_assert(ElementFormat::has_implicit_bit,
+                "MX elements are floating point formats with an implicit bit");
+  static_assert(element_bits <= 8, "MX elements are at most 8 bits");
+  static_assert(BlockSize > 0 && BlockSize * element_bits % 8 == 0,
+                "A block must fill a whole number of bytes");
+};
+
+// Standard MX formats: 32-element blocks of the OCP element encodings
+//
+// E4M3 without Inf (largest 448), FP6 and FP4 without Inf or NaN (largest
+// 28, 7.5 and 6); E5M2 keeps IEEE Inf and NaN
+using MXFP8_E4M3 = MicroscalingFormat<fp8_e4m3fn>;
+using MXFP8_E5M2 = MicroscalingFormat<fp8_e5m2>;
+using MXFP6_E3M2 = MicroscalingFormat<fp6_e3m2fn>;
+using MXFP6_E2M3 = MicroscalingFormat<fp6_e2m3fn>;
+using MXFP4_E2M1 = MicroscalingFormat<fp4_e2m1fn>;
+
+// E8M0 scale encoding
+inline constexpr int e8m0_bias = 127;
+inline constexpr std::uint8_t e8m0_nan = 0xFF;
+
+namespace detail {
+
+// Element packing: groups of `group` elements fill `group_bytes` whole bytes
+// (1 element in 1 byte for fp8, 2 in 1 for fp4, 4 in 3 for fp6), so a group
+// is one little-endian word and every element is a shift and a mask
+template <typename MxFormat> struct element_packing {
+  using element_storage = typename MxFormat::element_format::storage_type;
+  static constexpr int bits = MxFormat::element_bits;
+  static constexpr std::size_t group = 8 / std::gcd(bits, 8);
+  static constexpr std::size_t group_bytes = bits * group / 8;
+  static constexpr std::size_t groups = MxFormat::block_size / group;
+  static constexpr std::uint64_t mask = (std::uint64_t{1} << bits) - 1;
+
+  static constexpr std::uint64_t
+  load(std::span<const std::uint8_t, MxFormat::block_bytes> bytes,
+       std::size_t g) {
+    std::uint64_t word = 0;
+    for (std::size_t b = 0; b < group_bytes; ++b) {
+      word |= std::uint64_t{bytes[g * group_bytes + b]} << (8 * b);
+    }
+    return word;
+  }
+};
+
+// Pack a block of element encodings into its bytes
+template <typename MxFormat>
+constexpr void pack_elements(
+    std::span<const typename MxFormat::element_format::storage_type,
+              MxFormat::block_size>
+        elements,
+    std::span<std::uint8_t, MxFormat::block_bytes> bytes) {
+  using packing = element_packing<MxFormat>;
+
+  for (std::size_t g = 0; g < packing::groups; ++g) {
+    std::uint64_t word = 0;
+    for (std::size_t k = 0; k < packing::group; ++k) {
+      word |= (static_cast<std::uint64_t>(elements[g * packing::group + k]) &
+               packing::mask)
+              << (k * packing::bits);
+    }
+    for (std::size_t b = 0; b < packing::group_bytes; ++b) {
+      bytes[g * packing::group_bytes + b] =
+          static_cast<std::uint8_t>(word >> (8 * b));
+    }
+  }
+}
+
+// Unpack the element encodings of a block
+template <typename MxFormat>
+constexpr void unpack_elements(
+    std::span<const std::uint8_t, MxFormat::block_bytes> bytes,
+    std::span<typename MxFormat::element_format::storage_type,
+              MxFormat::block_size>
+        elements) {
+  using packing = element_packing<MxFormat>;
+  using element_storage = typename packing::element_storage;
+
+  for (std::size_t g = 0; g < packing::groups; ++g) {
+    const std::uint64_t word = packing::load(bytes, g);
+    for (std::size_t k = 0; k < packing::group; ++k) {
+      elements[g * packing::group + k] = static_cast<element_storage>(
+          (word >> (k * packing::bits)) & packing::mask);
+    }
+  }
+}
+
+// Element encoding i of a block
+template <typename MxFormat>
+constexpr typename MxFormat::element_format::storage_type
+extract_element(std::span<const std::uint8_t, MxFormat::block_bytes> bytes,
+                std::size_t i) {
+  using packing = element_packing<MxFormat>;
+  const std::uint64_t word = packing::load(bytes, i / packing::group);
+  return static_cast<typename packing::element_storage>(
+      (word >> ((i % packing::group) * packing::bits)) & packing::mask);
+}
+
+// Largest magnitude of a span, as the encoding with the sign cleared
+//
+// With the exponent field above the mantissa field, magnitudes order like
+// their encodings as unsigned integers, so this is a plain integer max
+// reduction (a loop compilers vectorize). Inf and NaN compare above every
+// finite value.
+template <typename Format>
+constexpr typename Format::storage_type
+max_magnitude(std::span<const typename Format::storage_type> bits) {
+  using storage_type = typename Format::storage_type;
+  static_assert(Format::exp_offset > Format::mant_offset,
+                "Magnitude order needs the exponent above the mantissa");
+  constexpr auto magnitude_mask = static_cast<storage_type>(
+      (((storage_type{1} << Format::exp_bits) - 1) << Format::exp_offset) |
+      (((storage_type{1} << Format::mant_bits) - 1) << Format::mant_offset));
+
+  storage_type result = 0;
+  for (const auto value : bits) {
+    result =
+        std::max(result, static_cast<storage_type>(value & magnitude_mask));
+  }
+  return result;
+}
+
+// E8M0 scale for a block whose largest magnitude is `magnitude`
+//
+// scale exponent = floor(log2(max |x|)) - element_emax, clamped to the E8M0
+// range; NaN if the block holds Inf or NaN. An all-zero block gets the
+// smallest scale.
+template <typename MxFormat, typename Format>
+constexpr std::uint8_t
+block_scale(typename Format::storage_type magnitude) {
+  constexpr int exp_max = (1 << Format::exp_bits) - 1;
+  constexpr auto mant_mask = static_cast<typename Format::storage_type>(
+      (typename Format::storage_type{1} << Format::mant_bits) - 1);
+
+  if (magnitude == 0) {
+    return 0;
+  }
+  const int exp = static_cast<int>(extract_exponent<Format>(magnitude));
+  if (exp == exp_max) {
+    return e8m0_nan;
+  }
+
+  int log2 = exp - Format::exp_bias;
+  if (exp == 0) {
+    const auto mant = (magnitude >> Format::mant_offset) & mant_mask;
+    log2 = bit_width<Format::mant_bits>(mant) - Format::exp_bias -
+           Format::mant_bits;
+  }
+  const int scale_exponent =
+      std::clamp(log2 - MxFormat::element_emax, -e8m0_bias, e8m0_bias);
+  return static_cast<std::uint8_t>(scale_exponent + e8m0_bias);
+}
+
+// Quantize up to block_size values (the rest of the block is +0) into the
+// block's bytes, returning the block's scale
+template <typename MxFormat, typename Format, typename ConversionPolicy>
+constexpr std::uint8_t
+quantize_block(std::span<const typename Format::storage_type> values,
+               std::span<std::uint8_t, MxFormat::block_bytes> bytes) {
+  using element_format = typename MxFormat::element_format;
+  using rounding_policy = typename ConversionPolicy::rounding_policy;
+
+  std::array<typename element_format::storage_type, MxFormat::block_size>
+      elements{};
+  const std::uint8_t scale =
+      block_scale<MxFormat, Format>(max_magnitude<Format>(values));
+
+  // One batch of counts per block (when instrumented)
+  instrumentation_policies::EventCounts counts;
+  if (scale != e8m0_nan) {
+    const int scale_exponent = e8m0_bias - scale;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      elements[i] = pack(convert_scaled<element_format, ConversionPolicy>(
+          unpack<Format, rounding_policy>(values[i]), scale_exponent,
+          counts));
+    }
+  } else if constexpr (conversion_policies::is_instrumented<
+                           ConversionPolicy>) {
+    // The block is NaN: only its NaN and Inf inputs are events
+    for (const auto bits : values) {
+      const auto value = unpack<Format, rounding_policy>(bits);
+      ++counts.conversions;
+      counts.nan_inputs += is_nan(value);
+      counts.inf_inputs += is_inf(value);
+    }
+  }
+  record_counts<ConversionPolicy>(counts);
+
+  pack_elements<MxFormat>(elements, bytes);
+  return scale;
+}
+
+// Dequantize one element encoding under a block scale
+//
+// An instrumented conversion adds its events to counts; an element under the
+// NaN scale counts as a NaN input.
+template <typename MxFormat, typename Format, typename ConversionPolicy>
+constexpr typename Format::storage_type
+dequantize_element(std::uint8_t scale,
+                   typename MxFormat::element_format::storage_type element,
+                   [[maybe_unused]] instrumentation_policies::EventCounts
+                       &counts) {
+  using storage_type = typename Format::storage_type;
+  using rounding_policy = typename ConversionPolicy::rounding_policy;
+
+  if (scale == e8m0_nan) {
+    if constexpr (conversion_policies::is_instrumented<ConversionPolicy>) {
+      ++counts.conversions;
+      ++counts.nan_inputs;
+    }
+    return static_cast<storage_type>(
+        (((storage_type{1} << Format::exp_bits) - 1) << Format::exp_offset) |
+        (storage_type{1} << (Format::mant_offset + Format::mant_bits - 1)));
+  }
+  return pack(convert_scaled<Format, ConversionPolicy>(
+      unpack<typename MxFormat::element_format, rounding_policy>(element),
+      scale - e8m0_bias, counts));
+}
+
+// Dequantize one element encoding under a block scale; an instrumented
+// conversion records its events
+template <typename MxFormat, typename Format, typename ConversionPolicy>
+constexpr typename Format::storage_type
+dequantize_element(std::uint8_t scale,
+                   typename MxFormat::element_format::storage_type element) {
+  instrumentation_policies::EventCounts counts;
+  const auto result = dequantize_element<MxFormat, Format, ConversionPolicy>(
+      scale, element, counts);
+  record_counts<ConversionPolicy>(counts);
+  return result;
+}
+
+// Dequantize the first out.size() (at most block_size) elements of a block
+template <typename MxFormat, typename Format, typename ConversionPolicy>
+constexpr void
+dequantize_block(std::uint8_t scale,
+                 std::span<const std::uint8_t, MxFormat::block_bytes> bytes,
+                 std::span<typename Format::storage_type> out) {
+  std::array<typename MxFormat::element_format::storage_type,
+             MxFormat::block_size>
+      elements{};
+  unpack_elements<MxFormat>(bytes, elements);
+
+  // One batch of counts per block (when instrumented)
+  instrumentation_policies::EventCounts counts;
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = dequantize_element<MxFormat, Format, ConversionPolicy>(
+        scale, elements[i], counts);
+  }
+  record_counts<ConversionPolicy>(counts);
+}
+
+} // namespace detail
+
+template <typename MxFormat, typename Format, typename ConversionPolicy>
+class DequantizeIterator;
+
+// Read-only view of MX-encoded values: E8M0 scales and packed elements in
+// the MicroscaledArray layout (from a MicroscaledArray, or memory-mapped
+// from a tensor file) and an element count
+template <typename MxFormat> class MicroscaledView {
+public:
+  using format = MxFormat;
+  using element_format = typename MxFormat::element_format;
+  static constexpr std::size_t block_size = MxFormat::block_size;
+  static constexpr std::size_t block_bytes = MxFormat::block_bytes;
+
+  // Blocks needed for size elements
+  static constexpr std::size_t block_count(std::size_t size) {
+    return (size + block_size - 1) / block_size;
+  }
+
+  MicroscaledView() = default;
+
+  // scales must hold block_count(size) bytes, elements block_bytes per block
+  MicroscaledView(std::size_t size, std::span<const std::uint8_t> scales,
+                  std::span<const std::uint8_t> elements)
+      : size_(size), scales_(scales), elements_(elements) {}
+
+  std::size_t size() const { return size_; }
+  std::size_t block_count() const { return block_count(size_); }
+
+  // Number of elements in a block (block_size except for the last block)
+  std::size_t block_length(std::size_t block) const {
+    return std::min(block_size, size_ - block * block_size);
+  }
+
+  // Raw encodings: E8M0 scales and packed elements
+  std::span<const std::uint8_t> scales() const { return scales_; }
+  std::span<const std::uint8_t> elements() const { return elements_; }
+
+  std::span<const std::uint8_t, block_bytes>
+  block_elements(std::size_t block) const {
+    return std::span<const std::uint8_t, block_bytes>(
+        elements_.data() + block * block_bytes, block_bytes);
+  }
+
+  // Decode one element (one shift and mask, no block decode)
+  template <typename Format,
+            conversion_policies::ConversionPolicy ConversionPolicy =
+                conversion_policies::DefaultConversionPolicy>
+  typename Format::storage_type get(std::size_t index) const {
+    const std::size_t block = index / block_size;
+    return detail::dequantize_element<MxFormat, Format, ConversionPolicy>(
+        scales_[block], detail::extract_element<MxFormat>(
+                            block_elements(block), index % block_size));
+  }
+
+  // Decode block `block` into out, return the number of elements written
+  // (block_length(), or out.size() if smaller)
+  template <typename Format,
+            conversion_policies::ConversionPolicy ConversionPolicy =
+                conversion_policies::DefaultConversionPolicy>
+  std::size_t
+  dequantize_block(std::size_t block,
+                   std::span<typename Format::storage_type> out) const {
+    const std::size_t n = std::min(block_length(block), out.size());
+    detail::dequantize_block<MxFormat, Format, ConversionPolicy>(
+        scales_[block], block_elements(block), out.first(n));
+    return n;
+  }
+
+  // Decode the whole array, return the number of elements written
+  template <typename Format,
+            conversion_policies::ConversionPolicy ConversionPolicy =
+                conversion_policies::DefaultConversionPolicy>
+  std::size_t dequantize(std::span<typename Format::storage_type> out) const {
+    const std::size_t n = std::min(size_, out.size());
+    for (std::size_t block = 0; block * block_size < n; ++block) {
+      dequantize_block<Format, ConversionPolicy>(
+          block, out.subspan(block * block_size));
+    }
+    return n;
+  }
+
+private:
+  std::size_t size_ = 0;
+  std::span<const std::uint8_t> scales_;
+  std::span<const std::uint8_t> elements_;
+};
+
+// Array of MX-encoded values
+//
+// Usage:
+//   auto weights = quantize<MXFP4_E2M1, fp32_e8m23>(checkpoint);
+//   for (auto block : weights.blocks<fp16_e5m10>()) {
+//     ... // block: std::span of up to 32 fp16 encodings
+//   }
+//   auto w = weights.get<fp32_e8m23>(i); // decodes one element
+//
+// The decoding members are those of view().
+template <typename MxFormat> class MicroscaledArray {
+public:
+  using format = MxFormat;
+  using element_format = typename MxFormat::element_format;
+  static constexpr std::size_t block_size = MxFormat::block_size;
+  static constexpr std::size_t block_bytes = MxFormat::block_bytes;
+
+  MicroscaledArray() = default;
+
+  // size elements, all +0
+  explicit MicroscaledArray(std::size_t size)
+      : size_(size),
+        scales_(MicroscaledView<MxFormat>::block_count(size)),
+        elements_(scales_.size() * block_bytes) {}
+
+  std::size_t size() const { return size_; }
+  std::size_t block_count() const { return scales_.size(); }
+
+  std::size_t block_length(std::size_t block) const {
+    return view().block_length(block);
+  }
+
+  // Raw encodings: E8M0 scales and packed elements
+  std::span<const std::uint8_t> scales() const { return scales_; }
+  std::span<const std::uint8_t> elements() const { return elements_; }
+
+  std::span<const std::uint8_t, block_bytes>
+  block_elements(std::size_t block) const {
+    return view().block_elements(block);
+  }
+
+  MicroscaledView<MxFormat> view() const {
+    return MicroscaledView<MxFormat>(size_, scales_, elements_);
+  }
+
+  // Quantize blocks [first_block, last_block) of src, which holds the
+  // values of the whole array (missing values are +0)
+  //
+  // Blocks are independent, so disjoint ranges may be quantized concurrently.
+  template <typename Format,
+            conversion_policies::ConversionPolicy ConversionPolicy =
+                conversion_policies::DefaultConversionPolicy>
+  void quantize_blocks(std::span<const typename Format::storage_type> src,
+                       std::size_t first_block, std::size_t last_block) {
+    last_block = std::min(last_block, block_count());
+    for (std::size_t block = first_block; block < last_block; ++block) {
+      const std::size_t offset = block * block_size;
+      const std::size_t count =
+          offset < src.size()
+              ? std::min(block_length(block), src.size() - offset)
+              : 0;
+      scales_[block] =
+          detail::quantize_block<MxFormat, Format, ConversionPolicy>(
+              src.subspan(std::min(offset, src.size()), count),
+              std::span<std::uint8_t, block_bytes>(
+                  elements_.data() + block * block_bytes, block_bytes));
+    }
+  }
+
+  template <typename Format,
+            conversion_policies::ConversionPolicy ConversionPolicy =
+                conversion_policies::DefaultConversionPolicy>
+  void quantize(std::span<const typename Format::storage_type> src) {
+    quantize_blocks<Format, ConversionPolicy>(src, 0, block_count());
+  }
+
+  template <typename Format,
+            conversion_policies::ConversionPolicy ConversionPolicy =
+                conversion_policies::DefaultConversionPolicy>
+  typename Format::storage_type get(std::size_t index) const {
+    return view().template get<Format, ConversionPolicy>(index);
+  }
+
+  template <typename Format,
+            conversion_policies::ConversionPolicy ConversionPolicy =
+                conversion_policies::DefaultConversionPolicy>
+  std::size_t
+  dequantize_block(std::size_t block,
+                   std::span<typename Format::storage_type> out) const {
+    return view().template dequantize_block<Format, ConversionPolicy>(block,
+                                                                      out);
+  }
+
+  template <typename Format,
+            conversion_policies::ConversionPolicy ConversionPolicy =
+                conversion_policies::DefaultConversionPolicy>
+  std::size_t dequantize(std::span<typename Format::storage_type> out) const {
+    return view().template dequantize<Format, ConversionPolicy>(out);
+  }
+
+  // Streaming decode: a range of blocks, each a span of Format encodings
+  // decoded when the iterator reaches it
+  template <typename Format,
+            conversion_policies::ConversionPolicy ConversionPolicy =
+                conversion_policies::DefaultConversionPolicy>
+  auto blocks() const {
+    return std::ranges::subrange(
+        DequantizeIterator<MxFormat, Format, ConversionPolicy>(*this),
+        std::default_sentinel);
+  }
+
+private:
+  using buffer_type =
+      std::vector<std::uint8_t,
+                  detail::aligned_allocator<std::uint8_t, cache_line_size>>;
+
+  std::size_t size_ = 0;
+  buffer_type scales_;
+  buffer_type elements_;
+};
+
+// Input iterator over the decoded blocks of a MicroscaledArray
+//
+// Holds one decoded block; dereferencing gives a span into it, valid until
+// the iterator is incremented.
+template <typename MxFormat, typename Format, typename ConversionPolicy>
+class DequantizeIterator {
+public:
+  using value_type = std::span<const typename Format::storage_type>;
+  using difference_type = std::ptrdiff_t;
+
+  DequantizeIterator() = default;
+
+  explicit DequantizeIterator(const MicroscaledArray<MxFormat> &array)
+      : array_(&array) {
+    decode();
+  }
+
+  value_type operator*() const { return value_type(buffer_.data(), count_); }
+
+  DequantizeIterator &operator++() {
+    ++block_;
+    decode();
+    return *this;
+  }
+
+  void operator++(int) { ++*this; }
+
+  std::size_t block_index() const { return block_; }
+
+  friend bool operator==(const DequantizeIterator &it,
+                         std::default_sentinel_t) {
+    return it.array_ == nullptr ||
+           it.block_ >= it.array_->block_count();
+  }
+
+private:
+  void decode() {
+    count_ = block_ < array_->block_count()
+                 ? array_->template dequantize_block<Format, ConversionPolicy>(
+                       block_, buffer_)
+                 : 0;
+  }
+
+  const MicroscaledArray<MxFormat> *array_ = nullptr;
+  std::size_t block_ = 0;
+  std::size_t count_ = 0;
+  std::array<typename Format::storage_type, MxFormat::block_size> buffer_{};
+};
+
+// Quantize a span of Format encodings into a new MicroscaledArray
+template <typename MxFormat, typename Format,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy>
+MicroscaledArray<MxFormat>
+quantize(std::span<const typename Format::storage_type> src) {
+  MicroscaledArray<MxFormat> result(src.size());
+  result.template quantize<Format, ConversionPolicy>(src);
+  return result;
+}
+
+} // namespace opine::inline v1
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <opine/core/types.hpp>
+#include <opine/core/unpacked.hpp>
+#include <opine/operations/arithmetic.hpp>
+#include <opine/operations/classify.hpp>
+#include <opine/operations/normalize.hpp>
+#include <opine/operations/pack_unpack.hpp>
+#include <opine/policies/rounding.hpp>
+#include <span>
+
+namespace opine::inline v1 {
+
+// Exact (Kulisch) accumulator for sums of products
+//
+// ExactAccumulator<FormatA, FormatB> holds a sum of products a * b, a in
+// FormatA and b in FormatB, as one two's complement fixed-point integer
+// wide enough for every product without rounding:
+//
+//   [sign][CarryBits][integer bits][fraction bits]
+//
+//   fraction bits   -(lowest A exponent + lowest B exponent), the weight of
+//                   the product of the two smallest denormals
+//   integer bits    2 + largest A exponent + largest B exponent, so every
+//                   finite product is below 2^(integer bits)
+//   CarryBits       headroom for 2^CarryBits products of any magnitude
+//
+// computed at compile time from the formats' exponent ranges and mantissa
+// widths: 67 bits for fp8_e4m3 x fp8_e4m3, 113 for fp16 x fp16, 342 for
+// fp8_e5m2 x fp32, in uint_t<bits> (WideUint limbs where there is no native
+// type that wide). Adding a product is one integer multiply, one shift and
+// one add; no term is ever rounded.
+//
+// Integer addition is associative, so the sum does not depend on the order
+// of the products or on how they are split: partial accumulators filled on
+// different threads or K-slices and merged with merge() in any order hold
+// the same bits, and value() rounds that exact sum once. (Beyond 2^CarryBits
+// products the sum wraps, and still does not depend on the order.)
+//
+// Special values are kept as flags, merged the same way: a NaN operand,
+// Inf * 0, or infinities of both signs make the sum NaN; otherwise an
+// infinite product makes it that infinity. An exact zero sum is +0, or -0
+// when rounding toward negative, as for add().
+
+namespace detail {
+
+// Weight of the lowest significand bit of the smallest denormal of Format,
+// and of the leading bit of its largest finite value
+template <typename Format>
+constexpr int lowest_exponent = 1 - Format::exp_bias - Format::mant_bits;
+
+template <typename Format>
+constexpr int highest_exponent =
+    max_finite_exponent<Format>() - Format::exp_bias;
+
+} // namespace detail
+
+template <typename FormatA, typename FormatB = FormatA, int CarryBits = 32>
+class ExactAccumulator {
+  static_assert(FormatA::has_implicit_bit && FormatB::has_implicit_bit,
+                "Exact accumulation requires formats with an implicit bit");
+  static_assert(CarryBits >= 0, "CarryBits must be non-negative");
+
+public:
+  using type_policy = typename FormatA::type_policy;
+
+  static constexpr int lsb_exponent =
+      detail::lowest_exponent<FormatA> + detail::lowest_exponent<FormatB>;
+  static constexpr int fraction_bits = -lsb_exponent;
+  static constexpr int integer_bits = detail::highest_exponent<FormatA> +
+                                      detail::highest_exponent<FormatB> + 2;
+  static constexpr int carry_bits = CarryBits;
+  static constexpr int bits = 1 + carry_bits + integer_bits + fraction_bits;
+
+  // The sum, as a two's complement integer of at least `bits` bits
+  using value_type = uint_t<bits, type_policy>;
+
+  constexpr ExactAccumulator() = default;
+
+  // Add a * b
+  constexpr void add_product(typename FormatA::storage_type a,
+                             typename FormatB::storage_type b) {
+    const auto x = unpack<FormatA, exact_rounding>(a);
+    const auto y = unpack<FormatB, exact_rounding>(b);
+    if (is_nan(x) || is_nan(y)) {
+      nan_ = true;
+      return;
+    }
+    const bool sign = x.sign != y.sign;
+    if (is_inf(x) || is_inf(y)) {
+      if (is_zero(x) || is_zero(y)) {
+        nan_ = true;
+      } else {
+        (sign ? negative_inf_ : positive_inf_) = true;
+      }
+      return;
+    }
+
+    // x = s * 2^(max(e, 1) - 1 + lowest exponent), so the product's weight
+    // relative to lsb_exponent is ex + ey - 2
+    using product_type =
+        uint_t<unpacked_a::mantissa_bits + unpacked_b::mantissa_bits,
+               type_policy>;
+    const auto product = static_cast<product_type>(
+        static_cast<product_type>(x.mantissa) *
+        static_cast<product_type>(y.mantissa));
+    add_term(sign, static_cast<value_type>(product),
+             effective_exponent(x) + effective_exponent(y) - 2);
+  }
+
+  // Add a (a * 1, for bias terms and plain sums)
+  constexpr void add(typename FormatA::storage_type a) {
+    const auto x = unpack<FormatA, exact_rounding>(a);
+    if (is_nan(x)) {
+      nan_ = true;
+      return;
+    }
+    if (is_inf(x)) {
+      (x.sign ? negative_inf_ : positive_inf_) = true;
+      return;
+    }
+    add_term(x.sign, static_cast<value_type>(x.mantissa),
+             effective_exponent(x) - 1 - detail::lowest_exponent<FormatB>);
+  }
+
+  // Add a[i] * b[i] for every i below the smaller of the two sizes
+  constexpr void
+  add_products(std::span<const typename FormatA::storage_type> a,
+               std::span<const typename FormatB::storage_type> b) {
+    const std::size_t n = std::min(a.size(), b.size());
+    for (std::size_t i = 0; i < n; ++i) {
+      add_product(a[i], b[i]);
+    }
+  }
+
+  // Add another partial sum
+  constexpr void merge(const ExactAccumulator &other) {
+    sum_ += other.sum_;
+    nan_ = nan_ || other.nan_;
+    positive_inf_ = positive_inf_ || other.positive_inf_;
+    negative_inf_ = negative_inf_ || other.negative_inf_;
+  }
+
+  // The sum in Dst, exact and unrounded (normalize() keeps a sticky bit), so
+  // that pack() rounds it once
+  template <typename Dst,
+            typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+            typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+  constexpr UnpackedFloat<Dst, RoundingPolicy, DenormalPolicy> value() const {
+    using traits =
+        detail::arithmetic_traits<Dst, RoundingPolicy, DenormalPolicy>;
+    if (nan_ || (positive_inf_ && negative_inf_)) {
+      return traits::default_nan();
+    }
+    if (positive_inf_ || negative_inf_) {
+      return traits::infinity(negative_inf_);
+    }
+    if (sum_ == value_type{0}) {
+      return traits::zero(traits::negative_zero_sum);
+    }
+    const bool sign = sum_ >= sign_bit;
+    const auto magnitude =
+        sign ? static_cast<value_type>(value_type{0} - sum_) : sum_;
+    return detail::normalize<Dst, RoundingPolicy, DenormalPolicy, bits>(
+        sign, lsb_exponent + traits::bias + traits::lead_position, magnitude,
+        false);
+  }
+
+  // The raw fixed-point sum (two's complement, weight 2^lsb_exponent)
+  constexpr const value_type &sum() const { return sum_; }
+
+  friend constexpr bool operator==(const ExactAccumulator &,
+                                   const ExactAccumulator &) = default;
+
+private:
+  // Significands of unpacked values with no guard bits are the exact
+  // integers of the encodings
+  using exact_rounding = rounding_policies::TowardZero;
+  using unpacked_a = UnpackedFloat<FormatA, exact_rounding>;
+  using unpacked_b = UnpackedFloat<FormatB, exact_rounding>;
+
+  // Lowest value_type with the sign bit set (value_type may be wider than
+  // bits, and is then modulo its own width)
+  static constexpr value_type sign_bit = value_type{1} << (bits - 1);
+
+  template <typename Unpacked>
+  static constexpr int effective_exponent(const Unpacked &x) {
+    return x.exponent == 0 ? 1 : static_cast<int>(x.exponent);
+  }
+
+  constexpr void add_term(bool sign, value_type term, int shift) {
+    term = static_cast<value_type>(term << shift);
+    sum_ = static_cast<value_type>(sign ? sum_ - term : sum_ + term);
+  }
+
+  value_type sum_{};
+  bool nan_ = false;
+  bool positive_inf_ = false;
+  bool negative_inf_ = false;
+};
+
+} // namespace opine::inline v1
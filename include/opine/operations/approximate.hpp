@@ -0,0 +1,655 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <opine/core/unpacked.hpp>
+#include <opine/operations/arithmetic.hpp>
+#include <opine/operations/classify.hpp>
+#include <opine/operations/normalize.hpp>
+#include <opine/policies/table.hpp>
+
+namespace opine::inline v1 {
+
+// Reduced-precision reciprocal, reciprocal square root and exponential
+//
+// recip(x), rsqrt(x) and exp(x) approximate 1/x, 1/sqrt(x) and e^x to the
+// precision of the format and no further, for the normalization and softmax
+// steps of fp16 and fp8 models where a correctly rounded division or a trip
+// through float costs more than the result is worth:
+//
+//   recip   seed table indexed by the top stored mantissa bits, then Newton
+//           steps y = y * (2 - m * y)
+//   rsqrt   seed table indexed by the exponent parity and the top stored
+//           mantissa bits, then Newton steps y = y * (3 - m * y^2) / 2
+//   exp     x * log2(e) in fixed point, split into 2^n * 2^f; 2^f from a
+//           table indexed by the top bits of f, times a short polynomial in
+//           the remaining bits of f
+//
+// Everything else is decided at compile time from the format's significand
+// width P = mant_bits + 1 and TablePolicy::max_table_bits, which bounds each
+// seed table to 2^max_table_bits entries (see detail::approximation_traits):
+// the tables are built by constexpr code, the seed error is measured over the
+// whole table, and the number of Newton steps (or the polynomial degree) is
+// the smallest that brings the relative error under 2^-(P + 2). Iterations the
+// seed already makes unnecessary are not generated: when the table is indexed
+// by every stored mantissa bit its entries are the results, so fp8 recip and
+// rsqrt are one lookup, and fp16 recip is one lookup under the default policy.
+//
+// Accuracy: a relative error below 2^-(P + 2) is below a quarter of an ulp,
+// so after the result is rounded it is within 0.75 ulp of the exact value
+// under round-to-nearest and within 1.25 ulp under directed rounding. The
+// results are NOT correctly rounded (use divide() for that). Powers of two
+// (and even powers for rsqrt) give exact reciprocals, and exp(0) is exactly 1.
+//
+// The operand is rounded to the format first (round(), a no-op for values
+// from unpack()), so an unrounded arithmetic result is approximated at the
+// value it would pack to. The result is returned unpacked, unrounded, through
+// normalize(): overflow, denormal results and flushing follow the rounding,
+// denormal and special-value policies as for arithmetic results. Special
+// values: NaN propagates (quieted); recip(+-0) = +-Inf and recip(+-Inf) =
+// +-0; rsqrt(-0) = -Inf, rsqrt(+Inf) = +0 and rsqrt(x < 0) is the default NaN;
+// exp(+Inf) = +Inf and exp(-Inf) = +0.
+//
+// The fixed-point arithmetic uses F = P + 6 fraction bits, so fp8 values are
+// 16-bit integers and fp16 values 32-bit ones; the constants are computed in
+// double, which limits the approximations to formats of up to fp32 precision.
+
+namespace detail {
+
+// 2^k as a double, in constant expressions
+constexpr double exp2_integer(int k) {
+  double result = 1.0;
+  for (; k > 0; --k) {
+    result *= 2.0;
+  }
+  for (; k < 0; ++k) {
+    result /= 2.0;
+  }
+  return result;
+}
+
+// sqrt(v) for v >= 1, in constant expressions: Newton steps from above
+// decrease monotonically until they stop changing the value
+constexpr double constexpr_sqrt(double v) {
+  double y = v;
+  for (;;) {
+    const double next = 0.5 * (y + v / y);
+    if (next >= y) {
+      return y;
+    }
+    y = next;
+  }
+}
+
+// 2^f for 0 <= f < 1, in constant expressions (Taylor series of e^(f ln 2))
+constexpr double constexpr_exp2(double f) {
+  constexpr double ln2 = 0.6931471805599453094;
+  const double u = f * ln2;
+  double term = 1.0;
+  double sum = 1.0;
+  for (int k = 1; k < 40; ++k) {
+    term *= u / k;
+    sum += term;
+  }
+  return sum;
+}
+
+// round(v * 2^bits) for v >= 0
+constexpr std::uint64_t to_fixed(double v, int bits) {
+  return static_cast<std::uint64_t>(v * exp2_integer(bits) + 0.5);
+}
+
+// Fraction bits of the fixed-point intermediates: 6 bits beyond the
+// significand leave room for the rounding errors of the seed, the Newton
+// steps and the polynomial under the 2^-(P + 2) target
+template <typename Format>
+constexpr int approximation_fraction_bits = Format::mant_bits + 7;
+
+template <typename Format>
+using approximation_value_t =
+    uint_t<approximation_fraction_bits<Format> + 2,
+           typename Format::type_policy>;
+
+// Reciprocal seeds: entry i covers the significands m whose top SeedBits
+// stored bits are i, and is the y minimizing max |1 - y * m| over them,
+// 2 / (lowest + highest), with F fraction bits. With SeedBits == mant_bits
+// each entry covers one significand and is its rounded reciprocal.
+template <typename Format, int SeedBits> constexpr auto make_recip_table() {
+  constexpr int fraction_bits = approximation_fraction_bits<Format>;
+  constexpr std::size_t size = std::size_t{1} << SeedBits;
+  const double step = exp2_integer(-SeedBits);
+  const double last = step - exp2_integer(-Format::mant_bits);
+
+  std::array<approximation_value_t<Format>, size> table{};
+  for (std::size_t i = 0; i < size; ++i) {
+    const double lowest = 1.0 + static_cast<double>(i) * step;
+    table[i] = static_cast<approximation_value_t<Format>>(
+        to_fixed(2.0 / (2.0 * lowest + last), fraction_bits));
+  }
+  return table;
+}
+
+// Lowest and highest significand in [1, 4) of a reciprocal square root seed
+// entry: index bit SeedBits - 1 is the exponent parity (an odd exponent
+// doubles the significand), the bits below it the top stored mantissa bits.
+// With no index bits the single entry covers all of [1, 4).
+template <typename Format, int SeedBits>
+constexpr std::array<double, 2> rsqrt_seed_interval(std::size_t i) {
+  constexpr int mant_bits = Format::mant_bits;
+  if constexpr (SeedBits == 0) {
+    return {1.0, 4.0 - exp2_integer(1 - mant_bits)};
+  } else {
+    constexpr int fraction_index_bits = SeedBits - 1;
+    const double scale = (i >> fraction_index_bits) != 0 ? 2.0 : 1.0;
+    const double step = exp2_integer(-fraction_index_bits);
+    const auto j = i & ((std::size_t{1} << fraction_index_bits) - 1);
+    const double lowest = 1.0 + static_cast<double>(j) * step;
+    const double highest = lowest + step - exp2_integer(-mant_bits);
+    return {scale * lowest, scale * highest};
+  }
+}
+
+// Reciprocal square root seeds: 2 / (sqrt(lowest) + sqrt(highest)), the y
+// minimizing max |1 - y * sqrt(m)| over the entry's interval
+template <typename Format, int SeedBits> constexpr auto make_rsqrt_table() {
+  constexpr int fraction_bits = approximation_fraction_bits<Format>;
+  constexpr std::size_t size = std::size_t{1} << SeedBits;
+
+  std::array<approximation_value_t<Format>, size> table{};
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto interval = rsqrt_seed_interval<Format, SeedBits>(i);
+    table[i] = static_cast<approximation_value_t<Format>>(
+        to_fixed(2.0 / (constexpr_sqrt(interval[0]) +
+                        constexpr_sqrt(interval[1])),
+                 fraction_bits));
+  }
+  return table;
+}
+
+// Exponential seeds: entry i is 2^(i / 2^SeedBits) with F fraction bits,
+// the product of 2^(2^k / 2^SeedBits) over the bits k set in i (built up one
+// bit at a time, so each entry is one multiplication in double)
+template <typename Format, int SeedBits> constexpr auto make_exp2_table() {
+  constexpr int fraction_bits = approximation_fraction_bits<Format>;
+  constexpr std::size_t size = std::size_t{1} << SeedBits;
+
+  std::array<double, SeedBits> powers{};
+  for (int k = 0; k < SeedBits; ++k) {
+    powers[static_cast<std::size_t>(k)] =
+        constexpr_exp2(exp2_integer(k - SeedBits));
+  }
+  std::array<double, size> values{};
+  values[0] = 1.0;
+  std::array<approximation_value_t<Format>, size> table{};
+  for (std::size_t i = 0; i < size; ++i) {
+    if (i != 0) {
+      const int lowest = std::countr_zero(i);
+      values[i] =
+          values[i & (i - 1)] * powers[static_cast<std::size_t>(lowest)];
+    }
+    table[i] =
+        static_cast<approximation_value_t<Format>>(to_fixed(values[i],
+                                                            fraction_bits));
+  }
+  return table;
+}
+
+template <typename Format, int SeedBits>
+inline constexpr auto recip_seed_table =
+    make_recip_table<Format, SeedBits>();
+
+template <typename Format, int SeedBits>
+inline constexpr auto rsqrt_seed_table =
+    make_rsqrt_table<Format, SeedBits>();
+
+template <typename Format, int SeedBits>
+inline constexpr auto exp2_seed_table = make_exp2_table<Format, SeedBits>();
+
+// Largest relative error |1 - y * m| (or |1 - y * sqrt(m)|) of a seed table
+// over the significands each entry covers; the extremes are at the ends of
+// each interval
+template <typename Format, int SeedBits>
+constexpr double recip_seed_error() {
+  const auto &table = recip_seed_table<Format, SeedBits>;
+  const double unit = exp2_integer(-approximation_fraction_bits<Format>);
+  const double step = exp2_integer(-SeedBits);
+  const double last = step - exp2_integer(-Format::mant_bits);
+  double error = 0.0;
+  for (std::size_t i = 0; i < table.size(); ++i) {
+    const double y = static_cast<double>(table[i]) * unit;
+    const double lowest = 1.0 + static_cast<double>(i) * step;
+    for (double m : {lowest, lowest + last}) {
+      const double e = 1.0 - y * m;
+      error = std::max(error, e < 0 ? -e : e);
+    }
+  }
+  return error;
+}
+
+template <typename Format, int SeedBits>
+constexpr double rsqrt_seed_error() {
+  const auto &table = rsqrt_seed_table<Format, SeedBits>;
+  const double unit = exp2_integer(-approximation_fraction_bits<Format>);
+  double error = 0.0;
+  for (std::size_t i = 0; i < table.size(); ++i) {
+    const double y = static_cast<double>(table[i]) * unit;
+    for (double m : rsqrt_seed_interval<Format, SeedBits>(i)) {
+      const double e = 1.0 - y * constexpr_sqrt(m);
+      error = std::max(error, e < 0 ? -e : e);
+    }
+  }
+  return error;
+}
+
+// Relative error after `steps` Newton steps from `error`: each step squares
+// the error (times `growth`, plus `cubic` times its cube) and adds the
+// fixed-point truncation `rounding`
+constexpr double newton_error(double error, double growth, double cubic,
+                              double rounding, int steps) {
+  for (int i = 0; i < steps; ++i) {
+    error = growth * error * error + cubic * error * error * error + rounding;
+  }
+  return error;
+}
+
+// Fewest Newton steps that bring `error` under `target`
+constexpr int newton_steps(double error, double growth, double cubic,
+                           double rounding, double target) {
+  int steps = 0;
+  while (steps < 16 &&
+         newton_error(error, growth, cubic, rounding, steps) > target) {
+    ++steps;
+  }
+  return steps;
+}
+
+// Relative error of exp() with a degree-d polynomial: the Taylor truncation
+// of 2^r for r < 2^-seed_bits (none when the table covers every bit of f),
+// plus the fixed-point errors of t (1.25 * 2^-F, times ln 2), the table entry
+// (2^-(F + 1)), each Horner step (2^-F, and 2^-(F + 1) for its coefficient)
+// and the final product (2^-F)
+constexpr double exp_error_bound(int seed_bits, int fraction_bits,
+                                 int degree) {
+  double truncation = 0.0;
+  if (seed_bits < fraction_bits) {
+    const double s = 0.6931471805599453094 * exp2_integer(-seed_bits);
+    double term = 1.0;
+    for (int k = 1; k <= degree + 1; ++k) {
+      term *= s / k;
+    }
+    truncation = term / (1.0 - s);
+  }
+  return truncation + (3 * degree + 5) * exp2_integer(-fraction_bits) / 2;
+}
+
+// Lowest polynomial degree that brings exp() under `target`
+constexpr int exp_polynomial_degree(int seed_bits, int fraction_bits,
+                                    double target) {
+  int degree = 0;
+  while (degree < 16 &&
+         exp_error_bound(seed_bits, fraction_bits, degree) > target) {
+    ++degree;
+  }
+  return degree;
+}
+
+// Compile-time plan of recip(), rsqrt() and exp() for a format and a table
+// budget: fixed-point widths, seed table sizes, iteration counts, polynomial
+// degree and the resulting error bounds (all relative, as doubles)
+template <typename Format, typename TablePolicy> struct approximation_traits {
+  static_assert(Format::has_implicit_bit,
+                "Approximations require a format with an implicit bit");
+  static_assert(Format::mant_bits <= 23,
+                "Approximations are limited to formats of up to fp32 "
+                "precision");
+
+  using type_policy = typename Format::type_policy;
+
+  static constexpr int mant_bits = Format::mant_bits;
+  static constexpr int precision = mant_bits + 1;
+  static constexpr int fraction_bits = approximation_fraction_bits<Format>;
+  static constexpr double target_error = exp2_integer(-(precision + 2));
+  static constexpr double unit = exp2_integer(-fraction_bits);
+
+  // Fixed-point values below 4 with F fraction bits, and their products
+  using value_type = approximation_value_t<Format>;
+  using product_type = uint_t<2 * (fraction_bits + 2), type_policy>;
+
+  // Reciprocal: the fixed-point step truncates twice, each at most 2^-F
+  // relative to a result in (1/2, 1]
+  static constexpr int recip_seed_bits =
+      std::min(mant_bits, TablePolicy::max_table_bits);
+  static constexpr double recip_seed_error =
+      detail::recip_seed_error<Format, recip_seed_bits>();
+  static constexpr double recip_rounding = 4 * unit;
+  static constexpr int recip_iterations = newton_steps(
+      recip_seed_error, 1.0, 0.0, recip_rounding, target_error);
+  static constexpr double recip_error = newton_error(
+      recip_seed_error, 1.0, 0.0, recip_rounding, recip_iterations);
+
+  // Reciprocal square root: one more index bit for the exponent parity;
+  // relative error d becomes 1.5 d^2 + 0.5 d^3 per step
+  static constexpr int rsqrt_seed_bits =
+      std::min(mant_bits + 1, TablePolicy::max_table_bits);
+  static constexpr double rsqrt_seed_error =
+      detail::rsqrt_seed_error<Format, rsqrt_seed_bits>();
+  static constexpr double rsqrt_rounding = 8 * unit;
+  static constexpr int rsqrt_iterations = newton_steps(
+      rsqrt_seed_error, 1.5, 0.5, rsqrt_rounding, target_error);
+  static constexpr double rsqrt_error = newton_error(
+      rsqrt_seed_error, 1.5, 0.5, rsqrt_rounding, rsqrt_iterations);
+
+  // Exponential: |x| >= 2^exp_integer_bits overflows (or underflows) in
+  // every format, so t = x * log2(e) has exp_integer_bits + 1 integer bits;
+  // log2(e) is kept with exp_constant_bits fraction bits, enough for
+  // an error of 2^-(F + 2) in t
+  static constexpr int exp_limit = Format::exp_bias + precision + 3;
+  static constexpr int exp_integer_bits =
+      std::bit_width(static_cast<unsigned>(exp_limit));
+  static constexpr int exp_constant_bits = fraction_bits + exp_integer_bits + 1;
+  static_assert(exp_constant_bits + 1 <= 53,
+                "log2(e) must fit the precision of double");
+
+  // At least one bit: {1, sqrt(2)} is a select rather than a table, and
+  // without it the polynomial on [0, 1) needs more bits than F to converge
+  static constexpr int exp_seed_bits =
+      std::max(1, std::min(fraction_bits, TablePolicy::max_table_bits));
+
+  static constexpr int exp_degree =
+      exp_polynomial_degree(exp_seed_bits, fraction_bits, target_error);
+  static constexpr double exp_error =
+      exp_error_bound(exp_seed_bits, fraction_bits, exp_degree);
+
+  static_assert(recip_error <= target_error && rsqrt_error <= target_error &&
+                    exp_error <= target_error,
+                "Approximation error budget exceeded");
+};
+
+// Exponential polynomial coefficients ln(2)^k / k! with F fraction bits
+template <typename Format, int Degree> constexpr auto make_exp2_polynomial() {
+  constexpr int fraction_bits = approximation_fraction_bits<Format>;
+  std::array<approximation_value_t<Format>, Degree + 1> coefficients{};
+  double c = 1.0;
+  for (int k = 0; k <= Degree; ++k) {
+    coefficients[static_cast<std::size_t>(k)] =
+        static_cast<approximation_value_t<Format>>(to_fixed(c, fraction_bits));
+    c *= 0.6931471805599453094 / (k + 1);
+  }
+  return coefficients;
+}
+
+// The operand at the value it packs to: round() unless its guard bits are
+// already clear, as they are for every value from unpack()
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+rounded_operand(
+    const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &x) {
+  using mantissa_type =
+      typename UnpackedFloat<Format, RoundingPolicy,
+                             DenormalPolicy>::mantissa_type;
+  constexpr int guard_bits = RoundingPolicy::guard_bits;
+  if constexpr (guard_bits > 0) {
+    constexpr auto guard_mask =
+        static_cast<mantissa_type>((mantissa_type{1} << guard_bits) - 1);
+    if ((x.mantissa & guard_mask) != 0) {
+      return round(x);
+    }
+  }
+  return x;
+}
+
+// A finite nonzero operand as m * 2^exponent, 1 <= m < 2, with its stored
+// mantissa bits (denormals normalized)
+template <typename Format> struct approximation_operand {
+  int exponent;
+  typename Format::mantissa_storage_type fraction;
+};
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr approximation_operand<Format> approximation_operand_of(
+    const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &x) {
+  using traits = arithmetic_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using mantissa_type =
+      typename UnpackedFloat<Format, RoundingPolicy,
+                             DenormalPolicy>::mantissa_type;
+  using fraction_type = typename Format::mantissa_storage_type;
+
+  int shift = 0;
+  if constexpr (!traits::normal_operands) {
+    shift = traits::lead_position + 1 -
+            bit_width<traits::operand_bits>(x.mantissa);
+  }
+  const auto mantissa = static_cast<mantissa_type>(x.mantissa << shift);
+  constexpr auto mask =
+      static_cast<mantissa_type>((mantissa_type{1} << Format::mant_bits) - 1);
+  return {static_cast<int>(traits::effective_exponent(x)) - shift -
+              traits::bias,
+          static_cast<fraction_type>(
+              (mantissa >> RoundingPolicy::guard_bits) & mask)};
+}
+
+// Normalize an approximation y * 2^-F * 2^exponent, y nonzero
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+approximation_result(bool sign, int exponent,
+                     approximation_value_t<Format> y) {
+  using traits = arithmetic_traits<Format, RoundingPolicy, DenormalPolicy>;
+  return normalize<Format, RoundingPolicy, DenormalPolicy,
+                   approximation_fraction_bits<Format> + 2>(
+      sign,
+      exponent - approximation_fraction_bits<Format> + traits::bias +
+          traits::lead_position,
+      y, false);
+}
+
+} // namespace detail
+
+// Approximate 1/x
+template <typename TablePolicy = table_policies::DefaultTablePolicy,
+          typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+recip(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &operand) {
+  using traits =
+      detail::arithmetic_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using plan = detail::approximation_traits<Format, TablePolicy>;
+  using value_type = typename plan::value_type;
+  using product_type = typename plan::product_type;
+  constexpr int fraction_bits = plan::fraction_bits;
+  constexpr int seed_bits = plan::recip_seed_bits;
+
+  const auto x = detail::rounded_operand(operand);
+  if (is_nan(x)) {
+    return traits::quiet(x);
+  }
+  if (is_zero(x)) {
+    return traits::infinity(x.sign);
+  }
+  if (is_inf(x)) {
+    return traits::zero(x.sign);
+  }
+
+  const auto [exponent, fraction] = detail::approximation_operand_of(x);
+  if (fraction == 0) {
+    return detail::approximation_result<Format, RoundingPolicy,
+                                        DenormalPolicy>(
+        x.sign, -exponent, value_type{1} << fraction_bits);
+  }
+
+  const auto m = static_cast<value_type>(
+      (value_type{1} << fraction_bits) |
+      static_cast<value_type>(static_cast<value_type>(fraction)
+                              << (fraction_bits - plan::mant_bits)));
+  const auto index =
+      static_cast<std::size_t>(fraction >> (plan::mant_bits - seed_bits));
+  auto y = detail::recip_seed_table<Format, seed_bits>[index];
+
+  // y * (2 - m * y); the product is within the seed error of 1
+  for (int i = 0; i < plan::recip_iterations; ++i) {
+    const auto my = static_cast<value_type>(
+        (static_cast<product_type>(m) * y) >> fraction_bits);
+    const auto correction =
+        static_cast<value_type>((value_type{2} << fraction_bits) - my);
+    y = static_cast<value_type>(
+        (static_cast<product_type>(y) * correction) >> fraction_bits);
+  }
+  return detail::approximation_result<Format, RoundingPolicy, DenormalPolicy>(
+      x.sign, -exponent, y);
+}
+
+// Approximate 1/sqrt(x)
+template <typename TablePolicy = table_policies::DefaultTablePolicy,
+          typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+rsqrt(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &operand) {
+  using traits =
+      detail::arithmetic_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using plan = detail::approximation_traits<Format, TablePolicy>;
+  using value_type = typename plan::value_type;
+  using product_type = typename plan::product_type;
+  constexpr int fraction_bits = plan::fraction_bits;
+  constexpr int seed_bits = plan::rsqrt_seed_bits;
+
+  const auto x = detail::rounded_operand(operand);
+  if (is_nan(x)) {
+    return traits::quiet(x);
+  }
+  if (is_zero(x)) {
+    return traits::infinity(x.sign);
+  }
+  if (x.sign) {
+    return traits::default_nan();
+  }
+  if (is_inf(x)) {
+    return traits::zero(false);
+  }
+
+  // x = m * 2^odd * 2^(exponent - odd), with an even power of two
+  const auto [exponent, fraction] = detail::approximation_operand_of(x);
+  const int odd = exponent & 1;
+  const int result_exponent = -((exponent - odd) / 2);
+  if (fraction == 0 && odd == 0) {
+    return detail::approximation_result<Format, RoundingPolicy,
+                                        DenormalPolicy>(
+        false, result_exponent, value_type{1} << fraction_bits);
+  }
+
+  std::size_t index = 0;
+  if constexpr (seed_bits > 0) {
+    index = (static_cast<std::size_t>(odd) << (seed_bits - 1)) |
+            static_cast<std::size_t>(fraction >>
+                                     (plan::mant_bits - (seed_bits - 1)));
+  }
+  auto y = detail::rsqrt_seed_table<Format, seed_bits>[index];
+
+  // y * (3 - m * y^2) / 2, with m in [1, 4)
+  if constexpr (plan::rsqrt_iterations > 0) {
+    const auto m = static_cast<value_type>(
+        ((value_type{1} << fraction_bits) |
+         static_cast<value_type>(static_cast<value_type>(fraction)
+                                 << (fraction_bits - plan::mant_bits)))
+        << odd);
+    for (int i = 0; i < plan::rsqrt_iterations; ++i) {
+      const auto y2 = static_cast<value_type>(
+          (static_cast<product_type>(y) * y) >> fraction_bits);
+      const auto my2 = static_cast<value_type>(
+          (static_cast<product_type>(m) * y2) >> fraction_bits);
+      const auto correction =
+          static_cast<value_type>((value_type{3} << fraction_bits) - my2);
+      y = static_cast<value_type>(
+          (static_cast<product_type>(y) * correction) >> (fraction_bits + 1));
+    }
+  }
+  return detail::approximation_result<Format, RoundingPolicy, DenormalPolicy>(
+      false, result_exponent, y);
+}
+
+// Approximate e^x
+template <typename TablePolicy = table_policies::DefaultTablePolicy,
+          typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+exp(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &operand) {
+  using traits =
+      detail::arithmetic_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using plan = detail::approximation_traits<Format, TablePolicy>;
+  using type_policy = typename plan::type_policy;
+  using value_type = typename plan::value_type;
+  using product_type = typename plan::product_type;
+  constexpr int fraction_bits = plan::fraction_bits;
+  constexpr int seed_bits = plan::exp_seed_bits;
+  constexpr int constant_bits = plan::exp_constant_bits;
+
+  const auto x = detail::rounded_operand(operand);
+  if (is_nan(x)) {
+    return traits::quiet(x);
+  }
+  if (is_inf(x)) {
+    return x.sign ? traits::zero(false) : traits::infinity(false);
+  }
+  if (is_zero(x)) {
+    return detail::approximation_result<Format, RoundingPolicy,
+                                        DenormalPolicy>(
+        false, 0, value_type{1} << fraction_bits);
+  }
+
+  // t = |x| * log2(e) with F fraction bits: the P-bit significand times
+  // log2(e) with constant_bits fraction bits, shifted by at least P + 1
+  using t_type = uint_t<plan::precision + constant_bits + 1, type_policy>;
+  constexpr auto log2e = static_cast<t_type>(
+      detail::to_fixed(1.4426950408889634074, constant_bits));
+  constexpr int t_bits = plan::precision + constant_bits + 1;
+
+  const auto [exponent, fraction] = detail::approximation_operand_of(x);
+  int n = 0;
+  value_type f = 0;
+  if (exponent >= plan::exp_integer_bits) {
+    // Beyond the largest finite value, or below the smallest denormal
+    n = x.sign ? -plan::exp_limit : plan::exp_limit;
+  } else {
+    const auto significand = static_cast<t_type>(
+        (t_type{1} << plan::mant_bits) | static_cast<t_type>(fraction));
+    const int shift =
+        plan::mant_bits + constant_bits - fraction_bits - exponent;
+    const auto t = shift < t_bits
+                       ? static_cast<t_type>((significand * log2e) >> shift)
+                       : t_type{0};
+    constexpr auto fraction_mask =
+        static_cast<t_type>((t_type{1} << fraction_bits) - 1);
+    n = static_cast<int>(t >> fraction_bits);
+    f = static_cast<value_type>(t & fraction_mask);
+    if (x.sign) {
+      // e^-t = 2^-(n + 1) * 2^(1 - f) when f is nonzero
+      n = -n;
+      if (f != 0) {
+        n -= 1;
+        f = static_cast<value_type>((value_type{1} << fraction_bits) - f);
+      }
+    }
+  }
+
+  // 2^f = table[top bits of f] * 2^r, r the rest of f
+  const auto index = static_cast<std::size_t>(f >> (fraction_bits - seed_bits));
+  auto y = detail::exp2_seed_table<Format, seed_bits>[index];
+  if constexpr (plan::exp_degree > 0) {
+    constexpr auto coefficients =
+        detail::make_exp2_polynomial<Format, plan::exp_degree>();
+    constexpr auto rest_mask = static_cast<value_type>(
+        (value_type{1} << (fraction_bits - seed_bits)) - 1);
+    const auto r = static_cast<value_type>(f & rest_mask);
+    auto sum = coefficients[plan::exp_degree];
+    for (int k = plan::exp_degree - 1; k >= 0; --k) {
+      sum = static_cast<value_type>(
+          coefficients[static_cast<std::size_t>(k)] +
+          static_cast<value_type>((static_cast<product_type>(sum) * r) >>
+                                  fraction_bits));
+    }
+    y = static_cast<value_type>((static_cast<product_type>(y) * sum) >>
+                                fraction_bits);
+  }
+  return detail::approximation_result<Format, RoundingPolicy, DenormalPolicy>(
+      false, n, y);
+}
+
+} // namespace opine::inline v1
@@ -0,0 +1,453 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <opine/core/unpacked.hpp>
+#include <opine/operations/classify.hpp>
+#include <opine/operations/multiply_integers.hpp>
+#include <opine/operations/normalize.hpp>
+#include <opine/policies/multiply.hpp>
+#include <opine/policies/rounding.hpp>
+#include <type_traits>
+
+namespace opine::inline v1 {
+
+// Arithmetic on unpacked values
+//
+// add(), subtract(), multiply(), divide() and fma() take UnpackedFloat
+// operands and return an UnpackedFloat of the same configuration, so chained
+// operations never go through pack()/unpack(). Each result is the exact
+// result normalized to the unpacked layout:
+//
+//   [implicit bit][M stored bits][G guard bits, lowest one sticky]
+//
+// and is NOT rounded. Rounding happens once, through RoundingPolicy's
+// round_mantissa(), when the result is packed (or when round() is called for
+// round-every-step semantics). With TowardZero (G = 0) the guard bits are
+// empty and every result is already truncated.
+//
+// Mantissa arithmetic uses uint_t<N, TypePolicy> at exactly the width each
+// operation needs (P = M + 1 significand bits, G guard bits):
+//
+//   add/subtract   P + G + 3 extra bits + 1 carry
+//   multiply       2 * (P + G)
+//   fma            2 * (P + G) + 3 extra bits + 1 carry
+//   divide         2 * (P + G) + 2 (dividend), P + G + 2 quotient bits
+//
+// so fp8 with TowardZero adds in 8-bit integers, and fp32 with
+// ToNearestTiesToEven multiplies in 54 bits. multiply() and fma() compute the
+// significand product with the strategy their multiply policy selects
+// (operations/multiply_integers.hpp): hardware, table or shift-and-add.
+//
+// Special values follow IEEE 754: NaN operands propagate (quieted), invalid
+// operations (Inf - Inf, 0 * Inf, 0 / 0, Inf / Inf) return the default quiet
+// NaN, x / 0 is a signed infinity, and denormals are fully supported unless
+// the denormal policy flushes them (see classify.hpp and normalize()).
+// Formats with other special values (Format::special_values) drop the
+// branches for the values they lack at compile time; without infinities
+// x / 0 is the overflow value (NaN, or the largest finite value when the
+// format saturates), without NaN 0 / 0 is +0, and without -0 every zero
+// result is +0.
+
+namespace detail {
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+struct arithmetic_traits {
+  static_assert(Format::has_implicit_bit,
+                "Arithmetic requires a format with an implicit bit");
+
+  using type_policy = typename Format::type_policy;
+  using unpacked_type = UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>;
+  using mantissa_type = typename unpacked_type::mantissa_type;
+
+  // Significand width of an operand (implicit bit, stored bits, guard bits)
+  static constexpr int operand_bits = unpacked_type::mantissa_bits;
+
+  // Extra low bits kept while aligning addends: guard, round and sticky
+  // beyond the operand width, enough for a correctly rounded sum
+  static constexpr int align_bits = 3;
+
+  static constexpr int product_bits = 2 * operand_bits;
+  static constexpr int quotient_shift = operand_bits + 2;
+  static constexpr int dividend_bits = operand_bits + quotient_shift;
+
+  using product_type = uint_t<product_bits, type_policy>;
+  using dividend_type = uint_t<dividend_bits, type_policy>;
+
+  // Exact product of two significands
+  template <typename MultiplyPolicy>
+  static constexpr product_type product(const unpacked_type &a,
+                                        const unpacked_type &b) {
+    using operand_type = uint_t<operand_bits, type_policy>;
+    return static_cast<product_type>(
+        multiply_integers<operand_bits, operand_bits, MultiplyPolicy,
+                          type_policy>(static_cast<operand_type>(a.mantissa),
+                                       static_cast<operand_type>(b.mantissa)));
+  }
+
+  // Signed exponent wide enough for sums and differences of two biased
+  // exponents plus the normalization shifts
+  static constexpr int exponent_bits =
+      std::max(Format::exp_bits,
+               static_cast<int>(std::bit_width(
+                   static_cast<unsigned>(4 * operand_bits)))) +
+      3;
+  using exponent_type = int_t<exponent_bits, type_policy>;
+
+  static constexpr int bias = Format::exp_bias;
+  static constexpr int lead_position =
+      Format::mant_bits + RoundingPolicy::guard_bits;
+
+  // Operands are never denormal when the denormal policy flushes inputs
+  // (classify.hpp: a zero exponent field is zero), so their significands
+  // always have the implicit bit set
+  static constexpr bool normal_operands = DenormalPolicy::flush_inputs;
+
+  // Biased exponent on the unpacked mantissa scale (denormals use 1)
+  static constexpr exponent_type effective_exponent(const unpacked_type &x) {
+    if constexpr (normal_operands) {
+      return static_cast<exponent_type>(x.exponent);
+    } else {
+      return x.exponent == 0 ? exponent_type{1}
+                             : static_cast<exponent_type>(x.exponent);
+    }
+  }
+
+  // Exact zero sums (x + (-x), and +0 + -0) are -0 when rounding toward
+  // negative, +0 in every other direction
+  static constexpr bool negative_zero_sum =
+      std::is_same_v<RoundingPolicy, rounding_policies::TowardNegative>;
+
+  static constexpr unpacked_type zero(bool sign) {
+    return signed_zero<Format, RoundingPolicy, DenormalPolicy>(sign);
+  }
+
+  static constexpr unpacked_type infinity(bool sign) {
+    return detail::infinity<Format, RoundingPolicy, DenormalPolicy>(sign);
+  }
+
+  // Default NaN, returned by invalid operations (+0 in a format without NaN)
+  static constexpr unpacked_type default_nan() {
+    return quiet_nan<Format, RoundingPolicy, DenormalPolicy>(false);
+  }
+
+  // NaN operand propagated to the result; formats other than IEEE have a
+  // single NaN (per sign) and no payload
+  static constexpr unpacked_type quiet(unpacked_type nan) {
+    if constexpr (special_encoding<Format> ==
+                  special_value_policies::SpecialValueEncoding::IEEE) {
+      nan.mantissa = static_cast<mantissa_type>(
+          nan.mantissa | static_cast<mantissa_type>(mantissa_type{1}
+                                                    << (lead_position - 1)));
+      return nan;
+    } else {
+      return quiet_nan<Format, RoundingPolicy, DenormalPolicy>(nan.sign);
+    }
+  }
+};
+
+// Add two finite significands of the same width, not both zero
+//
+// Each operand is (mantissa, exponent) in normalize()'s convention, and a
+// larger exponent, or an equal exponent and a larger mantissa, must mean a
+// larger magnitude (true for unpacked values, whose mantissas are normalized
+// unless the exponent is the minimum, and for left-justified significands).
+// The smaller operand is aligned to the larger with align_bits extra low
+// bits, everything shifted out is kept as a sticky bit in the lowest
+// position, and the exact sum is normalized.
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy,
+          int Bits, typename Exponent>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+add_significands(bool a_sign, Exponent a_exp,
+                 uint_t<Bits, typename Format::type_policy> a_mant,
+                 bool b_sign, Exponent b_exp,
+                 uint_t<Bits, typename Format::type_policy> b_mant) {
+  using traits = arithmetic_traits<Format, RoundingPolicy, DenormalPolicy>;
+  constexpr int align_bits = traits::align_bits;
+  constexpr int sum_bits = Bits + align_bits + 1;
+  using sum_type = uint_t<sum_bits, typename Format::type_policy>;
+
+  // Order the operands by magnitude: |big| >= |small|
+  const bool swap = b_exp > a_exp || (b_exp == a_exp && b_mant > a_mant);
+  const bool big_sign = swap ? b_sign : a_sign;
+  const bool small_sign = swap ? a_sign : b_sign;
+  const Exponent big_exp = swap ? b_exp : a_exp;
+  const int distance = static_cast<int>(swap ? b_exp - a_exp : a_exp - b_exp);
+
+  const auto big_mant = static_cast<sum_type>(
+      static_cast<sum_type>(swap ? b_mant : a_mant) << align_bits);
+  auto small_mant = static_cast<sum_type>(
+      static_cast<sum_type>(swap ? a_mant : b_mant) << align_bits);
+  if (distance >= sum_bits) {
+    small_mant = small_mant != 0 ? sum_type{1} : sum_type{0};
+  } else if (distance > 0) {
+    const auto lost =
+        static_cast<sum_type>(small_mant & ((sum_type{1} << distance) - 1));
+    small_mant = static_cast<sum_type>(small_mant >> distance);
+    if (lost != 0) {
+      small_mant = static_cast<sum_type>(small_mant | sum_type{1});
+    }
+  }
+
+  // Same signs add magnitudes, different signs subtract the smaller one
+  const auto sum = static_cast<sum_type>(big_sign == small_sign
+                                             ? big_mant + small_mant
+                                             : big_mant - small_mant);
+  if (sum == 0) {
+    // Exact cancellation: x + (-x) = +0 (-0 toward negative)
+    return traits::zero(traits::negative_zero_sum);
+  }
+
+  return normalize<Format, RoundingPolicy, DenormalPolicy, sum_bits>(
+      big_sign, static_cast<Exponent>(big_exp - align_bits), sum, false);
+}
+
+} // namespace detail
+
+// Add two unpacked values
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+add(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &a,
+    const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &b) {
+  using traits =
+      detail::arithmetic_traits<Format, RoundingPolicy, DenormalPolicy>;
+
+  // Special values
+  if (is_nan(a)) {
+    return traits::quiet(a);
+  }
+  if (is_nan(b)) {
+    return traits::quiet(b);
+  }
+  if (is_inf(a)) {
+    return is_inf(b) && a.sign != b.sign ? traits::default_nan() : a;
+  }
+  if (is_inf(b)) {
+    return b;
+  }
+  if (is_zero(a) && is_zero(b)) {
+    // Zeros of the same sign keep it; +0 + -0 = +0 (-0 toward negative)
+    return traits::zero(traits::negative_zero_sum ? a.sign || b.sign
+                                                  : a.sign && b.sign);
+  }
+  if constexpr (DenormalPolicy::flush_inputs) {
+    // Unrounded denormal results (outputs need not be flushed) have a zero
+    // exponent field, so they are zero here, as in multiply()
+    if (is_zero(a)) {
+      return b;
+    }
+    if (is_zero(b)) {
+      return a;
+    }
+  }
+
+  return detail::add_significands<Format, RoundingPolicy, DenormalPolicy,
+                                  traits::operand_bits>(
+      a.sign, traits::effective_exponent(a), a.mantissa, b.sign,
+      traits::effective_exponent(b), b.mantissa);
+}
+
+// Subtract two unpacked values: a - b = a + (-b)
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+subtract(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &a,
+         const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &b) {
+  if constexpr (!Format::special_values::has_negative_zero) {
+    // The sign of +0 and NaN is part of their encoding: flipping it would
+    // swap the two. a - 0 = a + 0, and a NaN b propagates either way.
+    if (is_nan(b) || is_zero(b)) {
+      return add(a, b);
+    }
+  }
+  auto negated = b;
+  negated.sign = !b.sign;
+  return add(a, negated);
+}
+
+// Multiply two unpacked values
+template <typename Format, typename RoundingPolicy,
+          multiply_policies::MultiplyPolicy MultiplyPolicy =
+              multiply_policies::DefaultMultiplyPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+multiply(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &a,
+         const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &b) {
+  using traits =
+      detail::arithmetic_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using product_type = typename traits::product_type;
+  using exponent_type = typename traits::exponent_type;
+
+  const bool sign = a.sign != b.sign;
+
+  // Special values
+  if (is_nan(a)) {
+    return traits::quiet(a);
+  }
+  if (is_nan(b)) {
+    return traits::quiet(b);
+  }
+  if (is_inf(a) || is_inf(b)) {
+    return is_zero(a) || is_zero(b) ? traits::default_nan()
+                                    : traits::infinity(sign);
+  }
+  if (is_zero(a) || is_zero(b)) {
+    return traits::zero(sign);
+  }
+
+  // The product has 2 * (M + G) fraction bits; rescale to M + G
+  const product_type product =
+      traits::template product<MultiplyPolicy>(a, b);
+  const auto exponent = static_cast<exponent_type>(
+      traits::effective_exponent(a) + traits::effective_exponent(b) -
+      traits::bias - traits::lead_position);
+
+  return detail::normalize<Format, RoundingPolicy, DenormalPolicy,
+                           traits::product_bits>(
+      sign, exponent, product, false);
+}
+
+// Fused multiply-add: a * b + c with a single rounding
+//
+// The product a * b is exact (2 * (P + G) bits, as in multiply()) and is
+// added to c without being rounded or truncated first; c is widened to the
+// product's width. The result is normalized and left unrounded like every
+// other operation, so the rounding policy runs once, when it is packed.
+template <typename Format, typename RoundingPolicy,
+          multiply_policies::MultiplyPolicy MultiplyPolicy =
+              multiply_policies::DefaultMultiplyPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+fma(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &a,
+    const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &b,
+    const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &c) {
+  using traits =
+      detail::arithmetic_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using product_type = typename traits::product_type;
+  using exponent_type = typename traits::exponent_type;
+  constexpr int product_bits = traits::product_bits;
+
+  const bool product_sign = a.sign != b.sign;
+
+  // Special values
+  if (is_nan(a)) {
+    return traits::quiet(a);
+  }
+  if (is_nan(b)) {
+    return traits::quiet(b);
+  }
+  if (is_nan(c)) {
+    return traits::quiet(c);
+  }
+  if (is_inf(a) || is_inf(b)) {
+    if (is_zero(a) || is_zero(b) ||
+        (is_inf(c) && c.sign != product_sign)) {
+      return traits::default_nan();
+    }
+    return traits::infinity(product_sign);
+  }
+  if (is_inf(c)) {
+    return c;
+  }
+  if (is_zero(a) || is_zero(b)) {
+    return add(traits::zero(product_sign), c);
+  }
+  // Under flush_inputs this includes an unrounded denormal c
+  if (is_zero(c)) {
+    return multiply<Format, RoundingPolicy, MultiplyPolicy>(a, b);
+  }
+
+  // Left-justify the exact product and c in product_bits, so that the
+  // larger exponent is the larger magnitude. Normal operands need no leading
+  // zero count: c's leading bit is the implicit bit, and the product of two
+  // significands in [1, 2) is in [1, 4).
+  auto product = traits::template product<MultiplyPolicy>(a, b);
+  auto product_exp = static_cast<exponent_type>(
+      traits::effective_exponent(a) + traits::effective_exponent(b) -
+      traits::bias - traits::lead_position);
+  auto addend = static_cast<product_type>(c.mantissa);
+  auto addend_exp = traits::effective_exponent(c);
+
+  int product_shift = 0;
+  int addend_shift = 0;
+  if constexpr (traits::normal_operands) {
+    product_shift = (product >> (product_bits - 1)) != 0 ? 0 : 1;
+    addend_shift = product_bits - traits::operand_bits;
+  } else {
+    product_shift = product_bits - detail::bit_width<product_bits>(product);
+    addend_shift = product_bits - detail::bit_width<product_bits>(addend);
+  }
+  product = static_cast<product_type>(product << product_shift);
+  product_exp = static_cast<exponent_type>(product_exp - product_shift);
+  addend = static_cast<product_type>(addend << addend_shift);
+  addend_exp = static_cast<exponent_type>(addend_exp - addend_shift);
+
+  return detail::add_significands<Format, RoundingPolicy, DenormalPolicy,
+                                  product_bits>(
+      product_sign, product_exp, product, c.sign, addend_exp, addend);
+}
+
+// Divide two unpacked values
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+divide(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &a,
+       const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &b) {
+  using traits =
+      detail::arithmetic_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using dividend_type = typename traits::dividend_type;
+  using exponent_type = typename traits::exponent_type;
+  constexpr int operand_bits = traits::operand_bits;
+
+  const bool sign = a.sign != b.sign;
+
+  // Special values
+  if (is_nan(a)) {
+    return traits::quiet(a);
+  }
+  if (is_nan(b)) {
+    return traits::quiet(b);
+  }
+  if (is_inf(a)) {
+    return is_inf(b) ? traits::default_nan() : traits::infinity(sign);
+  }
+  if (is_inf(b)) {
+    return traits::zero(sign);
+  }
+  if (is_zero(b)) {
+    return is_zero(a) ? traits::default_nan() : traits::infinity(sign);
+  }
+  if (is_zero(a)) {
+    return traits::zero(sign);
+  }
+
+  // Normalize denormal operands so that both quotient operands have their
+  // leading bit at the implicit bit position; the quotient of the mantissas
+  // is then in (1/2, 2) and has quotient_shift or quotient_shift + 1 bits.
+  // Normal operands are already there.
+  auto a_mant = static_cast<dividend_type>(a.mantissa);
+  auto b_mant = static_cast<dividend_type>(b.mantissa);
+  int a_shift = 0;
+  int b_shift = 0;
+  if constexpr (!traits::normal_operands) {
+    a_shift = traits::lead_position + 1 -
+              detail::bit_width<operand_bits>(a.mantissa);
+    b_shift = traits::lead_position + 1 -
+              detail::bit_width<operand_bits>(b.mantissa);
+    a_mant = static_cast<dividend_type>(a_mant << a_shift);
+    b_mant = static_cast<dividend_type>(b_mant << b_shift);
+  }
+
+  const auto dividend =
+      static_cast<dividend_type>(a_mant << traits::quotient_shift);
+  const auto quotient = static_cast<dividend_type>(dividend / b_mant);
+  const bool sticky = static_cast<dividend_type>(dividend % b_mant) != 0;
+
+  const auto exponent = static_cast<exponent_type>(
+      traits::effective_exponent(a) - a_shift - traits::effective_exponent(b) +
+      b_shift - traits::quotient_shift + traits::bias + traits::lead_position);
+
+  return detail::normalize<Format, RoundingPolicy, DenormalPolicy,
+                           traits::dividend_bits>(
+      sign, exponent, quotient, sticky);
+}
+
+} // namespace opine::inline v1
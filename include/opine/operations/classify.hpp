@@ -0,0 +1,256 @@
+#pragma once
+
+#include <opine/core/unpacked.hpp>
+
+namespace opine::inline v1 {
+
+// Classification of unpacked values
+//
+// IEEE 754 encoding rules: an all-ones exponent field is infinity (mantissa
+// zero) or NaN (mantissa nonzero), a zero exponent field is zero (mantissa
+// zero) or a denormal. Only the stored mantissa bits are examined; the
+// implicit and guard bits do not take part in the classification.
+//
+// Formats with other special-value encodings (Format::special_values, see
+// policies/special_values.hpp) are classified by theirs: without infinities
+// is_inf() is the constant false, without NaNs is_nan() is, so every branch
+// on them folds away; a FiniteNaN format's NaN is the all-ones exponent and
+// mantissa, an FNUZ format's NaN is the -0 encoding (sign set, exponent and
+// mantissa zero).
+//
+// Under a denormal policy that flushes inputs, every value with a zero
+// exponent field is zero: there are no denormal operands.
+
+namespace detail {
+
+template <typename Format> constexpr auto exp_all_ones() {
+  return static_cast<typename Format::exponent_type>((1 << Format::exp_bits) -
+                                                     1);
+}
+
+template <typename Format>
+constexpr auto special_encoding = Format::special_values::encoding;
+
+// True for the default IEEE 754 behaviour: Inf and NaN in the all-ones
+// exponent, signed zeros, overflow as the rounding policy decides
+template <typename Format>
+constexpr bool has_ieee_specials =
+    special_encoding<Format> ==
+        special_value_policies::SpecialValueEncoding::IEEE &&
+    !Format::special_values::saturate;
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr bool stored_mantissa_is_zero(
+    const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  constexpr auto stored_mask =
+      UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>::stored_bits_mask();
+  return (value.mantissa & stored_mask) == 0;
+}
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr bool stored_mantissa_is_all_ones(
+    const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  constexpr auto stored_mask =
+      UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>::stored_bits_mask();
+  return (value.mantissa & stored_mask) == stored_mask;
+}
+
+} // namespace detail
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr bool
+is_nan(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  using enum special_value_policies::SpecialValueEncoding;
+  constexpr auto encoding = detail::special_encoding<Format>;
+  if constexpr (encoding == IEEE) {
+    return value.exponent == detail::exp_all_ones<Format>() &&
+           !detail::stored_mantissa_is_zero(value);
+  } else if constexpr (encoding == FiniteNaN) {
+    return value.exponent == detail::exp_all_ones<Format>() &&
+           detail::stored_mantissa_is_all_ones(value);
+  } else if constexpr (encoding == FNUZ) {
+    return value.sign && value.exponent == 0 && value.mantissa == 0;
+  } else {
+    return false;
+  }
+}
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr bool
+is_inf(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  if constexpr (Format::special_values::has_infinity) {
+    return value.exponent == detail::exp_all_ones<Format>() &&
+           detail::stored_mantissa_is_zero(value);
+  } else {
+    return false;
+  }
+}
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr bool
+is_finite(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  if constexpr (Format::special_values::has_infinity) {
+    return value.exponent != detail::exp_all_ones<Format>();
+  } else {
+    return !is_nan(value);
+  }
+}
+
+// Zero: exponent field 0 and no mantissa bits at all (a value whose only
+// nonzero bits are guard bits is a tiny unrounded result, not zero). Without
+// -0 the sign must be clear: sign set is the NaN encoding.
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr bool
+is_zero(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  if constexpr (!Format::special_values::has_negative_zero) {
+    return value.exponent == 0 && !is_nan(value) &&
+           (DenormalPolicy::flush_inputs || value.mantissa == 0);
+  } else if constexpr (DenormalPolicy::flush_inputs) {
+    return value.exponent == 0;
+  } else {
+    return value.exponent == 0 && value.mantissa == 0;
+  }
+}
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr bool is_denormal(
+    const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  if constexpr (DenormalPolicy::flush_inputs) {
+    return false;
+  } else {
+    return value.exponent == 0 && value.mantissa != 0;
+  }
+}
+
+namespace detail {
+
+// Special values and limits of a format, as unpacked values
+//
+// The largest finite value is the all-ones mantissa in the highest binade
+// that holds finite values: below the all-ones exponent for IEEE formats, in
+// it for the others (one below the all-ones mantissa for FiniteNaN, whose
+// all-ones mantissa is NaN).
+
+template <typename Format> constexpr int max_finite_exponent() {
+  constexpr bool reserved_binade =
+      special_encoding<Format> ==
+      special_value_policies::SpecialValueEncoding::IEEE;
+  return (1 << Format::exp_bits) - (reserved_binade ? 2 : 1);
+}
+
+template <typename Format> constexpr auto max_finite_mantissa() {
+  using rounded_type = rounding_policies::rounded_mantissa_t<Format>;
+  constexpr auto all_ones =
+      static_cast<rounded_type>((rounded_type{1} << Format::mant_bits) - 1);
+  return special_encoding<Format> ==
+                 special_value_policies::SpecialValueEncoding::FiniteNaN
+             ? static_cast<rounded_type>(all_ones - 1)
+             : all_ones;
+}
+
+// True if the biased exponent and stored mantissa bits (after rounding, with
+// the carry added to the exponent) are beyond the largest finite value
+template <typename Format>
+constexpr bool
+exceeds_largest_finite(int exponent,
+                       rounding_policies::rounded_mantissa_t<Format> stored) {
+  return exponent > max_finite_exponent<Format>() ||
+         (exponent == max_finite_exponent<Format>() &&
+          stored > max_finite_mantissa<Format>());
+}
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+largest_finite(bool sign) {
+  using unpacked_type = UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>;
+  using mantissa_type = typename unpacked_type::mantissa_type;
+  unpacked_type result{};
+  result.sign = sign;
+  result.exponent = static_cast<typename Format::exponent_type>(
+      max_finite_exponent<Format>());
+  result.mantissa = static_cast<mantissa_type>(
+      unpacked_type::implicit_bit_mask() |
+      static_cast<mantissa_type>(
+          static_cast<mantissa_type>(max_finite_mantissa<Format>())
+          << RoundingPolicy::guard_bits));
+  return result;
+}
+
+// Zero of the given sign; +0 in a format without -0
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+signed_zero(bool sign) {
+  UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> result{};
+  result.sign = sign && Format::special_values::has_negative_zero;
+  return result;
+}
+
+// Quiet NaN of the given sign (FNUZ has one NaN, with the sign set); +0 in a
+// format without NaN
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+quiet_nan(bool sign) {
+  using enum special_value_policies::SpecialValueEncoding;
+  using unpacked_type = UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>;
+  using mantissa_type = typename unpacked_type::mantissa_type;
+  constexpr auto encoding = special_encoding<Format>;
+
+  unpacked_type result{};
+  if constexpr (encoding == IEEE) {
+    constexpr auto quiet_bit = static_cast<mantissa_type>(
+        mantissa_type{1}
+        << (Format::mant_bits - 1 + RoundingPolicy::guard_bits));
+    result.sign = sign;
+    result.exponent = exp_all_ones<Format>();
+    result.mantissa = static_cast<mantissa_type>(
+        unpacked_type::implicit_bit_mask() | quiet_bit);
+  } else if constexpr (encoding == FiniteNaN) {
+    result.sign = sign;
+    result.exponent = exp_all_ones<Format>();
+    result.mantissa = static_cast<mantissa_type>(
+        unpacked_type::implicit_bit_mask() | unpacked_type::stored_bits_mask());
+  } else if constexpr (encoding == FNUZ) {
+    result.sign = true;
+  }
+  return result;
+}
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+overflow_value(bool sign);
+
+// Signed infinity; overflow_value() in a format without infinities (x / 0)
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+infinity(bool sign) {
+  using unpacked_type = UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>;
+  if constexpr (Format::special_values::has_infinity) {
+    unpacked_type result{};
+    result.sign = sign;
+    result.exponent = exp_all_ones<Format>();
+    result.mantissa = unpacked_type::implicit_bit_mask();
+    return result;
+  } else {
+    return overflow_value<Format, RoundingPolicy, DenormalPolicy>(sign);
+  }
+}
+
+// Result of a finite overflow that is not rounded to the largest finite
+// value: infinity, or NaN without infinities; the largest finite value when
+// the format saturates
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+overflow_value(bool sign) {
+  using specials = typename Format::special_values;
+  if constexpr (specials::saturate) {
+    return largest_finite<Format, RoundingPolicy, DenormalPolicy>(sign);
+  } else if constexpr (specials::has_infinity) {
+    return infinity<Format, RoundingPolicy, DenormalPolicy>(sign);
+  } else {
+    return quiet_nan<Format, RoundingPolicy, DenormalPolicy>(sign);
+  }
+}
+
+} // namespace detail
+
+} // namespace opine::inline v1
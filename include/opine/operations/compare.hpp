@@ -0,0 +1,51 @@
+#pragma once
+
+#include <compare>
+#include <opine/core/unpacked.hpp>
+#include <opine/operations/classify.hpp>
+
+namespace opine::inline v1 {
+
+// Comparison of unpacked values
+//
+// IEEE 754 ordering: NaN is unordered with every value (itself included),
+// -0 == +0, and otherwise values order by sign and then magnitude. Unpacked
+// magnitudes order like their (exponent, mantissa) pairs: mantissas are
+// normalized except at exponent 0, infinity has the all-ones exponent, and
+// the guard bits of an unrounded result take part as value bits.
+//
+// Only the special values the format has are tested for: without NaN the
+// result is never unordered and no NaN test is generated, and without -0
+// (and without input flushing, which makes every zero exponent a zero) the
+// only zero is +0, which needs no test either.
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr std::partial_ordering
+compare(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &a,
+        const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &b) {
+  if constexpr (Format::special_values::has_nan) {
+    if (is_nan(a) || is_nan(b)) {
+      return std::partial_ordering::unordered;
+    }
+  }
+  if constexpr (Format::special_values::has_negative_zero ||
+                DenormalPolicy::flush_inputs) {
+    if (is_zero(a) && is_zero(b)) {
+      return std::partial_ordering::equivalent;
+    }
+  }
+
+  if (a.sign != b.sign) {
+    return a.sign ? std::partial_ordering::less
+                  : std::partial_ordering::greater;
+  }
+  if (a.exponent == b.exponent && a.mantissa == b.mantissa) {
+    return std::partial_ordering::equivalent;
+  }
+  const bool smaller_magnitude = a.exponent != b.exponent
+                                     ? a.exponent < b.exponent
+                                     : a.mantissa < b.mantissa;
+  return smaller_magnitude != a.sign ? std::partial_ordering::less
+                                     : std::partial_ordering::greater;
+}
+
+} // namespace opine::inline v1
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <cstdint>
+#include <opine/core/unpacked.hpp>
+#include <opine/operations/classify.hpp>
+#include <opine/operations/normalize.hpp>
+#include <opine/operations/pack_unpack.hpp>
+#include <opine/policies/conversion.hpp>
+#include <opine/policies/instrumentation.hpp>
+#include <type_traits>
+
+namespace opine::inline v1 {
+
+// Conversion between formats
+//
+// The pipeline of design.md section 7 on UnpackedFloat values:
+//
+//   1. Unpack the source (storage-level convert() only)
+//   2. Map special values: Inf to Inf, NaN to the quiet NaN (sign kept),
+//      signed zero to signed zero; to a destination without them, Inf to
+//      its overflow value, NaN to +0 and -0 to +0
+//   3. Rebias the exponent and hand the exact source significand to
+//      normalize(), which widens it by shifting or narrows it to the
+//      destination mantissa plus guard bits with sticky, producing
+//      denormals below the destination's normal range
+//   4. Round with the conversion policy's rounding policy (round(), or
+//      pack() for the storage-level convert()), including the carry into
+//      the exponent
+//   5. Out of range: the rounding policy picks infinity (NaN for formats
+//      without infinities) or the largest finite value; a saturating
+//      conversion policy, or a saturating destination format, always clips
+//      finite inputs to the largest finite value
+//
+// Bulk conversion with faster strategies (bit manipulation for exact
+// widening, lookup tables for small formats) is in convert_n.hpp; it gives
+// the same results.
+
+namespace detail {
+
+// Convert an unpacked value to another format, unrounded
+//
+// The result is normalized to Dst's unpacked layout like an arithmetic
+// result: exact when Dst has the range and precision (widening), otherwise
+// carrying Dst's guard bits with sticky for the rounding policy to round.
+// Src guard bits (an unrounded Src result) are taken as value bits. NaN
+// becomes Dst's quiet NaN with the sign kept, Inf Dst's infinity (its
+// overflow value when Dst has none).
+//
+// Finite values are multiplied by 2^scale_exponent on the way, exactly (the
+// microscaling block scale; 0 for a plain conversion).
+template <typename Dst, typename DstRoundingPolicy, typename Src,
+          typename SrcRoundingPolicy>
+constexpr UnpackedFloat<Dst, DstRoundingPolicy>
+convert_unpacked(const UnpackedFloat<Src, SrcRoundingPolicy> &value,
+                 int scale_exponent = 0) {
+  static_assert(Src::has_implicit_bit && Dst::has_implicit_bit,
+                "Conversion requires formats with an implicit bit");
+
+  using src_type = UnpackedFloat<Src, SrcRoundingPolicy>;
+  constexpr int significand_bits = src_type::mantissa_bits;
+  using significand_type =
+      uint_t<significand_bits, typename Dst::type_policy>;
+
+  // Inf and NaN
+  if (!is_finite(value)) {
+    return is_nan(value)
+               ? quiet_nan<Dst, DstRoundingPolicy,
+                           denormal_policies::DefaultDenormalPolicy>(value.sign)
+               : infinity<Dst, DstRoundingPolicy,
+                          denormal_policies::DefaultDenormalPolicy>(value.sign);
+  }
+
+  // Signed zero
+  if (is_zero(value)) {
+    return signed_zero<Dst, DstRoundingPolicy,
+                       denormal_policies::DefaultDenormalPolicy>(value.sign);
+  }
+
+  // value = mantissa * 2^(max(exponent, 1) - Src::exp_bias - Src::mant_bits
+  // - Src G), which is normalize()'s scale for the Dst exponent below
+  const int src_exp =
+      value.exponent != 0 ? static_cast<int>(value.exponent) : 1;
+  const int exponent = src_exp - Src::exp_bias - Src::mant_bits -
+                       SrcRoundingPolicy::guard_bits + Dst::exp_bias +
+                       Dst::mant_bits + DstRoundingPolicy::guard_bits +
+                       scale_exponent;
+
+  return normalize<Dst, DstRoundingPolicy,
+                   denormal_policies::DefaultDenormalPolicy, significand_bits>(
+      value.sign, exponent, static_cast<significand_type>(value.mantissa),
+      false);
+}
+
+// Hand a batch of counts to ConversionPolicy's instrumentation policy;
+// nothing for uninstrumented policies and under constant evaluation
+template <typename ConversionPolicy>
+constexpr void record_counts(
+    [[maybe_unused]] const instrumentation_policies::EventCounts &counts) {
+  if constexpr (conversion_policies::is_instrumented<ConversionPolicy>) {
+    if (!std::is_constant_evaluated()) {
+      conversion_policies::instrumentation_policy_t<ConversionPolicy>::record(
+          counts);
+    }
+  }
+}
+
+// True if value * 2^scale_exponent overflows Dst: rounded to Dst's precision
+// with an unbounded exponent range, it is beyond the largest finite value
+// (IEEE 754 section 7.4); value is finite and nonzero, rounded its rounded
+// conversion
+//
+// Values from the next binade up overflow; in the binade of the largest
+// finite value, those above it overflow when they round away from it
+// (round() gives the overflow value), which a saturating format does not
+// show, so there every value above it counts.
+template <typename Dst, typename Src, typename SrcRoundingPolicy,
+          typename RoundingPolicy>
+constexpr bool
+conversion_overflows(const UnpackedFloat<Src, SrcRoundingPolicy> &value,
+                     int scale_exponent,
+                     const UnpackedFloat<Dst, RoundingPolicy> &rounded) {
+  using src_type = UnpackedFloat<Src, SrcRoundingPolicy>;
+  constexpr int largest_width = Dst::mant_bits + 1;
+  constexpr int largest_lead = max_finite_exponent<Dst>() - Dst::exp_bias;
+  constexpr auto largest =
+      (std::uint64_t{1} << Dst::mant_bits) |
+      static_cast<std::uint64_t>(max_finite_mantissa<Dst>());
+  static_assert(largest_width <= 64,
+                "Event counting needs Dst significands of at most 64 bits");
+
+  const auto mantissa = value.mantissa;
+  const int width = bit_width<src_type::mantissa_bits>(mantissa);
+  const int src_exp =
+      value.exponent != 0 ? static_cast<int>(value.exponent) : 1;
+  const int lead = width - 1 + src_exp - Src::exp_bias - Src::mant_bits -
+                   SrcRoundingPolicy::guard_bits + scale_exponent;
+  if (lead != largest_lead) {
+    return lead > largest_lead;
+  }
+
+  bool above = false;
+  if (width <= largest_width) {
+    above = (static_cast<std::uint64_t>(mantissa) << (largest_width - width)) >
+            largest;
+  } else {
+    const int shift = width - largest_width;
+    const auto top = mantissa >> shift;
+    const auto leading = static_cast<std::uint64_t>(top);
+    above = leading > largest ||
+            (leading == largest &&
+             static_cast<decltype(mantissa)>(top << shift) != mantissa);
+  }
+  return above && (Dst::special_values::saturate || !is_finite(rounded));
+}
+
+// Count the events of converting value (times 2^scale_exponent) to Dst:
+// unrounded is convert_unpacked()'s result, rounded its round() and result
+// the converted value
+//
+// Rounding events are read off rounded rather than by rounding again, so a
+// stateful (stochastic) rounding policy rounds each value once.
+template <typename Dst, typename Src, typename SrcRoundingPolicy,
+          typename RoundingPolicy>
+constexpr void
+count_conversion(const UnpackedFloat<Src, SrcRoundingPolicy> &value,
+                 int scale_exponent,
+                 const UnpackedFloat<Dst, RoundingPolicy> &unrounded,
+                 const UnpackedFloat<Dst, RoundingPolicy> &rounded,
+                 const UnpackedFloat<Dst, RoundingPolicy> &result,
+                 instrumentation_policies::EventCounts &counts) {
+  constexpr int guard_bits = RoundingPolicy::guard_bits;
+
+  ++counts.conversions;
+  if (!is_finite(value)) {
+    ++(is_nan(value) ? counts.nan_inputs : counts.inf_inputs);
+    return;
+  }
+  if (is_zero(value)) {
+    return;
+  }
+  counts.denormal_inputs += is_denormal(value);
+
+  if (conversion_overflows<Dst>(value, scale_exponent, rounded)) {
+    ++counts.overflows;
+    counts.saturations += is_finite(result);
+    return;
+  }
+
+  const bool carry = rounded.exponent != unrounded.exponent;
+  counts.carries += carry;
+  counts.round_ups +=
+      carry ||
+      rounding_policies::detail::stored_bits<Dst, guard_bits>(
+          rounded.mantissa) !=
+          rounding_policies::detail::stored_bits<Dst, guard_bits>(
+              unrounded.mantissa);
+  counts.underflows += is_zero(result);
+  counts.denormal_outputs += is_denormal(result);
+}
+
+// value * 2^scale_exponent in Dst, rounded (and saturated) by
+// ConversionPolicy; when ConversionPolicy is instrumented, its events are
+// added to counts
+template <typename Dst, typename ConversionPolicy, typename Src,
+          typename SrcRoundingPolicy>
+constexpr UnpackedFloat<Dst, typename ConversionPolicy::rounding_policy>
+convert_scaled(const UnpackedFloat<Src, SrcRoundingPolicy> &value,
+               int scale_exponent,
+               [[maybe_unused]] instrumentation_policies::EventCounts &counts) {
+  using rounding_policy = typename ConversionPolicy::rounding_policy;
+
+  const auto unrounded =
+      convert_unpacked<Dst, rounding_policy>(value, scale_exponent);
+  const auto rounded = opine::round(unrounded);
+  auto result = rounded;
+  if constexpr (ConversionPolicy::saturate) {
+    if (!is_finite(result) && is_finite(value)) {
+      result = largest_finite<Dst, rounding_policy,
+                              denormal_policies::DefaultDenormalPolicy>(
+          value.sign);
+    }
+  }
+  if constexpr (conversion_policies::is_instrumented<ConversionPolicy>) {
+    count_conversion(value, scale_exponent, unrounded, rounded, result,
+                     counts);
+  }
+  return result;
+}
+
+// value * 2^scale_exponent in Dst, rounded (and saturated) by
+// ConversionPolicy; an instrumented conversion records its events
+template <typename Dst, typename ConversionPolicy, typename Src,
+          typename SrcRoundingPolicy>
+constexpr UnpackedFloat<Dst, typename ConversionPolicy::rounding_policy>
+convert_scaled(const UnpackedFloat<Src, SrcRoundingPolicy> &value,
+               int scale_exponent) {
+  instrumentation_policies::EventCounts counts;
+  const auto result =
+      convert_scaled<Dst, ConversionPolicy>(value, scale_exponent, counts);
+  record_counts<ConversionPolicy>(counts);
+  return result;
+}
+
+} // namespace detail
+
+// Convert an unpacked value to the Dst format, rounded by ConversionPolicy
+template <typename Dst,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename Src, typename SrcRoundingPolicy>
+constexpr UnpackedFloat<Dst, typename ConversionPolicy::rounding_policy>
+convert(const UnpackedFloat<Src, SrcRoundingPolicy> &value) {
+  return detail::convert_scaled<Dst, ConversionPolicy>(value, 0);
+}
+
+// Convert a Src storage value to a Dst storage value
+template <typename Dst, typename Src,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy>
+constexpr typename Dst::storage_type
+convert(typename Src::storage_type bits) {
+  using rounding_policy = typename ConversionPolicy::rounding_policy;
+  return pack<Dst, rounding_policy>(convert<Dst, ConversionPolicy>(
+      unpack<Src, rounding_policy>(bits)));
+}
+
+} // namespace opine::inline v1
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <opine/operations/convert.hpp>
+#include <opine/operations/lookup.hpp>
+#include <opine/operations/normalize.hpp>
+#include <opine/policies/conversion.hpp>
+#include <opine/policies/instrumentation.hpp>
+#include <opine/policies/table.hpp>
+#include <span>
+
+namespace opine::inline v1 {
+
+// Bulk conversion between formats
+//
+// convert_n() converts a span of Src storage values to Dst, with the same
+// results as calling convert() on each element, through the fastest strategy
+// the formats and TablePolicy allow (chosen at compile time):
+//
+//   Widen      Every Src value is exactly representable in Dst
+//              (fp16 -> fp32, fp8 -> fp16). Pure bit manipulation: rebias
+//              the exponent and shift the mantissa; only Src denormals need a
+//              leading-zero count. No rounding decision exists.
+//   Encode     Narrowing whose encode_index fits max_table_bits (fp16 -> fp8,
+//              fp32 -> fp8 with LargeTables). One load from a table indexed
+//              by the value class (sign, exponent, rounding-relevant bits).
+//   Direct     Src::total_bits <= max_table_bits (fp8 -> anything, e.g.
+//              fp8_e4m3 -> fp8_e5m2). One load from a table indexed by the
+//              Src bits; used when no smaller encode table exists.
+//   Compute    Everything else: convert() per element. Always used for
+//              stochastic rounding, whose results cannot be tabulated, and
+//              for instrumented conversion policies, which count each
+//              conversion's events (recorded once per call).
+//
+// conversion_strategy<Src, Dst, ConversionPolicy, TablePolicy> names the
+// strategy.
+
+enum class ConversionStrategy { Widen, Direct, Encode, Compute };
+
+namespace detail {
+
+// True if every finite Src value, denormals included, is a normal Dst value
+// with the same bits of significand (so conversion is exact and the
+// rounding and conversion policies cannot matter), and both formats have
+// IEEE special-value encodings, which widen_bits() maps field by field
+template <typename Src, typename Dst>
+constexpr bool is_exact_widening =
+    special_encoding<Src> ==
+        special_value_policies::SpecialValueEncoding::IEEE &&
+    special_encoding<Dst> ==
+        special_value_policies::SpecialValueEncoding::IEEE &&
+    Src::has_implicit_bit && Dst::has_implicit_bit &&
+    Src::sign_bits == 1 && Dst::sign_bits == 1 &&
+    Dst::mant_bits >= Src::mant_bits &&
+    // Smallest Src denormal is at least the smallest Dst normal
+    1 - Dst::exp_bias <= 1 - Src::exp_bias - Src::mant_bits &&
+    // Largest Src binade is at most the largest Dst binade
+    ((1 << Src::exp_bits) - 2) - Src::exp_bias <=
+        ((1 << Dst::exp_bits) - 2) - Dst::exp_bias;
+
+// Exact widening by field manipulation
+//
+// Normal values: rebias the exponent, shift the mantissa up. Denormals:
+// their leading bit becomes the implicit bit of a normal Dst value. Zero
+// keeps its sign, Inf stays Inf, NaN becomes Dst's quiet NaN (sign kept;
+// payload dropped, as convert() does).
+template <typename Src, typename Dst>
+constexpr typename Dst::storage_type
+widen_bits(typename Src::storage_type bits) {
+  using dst_storage = typename Dst::storage_type;
+  constexpr int shift = Dst::mant_bits - Src::mant_bits;
+  constexpr int src_exp_max = (1 << Src::exp_bits) - 1;
+  constexpr int dst_exp_max = (1 << Dst::exp_bits) - 1;
+  constexpr int rebias = Dst::exp_bias - Src::exp_bias;
+  constexpr auto src_mant_mask =
+      (typename Src::storage_type{1} << Src::mant_bits) - 1;
+
+  const bool sign = extract_sign<Src>(bits);
+  const int exp = static_cast<int>(extract_exponent<Src>(bits));
+  auto mant = static_cast<dst_storage>((bits >> Src::mant_offset) &
+                                       src_mant_mask);
+
+  int dst_exp = exp + rebias;
+  if (exp == src_exp_max) {
+    dst_exp = dst_exp_max;
+    mant = mant != 0 ? dst_storage{1} << (Src::mant_bits - 1) : 0;
+  } else if (exp == 0) {
+    if (mant == 0) {
+      dst_exp = 0;
+    } else {
+      // Shift the leading bit up to the implicit bit position
+      const int normalize_shift =
+          Src::mant_bits + 1 - bit_width<Src::mant_bits>(mant);
+      dst_exp = 1 + rebias - normalize_shift;
+      mant = static_cast<dst_storage>((mant << normalize_shift) &
+                                      src_mant_mask);
+    }
+  }
+
+  return static_cast<dst_storage>(
+      (static_cast<dst_storage>(sign) << Dst::sign_offset) |
+      (static_cast<dst_storage>(dst_exp) << Dst::exp_offset) |
+      (static_cast<dst_storage>(mant << shift) << Dst::mant_offset));
+}
+
+} // namespace detail
+
+template <typename Src, typename Dst,
+          typename ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy>
+constexpr ConversionStrategy conversion_strategy =
+    conversion_policies::is_instrumented<ConversionPolicy>
+        ? ConversionStrategy::Compute
+    : detail::is_exact_widening<Src, Dst> ? ConversionStrategy::Widen
+    : rounding_policies::is_stochastic<
+          typename ConversionPolicy::rounding_policy>
+        ? ConversionStrategy::Compute
+    : has_encode_table<Src, Dst, TablePolicy> &&
+            detail::encode_index<Src, Dst>::bits < Src::total_bits
+        ? ConversionStrategy::Encode
+    : Src::total_bits <= TablePolicy::max_table_bits
+        ? ConversionStrategy::Direct
+        : ConversionStrategy::Compute;
+
+// Bulk convert: convert min(src.size(), dst.size()) values, return the count
+template <typename Dst, typename Src,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy>
+constexpr std::size_t convert_n(std::span<const typename Src::storage_type> src,
+                                std::span<typename Dst::storage_type> dst) {
+  constexpr auto strategy =
+      conversion_strategy<Src, Dst, ConversionPolicy, TablePolicy>;
+  using rounding_policy = typename ConversionPolicy::rounding_policy;
+  const std::size_t n = std::min(src.size(), dst.size());
+
+  if constexpr (conversion_policies::is_instrumented<ConversionPolicy>) {
+    // One batch of counts for the call
+    instrumentation_policies::EventCounts counts;
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] = pack<Dst, rounding_policy>(
+          detail::convert_scaled<Dst, ConversionPolicy>(
+              unpack<Src, rounding_policy>(src[i]), 0, counts));
+    }
+    detail::record_counts<ConversionPolicy>(counts);
+    return n;
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    if constexpr (strategy == ConversionStrategy::Widen) {
+      dst[i] = detail::widen_bits<Src, Dst>(src[i]);
+    } else if constexpr (strategy == ConversionStrategy::Direct) {
+      dst[i] = direct_conversion_table<Src, Dst, ConversionPolicy>
+          [detail::decode_index<Src>(src[i])];
+    } else if constexpr (strategy == ConversionStrategy::Encode) {
+      dst[i] = conversion_table<Src, Dst, ConversionPolicy>
+          [detail::encode_index<Src, Dst>::of(src[i])];
+    } else {
+      dst[i] = convert<Dst, Src, ConversionPolicy>(src[i]);
+    }
+  }
+
+  return n;
+}
+
+} // namespace opine::inline v1
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <opine/core/unpacked.hpp>
+#include <opine/operations/accumulator.hpp>
+#include <opine/operations/arithmetic.hpp>
+#include <opine/operations/convert.hpp>
+#include <opine/operations/normalize.hpp>
+#include <opine/operations/pack_unpack.hpp>
+#include <opine/operations/pack_unpack_n.hpp>
+#include <span>
+#include <vector>
+
+namespace opine::inline v1 {
+
+// Mixed-precision dot product and matrix-vector product
+//
+// Inputs of any two formats (e.g. fp8 weights and fp16 activations) are
+// reduced in a wider accumulator format (e.g. fp32):
+//
+//   1. Inputs are unpacked in blocks of dot_block_size with unpack_n() and
+//      converted to the accumulator format, once per element
+//   2. Each product is accumulated with fma() on UnpackedFloat values:
+//      acc = round(a[i] * b[i] + acc), one rounding per element
+//   3. Only the final sum is packed
+//
+// The accumulator is rounded to AccumFormat after every element, so results
+// are bit-identical to an fma loop in AccumFormat hardware (for fp32, a loop
+// of std::fma on float starting from +0), and independent of the block size.
+// Inputs that are not exactly representable in AccumFormat are rounded to it
+// first; normally AccumFormat is at least as wide as both input formats.
+//
+// dot_exact() and gemv_exact() instead sum the products exactly in an
+// ExactAccumulator (operations/accumulator.hpp) and round once into
+// AccumFormat: the correctly rounded dot product, independent of the order
+// of the products, and therefore of how a parallel or split-K caller
+// partitions them (opine/parallel.hpp).
+
+// Number of input elements unpacked per batch
+inline constexpr std::size_t dot_block_size = 64;
+
+namespace detail {
+
+// Unpack up to dot_block_size values and convert them to the accumulator
+// format (rounded, like every accumulator value)
+template <typename AccumFormat, typename Format, typename RoundingPolicy>
+constexpr std::size_t unpack_block(
+    std::span<const typename Format::storage_type> bits,
+    std::span<UnpackedFloat<AccumFormat, RoundingPolicy>, dot_block_size>
+        out) {
+  const std::size_t n = std::min(bits.size(), dot_block_size);
+
+  std::array<bool, dot_block_size> sign{};
+  std::array<typename Format::exponent_type, dot_block_size> exponent{};
+  std::array<unpacked_mantissa_t<Format, RoundingPolicy>, dot_block_size>
+      mantissa{};
+  unpack_n<Format, RoundingPolicy>(bits.first(n), sign, exponent, mantissa);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    UnpackedFloat<Format, RoundingPolicy> value{};
+    value.sign = sign[i];
+    value.exponent = exponent[i];
+    value.mantissa = mantissa[i];
+    out[i] = round(convert_unpacked<AccumFormat, RoundingPolicy>(value));
+  }
+
+  return n;
+}
+
+} // namespace detail
+
+// Dot product of two spans, accumulated and returned in AccumFormat
+//
+// The number of products is the smaller of the two span sizes. An empty dot
+// product is +0.
+template <typename AccumFormat, typename FormatA, typename FormatB,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+constexpr typename AccumFormat::storage_type
+dot(std::span<const typename FormatA::storage_type> a,
+    std::span<const typename FormatB::storage_type> b) {
+  using accum_type = UnpackedFloat<AccumFormat, RoundingPolicy>;
+  const std::size_t n = std::min(a.size(), b.size());
+
+  accum_type acc{};
+  std::array<accum_type, dot_block_size> a_block{};
+  std::array<accum_type, dot_block_size> b_block{};
+
+  for (std::size_t start = 0; start < n; start += dot_block_size) {
+    const std::size_t count = std::min(dot_block_size, n - start);
+    detail::unpack_block<AccumFormat, FormatA, RoundingPolicy>(
+        a.subspan(start, count), a_block);
+    detail::unpack_block<AccumFormat, FormatB, RoundingPolicy>(
+        b.subspan(start, count), b_block);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      acc = round(fma(a_block[i], b_block[i], acc));
+    }
+  }
+
+  return pack<AccumFormat, RoundingPolicy>(acc);
+}
+
+// Matrix-vector product y = W x, accumulated and returned in AccumFormat
+//
+// matrix is row-major with x.size() columns. The number of rows is the
+// smaller of y.size() and the number of complete rows in matrix; it is
+// returned.
+//
+// x is unpacked once, one column block at a time; each block is then applied
+// to every row while it is hot, with one unpacked accumulator per row. Each
+// y[r] is bit-identical to dot() of row r with x.
+template <typename AccumFormat, typename FormatW, typename FormatX,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+constexpr std::size_t
+gemv(std::span<const typename FormatW::storage_type> matrix,
+     std::span<const typename FormatX::storage_type> x,
+     std::span<typename AccumFormat::storage_type> y) {
+  using accum_type = UnpackedFloat<AccumFormat, RoundingPolicy>;
+  const std::size_t cols = x.size();
+  const std::size_t rows =
+      cols == 0 ? y.size() : std::min(y.size(), matrix.size() / cols);
+
+  std::vector<accum_type> acc(rows, accum_type{});
+  std::array<accum_type, dot_block_size> x_block{};
+  std::array<accum_type, dot_block_size> w_block{};
+
+  for (std::size_t start = 0; start < cols; start += dot_block_size) {
+    const std::size_t count = std::min(dot_block_size, cols - start);
+    detail::unpack_block<AccumFormat, FormatX, RoundingPolicy>(
+        x.subspan(start, count), x_block);
+
+    for (std::size_t r = 0; r < rows; ++r) {
+      detail::unpack_block<AccumFormat, FormatW, RoundingPolicy>(
+          matrix.subspan(r * cols + start, count), w_block);
+      for (std::size_t i = 0; i < count; ++i) {
+        acc[r] = round(fma(w_block[i], x_block[i], acc[r]));
+      }
+    }
+  }
+
+  for (std::size_t r = 0; r < rows; ++r) {
+    y[r] = pack<AccumFormat, RoundingPolicy>(acc[r]);
+  }
+  return rows;
+}
+
+// Dot product of two spans, summed exactly and rounded once into AccumFormat
+//
+// The number of products is the smaller of the two span sizes. An empty dot
+// product is +0.
+template <typename AccumFormat, typename FormatA, typename FormatB,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+constexpr typename AccumFormat::storage_type
+dot_exact(std::span<const typename FormatA::storage_type> a,
+          std::span<const typename FormatB::storage_type> b) {
+  ExactAccumulator<FormatA, FormatB> acc;
+  acc.add_products(a, b);
+  return pack(acc.template value<AccumFormat, RoundingPolicy>());
+}
+
+// Matrix-vector product y = W x, each row summed exactly and rounded once
+// into AccumFormat; matrix and the returned row count as for gemv(), and
+// each y[r] equals dot_exact() of row r with x
+template <typename AccumFormat, typename FormatW, typename FormatX,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+constexpr std::size_t
+gemv_exact(std::span<const typename FormatW::storage_type> matrix,
+           std::span<const typename FormatX::storage_type> x,
+           std::span<typename AccumFormat::storage_type> y) {
+  const std::size_t cols = x.size();
+  const std::size_t rows =
+      cols == 0 ? y.size() : std::min(y.size(), matrix.size() / cols);
+
+  for (std::size_t r = 0; r < rows; ++r) {
+    y[r] = dot_exact<AccumFormat, FormatW, FormatX, RoundingPolicy>(
+        matrix.subspan(r * cols, cols), x);
+  }
+  return rows;
+}
+
+} // namespace opine::inline v1
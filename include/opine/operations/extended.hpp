@@ -0,0 +1,514 @@
+#pragma once
+
+#include <algorithm>
+#include <opine/core/extended.hpp>
+#include <opine/operations/arithmetic.hpp>
+#include <opine/operations/classify.hpp>
+#include <opine/operations/multiply_integers.hpp>
+#include <opine/operations/normalize.hpp>
+#include <opine/operations/pack_unpack.hpp>
+#include <opine/policies/multiply.hpp>
+
+namespace opine::inline v1 {
+
+// Arithmetic on extended values (core/extended.hpp)
+//
+// add(), subtract(), multiply(), divide() and fma() on ExtendedFloat compute
+// the same exact, unrounded results as their UnpackedFloat versions
+// (operations/arithmetic.hpp), with the same special-value rules, but never
+// re-bias an exponent, never shift into the denormal range and never check
+// for overflow: a result only needs its leading bit moved back to the
+// implicit bit position. The format's range is applied once, when the value
+// is converted back (to_unpacked(), pack()).
+//
+// A single operation packs to the same bits as the UnpackedFloat operation.
+// A chain packs to the same bits as long as no intermediate leaves the
+// format's normal range; otherwise it is more accurate (an intermediate
+// overflow can come back into range, an intermediate denormal keeps all its
+// bits).
+
+// Classification
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr bool
+is_nan(const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  return value.kind == FloatClass::NaN;
+}
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr bool
+is_inf(const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  return value.kind == FloatClass::Infinite;
+}
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr bool
+is_zero(const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  return value.kind == FloatClass::Zero;
+}
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr bool
+is_finite(const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  return value.kind == FloatClass::Zero || value.kind == FloatClass::Finite;
+}
+
+// Extended value of an unpacked value: the exponent unbiased, a denormal
+// mantissa shifted up to the implicit bit position
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>
+extend(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  using extended_type = ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>;
+  using mantissa_type = typename extended_type::mantissa_type;
+  using exponent_type = typename extended_type::exponent_type;
+
+  extended_type result{};
+  result.sign = value.sign;
+  if (is_nan(value)) {
+    result.kind = FloatClass::NaN;
+    result.mantissa = value.mantissa;
+  } else if (is_inf(value)) {
+    result.kind = FloatClass::Infinite;
+  } else if (is_zero(value)) {
+    result.kind = FloatClass::Zero;
+  } else {
+    result.kind = FloatClass::Finite;
+    int shift = 0;
+    if constexpr (!DenormalPolicy::flush_inputs) {
+      if (value.exponent == 0) {
+        shift = extended_type::lead_position + 1 -
+                detail::bit_width<extended_type::mantissa_bits>(
+                    value.mantissa);
+      }
+    }
+    const int exponent = value.exponent == 0 ? 1 : value.exponent;
+    result.exponent =
+        static_cast<exponent_type>(exponent - Format::exp_bias - shift);
+    result.mantissa =
+        static_cast<mantissa_type>(value.mantissa << shift);
+  }
+  return result;
+}
+
+// Unpacked value of an extended value: the format's range applied, as by
+// every UnpackedFloat operation (overflow, denormal results, flushing), but
+// not rounded. to_unpacked(extend(x)) == x, except that a denormal x is
+// flushed when the denormal policy flushes outputs.
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+to_unpacked(
+    const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  using extended_type = ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>;
+  using exponent_type = typename extended_type::exponent_type;
+
+  switch (value.kind) {
+  case FloatClass::Zero:
+    return detail::signed_zero<Format, RoundingPolicy, DenormalPolicy>(
+        value.sign);
+  case FloatClass::Infinite:
+    return detail::infinity<Format, RoundingPolicy, DenormalPolicy>(
+        value.sign);
+  case FloatClass::NaN:
+    if constexpr (detail::special_encoding<Format> ==
+                  special_value_policies::SpecialValueEncoding::IEEE) {
+      UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> nan{};
+      nan.sign = value.sign;
+      nan.exponent = detail::exp_all_ones<Format>();
+      nan.mantissa = value.mantissa;
+      return nan;
+    } else {
+      return detail::quiet_nan<Format, RoundingPolicy, DenormalPolicy>(
+          value.sign);
+    }
+  case FloatClass::Finite:
+    break;
+  }
+  return detail::normalize<Format, RoundingPolicy, DenormalPolicy,
+                           extended_type::mantissa_bits>(
+      value.sign,
+      static_cast<exponent_type>(value.exponent + Format::exp_bias),
+      value.mantissa, false);
+}
+
+// Unpack straight to an extended value
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>
+unpack_extended(typename Format::storage_type bits) {
+  return extend(unpack<Format, RoundingPolicy, DenormalPolicy>(bits));
+}
+
+// Pack an extended value: range checks, then the rounding of pack()
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr typename Format::storage_type
+pack(const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  return pack(to_unpacked(value));
+}
+
+// Round an extended value to the precision and range of its format, as
+// round() does for unpacked values
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>
+round(const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  return extend(round(to_unpacked(value)));
+}
+
+namespace detail {
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+struct extended_traits {
+  using extended_type = ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>;
+  using mantissa_type = typename extended_type::mantissa_type;
+  using exponent_type = typename extended_type::exponent_type;
+  using type_policy = typename Format::type_policy;
+  using unpacked_traits =
+      arithmetic_traits<Format, RoundingPolicy, DenormalPolicy>;
+
+  static constexpr int operand_bits = extended_type::mantissa_bits;
+  static constexpr int lead_position = extended_type::lead_position;
+  static constexpr int guard_bits = RoundingPolicy::guard_bits;
+
+  // Special results are the UnpackedFloat ones, extended, so formats with
+  // other special values get their own (no infinity, no NaN, no -0)
+  static constexpr extended_type zero(bool sign) {
+    return extend(unpacked_traits::zero(sign));
+  }
+  static constexpr extended_type infinity(bool sign) {
+    return extend(unpacked_traits::infinity(sign));
+  }
+  static constexpr extended_type default_nan() {
+    return extend(unpacked_traits::default_nan());
+  }
+  static constexpr extended_type quiet(extended_type nan) {
+    if constexpr (special_encoding<Format> ==
+                  special_value_policies::SpecialValueEncoding::IEEE) {
+      nan.mantissa = static_cast<mantissa_type>(
+          nan.mantissa | static_cast<mantissa_type>(mantissa_type{1}
+                                                    << (lead_position - 1)));
+      return nan;
+    } else {
+      return extend(
+          quiet_nan<Format, RoundingPolicy, DenormalPolicy>(nan.sign));
+    }
+  }
+};
+
+// Extended value of (mantissa + sticky * epsilon) * 2^(exponent -
+// lead_position), mantissa nonzero: the leading bit moved to lead_position,
+// bits shifted out ORed into the lowest guard bit. No range checks.
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy,
+          int WideBits, typename Exponent>
+constexpr ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>
+normalize_extended(bool sign, Exponent exponent,
+                   uint_t<WideBits, typename Format::type_policy> mantissa,
+                   bool sticky) {
+  using traits = extended_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using mantissa_type = typename traits::mantissa_type;
+  using exponent_type = typename traits::exponent_type;
+  constexpr int work_bits = std::max(WideBits, traits::operand_bits);
+  using work_type = uint_t<work_bits, typename Format::type_policy>;
+  const auto work = static_cast<work_type>(mantissa);
+
+  const int shift =
+      bit_width<WideBits>(mantissa) - 1 - traits::lead_position;
+  work_type shifted = 0;
+  if (shift <= 0) {
+    shifted = static_cast<work_type>(work << -shift);
+  } else {
+    shifted = static_cast<work_type>(work >> shift);
+    sticky = sticky ||
+             static_cast<work_type>(work & ((work_type{1} << shift) - 1)) != 0;
+  }
+  if constexpr (traits::guard_bits > 0) {
+    if (sticky) {
+      shifted = static_cast<work_type>(shifted | work_type{1});
+    }
+  }
+
+  ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> result{};
+  result.kind = FloatClass::Finite;
+  result.sign = sign;
+  result.exponent = static_cast<exponent_type>(exponent + shift);
+  result.mantissa = static_cast<mantissa_type>(shifted);
+  return result;
+}
+
+// Add two finite significands of the same width, not both zero, in the
+// convention of normalize_extended(); as add_significands(), a larger
+// exponent must mean a larger magnitude
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy,
+          int Bits, typename Exponent>
+constexpr ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>
+add_extended_significands(bool a_sign, Exponent a_exp,
+                          uint_t<Bits, typename Format::type_policy> a_mant,
+                          bool b_sign, Exponent b_exp,
+                          uint_t<Bits, typename Format::type_policy> b_mant) {
+  using traits = extended_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using unpacked_traits = typename traits::unpacked_traits;
+  constexpr int align_bits = unpacked_traits::align_bits;
+  constexpr int sum_bits = Bits + align_bits + 1;
+  using sum_type = uint_t<sum_bits, typename Format::type_policy>;
+
+  const bool swap = b_exp > a_exp || (b_exp == a_exp && b_mant > a_mant);
+  const bool big_sign = swap ? b_sign : a_sign;
+  const bool small_sign = swap ? a_sign : b_sign;
+  const Exponent big_exp = swap ? b_exp : a_exp;
+  const auto distance =
+      static_cast<Exponent>(swap ? b_exp - a_exp : a_exp - b_exp);
+
+  const auto big_mant = static_cast<sum_type>(
+      static_cast<sum_type>(swap ? b_mant : a_mant) << align_bits);
+  auto small_mant = static_cast<sum_type>(
+      static_cast<sum_type>(swap ? a_mant : b_mant) << align_bits);
+  if (distance >= sum_bits) {
+    small_mant = small_mant != 0 ? sum_type{1} : sum_type{0};
+  } else if (distance > 0) {
+    const int shift = static_cast<int>(distance);
+    const auto lost =
+        static_cast<sum_type>(small_mant & ((sum_type{1} << shift) - 1));
+    small_mant = static_cast<sum_type>(small_mant >> shift);
+    if (lost != 0) {
+      small_mant = static_cast<sum_type>(small_mant | sum_type{1});
+    }
+  }
+
+  const auto sum = static_cast<sum_type>(big_sign == small_sign
+                                             ? big_mant + small_mant
+                                             : big_mant - small_mant);
+  if (sum == 0) {
+    return traits::zero(unpacked_traits::negative_zero_sum);
+  }
+  return normalize_extended<Format, RoundingPolicy, DenormalPolicy,
+                            sum_bits>(
+      big_sign, static_cast<Exponent>(big_exp - align_bits), sum, false);
+}
+
+} // namespace detail
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>
+add(const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &a,
+    const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &b) {
+  using traits =
+      detail::extended_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using unpacked_traits = typename traits::unpacked_traits;
+
+  if (is_nan(a)) {
+    return traits::quiet(a);
+  }
+  if (is_nan(b)) {
+    return traits::quiet(b);
+  }
+  if (is_inf(a)) {
+    return is_inf(b) && a.sign != b.sign ? traits::default_nan() : a;
+  }
+  if (is_inf(b)) {
+    return b;
+  }
+  if (is_zero(a) || is_zero(b)) {
+    if (is_zero(a) && is_zero(b)) {
+      return traits::zero(unpacked_traits::negative_zero_sum
+                              ? a.sign || b.sign
+                              : a.sign && b.sign);
+    }
+    return is_zero(a) ? b : a;
+  }
+
+  return detail::add_extended_significands<Format, RoundingPolicy,
+                                           DenormalPolicy,
+                                           traits::operand_bits>(
+      a.sign, a.exponent, a.mantissa, b.sign, b.exponent, b.mantissa);
+}
+
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>
+subtract(const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &a,
+         const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &b) {
+  if constexpr (!Format::special_values::has_negative_zero) {
+    // As for unpacked values: a - 0 = a + 0, a NaN b propagates either way
+    if (is_nan(b) || is_zero(b)) {
+      return add(a, b);
+    }
+  }
+  auto negated = b;
+  negated.sign = !b.sign;
+  return add(a, negated);
+}
+
+// The exact significand product is in [1, 4): its leading bit is one of two
+// known positions, so no leading zero count is needed
+template <typename Format, typename RoundingPolicy,
+          multiply_policies::MultiplyPolicy MultiplyPolicy =
+              multiply_policies::DefaultMultiplyPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>
+multiply(const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &a,
+         const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &b) {
+  using traits =
+      detail::extended_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using type_policy = typename traits::type_policy;
+  using mantissa_type = typename traits::mantissa_type;
+  using exponent_type = typename traits::exponent_type;
+  constexpr int operand_bits = traits::operand_bits;
+  constexpr int product_bits = 2 * operand_bits;
+  using product_type = uint_t<product_bits, type_policy>;
+
+  const bool sign = a.sign != b.sign;
+
+  if (is_nan(a)) {
+    return traits::quiet(a);
+  }
+  if (is_nan(b)) {
+    return traits::quiet(b);
+  }
+  if (is_inf(a) || is_inf(b)) {
+    return is_zero(a) || is_zero(b) ? traits::default_nan()
+                                    : traits::infinity(sign);
+  }
+  if (is_zero(a) || is_zero(b)) {
+    return traits::zero(sign);
+  }
+
+  const auto product = static_cast<product_type>(
+      detail::multiply_integers<operand_bits, operand_bits, MultiplyPolicy,
+                                type_policy>(a.mantissa, b.mantissa));
+  // The carry is used as a number, not tested: with random significands a
+  // branch on it is mispredicted half the time
+  const int carry = static_cast<int>(product >> (product_bits - 1));
+  const int shift = traits::lead_position + carry;
+
+  ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> result{};
+  result.kind = FloatClass::Finite;
+  result.sign = sign;
+  result.exponent =
+      static_cast<exponent_type>(a.exponent + b.exponent + carry);
+  result.mantissa = static_cast<mantissa_type>(product >> shift);
+  if constexpr (traits::guard_bits > 0) {
+    const auto lost = static_cast<product_type>(
+        product & static_cast<product_type>((product_type{1} << shift) - 1));
+    if (lost != 0) {
+      result.mantissa =
+          static_cast<mantissa_type>(result.mantissa | mantissa_type{1});
+    }
+  }
+  return result;
+}
+
+// Fused multiply-add with a single rounding, as fma() on unpacked values
+template <typename Format, typename RoundingPolicy,
+          multiply_policies::MultiplyPolicy MultiplyPolicy =
+              multiply_policies::DefaultMultiplyPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>
+fma(const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &a,
+    const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &b,
+    const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &c) {
+  using traits =
+      detail::extended_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using type_policy = typename traits::type_policy;
+  using exponent_type = typename traits::exponent_type;
+  constexpr int operand_bits = traits::operand_bits;
+  constexpr int product_bits = 2 * operand_bits;
+  using product_type = uint_t<product_bits, type_policy>;
+
+  const bool product_sign = a.sign != b.sign;
+
+  if (is_nan(a)) {
+    return traits::quiet(a);
+  }
+  if (is_nan(b)) {
+    return traits::quiet(b);
+  }
+  if (is_nan(c)) {
+    return traits::quiet(c);
+  }
+  if (is_inf(a) || is_inf(b)) {
+    if (is_zero(a) || is_zero(b) ||
+        (is_inf(c) && c.sign != product_sign)) {
+      return traits::default_nan();
+    }
+    return traits::infinity(product_sign);
+  }
+  if (is_inf(c)) {
+    return c;
+  }
+  if (is_zero(a) || is_zero(b)) {
+    return add(traits::zero(product_sign), c);
+  }
+  if (is_zero(c)) {
+    return multiply<Format, RoundingPolicy, MultiplyPolicy>(a, b);
+  }
+
+  // Left-justify the exact product and c in product_bits: the product of
+  // two significands in [1, 2) is in [1, 4), c has its leading bit at
+  // lead_position
+  auto product = static_cast<product_type>(
+      detail::multiply_integers<operand_bits, operand_bits, MultiplyPolicy,
+                                type_policy>(a.mantissa, b.mantissa));
+  const int product_shift =
+      1 - static_cast<int>(product >> (product_bits - 1));
+  product = static_cast<product_type>(product << product_shift);
+  const auto product_exp = static_cast<exponent_type>(
+      a.exponent + b.exponent - traits::lead_position - product_shift);
+
+  constexpr int addend_shift = product_bits - operand_bits;
+  const auto addend = static_cast<product_type>(
+      static_cast<product_type>(c.mantissa) << addend_shift);
+  const auto addend_exp =
+      static_cast<exponent_type>(c.exponent - addend_shift);
+
+  return detail::add_extended_significands<Format, RoundingPolicy,
+                                           DenormalPolicy, product_bits>(
+      product_sign, product_exp, product, c.sign, addend_exp, addend);
+}
+
+// Divide: both significands are normalized, so the quotient of the
+// mantissas is in (1/2, 2) with no operand shifts
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr ExtendedFloat<Format, RoundingPolicy, DenormalPolicy>
+divide(const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &a,
+       const ExtendedFloat<Format, RoundingPolicy, DenormalPolicy> &b) {
+  using traits =
+      detail::extended_traits<Format, RoundingPolicy, DenormalPolicy>;
+  using unpacked_traits = typename traits::unpacked_traits;
+  using dividend_type = typename unpacked_traits::dividend_type;
+  using exponent_type = typename traits::exponent_type;
+
+  const bool sign = a.sign != b.sign;
+
+  if (is_nan(a)) {
+    return traits::quiet(a);
+  }
+  if (is_nan(b)) {
+    return traits::quiet(b);
+  }
+  if (is_inf(a)) {
+    return is_inf(b) ? traits::default_nan() : traits::infinity(sign);
+  }
+  if (is_inf(b)) {
+    return traits::zero(sign);
+  }
+  if (is_zero(b)) {
+    return is_zero(a) ? traits::default_nan() : traits::infinity(sign);
+  }
+  if (is_zero(a)) {
+    return traits::zero(sign);
+  }
+
+  const auto dividend =
+      static_cast<dividend_type>(static_cast<dividend_type>(a.mantissa)
+                                 << unpacked_traits::quotient_shift);
+  const auto divisor = static_cast<dividend_type>(b.mantissa);
+  const auto quotient = static_cast<dividend_type>(dividend / divisor);
+  const bool sticky = static_cast<dividend_type>(dividend % divisor) != 0;
+
+  return detail::normalize_extended<Format, RoundingPolicy, DenormalPolicy,
+                                    unpacked_traits::dividend_bits>(
+      sign,
+      static_cast<exponent_type>(a.exponent - b.exponent -
+                                 unpacked_traits::quotient_shift +
+                                 traits::lead_position),
+      quotient, sticky);
+}
+
+} // namespace opine::inline v1
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <opine/operations/convert.hpp>
+#include <opine/operations/pack_unpack.hpp>
+#include <opine/operations/pack_unpack_n.hpp>
+#include <opine/policies/conversion.hpp>
+#include <opine/policies/table.hpp>
+#include <span>
+
+namespace opine::inline v1 {
+
+// Table-driven decode and encode
+//
+// Small formats have few enough encodings that any pure function of the
+// storage bits can be tabulated at compile time. Two tables are provided:
+//
+//   decode_table<Format, RoundingPolicy>
+//     One UnpackedFloat per encoding, built from unpack(). Indexed by the
+//     storage bits. 256 entries for fp8.
+//
+//   encode_table<Src, Dst, RoundingPolicy>
+//     The correctly rounded Dst encoding of each Src value, for narrowing a
+//     wider format (fp16, fp32) to a smaller one (fp8). Indexed by the Src
+//     sign, exponent, the Src mantissa bits that can influence rounding, and
+//     one sticky bit for the rest (see detail::encode_index below).
+//
+// The same two index schemes generate the conversion tables used by
+// convert_n() (operations/convert_n.hpp), rounded by a conversion policy.
+//
+// Whether a table is used is a compile-time strategy choice controlled by a
+// table policy (policies/table.hpp): decode() and encode() use the table when
+// its index fits in TablePolicy::max_table_bits and compute the result bit by
+// bit otherwise. Both strategies return identical results; the table trades
+// ROM for latency. The tables are variable templates, so a table is only
+// generated (and only occupies space) for configurations that use it.
+
+// True if decode() uses a table for this format under TablePolicy
+template <typename Format,
+          typename TablePolicy = table_policies::DefaultTablePolicy>
+constexpr bool has_decode_table =
+    Format::total_bits <= TablePolicy::max_table_bits;
+
+namespace detail {
+
+template <typename Format, typename RoundingPolicy>
+constexpr auto make_decode_table() {
+  using storage_type = typename Format::storage_type;
+  constexpr std::size_t size = std::size_t{1} << Format::total_bits;
+
+  std::array<UnpackedFloat<Format, RoundingPolicy>, size> table{};
+  for (std::size_t i = 0; i < size; ++i) {
+    table[i] = unpack<Format, RoundingPolicy>(static_cast<storage_type>(i));
+  }
+  return table;
+}
+
+// Table index for a storage value (bits above total_bits are ignored, as
+// unpack() ignores them)
+template <typename Format>
+constexpr std::size_t decode_index(typename Format::storage_type bits) {
+  constexpr std::size_t index_mask = (std::size_t{1} << Format::total_bits) - 1;
+  return static_cast<std::size_t>(bits) & index_mask;
+}
+
+} // namespace detail
+
+// Decode table: decode_table<Format, RoundingPolicy>[bits] == unpack(bits)
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+inline constexpr auto decode_table =
+    detail::make_decode_table<Format, RoundingPolicy>();
+
+// Unpack a value, by table lookup when the table fits TablePolicy
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy>
+decode(typename Format::storage_type bits) {
+  if constexpr (has_decode_table<Format, TablePolicy>) {
+    return decode_table<Format, RoundingPolicy>[detail::decode_index<Format>(
+        bits)];
+  } else {
+    return unpack<Format, RoundingPolicy>(bits);
+  }
+}
+
+// Bulk decode into SoA buffers (same contract as unpack_n())
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy>
+constexpr std::size_t
+decode_n(std::span<const typename Format::storage_type> bits,
+         std::span<bool> sign,
+         std::span<typename Format::exponent_type> exponent,
+         std::span<unpacked_mantissa_t<Format, RoundingPolicy>> mantissa) {
+  if constexpr (has_decode_table<Format, TablePolicy>) {
+    const std::size_t n = std::min(
+        {bits.size(), sign.size(), exponent.size(), mantissa.size()});
+
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto &entry =
+          decode_table<Format, RoundingPolicy>[detail::decode_index<Format>(
+              bits[i])];
+      sign[i] = entry.sign;
+      exponent[i] = entry.exponent;
+      mantissa[i] = entry.mantissa;
+    }
+
+    return n;
+  } else {
+    return unpack_n<Format, RoundingPolicy>(bits, sign, exponent, mantissa);
+  }
+}
+
+namespace detail {
+
+// Reference encoder: correctly rounded conversion of one Src value to Dst
+//
+// The IEEE 754 conversion (overflow as the rounding policy decides, no
+// saturation) of convert.hpp. Every rounding policy and the rounding carry
+// behave exactly as they do for arithmetic results.
+template <typename Src, typename Dst, typename RoundingPolicy>
+constexpr typename Dst::storage_type
+encode_reference(typename Src::storage_type bits) {
+  using ieee_policy = conversion_policies::Conversion<RoundingPolicy, false>;
+  return convert<Dst, Src, ieee_policy>(bits);
+}
+
+// Encode table index: [sign][Src exponent][kept mantissa bits][sticky]
+//
+// Only the Src mantissa bits down to one below the Dst precision (the round
+// bit) can change the rounded result; everything below them matters only as
+// "zero or not", which is the sticky bit. This holds for every Dst binade,
+// including Dst denormals (which have even less precision), as long as the
+// Dst exponent range does not extend below the Src one (Dst::exp_bias is not
+// larger than Src::exp_bias), and as long as the dropped bits cannot tell a
+// Src NaN from a finite value (FiniteNaN's NaN is the all-ones mantissa).
+//
+// For fp16 -> fp8_e5m2 the index is 1 + 5 + 3 + 1 = 10 bits, for
+// fp32 -> fp8_e4m3 it is 1 + 8 + 4 + 1 = 14 bits.
+template <typename Src, typename Dst> struct encode_index {
+  static constexpr int kept_bits = std::min(Src::mant_bits, Dst::mant_bits + 1);
+  static constexpr int dropped_bits = Src::mant_bits - kept_bits;
+  static constexpr int sticky_bits = dropped_bits > 0 ? 1 : 0;
+  static constexpr int bits = 1 + Src::exp_bits + kept_bits + sticky_bits;
+
+  static constexpr bool exact =
+      Src::sign_bits == 1 && Dst::exp_bias <= Src::exp_bias &&
+      (dropped_bits == 0 ||
+       special_encoding<Src> !=
+           special_value_policies::SpecialValueEncoding::FiniteNaN);
+
+  using storage_type = typename Src::storage_type;
+
+  // Index of a Src storage value
+  static constexpr std::size_t of(storage_type value) {
+    constexpr std::size_t index_mask = (std::size_t{1} << bits) - 1;
+    constexpr auto dropped_mask = static_cast<storage_type>(
+        (storage_type{1} << dropped_bits) - 1);
+
+    std::size_t sticky = 0;
+    if constexpr (dropped_bits > 0) {
+      sticky = ((value >> Src::mant_offset) & dropped_mask) != 0 ? 1 : 0;
+    }
+
+    if constexpr (Src::is_standard_layout()) {
+      // Sign, exponent and kept mantissa bits are already contiguous
+      return ((static_cast<std::size_t>(value >> dropped_bits)
+               << sticky_bits) |
+              sticky) &
+             index_mask;
+    } else {
+      constexpr auto kept_mask =
+          static_cast<storage_type>((storage_type{1} << kept_bits) - 1);
+      const auto kept = static_cast<std::size_t>(
+          (value >> (Src::mant_offset + dropped_bits)) & kept_mask);
+      const auto exp =
+          static_cast<std::size_t>(extract_exponent<Src>(value));
+      const auto sign = static_cast<std::size_t>(extract_sign<Src>(value));
+      return (((((sign << Src::exp_bits) | exp) << kept_bits) | kept)
+              << sticky_bits) |
+             sticky;
+    }
+  }
+
+  // A Src storage value with the given index (dropped bits 0...01 if sticky)
+  static constexpr storage_type representative(std::size_t index) {
+    const std::size_t sticky = index & ((std::size_t{1} << sticky_bits) - 1);
+    index >>= sticky_bits;
+    const std::size_t kept = index & ((std::size_t{1} << kept_bits) - 1);
+    index >>= kept_bits;
+    const std::size_t exp = index & ((std::size_t{1} << Src::exp_bits) - 1);
+    const std::size_t sign = index >> Src::exp_bits;
+
+    const auto mant = static_cast<storage_type>(
+        (static_cast<storage_type>(kept) << dropped_bits) |
+        static_cast<storage_type>(sticky));
+    return static_cast<storage_type>(
+        (static_cast<storage_type>(sign) << Src::sign_offset) |
+        (static_cast<storage_type>(exp) << Src::exp_offset) |
+        (mant << Src::mant_offset));
+  }
+};
+
+template <typename Src, typename Dst, typename ConversionPolicy>
+constexpr auto make_encode_table() {
+  using index = encode_index<Src, Dst>;
+  constexpr std::size_t size = std::size_t{1} << index::bits;
+
+  std::array<typename Dst::storage_type, size> table{};
+  for (std::size_t i = 0; i < size; ++i) {
+    table[i] = convert<Dst, Src, ConversionPolicy>(index::representative(i));
+  }
+  return table;
+}
+
+template <typename Src, typename Dst, typename ConversionPolicy>
+constexpr auto make_direct_table() {
+  using storage_type = typename Src::storage_type;
+  constexpr std::size_t size = std::size_t{1} << Src::total_bits;
+
+  std::array<typename Dst::storage_type, size> table{};
+  for (std::size_t i = 0; i < size; ++i) {
+    table[i] =
+        convert<Dst, Src, ConversionPolicy>(static_cast<storage_type>(i));
+  }
+  return table;
+}
+
+} // namespace detail
+
+// True if encode() uses a table for this conversion under TablePolicy
+template <typename Src, typename Dst,
+          typename TablePolicy = table_policies::DefaultTablePolicy>
+constexpr bool has_encode_table =
+    detail::encode_index<Src, Dst>::exact &&
+    detail::encode_index<Src, Dst>::bits <= TablePolicy::max_table_bits;
+
+// Encode table: the Dst encoding of each Src value class, rounded with
+// RoundingPolicy
+template <typename Src, typename Dst,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+inline constexpr auto encode_table = detail::make_encode_table<
+    Src, Dst, conversion_policies::Conversion<RoundingPolicy, false>>();
+
+// Conversion tables for convert_n(), rounded (and saturated) as
+// ConversionPolicy says:
+//
+//   conversion_table<Src, Dst, ConversionPolicy>
+//     Indexed like encode_table (Src value classes), for narrowing
+//
+//   direct_conversion_table<Src, Dst, ConversionPolicy>
+//     Indexed by the Src storage bits, for any pair of formats; 256 entries
+//     for an fp8 source
+template <typename Src, typename Dst, typename ConversionPolicy>
+inline constexpr auto conversion_table =
+    detail::make_encode_table<Src, Dst, ConversionPolicy>();
+
+template <typename Src, typename Dst, typename ConversionPolicy>
+inline constexpr auto direct_conversion_table =
+    detail::make_direct_table<Src, Dst, ConversionPolicy>();
+
+// Convert a Src value to Dst, rounding with RoundingPolicy, by table lookup
+// when the table fits TablePolicy
+template <typename Src, typename Dst,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy>
+constexpr typename Dst::storage_type
+encode(typename Src::storage_type bits) {
+  if constexpr (has_encode_table<Src, Dst, TablePolicy>) {
+    return encode_table<Src, Dst, RoundingPolicy>[detail::encode_index<
+        Src, Dst>::of(bits)];
+  } else {
+    return detail::encode_reference<Src, Dst, RoundingPolicy>(bits);
+  }
+}
+
+// Bulk encode: convert min(src.size(), dst.size()) values, return the count
+template <typename Src, typename Dst,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy>
+constexpr std::size_t encode_n(std::span<const typename Src::storage_type> src,
+                               std::span<typename Dst::storage_type> dst) {
+  const std::size_t n = std::min(src.size(), dst.size());
+
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] = encode<Src, Dst, RoundingPolicy, TablePolicy>(src[i]);
+  }
+
+  return n;
+}
+
+} // namespace opine::inline v1
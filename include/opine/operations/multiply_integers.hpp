@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <opine/core/types.hpp>
+#include <opine/policies/multiply.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace opine::inline v1 {
+
+// Significand multiplication strategies
+//
+// multiply() and fma() need the exact product of two significands of
+// A and B bits. How to compute it depends on the platform (the multiply
+// policy, policies/multiply.hpp) and on the operand widths, and is decided
+// at compile time:
+//
+//   Hardware     a * b; a 64 x 64 -> 128-bit multiply instruction for
+//                WideUint products of operands up to 64 bits each.
+//   Table        The product is read from a constexpr-generated table indexed
+//                by (a << B) | b, when A + B <= max_table_bits. fp8_e5m2 with
+//                TowardZero multiplies 3-bit significands: 64 entries.
+//   ThreeShift   Shift-and-add with the product shifted right into the space
+//                the multiplier frees (Dr Jefyll's 6502 method, as in
+//                docs/reference/mulsf3.s): one shift of the combined
+//                register per multiplier bit, where the classic loop shifts
+//                both the multiplicand and the multiplier. For multipliers
+//                wider than 8 bits (fp16, 24-bit fp32 significands).
+//                Under a limbed type policy (type_policies::LimbWidth) it
+//                runs one multiplier limb at a time.
+//   ShiftAdd     Classic shift-and-add, for multipliers of up to 8 bits,
+//                where the ThreeShift register (A + B + 1 bits, for the
+//                carry) would need one more byte than the product.
+//
+// multiply_strategy<A, B, MultiplyPolicy> names the strategy.
+
+enum class MultiplyStrategy { Hardware, Table, ThreeShift, ShiftAdd };
+
+template <int BitsA, int BitsB,
+          multiply_policies::MultiplyPolicy MultiplyPolicy =
+              multiply_policies::DefaultMultiplyPolicy>
+constexpr MultiplyStrategy multiply_strategy =
+    MultiplyPolicy::has_hardware_multiply ? MultiplyStrategy::Hardware
+    : BitsA + BitsB <= MultiplyPolicy::max_table_bits
+        ? MultiplyStrategy::Table
+    : BitsB > 8 ? MultiplyStrategy::ThreeShift
+                : MultiplyStrategy::ShiftAdd;
+
+namespace detail {
+
+// Products of every A-bit by every B-bit operand, indexed by (a << B) | b,
+// in the narrowest type that holds them
+template <int BitsA, int BitsB> constexpr auto make_multiply_table() {
+  using entry_type = uint_t<BitsA + BitsB, type_policies::LeastWidth>;
+  constexpr std::size_t size = std::size_t{1} << (BitsA + BitsB);
+
+  std::array<entry_type, size> table{};
+  for (std::size_t a = 0; a < (std::size_t{1} << BitsA); ++a) {
+    for (std::size_t b = 0; b < (std::size_t{1} << BitsB); ++b) {
+      table[(a << BitsB) | b] = static_cast<entry_type>(a * b);
+    }
+  }
+  return table;
+}
+
+template <int BitsA, int BitsB>
+inline constexpr auto multiply_table = make_multiply_table<BitsA, BitsB>();
+
+// Classic shift-and-add: add the multiplicand, shifted left, for every set
+// multiplier bit
+template <int BitsA, int BitsB, typename TypePolicy>
+constexpr uint_t<BitsA + BitsB, TypePolicy>
+shift_add_multiply(uint_t<BitsA, TypePolicy> a, uint_t<BitsB, TypePolicy> b) {
+  using product_type = uint_t<BitsA + BitsB, TypePolicy>;
+
+  product_type product{0};
+  auto multiplicand = static_cast<product_type>(a);
+  auto multiplier = b;
+  for (int i = 0; i < BitsB; ++i) {
+    if ((multiplier & 1) != 0) {
+      product = static_cast<product_type>(product + multiplicand);
+    }
+    multiplicand = static_cast<product_type>(multiplicand << 1);
+    multiplier = static_cast<uint_t<BitsB, TypePolicy>>(multiplier >> 1);
+  }
+  return product;
+}
+
+// Three-shift multiply: one register holds [partial product | multiplier].
+// Each step tests the multiplier's low bit, adds the multiplicand to the top
+// half, and shifts the whole register right once; after B steps the
+// multiplier has been shifted out and the register is the product. The top
+// half can carry into one extra bit before the shift (the 6502 carry flag).
+template <int BitsA, int BitsB, typename TypePolicy>
+constexpr uint_t<BitsA + BitsB, TypePolicy>
+three_shift_multiply(uint_t<BitsA, TypePolicy> a,
+                     uint_t<BitsB, TypePolicy> b) {
+  using register_type = uint_t<BitsA + BitsB + 1, TypePolicy>;
+
+  const auto addend =
+      static_cast<register_type>(static_cast<register_type>(a) << BitsB);
+  auto product = static_cast<register_type>(b);
+  for (int i = 0; i < BitsB; ++i) {
+    if ((product & 1) != 0) {
+      product = static_cast<register_type>(product + addend);
+    }
+    product = static_cast<register_type>(product >> 1);
+  }
+  return static_cast<uint_t<BitsA + BitsB, TypePolicy>>(product);
+}
+
+// Three-shift multiply one multiplier limb at a time, for type policies that
+// size integers in limbs. The register holds [partial product | one limb]:
+// A + limb + 1 bits instead of A + B + 1. After the limb's steps it is the
+// partial product plus a times the limb, whose low limb is final and moves
+// to the product; the rest carries into the next limb. A 24 x 24-bit fp32
+// significand product in byte limbs shifts 5 bytes per step instead of 7.
+// The limbs are unrolled, so each lands in the product at a fixed offset.
+template <int BitsA, int BitsB, typename TypePolicy>
+constexpr uint_t<BitsA + BitsB, TypePolicy>
+limb_three_shift_multiply(uint_t<BitsA, TypePolicy> a,
+                          uint_t<BitsB, TypePolicy> b) {
+  constexpr int limb = type_policies::limb_bits<TypePolicy>;
+  constexpr int limbs = type_policies::limb_count<BitsB, TypePolicy>;
+  using product_type = uint_t<BitsA + BitsB, TypePolicy>;
+  using register_type = uint_t<BitsA + limb + 1, TypePolicy>;
+
+  product_type product{0};
+  register_type high{0};
+  auto multiply_limb = [&]<int Index>(std::integral_constant<int, Index>) {
+    constexpr int offset = Index * limb;
+    constexpr int steps = std::min(limb, BitsB - offset);
+    const auto addend =
+        static_cast<register_type>(static_cast<register_type>(a) << steps);
+    const auto digit = static_cast<register_type>(
+        static_cast<register_type>(b >> offset) &
+        static_cast<register_type>((register_type{1} << steps) - 1));
+
+    auto partial = static_cast<register_type>((high << steps) | digit);
+    for (int i = 0; i < steps; ++i) {
+      if ((partial & 1) != 0) {
+        partial = static_cast<register_type>(partial + addend);
+      }
+      partial = static_cast<register_type>(partial >> 1);
+    }
+
+    if constexpr (Index + 1 < limbs) {
+      const auto low = static_cast<register_type>(
+          partial & static_cast<register_type>((register_type{1} << limb) - 1));
+      product = static_cast<product_type>(
+          product | static_cast<product_type>(static_cast<product_type>(low)
+                                              << offset));
+      high = static_cast<register_type>(partial >> limb);
+    } else {
+      product = static_cast<product_type>(
+          product | static_cast<product_type>(
+                        static_cast<product_type>(partial) << offset));
+    }
+  };
+  [&]<int... Index>(std::integer_sequence<int, Index...>) {
+    (multiply_limb(std::integral_constant<int, Index>{}), ...);
+  }(std::make_integer_sequence<int, limbs>{});
+  return product;
+}
+
+// Exact product of an A-bit and a B-bit unsigned integer, computed with the
+// strategy the multiply policy selects
+template <int BitsA, int BitsB,
+          multiply_policies::MultiplyPolicy MultiplyPolicy =
+              multiply_policies::DefaultMultiplyPolicy,
+          typename TypePolicy = DefaultTypeSelectionPolicy,
+          MultiplyStrategy Strategy =
+              multiply_strategy<BitsA, BitsB, MultiplyPolicy>>
+constexpr uint_t<BitsA + BitsB, TypePolicy>
+multiply_integers(uint_t<BitsA, TypePolicy> a, uint_t<BitsB, TypePolicy> b) {
+  using product_type = uint_t<BitsA + BitsB, TypePolicy>;
+
+  if constexpr (Strategy == MultiplyStrategy::Hardware &&
+                is_wide_uint<product_type> && BitsA <= 64 && BitsB <= 64) {
+    // One 64 x 64 -> 128-bit multiply, not a multi-limb product
+    return multiply_wide<BitsA + BitsB>(static_cast<std::uint64_t>(a),
+                                        static_cast<std::uint64_t>(b));
+  } else if constexpr (Strategy == MultiplyStrategy::Hardware) {
+    return static_cast<product_type>(static_cast<product_type>(a) *
+                                     static_cast<product_type>(b));
+  } else if constexpr (Strategy == MultiplyStrategy::Table) {
+    const auto index = static_cast<std::size_t>(
+        (static_cast<std::size_t>(a) << BitsB) | static_cast<std::size_t>(b));
+    return static_cast<product_type>(multiply_table<BitsA, BitsB>[index]);
+  } else if constexpr (Strategy == MultiplyStrategy::ThreeShift &&
+                       type_policies::limb_count<BitsB, TypePolicy> > 1) {
+    return limb_three_shift_multiply<BitsA, BitsB, TypePolicy>(a, b);
+  } else if constexpr (Strategy == MultiplyStrategy::ThreeShift) {
+    return three_shift_multiply<BitsA, BitsB, TypePolicy>(a, b);
+  } else {
+    return shift_add_multiply<BitsA, BitsB, TypePolicy>(a, b);
+  }
+}
+
+} // namespace detail
+
+} // namespace opine::inline v1
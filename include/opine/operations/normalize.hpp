@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <opine/core/unpacked.hpp>
+#include <opine/operations/classify.hpp>
+
+namespace opine::inline v1 {
+
+namespace detail {
+
+// Number of bits needed to represent value (0 for 0)
+//
+// std::bit_width() only accepts the standard unsigned types, so OPINE's
+// integer types (which may be _BitInt(N)) are converted to the smallest
+// standard type that holds them first. Keeping the conversion narrow matters
+// on 8-bit targets, where a 64-bit count-leading-zeros is a library call.
+// WideUint (core/wide_uint.hpp) counts its own limbs.
+template <int Bits, typename T> constexpr int bit_width(T value) {
+  if constexpr (is_wide_uint<T>) {
+    return value.bit_width();
+  } else if constexpr (Bits <= 8) {
+    return std::bit_width(static_cast<std::uint8_t>(value));
+  } else if constexpr (Bits <= 16) {
+    return std::bit_width(static_cast<std::uint16_t>(value));
+  } else if constexpr (Bits <= 32) {
+    return std::bit_width(static_cast<std::uint32_t>(value));
+  } else if constexpr (Bits <= 64) {
+    return std::bit_width(static_cast<std::uint64_t>(value));
+  } else {
+    const auto high = value >> 64;
+    return high != 0 ? 64 + bit_width<Bits - 64>(high)
+                     : std::bit_width(static_cast<std::uint64_t>(value));
+  }
+}
+
+} // namespace detail
+
+// Round an unpacked value to the precision of its format
+//
+// Applies RoundingPolicy::round_mantissa() exactly as pack() does, but keeps
+// the result unpacked: the guard bits are cleared, the rounding carry moves
+// the value to the next binade, and the implicit bit is restored. So
+// pack(round(x)) == pack(x) and unpack(pack(x)) == round(x).
+//
+// Arithmetic results carry their guard bits unrounded so that a chain of
+// operations is rounded only once, when the result is packed. round() is for
+// callers that need IEEE 754 round-every-step semantics without packing.
+//
+// A denormal policy that flushes outputs rounds values in the denormal range
+// to signed zeros, as pack() does. In a format whose special values are not
+// the IEEE default, a finite value that rounds past the largest finite value
+// becomes the format's overflow value (NaN, or the largest finite value when
+// it saturates), and a zero result is +0 when the format has no -0.
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+round(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &value) {
+  using unpacked_type = UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>;
+  using mantissa_type = typename unpacked_type::mantissa_type;
+  using exponent_type = typename Format::exponent_type;
+  using rounded_type = rounding_policies::rounded_mantissa_t<Format>;
+
+  if constexpr (DenormalPolicy::flush_outputs) {
+    if (value.exponent == 0 && !is_nan(value)) {
+      return detail::signed_zero<Format, RoundingPolicy, DenormalPolicy>(
+          value.sign);
+    }
+  }
+
+  const rounded_type rounded = RoundingPolicy::template round_mantissa<Format>(
+      value.mantissa, value.sign);
+
+  constexpr auto mant_mask =
+      static_cast<rounded_type>((rounded_type{1} << Format::mant_bits) - 1);
+  const bool carry = (rounded >> Format::mant_bits) != 0;
+
+  unpacked_type result{};
+  result.sign = value.sign;
+  result.exponent =
+      static_cast<exponent_type>(value.exponent + (carry ? 1 : 0));
+  result.mantissa = static_cast<mantissa_type>(
+      static_cast<mantissa_type>(rounded & mant_mask)
+      << RoundingPolicy::guard_bits);
+  if constexpr (Format::has_implicit_bit) {
+    if (result.exponent != 0) {
+      result.mantissa = static_cast<mantissa_type>(
+          result.mantissa | unpacked_type::implicit_bit_mask());
+    }
+  }
+
+  if constexpr (!detail::has_ieee_specials<Format>) {
+    if (is_finite(value) &&
+        detail::exceeds_largest_finite<Format>(
+            static_cast<int>(value.exponent) + (carry ? 1 : 0),
+            static_cast<rounded_type>(rounded & mant_mask))) {
+      return detail::overflow_value<Format, RoundingPolicy, DenormalPolicy>(
+          value.sign);
+    }
+    if constexpr (!Format::special_values::has_negative_zero) {
+      if (result.exponent == 0 && result.mantissa == 0 && !is_nan(value)) {
+        result.sign = false;
+      }
+    }
+  }
+  return result;
+}
+
+namespace detail {
+
+// Result beyond the largest finite value
+//
+// Presented to the rounding policy as "just above the largest finite value"
+// (largest finite mantissa, all guard bits set): a policy that rounds it up
+// gets the format's overflow value (infinity for IEEE formats), the others
+// the largest finite value. A saturating format always gets the largest
+// finite value.
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+overflow(bool sign) {
+  using unpacked_type = UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>;
+  using mantissa_type = typename unpacked_type::mantissa_type;
+
+  const auto largest =
+      largest_finite<Format, RoundingPolicy, DenormalPolicy>(sign);
+  if constexpr (Format::special_values::saturate) {
+    return largest;
+  } else {
+    constexpr auto guard_mask = static_cast<mantissa_type>(
+        (mantissa_type{1} << RoundingPolicy::guard_bits) - 1);
+    const auto rounded = RoundingPolicy::template round_mantissa<Format>(
+        static_cast<mantissa_type>(largest.mantissa | guard_mask), sign);
+    return rounded != max_finite_mantissa<Format>()
+               ? overflow_value<Format, RoundingPolicy, DenormalPolicy>(sign)
+               : largest;
+  }
+}
+
+// Build a normalized UnpackedFloat from an exact intermediate result
+//
+// The intermediate is
+//
+//   (mantissa + sticky * epsilon) * 2^(exponent - exp_bias - mant_bits - G)
+//
+// i.e. `exponent` is the biased exponent the value would have if bit
+// mant_bits + G of `mantissa` were its leading (implicit) bit, and `sticky`
+// says whether nonzero bits were already lost below bit 0. For a value that
+// came straight from unpack(), exponent = max(exponent field, 1) and the
+// mantissa is unchanged, and normalize() returns the same value.
+//
+// The mantissa is shifted so that its leading bit lands on the implicit bit
+// position (or, below the normal range, so that the exponent field is 0 and
+// the value is a denormal). Bits shifted out are ORed into the lowest guard
+// bit as a sticky bit; with no guard bits they are simply truncated, which is
+// all TowardZero needs. The result is NOT rounded: the rounding policy sees
+// the guard bits when the value is packed (or passed to round()).
+//
+// A result beyond the largest finite value is resolved immediately by
+// overflow(), so each policy picks its own overflow result: infinity for
+// round-to-nearest, the largest finite value for TowardZero (for formats
+// without infinities, NaN or a saturated value as Format::special_values
+// says). A result below the normal range becomes a signed zero when
+// DenormalPolicy flushes outputs, and the denormal shift is not generated.
+//
+// mantissa must be nonzero. Exponent is any signed integer type wide enough
+// for the caller's exponent arithmetic.
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy,
+          int WideBits, typename Exponent>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
+normalize(bool sign, Exponent exponent,
+          uint_t<WideBits, typename Format::type_policy> mantissa,
+          bool sticky) {
+  using unpacked_type = UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>;
+  using mantissa_type = typename unpacked_type::mantissa_type;
+  using exponent_type = typename Format::exponent_type;
+  constexpr int guard_bits = RoundingPolicy::guard_bits;
+  constexpr int result_bits = unpacked_type::mantissa_bits;
+  constexpr int lead_position = Format::mant_bits + guard_bits;
+  constexpr int exp_max = (1 << Format::exp_bits) - 1;
+
+  // Wide enough for both the intermediate and the result
+  constexpr int work_bits = std::max(WideBits, result_bits);
+  using work_type = uint_t<work_bits, typename Format::type_policy>;
+  const auto work = static_cast<work_type>(mantissa);
+
+  unpacked_type result{};
+  result.sign = sign;
+
+  // Biased exponent of the leading bit
+  const int leading = bit_width<WideBits>(mantissa) - 1;
+  const auto result_exp =
+      static_cast<Exponent>(exponent + (leading - lead_position));
+
+  if (result_exp > max_finite_exponent<Format>()) {
+    return overflow<Format, RoundingPolicy, DenormalPolicy>(sign);
+  }
+
+  if constexpr (DenormalPolicy::flush_outputs) {
+    if (result_exp < 1) {
+      return signed_zero<Format, RoundingPolicy, DenormalPolicy>(sign);
+    }
+  }
+
+  // Below the normal range the value keeps the scale of exponent 1
+  const auto field_exp = result_exp >= 1 ? result_exp : Exponent{1};
+  const int shift = static_cast<int>(field_exp - exponent);
+
+  work_type shifted = 0;
+  if (shift <= 0) {
+    shifted = static_cast<work_type>(work << -shift);
+  } else if (shift < work_bits) {
+    shifted = static_cast<work_type>(work >> shift);
+    const auto lost =
+        static_cast<work_type>(work & ((work_type{1} << shift) - 1));
+    sticky = sticky || lost != 0;
+  } else {
+    sticky = true; // mantissa is nonzero, and all of it is below the result
+  }
+
+  if constexpr (guard_bits > 0) {
+    if (sticky) {
+      shifted = static_cast<work_type>(shifted | work_type{1});
+    }
+  }
+
+  result.exponent =
+      static_cast<exponent_type>(result_exp >= 1 ? result_exp : Exponent{0});
+  result.mantissa = static_cast<mantissa_type>(shifted);
+
+  if constexpr (!Format::special_values::has_negative_zero) {
+    // Everything shifted out (no guard bits to keep a sticky bit): the value
+    // truncated to zero, which is +0 here
+    if (result.exponent == 0 && result.mantissa == 0) {
+      result.sign = false;
+    }
+  }
+  if constexpr (special_encoding<Format> ==
+                special_value_policies::SpecialValueEncoding::FiniteNaN) {
+    // The all-ones mantissa of the top binade is NaN, so values there are
+    // beyond the largest finite value too
+    if (result_exp == exp_max && stored_mantissa_is_all_ones(result)) {
+      return overflow<Format, RoundingPolicy, DenormalPolicy>(sign);
+    }
+  }
+  return result;
+}
+
+} // namespace detail
+
+} // namespace opine::inline v1
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <opine/core/format.hpp>
+#include <opine/operations/classify.hpp>
+#include <opine/operations/pack_unpack.hpp>
+#include <span>
+
+namespace opine::inline v1 {
+
+// Ordering on storage bits
+//
+// Sign-magnitude encodings order like unsigned integers once the sign is
+// moved out of the way: a positive value gets the top bit of the key set,
+// a negative one has every bit of the key inverted, so that larger
+// magnitudes give smaller keys. Comparing two order keys is then one integer
+// comparison, with no unpacking:
+//
+//   -NaN < -Inf < -finite < -0 < +0 < +finite < +Inf < +NaN
+//
+// which is the totalOrder predicate of IEEE 754, 5.10 (NaN payloads order
+// by magnitude too). The key map is a bijection between encodings and keys,
+// so keys sort, deduplicate and radix-sort (they are plain unsigned integers
+// of 1 + exp_bits + mant_bits bits) like the values themselves, and
+// from_order_key() gives the encoding back.
+//
+// The special-value policy decides where the NaNs go (Format::special_values,
+// policies/special_values.hpp):
+//
+//   IEEE, FiniteNaN  negative NaNs below -Inf (or the most negative finite
+//                    value), positive NaNs above the largest value
+//   FNUZ             the one NaN is the -0 encoding; it takes key 0, below
+//                    every number, and the negative keys move up by one
+//   Finite           no NaN: every key is a number
+//
+// The reductions below (argmax_n(), max_n(), clamp_n(), top_k_n()) skip
+// NaNs, as IEEE 754 maximumNumber() does, and compare the numbers by their
+// keys: -0 is below +0. The keys order encodings, so the denormal policy
+// does not take part (a denormal is above zero even where it would be
+// flushed).
+//
+// For is_standard_layout() formats the key is the storage bits with a select
+// and an XOR; opine/platforms/simd/order.hpp has vector kernels of the same
+// functions with bit-identical results.
+
+// Unsigned key type of a format: the sign, exponent and mantissa fields with
+// no padding
+template <typename Format>
+using order_key_t = uint_t<1 + Format::exp_bits + Format::mant_bits,
+                           typename Format::type_policy>;
+
+namespace detail {
+
+template <typename Format>
+constexpr int order_key_bits = 1 + Format::exp_bits + Format::mant_bits;
+
+// The key bit that is set for +0 and every positive number
+template <typename Format>
+constexpr auto order_key_top = static_cast<order_key_t<Format>>(
+    order_key_t<Format>{1} << (order_key_bits<Format> - 1));
+
+template <typename Format>
+constexpr auto order_key_mask = static_cast<order_key_t<Format>>(
+    order_key_top<Format> | (order_key_top<Format> - 1));
+
+// Exponent and mantissa fields side by side, [E][M]
+template <typename Format>
+constexpr order_key_t<Format>
+order_magnitude(typename Format::storage_type bits) {
+  using key_type = order_key_t<Format>;
+  if constexpr (Format::is_standard_layout()) {
+    return static_cast<key_type>(static_cast<key_type>(bits) &
+                                 (order_key_top<Format> - 1));
+  } else {
+    using storage_type = typename Format::storage_type;
+    constexpr auto mant_mask =
+        static_cast<storage_type>((storage_type{1} << Format::mant_bits) - 1);
+    const auto exponent = static_cast<key_type>(extract_exponent<Format>(bits));
+    const auto mantissa =
+        static_cast<key_type>((bits >> Format::mant_offset) & mant_mask);
+    return static_cast<key_type>(
+        static_cast<key_type>(exponent << Format::mant_bits) | mantissa);
+  }
+}
+
+template <typename Format>
+constexpr order_key_t<Format> order_key_of(bool sign,
+                                           order_key_t<Format> magnitude) {
+  using key_type = order_key_t<Format>;
+  constexpr key_type top = order_key_top<Format>;
+  if constexpr (special_encoding<Format> ==
+                special_value_policies::SpecialValueEncoding::FNUZ) {
+    // -0 is the NaN: negative keys are top - magnitude, NaN wraps to 0
+    const auto negative =
+        static_cast<key_type>((top - magnitude) & (top - 1));
+    return sign ? negative : static_cast<key_type>(top | magnitude);
+  } else {
+    const key_type flip = sign ? order_key_mask<Format> : key_type{0};
+    return static_cast<key_type>(static_cast<key_type>(top | magnitude) ^
+                                 flip);
+  }
+}
+
+// Largest magnitude of a number: infinity, or the largest finite value
+template <typename Format> constexpr auto largest_order_magnitude() {
+  using key_type = order_key_t<Format>;
+  if constexpr (Format::special_values::has_infinity) {
+    return static_cast<key_type>(
+        static_cast<key_type>(exp_all_ones<Format>()) << Format::mant_bits);
+  } else {
+    return static_cast<key_type>(
+        static_cast<key_type>(static_cast<key_type>(
+                                  max_finite_exponent<Format>())
+                              << Format::mant_bits) |
+        static_cast<key_type>(max_finite_mantissa<Format>()));
+  }
+}
+
+// The keys of numbers (every encoding but the NaNs) are the range
+// [smallest_ordered_key, largest_ordered_key]
+template <typename Format>
+constexpr auto smallest_ordered_key =
+    order_key_of<Format>(true, largest_order_magnitude<Format>());
+
+template <typename Format>
+constexpr auto largest_ordered_key =
+    order_key_of<Format>(false, largest_order_magnitude<Format>());
+
+} // namespace detail
+
+// Order key of an encoding
+template <typename Format>
+constexpr order_key_t<Format> order_key(typename Format::storage_type bits) {
+  return detail::order_key_of<Format>(detail::extract_sign<Format>(bits),
+                                      detail::order_magnitude<Format>(bits));
+}
+
+// Encoding of an order key (padding bits zero)
+template <typename Format>
+constexpr typename Format::storage_type
+from_order_key(order_key_t<Format> key) {
+  using storage_type = typename Format::storage_type;
+  using key_type = order_key_t<Format>;
+  constexpr key_type top = detail::order_key_top<Format>;
+
+  const bool sign = (key & top) == 0;
+  key_type magnitude{};
+  if constexpr (detail::special_encoding<Format> ==
+                special_value_policies::SpecialValueEncoding::FNUZ) {
+    magnitude = sign ? static_cast<key_type>((top - key) & (top - 1))
+                     : static_cast<key_type>(key & (top - 1));
+  } else {
+    const key_type flip = sign ? detail::order_key_mask<Format> : key_type{0};
+    magnitude = static_cast<key_type>((key ^ flip) & (top - 1));
+  }
+
+  constexpr auto sign_field = static_cast<storage_type>(
+      ((storage_type{1} << Format::sign_bits) - 1) << Format::sign_offset);
+  constexpr auto mant_mask =
+      static_cast<key_type>((key_type{1} << Format::mant_bits) - 1);
+  const auto exponent =
+      static_cast<storage_type>(magnitude >> Format::mant_bits);
+  const auto mantissa = static_cast<storage_type>(magnitude & mant_mask);
+  return static_cast<storage_type>(
+      (sign ? sign_field : storage_type{0}) |
+      static_cast<storage_type>(exponent << Format::exp_offset) |
+      static_cast<storage_type>(mantissa << Format::mant_offset));
+}
+
+// True unless the key is a NaN's
+template <typename Format>
+constexpr bool is_ordered_key(order_key_t<Format> key) {
+  return key >= detail::smallest_ordered_key<Format> &&
+         key <= detail::largest_ordered_key<Format>;
+}
+
+// Order keys of a span of encodings; processes the smaller of the two span
+// sizes and returns that count
+template <typename Format>
+constexpr std::size_t
+order_keys_n(std::span<const typename Format::storage_type> bits,
+             std::span<order_key_t<Format>> keys) {
+  const std::size_t n = std::min(bits.size(), keys.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    keys[i] = order_key<Format>(bits[i]);
+  }
+  return n;
+}
+
+namespace detail {
+
+// Index of the first largest (Largest) or smallest number, bits.size() if
+// there is none
+template <typename Format, bool Largest>
+constexpr std::size_t
+arg_extreme_n(std::span<const typename Format::storage_type> bits) {
+  std::size_t index = bits.size();
+  order_key_t<Format> best{};
+  for (std::size_t i = 0; i < bits.size(); ++i) {
+    const auto key = order_key<Format>(bits[i]);
+    const bool better = Largest ? key > best : key < best;
+    if (is_ordered_key<Format>(key) && (index == bits.size() || better)) {
+      index = i;
+      best = key;
+    }
+  }
+  return index;
+}
+
+// Encoding returned by max_n() and min_n() when there is no number
+template <typename Format> constexpr typename Format::storage_type no_number() {
+  return pack(quiet_nan<Format, rounding_policies::DefaultRoundingPolicy,
+                        denormal_policies::DefaultDenormalPolicy>(false));
+}
+
+} // namespace detail
+
+// Index of the first largest number in the span; bits.size() when the span
+// is empty or all NaN
+template <typename Format>
+constexpr std::size_t
+argmax_n(std::span<const typename Format::storage_type> bits) {
+  return detail::arg_extreme_n<Format, true>(bits);
+}
+
+// Index of the first smallest number; bits.size() when there is none
+template <typename Format>
+constexpr std::size_t
+argmin_n(std::span<const typename Format::storage_type> bits) {
+  return detail::arg_extreme_n<Format, false>(bits);
+}
+
+// Largest number in the span; the format's quiet NaN (+0 in a format without
+// NaN) when there is none
+template <typename Format>
+constexpr typename Format::storage_type
+max_n(std::span<const typename Format::storage_type> bits) {
+  const std::size_t index = argmax_n<Format>(bits);
+  return index < bits.size() ? bits[index] : detail::no_number<Format>();
+}
+
+// Smallest number in the span; the format's quiet NaN (+0 without NaN) when
+// there is none
+template <typename Format>
+constexpr typename Format::storage_type
+min_n(std::span<const typename Format::storage_type> bits) {
+  const std::size_t index = argmin_n<Format>(bits);
+  return index < bits.size() ? bits[index] : detail::no_number<Format>();
+}
+
+// Clamp every number to [lo, hi] in the total order (lo and hi numbers,
+// lo <= hi): values below lo become lo, values above hi become hi, and
+// everything else, NaNs included, is copied. Processes the smaller of the
+// two span sizes and returns that count.
+template <typename Format>
+constexpr std::size_t
+clamp_n(std::span<const typename Format::storage_type> bits,
+        typename Format::storage_type lo, typename Format::storage_type hi,
+        std::span<typename Format::storage_type> out) {
+  const auto lo_key = order_key<Format>(lo);
+  const auto hi_key = order_key<Format>(hi);
+  const std::size_t n = std::min(bits.size(), out.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto key = order_key<Format>(bits[i]);
+    const bool ordered = is_ordered_key<Format>(key);
+    out[i] = ordered && key < lo_key   ? lo
+             : ordered && key > hi_key ? hi
+                                       : bits[i];
+  }
+  return n;
+}
+
+namespace detail {
+
+// Top-k selection, shared with the vector kernel
+//
+// The kept indices form a heap in the output span whose front is the worst
+// kept element, so a candidate only has to beat that one element's key.
+// Equal keys keep the lower index.
+template <typename Format> struct top_k_heap {
+  std::span<const typename Format::storage_type> bits;
+  std::span<std::size_t> indices;
+  std::size_t count = 0;
+
+  // True if element a comes before element b in the output
+  constexpr bool before(std::size_t a, std::size_t b) const {
+    const auto key_a = order_key<Format>(bits[a]);
+    const auto key_b = order_key<Format>(bits[b]);
+    return key_a != key_b ? key_a > key_b : a < b;
+  }
+
+  constexpr auto compare() const {
+    return [this](std::size_t a, std::size_t b) { return before(a, b); };
+  }
+
+  // Take numbers from the front of the span until k are kept; returns the
+  // index of the first element not looked at
+  constexpr std::size_t fill() {
+    std::size_t i = 0;
+    for (; i < bits.size() && count < indices.size(); ++i) {
+      if (is_ordered_key<Format>(order_key<Format>(bits[i]))) {
+        indices[count++] = i;
+        std::push_heap(indices.begin(), indices.begin() + count, compare());
+      }
+    }
+    return i;
+  }
+
+  // Key every new candidate must exceed (all k kept)
+  constexpr order_key_t<Format> threshold() const {
+    return order_key<Format>(bits[indices[0]]);
+  }
+
+  // Keep element i in place of the worst kept one if it is a larger number
+  constexpr void offer(std::size_t i) {
+    const auto key = order_key<Format>(bits[i]);
+    if (key > threshold() && is_ordered_key<Format>(key)) {
+      std::pop_heap(indices.begin(), indices.end(), compare());
+      indices.back() = i;
+      std::push_heap(indices.begin(), indices.end(), compare());
+    }
+  }
+
+  constexpr std::size_t finish() {
+    std::sort_heap(indices.begin(), indices.begin() + count, compare());
+    return count;
+  }
+};
+
+} // namespace detail
+
+// Indices of the k = indices.size() largest numbers of the span, largest
+// first (equal values in index order), as for top-k sampling over logits.
+// NaNs are never selected; returns the number of indices written, k or the
+// count of numbers in the span if that is smaller.
+template <typename Format>
+constexpr std::size_t
+top_k_n(std::span<const typename Format::storage_type> bits,
+        std::span<std::size_t> indices) {
+  detail::top_k_heap<Format> heap{bits, indices};
+  std::size_t i = heap.fill();
+  if (heap.count == indices.size() && heap.count > 0) {
+    for (; i < bits.size(); ++i) {
+      heap.offer(i);
+    }
+  }
+  return heap.finish();
+}
+
+} // namespace opine::inline v1
@@ -1,9 +1,99 @@
 #pragma once
 
 #include <opine/core/unpacked.hpp>
+#include <opine/operations/classify.hpp>
 
 namespace opine::inline v1 {
 
+namespace detail {
+
+// Field extraction helpers shared by unpack() and the bulk unpack_n()
+//
+// Each helper works on plain integers and contains no branches, so a loop
+// calling them over an array is straight-line per-lane work the compiler
+// can vectorize.
+
+// The sign is tested in place with a mask rather than shifted down first:
+// same result, and it avoids byte-lane shifts, which x86 vector units lack.
+//
+// In a format without -0 whose denormals DenormalPolicy flushes, a flushed
+// denormal is +0: keeping the sign would make it the NaN encoding.
+template <typename Format,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr bool extract_sign(typename Format::storage_type bits) {
+  using storage_type = typename Format::storage_type;
+  constexpr auto sign_mask = (storage_type{1} << Format::sign_bits) - 1;
+  constexpr auto sign_field =
+      static_cast<storage_type>(sign_mask << Format::sign_offset);
+  if constexpr (!Format::special_values::has_negative_zero &&
+                DenormalPolicy::flush_inputs) {
+    constexpr auto exp_field = static_cast<storage_type>(
+        ((storage_type{1} << Format::exp_bits) - 1) << Format::exp_offset);
+    constexpr auto mant_field = static_cast<storage_type>(
+        ((storage_type{1} << Format::mant_bits) - 1) << Format::mant_offset);
+    const bool denormal = (bits & exp_field) == 0 && (bits & mant_field) != 0;
+    return (bits & sign_field) != 0 && !denormal;
+  } else {
+    return (bits & sign_field) != 0;
+  }
+}
+
+template <typename Format>
+constexpr typename Format::exponent_type
+extract_exponent(typename Format::storage_type bits) {
+  constexpr auto exp_mask =
+      (typename Format::storage_type{1} << Format::exp_bits) - 1;
+  return static_cast<typename Format::exponent_type>(
+      (bits >> Format::exp_offset) & exp_mask);
+}
+
+// Build the unpacked mantissa from the storage bits and the already extracted
+// exponent field
+//
+// Layout: [implicit bit (if any)][M stored bits][guard bits (zero)]
+//
+// When DenormalPolicy flushes inputs, a zero exponent field gives a zero
+// mantissa (a signed zero) instead of a denormal.
+template <typename Format, typename RoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr typename UnpackedFloat<Format, RoundingPolicy>::mantissa_type
+extract_mantissa(typename Format::storage_type bits,
+                 typename Format::exponent_type exponent) {
+  using mantissa_type =
+      typename UnpackedFloat<Format, RoundingPolicy>::mantissa_type;
+
+  // Extract stored mantissa bits
+  constexpr auto mant_mask =
+      (typename Format::storage_type{1} << Format::mant_bits) - 1;
+  auto mant_stored = (bits >> Format::mant_offset) & mant_mask;
+
+  // Shift stored bits left to make room for guard bits at LSB
+  auto mant_shifted = static_cast<mantissa_type>(
+      static_cast<mantissa_type>(mant_stored) << RoundingPolicy::guard_bits);
+
+  if constexpr (Format::has_implicit_bit) {
+    // Normal number (exponent != 0): implicit bit is 1
+    // Denormal (exponent == 0): implicit bit is 0
+    //
+    // Written as a select rather than an if/else so that the bulk loops stay
+    // branch-free after inlining.
+    constexpr auto implicit_bit =
+        UnpackedFloat<Format, RoundingPolicy>::implicit_bit_mask();
+    const bool is_normal = (exponent != 0);
+    const mantissa_type denormal =
+        DenormalPolicy::flush_inputs ? mantissa_type{0} : mant_shifted;
+    return is_normal ? static_cast<mantissa_type>(mant_shifted | implicit_bit)
+                     : denormal;
+  } else if constexpr (DenormalPolicy::flush_inputs) {
+    return exponent != 0 ? mant_shifted : mantissa_type{0};
+  } else {
+    // No implicit bit - just shift for guard bits
+    return mant_shifted;
+  }
+}
+
+} // namespace detail
+
 // Unpack a floating point value from storage format to computational format
 //
 // Extracts sign, exponent, and mantissa fields from the storage bits
@@ -17,61 +107,115 @@ namespace opine::inline v1 {
 //
 // Denormal handling: For formats with implicit bits, when exponent == 0,
 // the implicit bit is set to 0 (denormal). For normal numbers (exponent != 0),
-// the implicit bit is set to 1.
+// the implicit bit is set to 1. A denormal policy that flushes inputs
+// (FlushInputsToZero, FlushOnZero) unpacks denormals as signed zeros.
 template <typename Format,
-          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
-constexpr UnpackedFloat<Format, RoundingPolicy>
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>
 unpack(typename Format::storage_type bits) {
-  UnpackedFloat<Format, RoundingPolicy> result{};
+  UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> result{};
 
-  // Extract sign bit
-  constexpr auto sign_mask =
-      (typename Format::storage_type{1} << Format::sign_bits) - 1;
-  result.sign = static_cast<bool>((bits >> Format::sign_offset) & sign_mask);
+  result.sign = detail::extract_sign<Format, DenormalPolicy>(bits);
+  result.exponent = detail::extract_exponent<Format>(bits);
+  result.mantissa =
+      detail::extract_mantissa<Format, RoundingPolicy, DenormalPolicy>(
+          bits, result.exponent);
 
-  // Extract exponent
-  constexpr auto exp_mask =
-      (typename Format::storage_type{1} << Format::exp_bits) - 1;
-  result.exponent = static_cast<typename Format::exponent_type>(
-      (bits >> Format::exp_offset) & exp_mask);
+  return result;
+}
 
-  // Extract stored mantissa bits
-  constexpr auto mant_mask =
-      (typename Format::storage_type{1} << Format::mant_bits) - 1;
-  auto mant_stored = (bits >> Format::mant_offset) & mant_mask;
+namespace detail {
 
-  // Build mantissa with implicit bit and guard bits
-  // Layout: [implicit bit (if any)][M stored bits][guard bits (zero)]
-  using mantissa_type =
-      typename UnpackedFloat<Format, RoundingPolicy>::mantissa_type;
+// Assemble the storage bits from a sign, a biased exponent and a rounded
+// mantissa (round_mantissa()'s result: the stored bits plus the carry)
+//
+// The carry is added to the exponent; the sum is masked to the exponent field
+// so that it can never spill into the neighbouring field. When DenormalPolicy
+// flushes outputs, a value in the denormal range (exponent 0, before
+// rounding) is assembled as a signed zero.
+template <typename Format,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr typename Format::storage_type
+assemble(bool sign, typename Format::exponent_type exponent,
+         rounding_policies::rounded_mantissa_t<Format> rounded_mant) {
+  using storage_type = typename Format::storage_type;
+  storage_type result = 0;
+
+  if constexpr (DenormalPolicy::flush_outputs) {
+    rounded_mant = exponent != 0
+                       ? rounded_mant
+                       : rounding_policies::rounded_mantissa_t<Format>{0};
+  }
 
-  if constexpr (Format::has_implicit_bit) {
-    // Check if this is a normal number (exponent != 0) or denormal (exponent ==
-    // 0)
-    bool is_normal = (result.exponent != 0);
-
-    // Shift stored bits left to make room for guard bits at LSB
-    auto mant_shifted = static_cast<mantissa_type>(mant_stored)
-                        << RoundingPolicy::guard_bits;
-
-    if (is_normal) {
-      // Normal number: set implicit bit to 1
-      constexpr int implicit_bit_pos =
-          Format::mant_bits + RoundingPolicy::guard_bits;
-      result.mantissa = mant_shifted | (mantissa_type{1} << implicit_bit_pos);
-    } else {
-      // Denormal: implicit bit is 0
-      result.mantissa = mant_shifted;
+  // Pack sign bit
+  auto sign_value = static_cast<storage_type>(sign ? 1 : 0);
+  result |= (sign_value << Format::sign_offset);
+
+  auto rounded_value = static_cast<storage_type>(rounded_mant);
+  const auto carry =
+      static_cast<storage_type>(rounded_value >> Format::mant_bits);
+
+  // Pack exponent, adding the rounding carry
+  constexpr auto exp_mask = (storage_type{1} << Format::exp_bits) - 1;
+  auto exp_value = static_cast<storage_type>(
+      (static_cast<storage_type>(exponent) + carry) & exp_mask);
+  result |= (exp_value << Format::exp_offset);
+
+  // Pack mantissa (a carry leaves the stored bits all zero)
+  constexpr auto mant_mask = (storage_type{1} << Format::mant_bits) - 1;
+  auto mant_value = static_cast<storage_type>(rounded_value & mant_mask);
+  result |= (mant_value << Format::mant_offset);
+
+  return result;
+}
+
+// Storage bits of an unpacked value and its rounded mantissa
+//
+// assemble() plus the special-value rules of formats that do not have the
+// IEEE default ones: a finite value whose rounding goes past the largest
+// finite value is assembled as the format's overflow value (NaN, or the
+// largest finite value when the format saturates), and without -0 a zero
+// result is +0 (a tiny negative value rounded to zero would otherwise be the
+// NaN encoding). Both are selects on the assembled bits.
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr typename Format::storage_type
+pack_rounded(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &value,
+             rounding_policies::rounded_mantissa_t<Format> rounded_mant) {
+  using storage_type = typename Format::storage_type;
+  using rounded_type = rounding_policies::rounded_mantissa_t<Format>;
+
+  auto result = assemble<Format, DenormalPolicy>(value.sign, value.exponent,
+                                                 rounded_mant);
+  if constexpr (!has_ieee_specials<Format>) {
+    constexpr auto mant_mask =
+        static_cast<rounded_type>((rounded_type{1} << Format::mant_bits) - 1);
+    const auto overflowed = overflow_value<Format, RoundingPolicy,
+                                           DenormalPolicy>(value.sign);
+    const auto overflow_bits = assemble<Format, DenormalPolicy>(
+        overflowed.sign, overflowed.exponent,
+        static_cast<rounded_type>((overflowed.mantissa >>
+                                   RoundingPolicy::guard_bits) &
+                                  mant_mask));
+    const bool overflow =
+        is_finite(value) &&
+        exceeds_largest_finite<Format>(
+            static_cast<int>(value.exponent) +
+                static_cast<int>(rounded_mant >> Format::mant_bits),
+            static_cast<rounded_type>(rounded_mant & mant_mask));
+    if constexpr (!Format::special_values::has_negative_zero) {
+      constexpr auto sign_field =
+          static_cast<storage_type>(storage_type{1} << Format::sign_offset);
+      result = result == sign_field && !is_nan(value) ? storage_type{0}
+                                                      : result;
     }
-  } else {
-    // No implicit bit - just shift for guard bits
-    result.mantissa = static_cast<mantissa_type>(mant_stored)
-                      << RoundingPolicy::guard_bits;
+    result = overflow ? overflow_bits : result;
   }
-
   return result;
 }
 
+} // namespace detail
+
 // Pack a floating point value from computational format to storage format
 //
 // Takes an UnpackedFloat (with sign, biased exponent, and wide mantissa
@@ -81,36 +225,31 @@ unpack(typename Format::storage_type bits) {
 // rounded to fit in the storage mantissa field. The implicit bit (if present)
 // is removed before packing.
 //
-// Note: This implementation does NOT handle mantissa overflow from rounding
-// (where rounding causes the mantissa to overflow and requires incrementing
-// the exponent). This is deferred to future implementation.
+// Mantissa overflow from rounding (1.111|GRS rounding up to 10.000) is carried
+// into the exponent: the stored mantissa becomes 0 and the exponent is
+// incremented. This turns the largest denormal into the smallest normal and
+// the largest finite value into infinity, as IEEE 754 requires. Inf and NaN
+// inputs (exponent all ones) are expected to have clear guard bits, which is
+// how unpack() produces them.
+//
+// A denormal policy that flushes outputs (FlushToZero, FlushOnZero) packs
+// values in the denormal range as signed zeros. Formats with other special
+// values (Format::special_values) follow their own overflow and zero rules,
+// see detail::pack_rounded().
 template <typename Format,
-          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
 constexpr typename Format::storage_type
-pack(const UnpackedFloat<Format, RoundingPolicy> &unpacked) {
-  typename Format::storage_type result = 0;
-
-  // Pack sign bit
-  auto sign_value =
-      static_cast<typename Format::storage_type>(unpacked.sign ? 1 : 0);
-  result |= (sign_value << Format::sign_offset);
-
-  // Pack exponent
-  auto exp_value =
-      static_cast<typename Format::storage_type>(unpacked.exponent);
-  result |= (exp_value << Format::exp_offset);
-
+pack(const UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> &unpacked) {
   // Round mantissa (removes guard bits and implicit bit)
-  auto rounded_mant = RoundingPolicy::template round_mantissa<Format>(
+  //
+  // The rounded value has one bit more than the stored mantissa field: bit M
+  // is the carry out of rounding.
+  const auto rounded_mant = RoundingPolicy::template round_mantissa<Format>(
       unpacked.mantissa,
       unpacked.sign // Pass sign for directional rounding modes
   );
-
-  // Pack mantissa
-  auto mant_value = static_cast<typename Format::storage_type>(rounded_mant);
-  result |= (mant_value << Format::mant_offset);
-
-  return result;
+  return detail::pack_rounded(unpacked, rounded_mant);
 }
 
 } // namespace opine::inline v1
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <opine/operations/pack_unpack.hpp>
+#include <span>
+#include <type_traits>
+
+namespace opine::inline v1 {
+
+// Batched pack/unpack over contiguous spans
+//
+// These are the bulk counterparts of unpack() and pack(). Instead of returning
+// one UnpackedFloat per value (array-of-structures), they write the sign,
+// exponent and mantissa of every element into three separate buffers
+// (structure-of-arrays):
+//
+//   bits:      [b0][b1][b2][b3]...
+//   sign:      [s0][s1][s2][s3]...
+//   exponent:  [e0][e1][e2][e3]...
+//   mantissa:  [m0][m1][m2][m3]...
+//
+// Each output stream is a plain array of one integer type, so the loops below
+// contain nothing but shifts, masks and selects on independent lanes. That is
+// the shape compilers auto-vectorize.
+//
+// The per-element work goes through the same field helpers (and, for packing,
+// the same pack()) as the scalar path, which remains the reference
+// implementation: the bulk results are bit-identical to calling unpack() and
+// pack() in a loop, for every format and policy.
+//
+// Buffer sizes: the number of elements processed is the smallest of the span
+// sizes involved, and that count is returned. Callers normally size all
+// buffers identically.
+
+// Mantissa element type used by the SoA buffers for a given configuration
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+using unpacked_mantissa_t =
+    typename UnpackedFloat<Format, RoundingPolicy>::mantissa_type;
+
+// Unpack a span of storage values into SoA sign/exponent/mantissa buffers
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr std::size_t
+unpack_n(std::span<const typename Format::storage_type> bits,
+         std::span<bool> sign,
+         std::span<typename Format::exponent_type> exponent,
+         std::span<unpacked_mantissa_t<Format, RoundingPolicy>> mantissa) {
+  const std::size_t n = std::min(
+      {bits.size(), sign.size(), exponent.size(), mantissa.size()});
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto value = bits[i];
+    const auto exp = detail::extract_exponent<Format>(value);
+    sign[i] = detail::extract_sign<Format, DenormalPolicy>(value);
+    exponent[i] = exp;
+    mantissa[i] =
+        detail::extract_mantissa<Format, RoundingPolicy, DenormalPolicy>(value,
+                                                                         exp);
+  }
+
+  return n;
+}
+
+// Pack SoA sign/exponent/mantissa buffers into a span of storage values
+//
+// Rounding is applied per element through RoundingPolicy, exactly as pack()
+// does for a single UnpackedFloat. A stochastic policy reserves one stream
+// counter per element before the loop (element i uses counter first + i), so
+// the loop body stays a pure function of the lane.
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr std::size_t
+pack_n(std::span<const bool> sign,
+       std::span<const typename Format::exponent_type> exponent,
+       std::span<const unpacked_mantissa_t<Format, RoundingPolicy>> mantissa,
+       std::span<typename Format::storage_type> bits) {
+  const std::size_t n = std::min(
+      {bits.size(), sign.size(), exponent.size(), mantissa.size()});
+
+  if constexpr (rounding_policies::is_stochastic<RoundingPolicy>) {
+    if (!std::is_constant_evaluated()) {
+      const std::uint32_t first =
+          RoundingPolicy::advance(static_cast<std::uint32_t>(n));
+      for (std::size_t i = 0; i < n; ++i) {
+        const auto rounded = RoundingPolicy::template round_mantissa<Format>(
+            mantissa[i], sign[i],
+            RoundingPolicy::random(first + static_cast<std::uint32_t>(i)));
+        UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> unpacked{};
+        unpacked.sign = sign[i];
+        unpacked.exponent = exponent[i];
+        unpacked.mantissa = mantissa[i];
+        bits[i] = detail::pack_rounded(unpacked, rounded);
+      }
+      return n;
+    }
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> unpacked{};
+    unpacked.sign = sign[i];
+    unpacked.exponent = exponent[i];
+    unpacked.mantissa = mantissa[i];
+    bits[i] = pack<Format, RoundingPolicy, DenormalPolicy>(unpacked);
+  }
+
+  return n;
+}
+
+} // namespace opine::inline v1
@@ -3,13 +3,39 @@
 // OPINE - Optimized Policy-Instantiated Numeric Engine
 // Main convenience header
 
+#include <opine/core/aligned_allocator.hpp>
+#include <opine/core/extended.hpp>
 #include <opine/core/format.hpp>
+#include <opine/core/type_list.hpp>
 #include <opine/core/types.hpp>
 #include <opine/core/unpacked.hpp>
+#include <opine/expression.hpp>
+#include <opine/extern_ops.hpp>
+#include <opine/float_engine.hpp>
+#include <opine/microscaling.hpp>
+#include <opine/operations/accumulator.hpp>
+#include <opine/operations/approximate.hpp>
+#include <opine/operations/arithmetic.hpp>
+#include <opine/operations/classify.hpp>
+#include <opine/operations/compare.hpp>
+#include <opine/operations/convert.hpp>
+#include <opine/operations/convert_n.hpp>
+#include <opine/operations/dot.hpp>
+#include <opine/operations/extended.hpp>
+#include <opine/operations/lookup.hpp>
+#include <opine/operations/multiply_integers.hpp>
+#include <opine/operations/normalize.hpp>
+#include <opine/operations/order.hpp>
 #include <opine/operations/pack_unpack.hpp>
+#include <opine/operations/pack_unpack_n.hpp>
+#include <opine/packed_array.hpp>
+#include <opine/policies/conversion.hpp>
+#include <opine/policies/evaluation.hpp>
+#include <opine/policies/multiply.hpp>
 #include <opine/policies/rounding.hpp>
+#include <opine/policies/special_values.hpp>
+#include <opine/policies/table.hpp>
 
 // Future additions:
-// #include <opine/float_engine.hpp>
 // #include <opine/presets/ieee754.hpp>
 // #include <opine/presets/ml_formats.hpp>
@@ -0,0 +1,525 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <opine/core/aligned_allocator.hpp>
+#include <opine/core/format.hpp>
+#include <opine/operations/pack_unpack_n.hpp>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace opine::inline v1 {
+
+// Bit-contiguous storage for formats narrower than their storage type
+//
+// A FormatDescriptor's storage_type is at least a byte, so a std::vector of
+// fp4 encodings spends 8 bits on every 4-bit element. PackedArray stores
+// elements at total_bits each, with no padding between them:
+//
+//   element i:  bits [i * total_bits, (i + 1) * total_bits)
+//
+// of the array's 64-bit words read as one little-endian integer (element 0
+// in the low bits of word 0). On a little-endian host the bytes of the words
+// are the LSB-first element layout of MicroscaledArray. Elements straddle
+// word boundaries when 64 is not a multiple of total_bits (fp6, fp5, ...).
+//
+// Element access goes through a proxy reference, like std::vector<bool>, and
+// costs a shift and a mask (two of each, for a straddling element). The bulk
+// functions work a word group at a time: `group` elements exactly fill
+// `group_words` words (16 fp4 elements per word, 32 fp6 elements per 3
+// words), so a whole group is loaded or stored with no read-modify-write and
+// every element offset in it is a compile-time constant.
+//
+// PackedView is the read-only counterpart that does not own its words: a
+// PackedArray's view(), or words memory-mapped from a tensor file.
+//
+// Usage:
+//   PackedArray<fp4_e2m1> weights(checkpoint);  // span of fp4 encodings
+//   weights[i] = 0x3;                           // proxy assignment
+//   unpack_n<fp4_e2m1, RNE>(weights, 0, sign, exponent, mantissa);
+
+namespace detail {
+
+// Word packing of Bits-wide elements into 64-bit words
+template <int Bits> struct word_packing {
+  static_assert(Bits > 0 && Bits <= 64, "Elements are 1 to 64 bits wide");
+
+  static constexpr int word_bits = 64;
+  static constexpr std::size_t group = word_bits / std::gcd(Bits, word_bits);
+  static constexpr std::size_t group_words = Bits * group / word_bits;
+  static constexpr std::uint64_t mask = ~std::uint64_t{0} >> (word_bits - Bits);
+  static constexpr bool straddles = word_bits % Bits != 0;
+
+  static constexpr std::size_t word_count(std::size_t size) {
+    return (size * Bits + word_bits - 1) / word_bits;
+  }
+
+  static constexpr std::uint64_t extract(const std::uint64_t *words,
+                                         std::size_t i) {
+    const std::size_t bit = i * Bits;
+    const std::size_t word = bit / word_bits;
+    const int offset = static_cast<int>(bit % word_bits);
+    std::uint64_t value = words[word] >> offset;
+    if constexpr (straddles) {
+      if (offset + Bits > word_bits) {
+        value |= words[word + 1] << (word_bits - offset);
+      }
+    }
+    return value & mask;
+  }
+
+  static constexpr void insert(std::uint64_t *words, std::size_t i,
+                               std::uint64_t value) {
+    const std::size_t bit = i * Bits;
+    const std::size_t word = bit / word_bits;
+    const int offset = static_cast<int>(bit % word_bits);
+    value &= mask;
+    words[word] = (words[word] & ~(mask << offset)) | (value << offset);
+    if constexpr (straddles) {
+      if (offset + Bits > word_bits) {
+        const int shift = word_bits - offset;
+        words[word + 1] =
+            (words[word + 1] & ~(mask >> shift)) | (value >> shift);
+      }
+    }
+  }
+
+  // Decode the group starting at `words` into out[0, group)
+  template <typename Storage>
+  static constexpr void unpack_group(const std::uint64_t *words,
+                                     Storage *out) {
+    for (std::size_t k = 0; k < group; ++k) {
+      out[k] = static_cast<Storage>(extract(words, k));
+    }
+  }
+
+  // Encode in[0, group) into the group's words, overwriting them
+  template <typename Storage>
+  static constexpr void pack_group(const Storage *in, std::uint64_t *words) {
+    std::array<std::uint64_t, group_words> group_bits{};
+    for (std::size_t k = 0; k < group; ++k) {
+      const std::size_t bit = k * Bits;
+      const std::size_t word = bit / word_bits;
+      const int offset = static_cast<int>(bit % word_bits);
+      const std::uint64_t value = static_cast<std::uint64_t>(in[k]) & mask;
+      group_bits[word] |= value << offset;
+      if constexpr (straddles) {
+        if (offset + Bits > word_bits) {
+          group_bits[word + 1] |= value >> (word_bits - offset);
+        }
+      }
+    }
+    std::copy(group_bits.begin(), group_bits.end(), words);
+  }
+};
+
+// Decode elements [first, first + out.size()) of packed words
+//
+// Elements before the first group boundary and after the last are decoded
+// one at a time; whole groups in between a group at a time.
+template <typename Format>
+constexpr void unpack_words(std::span<const std::uint64_t> words,
+                            std::size_t first,
+                            std::span<typename Format::storage_type> out) {
+  using packing = word_packing<Format::total_bits>;
+  using storage_type = typename Format::storage_type;
+
+  std::size_t i = 0;
+  for (; i < out.size() && (first + i) % packing::group != 0; ++i) {
+    out[i] = static_cast<storage_type>(
+        packing::extract(words.data(), first + i));
+  }
+  for (; out.size() - i >= packing::group; i += packing::group) {
+    packing::unpack_group(words.data() + (first + i) / packing::group *
+                                             packing::group_words,
+                          out.data() + i);
+  }
+  for (; i < out.size(); ++i) {
+    out[i] = static_cast<storage_type>(
+        packing::extract(words.data(), first + i));
+  }
+}
+
+// Encode in into elements [first, first + in.size()) of packed words
+template <typename Format>
+constexpr void
+pack_words(std::span<const typename Format::storage_type> in,
+           std::size_t first, std::span<std::uint64_t> words) {
+  using packing = word_packing<Format::total_bits>;
+
+  std::size_t i = 0;
+  for (; i < in.size() && (first + i) % packing::group != 0; ++i) {
+    packing::insert(words.data(), first + i, in[i]);
+  }
+  for (; in.size() - i >= packing::group; i += packing::group) {
+    packing::pack_group(in.data() + i,
+                        words.data() + (first + i) / packing::group *
+                                           packing::group_words);
+  }
+  for (; i < in.size(); ++i) {
+    packing::insert(words.data(), first + i, in[i]);
+  }
+}
+
+// Elements decoded per step by the PackedArray unpack_n()/pack_n(): a
+// multiple of every group size, small enough for a stack buffer
+inline constexpr std::size_t packed_chunk = 64;
+
+} // namespace detail
+
+template <typename Format> class PackedArray;
+template <typename Format> class PackedView;
+
+// Proxy reference to one element of a PackedArray
+//
+// Reads as the element's storage_type encoding; assignment writes the
+// element's bits. Assignment is const, as for a pointer: the proxy refers to
+// the element, it does not hold it.
+template <typename Format> class PackedReference {
+public:
+  using storage_type = typename Format::storage_type;
+
+  PackedReference(PackedArray<Format> &array, std::size_t index)
+      : array_(&array), index_(index) {}
+
+  operator storage_type() const { return array_->get(index_); }
+
+  const PackedReference &operator=(storage_type value) const {
+    array_->set(index_, value);
+    return *this;
+  }
+
+  const PackedReference &operator=(const PackedReference &other) const {
+    return *this = static_cast<storage_type>(other);
+  }
+
+  friend void swap(const PackedReference &a, const PackedReference &b) {
+    const storage_type value = a;
+    a = static_cast<storage_type>(b);
+    b = value;
+  }
+
+private:
+  PackedArray<Format> *array_;
+  std::size_t index_;
+};
+
+// Random-access iterator over a PackedArray or PackedView; Const iterators
+// read encodings (through a copy of the view), mutable ones yield proxy
+// references
+template <typename Format, bool Const> class PackedIterator {
+  using container_type =
+      std::conditional_t<Const, PackedView<Format>, PackedArray<Format> *>;
+
+public:
+  using iterator_concept = std::random_access_iterator_tag;
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = typename Format::storage_type;
+  using difference_type = std::ptrdiff_t;
+  using reference =
+      std::conditional_t<Const, value_type, PackedReference<Format>>;
+
+  PackedIterator() = default;
+
+  PackedIterator(PackedView<Format> view, std::size_t index)
+    requires Const
+      : container_(view), index_(index) {}
+
+  PackedIterator(PackedArray<Format> &array, std::size_t index)
+    requires(!Const)
+      : container_(&array), index_(index) {}
+
+  // Mutable to const
+  template <bool OtherConst>
+    requires(Const && !OtherConst)
+  PackedIterator(const PackedIterator<Format, OtherConst> &other)
+      : container_(other.container_->view()), index_(other.index_) {}
+
+  reference operator*() const { return at(index_); }
+  reference operator[](difference_type n) const {
+    return at(static_cast<std::size_t>(static_cast<difference_type>(index_) +
+                                       n));
+  }
+
+  PackedIterator &operator++() {
+    ++index_;
+    return *this;
+  }
+  PackedIterator operator++(int) {
+    PackedIterator result = *this;
+    ++index_;
+    return result;
+  }
+  PackedIterator &operator--() {
+    --index_;
+    return *this;
+  }
+  PackedIterator operator--(int) {
+    PackedIterator result = *this;
+    --index_;
+    return result;
+  }
+
+  PackedIterator &operator+=(difference_type n) {
+    index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + n);
+    return *this;
+  }
+  PackedIterator &operator-=(difference_type n) { return *this += -n; }
+
+  friend PackedIterator operator+(PackedIterator it, difference_type n) {
+    return it += n;
+  }
+  friend PackedIterator operator+(difference_type n, PackedIterator it) {
+    return it += n;
+  }
+  friend PackedIterator operator-(PackedIterator it, difference_type n) {
+    return it -= n;
+  }
+  friend difference_type operator-(const PackedIterator &a,
+                                   const PackedIterator &b) {
+    return static_cast<difference_type>(a.index_) -
+           static_cast<difference_type>(b.index_);
+  }
+
+  friend bool operator==(const PackedIterator &a, const PackedIterator &b) {
+    return a.index_ == b.index_;
+  }
+  friend std::strong_ordering operator<=>(const PackedIterator &a,
+                                          const PackedIterator &b) {
+    return a.index_ <=> b.index_;
+  }
+
+private:
+  template <typename, bool> friend class PackedIterator;
+
+  reference at(std::size_t index) const {
+    if constexpr (Const) {
+      return container_[index];
+    } else {
+      return (*container_)[index];
+    }
+  }
+
+  container_type container_{};
+  std::size_t index_ = 0;
+};
+
+// Read-only view of packed Format encodings: words in the PackedArray
+// layout (from a PackedArray, or memory-mapped from a file) and an element
+// count
+template <typename Format> class PackedView {
+  using packing = detail::word_packing<Format::total_bits>;
+
+public:
+  using format = Format;
+  using storage_type = typename Format::storage_type;
+  using value_type = storage_type;
+  using word_type = std::uint64_t;
+  using size_type = std::size_t;
+  using const_reference = storage_type;
+  using iterator = PackedIterator<Format, true>;
+  using const_iterator = iterator;
+
+  static constexpr std::size_t group = packing::group;
+  static constexpr std::size_t group_words = packing::group_words;
+
+  // Words needed for size elements
+  static constexpr std::size_t word_count(std::size_t size) {
+    return packing::word_count(size);
+  }
+
+  PackedView() = default;
+
+  // words.size() must be at least word_count(size)
+  PackedView(std::span<const word_type> words, std::size_t size)
+      : words_(words), size_(size) {}
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  std::span<const word_type> words() const { return words_; }
+
+  storage_type get(std::size_t index) const {
+    return static_cast<storage_type>(packing::extract(words_.data(), index));
+  }
+
+  const_reference operator[](std::size_t index) const { return get(index); }
+
+  iterator begin() const { return iterator(*this, 0); }
+  iterator end() const { return iterator(*this, size_); }
+
+  // Decode elements [first, first + n) into out, n = out.size() or the
+  // number of elements from first, whichever is smaller; return n
+  std::size_t load(std::size_t first, std::span<storage_type> out) const {
+    const std::size_t n =
+        first < size_ ? std::min(out.size(), size_ - first) : 0;
+    detail::unpack_words<Format>(words_, first, out.first(n));
+    return n;
+  }
+
+private:
+  std::span<const word_type> words_;
+  std::size_t size_ = 0;
+};
+
+// Array of Format encodings packed at Format::total_bits each
+template <typename Format> class PackedArray {
+  using packing = detail::word_packing<Format::total_bits>;
+
+public:
+  using format = Format;
+  using storage_type = typename Format::storage_type;
+  using value_type = storage_type;
+  using word_type = std::uint64_t;
+  using size_type = std::size_t;
+  using reference = PackedReference<Format>;
+  using const_reference = storage_type;
+  using iterator = PackedIterator<Format, false>;
+  using const_iterator = PackedIterator<Format, true>;
+
+  // Elements per word group and the words they fill
+  static constexpr std::size_t group = packing::group;
+  static constexpr std::size_t group_words = packing::group_words;
+
+  PackedArray() = default;
+
+  // size elements, all encoding 0 (+0 for the standard formats)
+  explicit PackedArray(std::size_t size)
+      : size_(size), words_(packing::word_count(size)) {}
+
+  // The encodings of values
+  explicit PackedArray(std::span<const storage_type> values)
+      : PackedArray(values.size()) {
+    store(0, values);
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Raw packed words
+  std::span<const word_type> words() const { return words_; }
+
+  PackedView<Format> view() const {
+    return PackedView<Format>(words_, size_);
+  }
+
+  // Bytes of element storage (words, so up to 7 bytes over size * bits / 8)
+  std::size_t storage_bytes() const {
+    return words_.size() * sizeof(word_type);
+  }
+
+  storage_type get(std::size_t index) const {
+    return static_cast<storage_type>(packing::extract(words_.data(), index));
+  }
+
+  void set(std::size_t index, storage_type value) {
+    packing::insert(words_.data(), index, value);
+  }
+
+  reference operator[](std::size_t index) { return reference(*this, index); }
+  const_reference operator[](std::size_t index) const { return get(index); }
+
+  iterator begin() { return iterator(*this, 0); }
+  iterator end() { return iterator(*this, size_); }
+  const_iterator begin() const { return view().begin(); }
+  const_iterator end() const { return view().end(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  // Decode elements [first, first + n) into out, n = out.size() or the
+  // number of elements from first, whichever is smaller; return n
+  std::size_t load(std::size_t first, std::span<storage_type> out) const {
+    return view().load(first, out);
+  }
+
+  // Encode in into elements [first, first + n), n as for load(); return n
+  std::size_t store(std::size_t first, std::span<const storage_type> in) {
+    const std::size_t n =
+        first < size_ ? std::min(in.size(), size_ - first) : 0;
+    detail::pack_words<Format>(in.first(n), first, words_);
+    return n;
+  }
+
+private:
+  using buffer_type =
+      std::vector<word_type, detail::aligned_allocator<word_type,
+                                                       cache_line_size>>;
+
+  std::size_t size_ = 0;
+  buffer_type words_;
+};
+
+// Unpack elements [first, first + n) of packed encodings into SoA buffers
+//
+// The PackedView counterpart of unpack_n() on a span: elements are decoded
+// a chunk of word groups at a time into a stack buffer and unpacked from
+// there, with the same result as load() followed by unpack_n(). n is the
+// smallest of the buffer sizes and the number of elements from first.
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+std::size_t
+unpack_n(PackedView<Format> src, std::size_t first, std::span<bool> sign,
+         std::span<typename Format::exponent_type> exponent,
+         std::span<unpacked_mantissa_t<Format, RoundingPolicy>> mantissa) {
+  const std::size_t size = first < src.size() ? src.size() - first : 0;
+  const std::size_t n =
+      std::min({size, sign.size(), exponent.size(), mantissa.size()});
+
+  std::array<typename Format::storage_type, detail::packed_chunk> bits;
+  for (std::size_t i = 0; i < n; i += detail::packed_chunk) {
+    const std::size_t m = std::min(detail::packed_chunk, n - i);
+    src.load(first + i, std::span(bits).first(m));
+    unpack_n<Format, RoundingPolicy, DenormalPolicy>(
+        std::span<const typename Format::storage_type>(bits.data(), m),
+        sign.subspan(i, m), exponent.subspan(i, m), mantissa.subspan(i, m));
+  }
+  return n;
+}
+
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+std::size_t
+unpack_n(const PackedArray<Format> &src, std::size_t first,
+         std::span<bool> sign,
+         std::span<typename Format::exponent_type> exponent,
+         std::span<unpacked_mantissa_t<Format, RoundingPolicy>> mantissa) {
+  return unpack_n<Format, RoundingPolicy, DenormalPolicy>(
+      src.view(), first, sign, exponent, mantissa);
+}
+
+// Pack SoA buffers into elements [first, first + n) of a PackedArray
+//
+// Elements are packed into a stack buffer a chunk at a time and stored a
+// word group at a time, with the same result as pack_n() followed by store().
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+std::size_t
+pack_n(std::span<const bool> sign,
+       std::span<const typename Format::exponent_type> exponent,
+       std::span<const unpacked_mantissa_t<Format, RoundingPolicy>> mantissa,
+       PackedArray<Format> &dst, std::size_t first) {
+  const std::size_t size = first < dst.size() ? dst.size() - first : 0;
+  const std::size_t n =
+      std::min({size, sign.size(), exponent.size(), mantissa.size()});
+
+  std::array<typename Format::storage_type, detail::packed_chunk> bits;
+  for (std::size_t i = 0; i < n; i += detail::packed_chunk) {
+    const std::size_t m = std::min(detail::packed_chunk, n - i);
+    pack_n<Format, RoundingPolicy, DenormalPolicy>(
+        sign.subspan(i, m), exponent.subspan(i, m), mantissa.subspan(i, m),
+        std::span(bits).first(m));
+    dst.store(first + i, std::span<const typename Format::storage_type>(
+                             bits.data(), m));
+  }
+  return n;
+}
+
+} // namespace opine::inline v1
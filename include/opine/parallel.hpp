@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <opine/core/aligned_allocator.hpp>
+#include <opine/microscaling.hpp>
+#include <opine/operations/convert_n.hpp>
+#include <opine/operations/dot.hpp>
+#include <opine/policies/conversion.hpp>
+#include <opine/policies/instrumentation.hpp>
+#include <opine/policies/table.hpp>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace opine::inline v1 {
+
+// Multithreaded bulk conversion, MX quantization and exact reductions
+//
+// Opt-in: this header is not part of opine.hpp and is the only one that
+// needs a thread library (link opine_parallel instead of opine in CMake).
+// Single-threaded targets never include it.
+//
+// The input is split into chunks of about chunk_bytes of source data, a
+// multiple of 64 elements for convert_n() and of whole MX blocks for
+// quantize() and dequantize(), so no two threads write the same cache line
+// or block. Threads claim chunks from a shared counter until none are left:
+// a thread that draws cheap chunks (zeros, say, on the Compute path) simply
+// claims more, which balances the load without per-thread queues. The
+// calling thread works too.
+//
+// Results are bit-identical to the serial functions, for every thread count
+// and chunk size, except under stochastic rounding, where each thread draws
+// from its own random stream (rounding_policies::Stochastic). dot_exact()
+// splits the products into chunks (split-K), fills one ExactAccumulator per
+// chunk and merges them; exact sums do not depend on the partition or the
+// merge order, so it too matches the serial function. Instrumented
+// conversion policies (conversion_policies::Instrumented) count on every
+// thread; the counts reach the calling thread before the function returns.
+//
+// Usage:
+//   convert_n<fp16_e5m10, fp32_e8m23>(parallel, src, dst);
+//   auto weights = quantize<MXFP4_E2M1, fp32_e8m23>(parallel, checkpoint);
+//   dequantize<fp16_e5m10>(ParallelExecution{.threads = 8}, weights, out);
+//   auto sum = dot_exact<fp32_e8m23, fp8_e4m3, fp8_e4m3>(parallel, a, b);
+
+// Parallel execution: thread count (0 = std::thread::hardware_concurrency())
+// and the source bytes per chunk (the default fits in a core's L2 cache with
+// its destination)
+struct ParallelExecution {
+  unsigned threads = 0;
+  std::size_t chunk_bytes = 256 * 1024;
+};
+
+inline constexpr ParallelExecution parallel{};
+
+namespace detail {
+
+// Call body(first, last) for the chunks [first, last) of [0, count), each
+// chunk elements long except the last, on up to execution.threads threads
+template <typename Body>
+void parallel_for_chunks(const ParallelExecution &execution,
+                         std::size_t count, std::size_t chunk, Body body) {
+  if (count == 0) {
+    return;
+  }
+  chunk = std::max<std::size_t>(chunk, 1);
+  const std::size_t chunks = (count + chunk - 1) / chunk;
+  const unsigned hardware = std::max(std::thread::hardware_concurrency(), 1u);
+  const std::size_t threads = std::min<std::size_t>(
+      execution.threads != 0 ? execution.threads : hardware, chunks);
+
+  std::atomic<std::size_t> next{0};
+  auto work = [&] {
+    for (std::size_t c = next.fetch_add(1, std::memory_order_relaxed);
+         c < chunks; c = next.fetch_add(1, std::memory_order_relaxed)) {
+      body(c * chunk, std::min(count, (c + 1) * chunk));
+    }
+  };
+
+  std::vector<std::jthread> workers;
+  workers.reserve(threads - 1);
+  for (std::size_t t = 1; t < threads; ++t) {
+    workers.emplace_back(work);
+  }
+  work();
+}
+
+// parallel_for_chunks() for conversions under ConversionPolicy
+//
+// An instrumented conversion counts into the thread that converts; chunk by
+// chunk, the worker threads' counts are moved (take()) to a shared batch,
+// recorded on the calling thread once every chunk is done. So the caller
+// sees the counts of the whole call, as from the serial function.
+template <typename ConversionPolicy, typename Body>
+void parallel_convert_chunks(const ParallelExecution &execution,
+                             std::size_t count, std::size_t chunk,
+                             Body body) {
+  using instrumentation =
+      conversion_policies::instrumentation_policy_t<ConversionPolicy>;
+  if constexpr (conversion_policies::is_instrumented<ConversionPolicy> &&
+                requires { instrumentation::take(); }) {
+    const auto caller = std::this_thread::get_id();
+    std::mutex mutex;
+    instrumentation_policies::EventCounts workers;
+    parallel_for_chunks(execution, count, chunk,
+                        [&](std::size_t first, std::size_t last) {
+                          body(first, last);
+                          if (std::this_thread::get_id() != caller) {
+                            const auto batch = instrumentation::take();
+                            const std::lock_guard lock(mutex);
+                            workers += batch;
+                          }
+                        });
+    instrumentation::record(workers);
+  } else {
+    parallel_for_chunks(execution, count, chunk, body);
+  }
+}
+
+// Number of unit_bytes-sized units in a chunk (at least one)
+inline std::size_t chunk_units(const ParallelExecution &execution,
+                               std::size_t unit_bytes) {
+  return std::max<std::size_t>(execution.chunk_bytes / unit_bytes, 1);
+}
+
+} // namespace detail
+
+// Bulk convert on several threads: the same results as convert_n(src, dst)
+template <typename Dst, typename Src,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy>
+std::size_t convert_n(const ParallelExecution &execution,
+                      std::span<const typename Src::storage_type> src,
+                      std::span<typename Dst::storage_type> dst) {
+  // Chunks of whole 64-element runs: a cache line of every destination
+  // storage type
+  constexpr std::size_t run = cache_line_size;
+  const std::size_t n = std::min(src.size(), dst.size());
+
+  detail::parallel_convert_chunks<ConversionPolicy>(
+      execution, n,
+      run * detail::chunk_units(execution,
+                                run * sizeof(typename Src::storage_type)),
+      [&](std::size_t first, std::size_t last) {
+        convert_n<Dst, Src, ConversionPolicy, TablePolicy>(
+            src.subspan(first, last - first),
+            dst.subspan(first, last - first));
+      });
+  return n;
+}
+
+// Quantize on several threads: the same array as quantize(src)
+template <typename MxFormat, typename Format,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy>
+MicroscaledArray<MxFormat>
+quantize(const ParallelExecution &execution,
+         std::span<const typename Format::storage_type> src) {
+  MicroscaledArray<MxFormat> result(src.size());
+  detail::parallel_convert_chunks<ConversionPolicy>(
+      execution, result.block_count(),
+      detail::chunk_units(execution, MxFormat::block_size *
+                                         sizeof(typename Format::storage_type)),
+      [&](std::size_t first, std::size_t last) {
+        result.template quantize_blocks<Format, ConversionPolicy>(src, first,
+                                                                  last);
+      });
+  return result;
+}
+
+// Dequantize on several threads: the same values as array.dequantize(out);
+// return the number of elements written
+template <typename Format,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename MxFormat>
+std::size_t dequantize(const ParallelExecution &execution,
+                       const MicroscaledArray<MxFormat> &array,
+                       std::span<typename Format::storage_type> out) {
+  constexpr std::size_t block_size = MxFormat::block_size;
+  const std::size_t n = std::min(array.size(), out.size());
+
+  detail::parallel_convert_chunks<ConversionPolicy>(
+      execution, (n + block_size - 1) / block_size,
+      detail::chunk_units(execution, MxFormat::block_bytes + 1),
+      [&](std::size_t first, std::size_t last) {
+        for (std::size_t block = first; block < last; ++block) {
+          array.template dequantize_block<Format, ConversionPolicy>(
+              block, out.first(n).subspan(block * block_size));
+        }
+      });
+  return n;
+}
+
+// Exact dot product on several threads: the same result as dot_exact(a, b)
+template <typename AccumFormat, typename FormatA, typename FormatB,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+typename AccumFormat::storage_type
+dot_exact(const ParallelExecution &execution,
+          std::span<const typename FormatA::storage_type> a,
+          std::span<const typename FormatB::storage_type> b) {
+  using accumulator_type = ExactAccumulator<FormatA, FormatB>;
+  const std::size_t n = std::min(a.size(), b.size());
+  const std::size_t chunk = detail::chunk_units(
+      execution, sizeof(typename FormatA::storage_type) +
+                     sizeof(typename FormatB::storage_type));
+
+  std::vector<accumulator_type> partials((n + chunk - 1) / chunk);
+  detail::parallel_for_chunks(
+      execution, n, chunk, [&](std::size_t first, std::size_t last) {
+        partials[first / chunk].add_products(a.subspan(first, last - first),
+                                             b.subspan(first, last - first));
+      });
+
+  accumulator_type sum;
+  for (const auto &partial : partials) {
+    sum.merge(partial);
+  }
+  return pack(sum.template value<AccumFormat, RoundingPolicy>());
+}
+
+// Exact matrix-vector product on several threads, in chunks of rows: the
+// same result as gemv_exact(matrix, x, y)
+template <typename AccumFormat, typename FormatW, typename FormatX,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+std::size_t gemv_exact(const ParallelExecution &execution,
+                       std::span<const typename FormatW::storage_type> matrix,
+                       std::span<const typename FormatX::storage_type> x,
+                       std::span<typename AccumFormat::storage_type> y) {
+  const std::size_t cols = x.size();
+  const std::size_t rows =
+      cols == 0 ? y.size() : std::min(y.size(), matrix.size() / cols);
+
+  detail::parallel_for_chunks(
+      execution, rows,
+      detail::chunk_units(execution,
+                          std::max<std::size_t>(cols, 1) *
+                              sizeof(typename FormatW::storage_type)),
+      [&](std::size_t first, std::size_t last) {
+        gemv_exact<AccumFormat, FormatW, FormatX, RoundingPolicy>(
+            matrix.subspan(first * cols, (last - first) * cols), x,
+            y.subspan(first, last - first));
+      });
+  return rows;
+}
+
+} // namespace opine::inline v1
@@ -0,0 +1,381 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <opine/core/unpacked.hpp>
+#include <opine/operations/arithmetic.hpp>
+#include <opine/operations/pack_unpack.hpp>
+#include <opine/platforms/native/convert.hpp>
+#include <opine/platforms/native/features.hpp>
+#include <opine/policies/denormal.hpp>
+#include <opine/policies/platform.hpp>
+#include <opine/policies/rounding.hpp>
+#include <span>
+#include <type_traits>
+
+namespace opine::inline v1::native {
+
+// Bulk fp16 arithmetic with native instructions
+//
+// add_n(), subtract_n(), multiply_n(), divide_n() and fma_n() apply one
+// operation element-wise to spans of storage values, with the results of
+// unpacking each element, calling the opine:: operation and packing:
+//
+//   out[i] = pack(add(unpack<Format, R, D>(a[i]), unpack<...>(b[i])))
+//   out[i] = pack(fma(a[i], b[i], c[i]))                  (a * b + c)
+//
+// For IEEE binary16 with gradual underflow (FullSupport) they compute a
+// register at a time in hardware where it rounds the same way:
+//
+//   AVX512FP16            32 lanes, every operation, the four IEEE rounding
+//                         directions as embedded rounding
+//   F16C                  8 lanes through binary32: add, subtract, multiply
+//                         and divide, round to nearest even. binary32 has
+//                         more than 2p + 2 bits for p = 11, so rounding the
+//                         binary32 result again gives the correctly rounded
+//                         binary16 result, and the range of binary32 holds
+//                         every intermediate exactly; fma would round twice
+//   NeonFP16Arithmetic    8 lanes, every operation, round to nearest even
+//
+// As in native::convert_n(), lanes whose result is Inf or NaN (NaN
+// propagation differs, and a saturating format never overflows to Inf) are
+// computed again by the generic path, as is everything else.
+
+namespace detail {
+
+enum class Operation { Add, Subtract, Multiply, Divide, Fma };
+
+// One element on the generic path (c is read only by Fma)
+template <Operation Op, typename Format, typename RoundingPolicy,
+          typename DenormalPolicy>
+constexpr typename Format::storage_type
+apply(typename Format::storage_type a, typename Format::storage_type b,
+      typename Format::storage_type c) {
+  const auto x = unpack<Format, RoundingPolicy, DenormalPolicy>(a);
+  const auto y = unpack<Format, RoundingPolicy, DenormalPolicy>(b);
+  if constexpr (Op == Operation::Add) {
+    return pack(add(x, y));
+  } else if constexpr (Op == Operation::Subtract) {
+    return pack(subtract(x, y));
+  } else if constexpr (Op == Operation::Multiply) {
+    return pack(multiply(x, y));
+  } else if constexpr (Op == Operation::Divide) {
+    return pack(divide(x, y));
+  } else {
+    return pack(
+        fma(x, y, unpack<Format, RoundingPolicy, DenormalPolicy>(c)));
+  }
+}
+
+template <typename Format, typename DenormalPolicy>
+constexpr bool is_native_binary16 =
+    is_binary16<Format> &&
+    std::is_same_v<DenormalPolicy, denormal_policies::FullSupport>;
+
+template <Operation Op, typename Format, typename RoundingPolicy,
+          typename DenormalPolicy>
+constexpr bool avx512fp16_arithmetic =
+    has_x86_kernels && is_native_binary16<Format, DenormalPolicy> &&
+    rounding_mode<RoundingPolicy> >= 0;
+
+template <Operation Op, typename Format, typename RoundingPolicy,
+          typename DenormalPolicy>
+constexpr bool f16c_arithmetic =
+    has_x86_kernels && is_native_binary16<Format, DenormalPolicy> &&
+    std::is_same_v<RoundingPolicy, rounding_policies::ToNearestTiesToEven> &&
+    Op != Operation::Fma;
+
+template <Operation Op, typename Format, typename RoundingPolicy,
+          typename DenormalPolicy>
+constexpr bool neon_arithmetic =
+    has_arm_kernels && is_native_binary16<Format, DenormalPolicy> &&
+    arm_rounding<RoundingPolicy>;
+
+// Compute lanes whose native result is Inf or NaN again
+template <Operation Op, typename Format, typename RoundingPolicy,
+          typename DenormalPolicy, std::size_t N>
+inline void apply_specials(const typename Format::storage_type *a,
+                           const typename Format::storage_type *b,
+                           const typename Format::storage_type *c,
+                           typename Format::storage_type *out) {
+  for (std::size_t i = 0; i < N; ++i) {
+    if (is_inf_or_nan_bits<Format>(out[i])) {
+      out[i] =
+          apply<Op, Format, RoundingPolicy, DenormalPolicy>(a[i], b[i], c[i]);
+    }
+  }
+}
+
+#if defined(OPINE_NATIVE_X86_KERNELS)
+
+// AVX512FP16: 32 lanes per step; returns the count computed
+template <Operation Op, typename Format, typename RoundingPolicy,
+          typename DenormalPolicy>
+__attribute__((target("avx512fp16"))) inline std::size_t
+avx512fp16_apply_n(const typename Format::storage_type *a,
+                   const typename Format::storage_type *b,
+                   const typename Format::storage_type *c,
+                   typename Format::storage_type *out, std::size_t n) {
+  using halves_type = simd::vec<std::uint16_t, 32>;
+  constexpr int mode = rounding_mode<RoundingPolicy> | _MM_FROUND_NO_EXC;
+
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    halves_type lanes;
+    load_lanes<std::uint16_t, 32>(lanes, a + i);
+    const __m512h x = __builtin_bit_cast(__m512h, lanes);
+    load_lanes<std::uint16_t, 32>(lanes, b + i);
+    const __m512h y = __builtin_bit_cast(__m512h, lanes);
+    __m512h result;
+    if constexpr (Op == Operation::Add) {
+      result = _mm512_add_round_ph(x, y, mode);
+    } else if constexpr (Op == Operation::Subtract) {
+      result = _mm512_sub_round_ph(x, y, mode);
+    } else if constexpr (Op == Operation::Multiply) {
+      result = _mm512_mul_round_ph(x, y, mode);
+    } else if constexpr (Op == Operation::Divide) {
+      result = _mm512_div_round_ph(x, y, mode);
+    } else {
+      load_lanes<std::uint16_t, 32>(lanes, c + i);
+      result = _mm512_fmadd_round_ph(x, y, __builtin_bit_cast(__m512h, lanes),
+                                     mode);
+    }
+    lanes = __builtin_bit_cast(halves_type, result);
+    store_lanes<std::uint16_t, 32>(out + i, lanes);
+    if (any_inf_or_nan<32>(lanes)) {
+      apply_specials<Op, Format, RoundingPolicy, DenormalPolicy, 32>(
+          a + i, b + i, c + i, out + i);
+    }
+  }
+  return i;
+}
+
+// F16C: 8 lanes per step through binary32; returns the count computed
+template <Operation Op, typename Format, typename RoundingPolicy,
+          typename DenormalPolicy>
+__attribute__((target("f16c,avx"))) inline std::size_t
+f16c_apply_n(const typename Format::storage_type *a,
+             const typename Format::storage_type *b,
+             const typename Format::storage_type *c,
+             typename Format::storage_type *out, std::size_t n) {
+  using halves_type = simd::vec<std::uint16_t, 8>;
+
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    halves_type lanes;
+    load_lanes<std::uint16_t, 8>(lanes, a + i);
+    const __m256 x = _mm256_cvtph_ps(__builtin_bit_cast(__m128i, lanes));
+    load_lanes<std::uint16_t, 8>(lanes, b + i);
+    const __m256 y = _mm256_cvtph_ps(__builtin_bit_cast(__m128i, lanes));
+    __m256 result;
+    if constexpr (Op == Operation::Add) {
+      result = _mm256_add_ps(x, y);
+    } else if constexpr (Op == Operation::Subtract) {
+      result = _mm256_sub_ps(x, y);
+    } else if constexpr (Op == Operation::Multiply) {
+      result = _mm256_mul_ps(x, y);
+    } else {
+      result = _mm256_div_ps(x, y);
+    }
+    lanes = __builtin_bit_cast(
+        halves_type, _mm256_cvtps_ph(result, _MM_FROUND_TO_NEAREST_INT));
+    store_lanes<std::uint16_t, 8>(out + i, lanes);
+    if (any_inf_or_nan<8>(lanes)) {
+      apply_specials<Op, Format, RoundingPolicy, DenormalPolicy, 8>(
+          a + i, b + i, c + i, out + i);
+    }
+  }
+  return i;
+}
+
+#elif defined(OPINE_NATIVE_ARM_KERNELS) &&                                  \
+    defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+
+// NEON FP16: 8 lanes per step; returns the count computed
+template <Operation Op, typename Format, typename RoundingPolicy,
+          typename DenormalPolicy>
+inline std::size_t neon_apply_n(const typename Format::storage_type *a,
+                                const typename Format::storage_type *b,
+                                const typename Format::storage_type *c,
+                                typename Format::storage_type *out,
+                                std::size_t n) {
+  using halves_type = simd::vec<std::uint16_t, 8>;
+
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    halves_type lanes;
+    load_lanes<std::uint16_t, 8>(lanes, a + i);
+    const float16x8_t x = __builtin_bit_cast(float16x8_t, lanes);
+    load_lanes<std::uint16_t, 8>(lanes, b + i);
+    const float16x8_t y = __builtin_bit_cast(float16x8_t, lanes);
+    float16x8_t result;
+    if constexpr (Op == Operation::Add) {
+      result = vaddq_f16(x, y);
+    } else if constexpr (Op == Operation::Subtract) {
+      result = vsubq_f16(x, y);
+    } else if constexpr (Op == Operation::Multiply) {
+      result = vmulq_f16(x, y);
+    } else if constexpr (Op == Operation::Divide) {
+      result = vdivq_f16(x, y);
+    } else {
+      load_lanes<std::uint16_t, 8>(lanes, c + i);
+      result = vfmaq_f16(__builtin_bit_cast(float16x8_t, lanes), x, y);
+    }
+    lanes = __builtin_bit_cast(halves_type, result);
+    store_lanes<std::uint16_t, 8>(out + i, lanes);
+    if (any_inf_or_nan<8>(lanes)) {
+      apply_specials<Op, Format, RoundingPolicy, DenormalPolicy, 8>(
+          a + i, b + i, c + i, out + i);
+    }
+  }
+  return i;
+}
+
+#endif
+
+// The longest prefix the native kernels available under PlatformPolicy
+// compute (0 when there are none)
+template <Operation Op, typename Format, typename RoundingPolicy,
+          typename DenormalPolicy, typename PlatformPolicy>
+inline std::size_t native_apply_n([[maybe_unused]] const
+                                  typename Format::storage_type *a,
+                                  [[maybe_unused]] const
+                                  typename Format::storage_type *b,
+                                  [[maybe_unused]] const
+                                  typename Format::storage_type *c,
+                                  [[maybe_unused]]
+                                  typename Format::storage_type *out,
+                                  [[maybe_unused]] std::size_t n) {
+  if constexpr (PlatformPolicy::use_native) {
+#if defined(OPINE_NATIVE_X86_KERNELS)
+    if constexpr (avx512fp16_arithmetic<Op, Format, RoundingPolicy,
+                                        DenormalPolicy>) {
+      if (available<PlatformPolicy>(Feature::AVX512FP16)) {
+        return avx512fp16_apply_n<Op, Format, RoundingPolicy,
+                                  DenormalPolicy>(a, b, c, out, n);
+      }
+    }
+    if constexpr (f16c_arithmetic<Op, Format, RoundingPolicy,
+                                  DenormalPolicy>) {
+      if (available<PlatformPolicy>(Feature::F16C)) {
+        return f16c_apply_n<Op, Format, RoundingPolicy, DenormalPolicy>(
+            a, b, c, out, n);
+      }
+    }
+#elif defined(OPINE_NATIVE_ARM_KERNELS) &&                                  \
+    defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+    if constexpr (neon_arithmetic<Op, Format, RoundingPolicy,
+                                  DenormalPolicy>) {
+      return neon_apply_n<Op, Format, RoundingPolicy, DenormalPolicy>(
+          a, b, c, out, n);
+    }
+#endif
+  }
+  return 0;
+}
+
+template <Operation Op, typename Format, typename RoundingPolicy,
+          typename DenormalPolicy, typename PlatformPolicy>
+constexpr std::size_t
+apply_n(std::span<const typename Format::storage_type> a,
+        std::span<const typename Format::storage_type> b,
+        std::span<const typename Format::storage_type> c,
+        std::span<typename Format::storage_type> out) {
+  const std::size_t n = std::min({a.size(), b.size(), c.size(), out.size()});
+  std::size_t i = 0;
+  if (!std::is_constant_evaluated()) {
+    i = native_apply_n<Op, Format, RoundingPolicy, DenormalPolicy,
+                       PlatformPolicy>(a.data(), b.data(), c.data(),
+                                       out.data(), n);
+  }
+  for (; i < n; ++i) {
+    out[i] = apply<Op, Format, RoundingPolicy, DenormalPolicy>(a[i], b[i],
+                                                               c[i]);
+  }
+  return n;
+}
+
+} // namespace detail
+
+// True if the operation has a native kernel for this configuration on some
+// host of the target architecture
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr bool has_native_arithmetic =
+    detail::avx512fp16_arithmetic<detail::Operation::Add, Format,
+                                  RoundingPolicy, DenormalPolicy> ||
+    detail::neon_arithmetic<detail::Operation::Add, Format, RoundingPolicy,
+                            DenormalPolicy>;
+
+// out[i] = a[i] + b[i], for the smallest of the span sizes; returns the count
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy,
+          platform_policies::PlatformPolicy PlatformPolicy =
+              platform_policies::DefaultPlatformPolicy>
+constexpr std::size_t add_n(std::span<const typename Format::storage_type> a,
+                            std::span<const typename Format::storage_type> b,
+                            std::span<typename Format::storage_type> out) {
+  return detail::apply_n<detail::Operation::Add, Format, RoundingPolicy,
+                         DenormalPolicy, PlatformPolicy>(a, b, b, out);
+}
+
+// out[i] = a[i] - b[i]
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy,
+          platform_policies::PlatformPolicy PlatformPolicy =
+              platform_policies::DefaultPlatformPolicy>
+constexpr std::size_t
+subtract_n(std::span<const typename Format::storage_type> a,
+           std::span<const typename Format::storage_type> b,
+           std::span<typename Format::storage_type> out) {
+  return detail::apply_n<detail::Operation::Subtract, Format, RoundingPolicy,
+                         DenormalPolicy, PlatformPolicy>(a, b, b, out);
+}
+
+// out[i] = a[i] * b[i]
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy,
+          platform_policies::PlatformPolicy PlatformPolicy =
+              platform_policies::DefaultPlatformPolicy>
+constexpr std::size_t
+multiply_n(std::span<const typename Format::storage_type> a,
+           std::span<const typename Format::storage_type> b,
+           std::span<typename Format::storage_type> out) {
+  return detail::apply_n<detail::Operation::Multiply, Format, RoundingPolicy,
+                         DenormalPolicy, PlatformPolicy>(a, b, b, out);
+}
+
+// out[i] = a[i] / b[i]
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy,
+          platform_policies::PlatformPolicy PlatformPolicy =
+              platform_policies::DefaultPlatformPolicy>
+constexpr std::size_t
+divide_n(std::span<const typename Format::storage_type> a,
+         std::span<const typename Format::storage_type> b,
+         std::span<typename Format::storage_type> out) {
+  return detail::apply_n<detail::Operation::Divide, Format, RoundingPolicy,
+                         DenormalPolicy, PlatformPolicy>(a, b, b, out);
+}
+
+// out[i] = a[i] * b[i] + c[i], rounded once
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy,
+          platform_policies::PlatformPolicy PlatformPolicy =
+              platform_policies::DefaultPlatformPolicy>
+constexpr std::size_t fma_n(std::span<const typename Format::storage_type> a,
+                            std::span<const typename Format::storage_type> b,
+                            std::span<const typename Format::storage_type> c,
+                            std::span<typename Format::storage_type> out) {
+  return detail::apply_n<detail::Operation::Fma, Format, RoundingPolicy,
+                         DenormalPolicy, PlatformPolicy>(a, b, c, out);
+}
+
+} // namespace opine::inline v1::native
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <opine/operations/classify.hpp>
+#include <opine/operations/convert.hpp>
+#include <opine/operations/convert_n.hpp>
+#include <opine/platforms/native/features.hpp>
+#include <opine/platforms/simd/vector.hpp>
+#include <opine/policies/conversion.hpp>
+#include <opine/policies/platform.hpp>
+#include <opine/policies/rounding.hpp>
+#include <opine/policies/table.hpp>
+#include <span>
+#include <type_traits>
+
+#if defined(OPINE_NATIVE_X86_KERNELS)
+#include <immintrin.h>
+#elif defined(OPINE_NATIVE_ARM_KERNELS)
+#include <arm_neon.h>
+#endif
+
+namespace opine::inline v1::native {
+
+// Bulk fp16 <-> fp32 conversion with conversion instructions
+//
+// native::convert_n() has the contract of opine::convert_n(), results
+// included. Where the formats are IEEE binary16 and binary32 and the
+// host converts between them (features.hpp), it converts a register at a
+// time in hardware:
+//
+//   binary16 -> binary32   exact: any conversion policy
+//   binary32 -> binary16   Conversion<R, Saturate> with R one of the IEEE
+//                          rounding directions (round to nearest even only
+//                          on Arm, which takes it from FPCR)
+//
+// Hardware and OPINE agree on every finite result. They differ on NaNs
+// (hardware keeps the payload, convert() returns the quiet NaN) and on
+// saturating overflow, so lanes whose result is Inf or NaN are converted
+// again by convert(); those are rare in real data. Everything else, the
+// tail of each span, constant evaluation, and hosts without the feature
+// under PlatformPolicy go through opine::convert_n(), as do instrumented
+// conversion policies, which count each element. The kernels assume
+// the default floating-point environment (no DAZ, round to nearest on Arm).
+
+namespace detail {
+
+// The IEEE binary interchange layout with ExpBits and MantBits
+template <typename Format, int ExpBits, int MantBits>
+constexpr bool is_ieee_binary =
+    Format::is_standard_layout() && Format::exp_bits == ExpBits &&
+    Format::mant_bits == MantBits && Format::has_implicit_bit &&
+    Format::exp_bias == (1 << (ExpBits - 1)) - 1 &&
+    opine::detail::special_encoding<Format> ==
+        special_value_policies::SpecialValueEncoding::IEEE &&
+    simd::is_lane_compatible<typename Format::storage_type>;
+
+template <typename Format>
+constexpr bool is_binary16 = is_ieee_binary<Format, 5, 10>;
+
+template <typename Format>
+constexpr bool is_binary32 = is_ieee_binary<Format, 8, 23>;
+
+// x86 immediate rounding mode of a rounding policy (_MM_FROUND_TO_*), or -1
+// for one no instruction implements
+template <typename RoundingPolicy> constexpr int rounding_mode = -1;
+template <>
+constexpr int rounding_mode<rounding_policies::ToNearestTiesToEven> = 0;
+template <> constexpr int rounding_mode<rounding_policies::TowardNegative> = 1;
+template <> constexpr int rounding_mode<rounding_policies::TowardPositive> = 2;
+template <> constexpr int rounding_mode<rounding_policies::TowardZero> = 3;
+
+// True if Arm instructions implement the rounding policy (FPCR's default
+// rounding, to nearest even)
+template <typename RoundingPolicy>
+constexpr bool arm_rounding =
+    std::is_same_v<RoundingPolicy, rounding_policies::ToNearestTiesToEven>;
+
+enum class Conversion { None, Widen, Narrow };
+
+template <typename Src, typename Dst, typename ConversionPolicy>
+constexpr Conversion native_conversion =
+    conversion_policies::is_instrumented<ConversionPolicy> ? Conversion::None
+    : is_binary16<Src> && is_binary32<Dst> ? Conversion::Widen
+    : is_binary32<Src> && is_binary16<Dst> &&
+            rounding_mode<typename ConversionPolicy::rounding_policy> >= 0
+        ? Conversion::Narrow
+        : Conversion::None;
+
+// True if the Inf/NaN exponent is set in storage bits of a standard layout
+template <typename Format>
+constexpr bool is_inf_or_nan_bits(typename Format::storage_type bits) {
+  constexpr auto exponent_field =
+      static_cast<typename Format::storage_type>(
+          ((std::uint64_t{1} << Format::exp_bits) - 1) << Format::exp_offset);
+  return (bits & exponent_field) == exponent_field;
+}
+
+// Convert lanes whose native result is Inf or NaN again with convert()
+template <typename Dst, typename Src, typename ConversionPolicy,
+          std::size_t N>
+inline void convert_specials(const typename Src::storage_type *src,
+                             typename Dst::storage_type *dst) {
+  for (std::size_t i = 0; i < N; ++i) {
+    if (is_inf_or_nan_bits<Dst>(dst[i])) {
+      dst[i] = convert<Dst, Src, ConversionPolicy>(src[i]);
+    }
+  }
+}
+
+#if defined(OPINE_NATIVE_X86_KERNELS) || defined(OPINE_NATIVE_ARM_KERNELS)
+
+// Load N storage values as N unsigned lanes of type Lane
+//
+// Kernels move between these generic vectors and the instruction set's
+// register types (__m256, __m512h, float16x8_t, ...) with
+// __builtin_bit_cast (std::bit_cast is a function returning the register,
+// which -Wpsabi flags outside the kernels' target attributes).
+//
+// 64-bit storage (uint_fast16_t on x86-64 Linux) is narrowed and widened
+// through 32-bit lanes: GCC lowers the direct 64 <-> 16-bit conversion one
+// element at a time.
+template <typename Lane, std::size_t N, typename T>
+inline void load_lanes(simd::vec<Lane, N> &lanes, const T *src) {
+  using S = simd::lane_t<sizeof(T)>;
+  simd::vec<S, N> v;
+  simd::load<N>(v, src);
+  if constexpr (sizeof(Lane) < 4 && sizeof(S) == 8) {
+    const auto words = __builtin_convertvector(v, simd::vec<std::uint32_t, N>);
+    lanes = __builtin_convertvector(words, simd::vec<Lane, N>);
+  } else {
+    lanes = __builtin_convertvector(v, simd::vec<Lane, N>);
+  }
+}
+
+// Store N unsigned lanes into N storage values
+template <typename Lane, std::size_t N, typename T>
+inline void store_lanes(T *dst, const simd::vec<Lane, N> &lanes) {
+  using S = simd::lane_t<sizeof(T)>;
+  if constexpr (sizeof(Lane) < 4 && sizeof(S) == 8) {
+    const auto words =
+        __builtin_convertvector(lanes, simd::vec<std::uint32_t, N>);
+    simd::store<N>(dst, __builtin_convertvector(words, simd::vec<S, N>));
+  } else {
+    simd::store<N>(dst, __builtin_convertvector(lanes, simd::vec<S, N>));
+  }
+}
+
+// True if any binary16 lane is Inf or NaN
+template <std::size_t N>
+inline bool any_inf_or_nan(const simd::vec<std::uint16_t, N> &halves) {
+  const simd::vec<std::uint16_t, N> special = (halves & 0x7C00) == 0x7C00;
+  std::uint64_t words[sizeof(special) / 8];
+  std::memcpy(words, &special, sizeof(special));
+  std::uint64_t any = 0;
+  for (const auto word : words) {
+    any |= word;
+  }
+  return any != 0;
+}
+
+#endif
+
+#if defined(OPINE_NATIVE_X86_KERNELS)
+
+// F16C: 8 lanes per step; returns the count converted (a multiple of 8)
+template <typename Dst, typename Src, typename ConversionPolicy>
+__attribute__((target("f16c,avx"))) inline std::size_t
+f16c_convert_n(const typename Src::storage_type *src,
+               typename Dst::storage_type *dst, std::size_t n) {
+  constexpr auto kind = native_conversion<Src, Dst, ConversionPolicy>;
+
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    simd::vec<std::uint16_t, 8> halves;
+    if constexpr (kind == Conversion::Widen) {
+      load_lanes<std::uint16_t, 8>(halves, src + i);
+      const __m256 singles =
+          _mm256_cvtph_ps(__builtin_bit_cast(__m128i, halves));
+      store_lanes<std::uint32_t, 8>(
+          dst + i, __builtin_bit_cast(simd::vec<std::uint32_t, 8>, singles));
+    } else {
+      constexpr int mode =
+          rounding_mode<typename ConversionPolicy::rounding_policy>;
+      simd::vec<std::uint32_t, 8> singles;
+      load_lanes<std::uint32_t, 8>(singles, src + i);
+      halves = __builtin_bit_cast(
+          simd::vec<std::uint16_t, 8>,
+          _mm256_cvtps_ph(__builtin_bit_cast(__m256, singles), mode));
+      store_lanes<std::uint16_t, 8>(dst + i, halves);
+    }
+    if (any_inf_or_nan<8>(halves)) {
+      convert_specials<Dst, Src, ConversionPolicy, 8>(src + i, dst + i);
+    }
+  }
+  return i;
+}
+
+#elif defined(OPINE_NATIVE_ARM_KERNELS)
+
+// NEON: 4 lanes per step; returns the count converted (a multiple of 4)
+template <typename Dst, typename Src, typename ConversionPolicy>
+inline std::size_t neon_convert_n(const typename Src::storage_type *src,
+                                  typename Dst::storage_type *dst,
+                                  std::size_t n) {
+  constexpr auto kind = native_conversion<Src, Dst, ConversionPolicy>;
+
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    simd::vec<std::uint16_t, 4> halves;
+    if constexpr (kind == Conversion::Widen) {
+      load_lanes<std::uint16_t, 4>(halves, src + i);
+      const float32x4_t singles =
+          vcvt_f32_f16(__builtin_bit_cast(float16x4_t, halves));
+      store_lanes<std::uint32_t, 4>(
+          dst + i, __builtin_bit_cast(simd::vec<std::uint32_t, 4>, singles));
+    } else {
+      simd::vec<std::uint32_t, 4> singles;
+      load_lanes<std::uint32_t, 4>(singles, src + i);
+      halves = __builtin_bit_cast(
+          simd::vec<std::uint16_t, 4>,
+          vcvt_f16_f32(__builtin_bit_cast(float32x4_t, singles)));
+      store_lanes<std::uint16_t, 4>(dst + i, halves);
+    }
+    if (any_inf_or_nan<4>(halves)) {
+      convert_specials<Dst, Src, ConversionPolicy, 4>(src + i, dst + i);
+    }
+  }
+  return i;
+}
+
+#endif
+
+} // namespace detail
+
+// True if native::convert_n() has a hardware path for this configuration
+// when the feature it needs is available (native_conversion_feature)
+template <typename Src, typename Dst,
+          typename ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy>
+constexpr bool has_native_conversion =
+    detail::native_conversion<Src, Dst, ConversionPolicy> ==
+        detail::Conversion::Widen ||
+    (detail::native_conversion<Src, Dst, ConversionPolicy> ==
+         detail::Conversion::Narrow &&
+     (detail::has_x86_kernels ||
+      detail::arm_rounding<typename ConversionPolicy::rounding_policy>));
+
+// The feature the hardware path of this target uses
+constexpr Feature native_conversion_feature =
+    detail::has_arm_kernels ? Feature::NeonFP16 : Feature::F16C;
+
+// Bulk convert: convert min(src.size(), dst.size()) values, return the count
+template <typename Dst, typename Src,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy,
+          platform_policies::PlatformPolicy PlatformPolicy =
+              platform_policies::DefaultPlatformPolicy>
+constexpr std::size_t convert_n(std::span<const typename Src::storage_type> src,
+                                std::span<typename Dst::storage_type> dst) {
+#if defined(OPINE_NATIVE_X86_KERNELS) || defined(OPINE_NATIVE_ARM_KERNELS)
+  if constexpr (PlatformPolicy::use_native &&
+                has_native_conversion<Src, Dst, ConversionPolicy>) {
+    if (!std::is_constant_evaluated() &&
+        available<PlatformPolicy>(native_conversion_feature)) {
+      const std::size_t n = std::min(src.size(), dst.size());
+#if defined(OPINE_NATIVE_X86_KERNELS)
+      const std::size_t i =
+          detail::f16c_convert_n<Dst, Src, ConversionPolicy>(
+              src.data(), dst.data(), n);
+#else
+      const std::size_t i =
+          detail::neon_convert_n<Dst, Src, ConversionPolicy>(
+              src.data(), dst.data(), n);
+#endif
+      ::opine::convert_n<Dst, Src, ConversionPolicy, TablePolicy>(
+          src.subspan(i, n - i), dst.subspan(i, n - i));
+      return n;
+    }
+  }
+#endif
+
+  return ::opine::convert_n<Dst, Src, ConversionPolicy, TablePolicy>(src,
+                                                                     dst);
+}
+
+} // namespace opine::inline v1::native
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <opine/policies/platform.hpp>
+
+// Native fp16 instruction detection
+//
+// Some hosts convert and compute on IEEE binary16 in hardware:
+//
+//   F16C                 x86: fp16 <-> fp32 conversion, 8 lanes
+//                        (vcvtph2ps, vcvtps2ph with an immediate rounding
+//                        mode); Ivy Bridge, Piledriver and later
+//   AVX512FP16           x86: fp16 add, subtract, multiply, divide and fma,
+//                        32 lanes, with embedded rounding; Sapphire Rapids
+//   NeonFP16             AArch64: fp16 <-> fp32 conversion (fcvtl, fcvtn),
+//                        every AArch64 core
+//   NeonFP16Arithmetic   AArch64: fp16 vector arithmetic (FEAT_FP16,
+//                        ARMv8.2-A and later)
+//
+// compiled_for() reports what the translation unit's target flags enable;
+// cpu_supports() asks the CPU (cpuid on x86, once per process). There is no
+// fp8 entry: the fp8 instructions (AVX10.2, AMX-FP8, Arm FEAT_FP8) have no
+// intrinsics in the supported compilers yet, and fp8 conversion is already
+// one table load per element (operations/convert_n.hpp).
+
+// Kernel families this compiler can build: x86 kernels through target
+// attributes whatever the flags, Arm kernels only for the compiled target
+#if (defined(__GNUC__) || defined(__clang__)) &&                            \
+    (defined(__x86_64__) || defined(__i386__))
+#define OPINE_NATIVE_X86_KERNELS 1
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__) &&  \
+    defined(__ARM_NEON) && defined(__ARM_FP16_FORMAT_IEEE)
+#define OPINE_NATIVE_ARM_KERNELS 1
+#endif
+
+namespace opine::inline v1::native {
+
+enum class Feature { F16C, AVX512FP16, NeonFP16, NeonFP16Arithmetic };
+
+namespace detail {
+
+#if defined(OPINE_NATIVE_X86_KERNELS)
+constexpr bool has_x86_kernels = true;
+#else
+constexpr bool has_x86_kernels = false;
+#endif
+
+#if defined(OPINE_NATIVE_ARM_KERNELS)
+constexpr bool has_arm_kernels = true;
+#else
+constexpr bool has_arm_kernels = false;
+#endif
+
+#if defined(__F16C__)
+constexpr bool compiled_f16c = true;
+#else
+constexpr bool compiled_f16c = false;
+#endif
+
+#if defined(__AVX512FP16__)
+constexpr bool compiled_avx512fp16 = true;
+#else
+constexpr bool compiled_avx512fp16 = false;
+#endif
+
+#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+constexpr bool compiled_neon_fp16_arithmetic = has_arm_kernels;
+#else
+constexpr bool compiled_neon_fp16_arithmetic = false;
+#endif
+
+} // namespace detail
+
+// True if the translation unit is compiled for the feature
+constexpr bool compiled_for(Feature feature) {
+  switch (feature) {
+  case Feature::F16C:
+    return detail::has_x86_kernels && detail::compiled_f16c;
+  case Feature::AVX512FP16:
+    return detail::has_x86_kernels && detail::compiled_avx512fp16;
+  case Feature::NeonFP16:
+    return detail::has_arm_kernels;
+  default:
+    return detail::compiled_neon_fp16_arithmetic;
+  }
+}
+
+// True if the CPU running the program has the feature (on Arm, what the
+// translation unit is compiled for: there is no run-time check)
+inline bool cpu_supports(Feature feature) {
+#if defined(OPINE_NATIVE_X86_KERNELS)
+  // The checks include the operating system's support for the register
+  // state (XGETBV), and may run before static initializers
+  static const bool f16c = (__builtin_cpu_init(),
+                            __builtin_cpu_supports("f16c") &&
+                                __builtin_cpu_supports("avx"));
+  static const bool avx512fp16 =
+      (__builtin_cpu_init(), __builtin_cpu_supports("avx512fp16"));
+  switch (feature) {
+  case Feature::F16C:
+    return f16c;
+  case Feature::AVX512FP16:
+    return avx512fp16;
+  default:
+    return false;
+  }
+#else
+  return compiled_for(feature);
+#endif
+}
+
+// True if kernels using the feature may run under PlatformPolicy: compiled
+// for it, or detected on this CPU when the policy allows
+template <platform_policies::PlatformPolicy PlatformPolicy>
+inline bool available(Feature feature) {
+  if constexpr (!PlatformPolicy::use_native) {
+    return false;
+  } else if constexpr (PlatformPolicy::detect_at_runtime) {
+    return compiled_for(feature) || cpu_supports(feature);
+  } else {
+    return compiled_for(feature);
+  }
+}
+
+} // namespace opine::inline v1::native
@@ -0,0 +1,400 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <opine/operations/order.hpp>
+#include <opine/platforms/simd/vector.hpp>
+#include <span>
+#include <type_traits>
+
+namespace opine::inline v1::simd {
+
+// SIMD ordering kernels for standard IEEE-like layouts
+//
+// For a format laid out [S][E][M] with no padding, the order key
+// (operations/order.hpp) is computed from the storage bits with lane-wise
+// constants only:
+//
+//   magnitude = v & (top - 1)
+//   negative  = (v & top) != 0                    (all-ones lanes)
+//   key       = (magnitude | top) ^ (negative & key_mask)
+//
+// (FNUZ formats select (top - magnitude) & (top - 1) for negative lanes
+// instead), and a NaN is a key outside [smallest_ordered_key,
+// largest_ordered_key], two lane comparisons. Reductions keep one running
+// max/min per lane and reduce the register at the end; argmax_n() then finds
+// the first lane holding the result. top_k_n() tests a whole register of
+// keys against the current threshold and only looks at the elements of a
+// register that has a candidate.
+//
+// Configurations without a kernel and the tail of each span go through the
+// scalar functions, so results are identical to the opine:: ones.
+
+namespace detail {
+
+// Bytes of the narrowest standard unsigned integer that holds an order key
+template <typename Format>
+constexpr std::size_t order_compute_bytes =
+    ::opine::detail::order_key_bits<Format> <= 8    ? 1
+    : ::opine::detail::order_key_bits<Format> <= 16 ? 2
+    : ::opine::detail::order_key_bits<Format> <= 32 ? 4
+                                                    : 8;
+
+} // namespace detail
+
+// True if the simd:: ordering functions have vector kernels for the format
+template <typename Format>
+constexpr bool has_order_kernel =
+    enabled && Format::is_standard_layout() &&
+    is_lane_compatible<typename Format::storage_type> &&
+    is_lane_compatible<order_key_t<Format>>;
+
+// Number of elements the kernels process per iteration (1 without a kernel)
+//
+// Keys are computed in lanes of the key's width (16 bits for fp16), whatever
+// the storage type's size: uint_fast16_t storage is 8 bytes on x86-64 Linux,
+// and SSE2 has no 64-bit lane comparisons.
+template <typename Format>
+constexpr std::size_t order_lanes =
+    has_order_kernel<Format>
+        ? lanes_per_register<lane_t<detail::order_compute_bytes<Format>>>
+        : 1;
+
+#if defined(__GNUC__) || defined(__clang__)
+
+namespace detail {
+
+// Lanes the keys are computed in, and the storage and key lanes
+template <typename Format>
+using order_lane_t = lane_t<order_compute_bytes<Format>>;
+
+template <typename Format>
+using order_vec = vec<order_lane_t<Format>, order_lanes<Format>>;
+
+template <typename Format>
+using storage_vec = vec<lane_t<sizeof(typename Format::storage_type)>,
+                        order_lanes<Format>>;
+
+template <typename Format>
+using key_vec =
+    vec<lane_t<sizeof(order_key_t<Format>)>, order_lanes<Format>>;
+
+template <typename Format> constexpr auto lane_constant(auto value) {
+  return static_cast<order_lane_t<Format>>(value);
+}
+
+// Load the encodings at bits, narrowed to key lanes (the bits above the key
+// are not part of the encoding)
+template <typename Format>
+inline void load_encodings(order_vec<Format> &v,
+                           const typename Format::storage_type *bits) {
+  storage_vec<Format> wide;
+  load<order_lanes<Format>>(wide, bits);
+  v = __builtin_convertvector(wide, order_vec<Format>);
+}
+
+// All-ones/all-zeros key lanes as storage lanes (sign extension)
+template <typename Format>
+inline void widen_mask(storage_vec<Format> &wide_mask,
+                       const order_vec<Format> &mask) {
+  constexpr std::size_t lanes = order_lanes<Format>;
+  using narrow = vec<std::make_signed_t<order_lane_t<Format>>, lanes>;
+  using wide = vec<std::make_signed_t<lane_t<sizeof(
+                       typename Format::storage_type)>>,
+                   lanes>;
+  wide_mask =
+      (storage_vec<Format>)__builtin_convertvector((narrow)mask, wide);
+}
+
+// Keys of one register of encodings
+template <typename Format>
+inline void order_keys(order_vec<Format> &key, const order_vec<Format> &v) {
+  using S = order_lane_t<Format>;
+  using V = order_vec<Format>;
+  constexpr S top =
+      lane_constant<Format>(::opine::detail::order_key_top<Format>);
+  constexpr S mask =
+      lane_constant<Format>(::opine::detail::order_key_mask<Format>);
+
+  const V magnitude = v & S(top - 1);
+  const V negative = (V)((v & top) != S{0});
+  if constexpr (::opine::detail::special_encoding<Format> ==
+                special_value_policies::SpecialValueEncoding::FNUZ) {
+    const V negative_key = (S(top) - magnitude) & S(top - 1);
+    key = (negative & negative_key) | (~negative & (magnitude | top));
+  } else {
+    key = (magnitude | top) ^ (negative & mask);
+  }
+}
+
+// All-ones lanes where the key is a number's
+template <typename Format>
+inline void ordered_lanes(order_vec<Format> &ordered,
+                          const order_vec<Format> &key) {
+  using S = order_lane_t<Format>;
+  using V = order_vec<Format>;
+  constexpr S smallest =
+      lane_constant<Format>(::opine::detail::smallest_ordered_key<Format>);
+  constexpr S largest =
+      lane_constant<Format>(::opine::detail::largest_ordered_key<Format>);
+  constexpr S mask =
+      lane_constant<Format>(::opine::detail::order_key_mask<Format>);
+
+  ordered = ~V{};
+  if constexpr (smallest != 0) {
+    ordered &= (V)(key >= smallest);
+  }
+  if constexpr (largest != mask) {
+    ordered &= (V)(key <= largest);
+  }
+}
+
+template <typename Format> inline bool any_lane(const order_vec<Format> &v) {
+  order_lane_t<Format> lanes[order_lanes<Format>];
+  std::memcpy(lanes, &v, sizeof(v));
+  order_lane_t<Format> any = 0;
+  for (auto lane : lanes) {
+    any |= lane;
+  }
+  return any != 0;
+}
+
+// Vector argmax_n() (Largest) and argmin_n()
+template <typename Format, bool Largest>
+inline std::size_t
+arg_extreme_n(std::span<const typename Format::storage_type> bits) {
+  using S = order_lane_t<Format>;
+  using V = order_vec<Format>;
+  constexpr std::size_t lanes = order_lanes<Format>;
+  const std::size_t n = bits.size();
+  const std::size_t blocks = n - n % lanes;
+
+  // Pass 1: the extreme key; NaN lanes are replaced by the identity
+  V best = V{} + S(Largest ? 0 : ~S{0});
+  V any = V{};
+  for (std::size_t i = 0; i < blocks; i += lanes) {
+    V v, key, ordered;
+    load_encodings<Format>(v, bits.data() + i);
+    order_keys<Format>(key, v);
+    ordered_lanes<Format>(ordered, key);
+    const V candidate = Largest ? (key & ordered) : (key | ~ordered);
+    const V take = Largest ? (V)(candidate > best) : (V)(candidate < best);
+    best = (take & candidate) | (~take & best);
+    any |= ordered;
+  }
+
+  S lanes_best[lanes];
+  std::memcpy(lanes_best, &best, sizeof(best));
+  S result = Largest ? 0 : ~S{0};
+  for (S lane : lanes_best) {
+    result = Largest ? std::max(result, lane) : std::min(result, lane);
+  }
+  bool found = any_lane<Format>(any);
+  for (std::size_t i = blocks; i < n; ++i) {
+    const auto key = static_cast<S>(order_key<Format>(bits[i]));
+    if (is_ordered_key<Format>(key)) {
+      result = !found             ? key
+               : Largest          ? std::max(result, key)
+                                  : std::min(result, key);
+      found = true;
+    }
+  }
+  if (!found) {
+    return n;
+  }
+
+  // Pass 2: the first register with that key, then the lane in it
+  std::size_t start = blocks;
+  for (std::size_t i = 0; i < blocks; i += lanes) {
+    V v, key, ordered;
+    load_encodings<Format>(v, bits.data() + i);
+    order_keys<Format>(key, v);
+    ordered_lanes<Format>(ordered, key);
+    if (any_lane<Format>((V)(key == result) & ordered)) {
+      start = i;
+      break;
+    }
+  }
+  for (std::size_t i = start; i < n; ++i) {
+    const auto key = static_cast<S>(order_key<Format>(bits[i]));
+    if (key == result && is_ordered_key<Format>(key)) {
+      return i;
+    }
+  }
+  return n;
+}
+
+} // namespace detail
+
+#endif
+
+// Same contract as opine::order_keys_n()
+//
+// Key types wider than the key (uint_fast16_t) take the scalar loop: it is
+// bound by the stores, and the compiler vectorizes it at the key type's width.
+template <typename Format>
+constexpr std::size_t
+order_keys_n(std::span<const typename Format::storage_type> bits,
+             std::span<order_key_t<Format>> keys) {
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (has_order_kernel<Format> &&
+                sizeof(order_key_t<Format>) ==
+                    detail::order_compute_bytes<Format>) {
+    if (!std::is_constant_evaluated()) {
+      using V = detail::order_vec<Format>;
+      constexpr std::size_t lanes = order_lanes<Format>;
+      const std::size_t n = std::min(bits.size(), keys.size());
+
+      std::size_t i = 0;
+      for (; i + lanes <= n; i += lanes) {
+        V v, key;
+        detail::load_encodings<Format>(v, bits.data() + i);
+        detail::order_keys<Format>(key, v);
+        const auto wide_key =
+            __builtin_convertvector(key, detail::key_vec<Format>);
+        store<lanes>(keys.data() + i, wide_key);
+      }
+      ::opine::order_keys_n<Format>(bits.subspan(i, n - i),
+                                    keys.subspan(i, n - i));
+      return n;
+    }
+  }
+#endif
+
+  return ::opine::order_keys_n<Format>(bits, keys);
+}
+
+// Same contract as opine::argmax_n()
+template <typename Format>
+constexpr std::size_t
+argmax_n(std::span<const typename Format::storage_type> bits) {
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (has_order_kernel<Format>) {
+    if (!std::is_constant_evaluated()) {
+      return detail::arg_extreme_n<Format, true>(bits);
+    }
+  }
+#endif
+
+  return ::opine::argmax_n<Format>(bits);
+}
+
+// Same contract as opine::argmin_n()
+template <typename Format>
+constexpr std::size_t
+argmin_n(std::span<const typename Format::storage_type> bits) {
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (has_order_kernel<Format>) {
+    if (!std::is_constant_evaluated()) {
+      return detail::arg_extreme_n<Format, false>(bits);
+    }
+  }
+#endif
+
+  return ::opine::argmin_n<Format>(bits);
+}
+
+// Same contract as opine::max_n()
+template <typename Format>
+constexpr typename Format::storage_type
+max_n(std::span<const typename Format::storage_type> bits) {
+  const std::size_t index = simd::argmax_n<Format>(bits);
+  return index < bits.size() ? bits[index]
+                             : ::opine::detail::no_number<Format>();
+}
+
+// Same contract as opine::min_n()
+template <typename Format>
+constexpr typename Format::storage_type
+min_n(std::span<const typename Format::storage_type> bits) {
+  const std::size_t index = simd::argmin_n<Format>(bits);
+  return index < bits.size() ? bits[index]
+                             : ::opine::detail::no_number<Format>();
+}
+
+// Same contract as opine::clamp_n()
+template <typename Format>
+constexpr std::size_t
+clamp_n(std::span<const typename Format::storage_type> bits,
+        typename Format::storage_type lo, typename Format::storage_type hi,
+        std::span<typename Format::storage_type> out) {
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (has_order_kernel<Format>) {
+    if (!std::is_constant_evaluated()) {
+      using S = detail::order_lane_t<Format>;
+      using V = detail::order_vec<Format>;
+      using W = detail::storage_vec<Format>;
+      using storage_lane = lane_t<sizeof(typename Format::storage_type)>;
+      constexpr std::size_t lanes = order_lanes<Format>;
+      const std::size_t n = std::min(bits.size(), out.size());
+      const W lo_bits = W{} + static_cast<storage_lane>(lo);
+      const W hi_bits = W{} + static_cast<storage_lane>(hi);
+      const V lo_key = V{} + static_cast<S>(order_key<Format>(lo));
+      const V hi_key = V{} + static_cast<S>(order_key<Format>(hi));
+
+      std::size_t i = 0;
+      for (; i + lanes <= n; i += lanes) {
+        W wide;
+        load<lanes>(wide, bits.data() + i);
+        const V v = __builtin_convertvector(wide, V);
+        V key, ordered;
+        detail::order_keys<Format>(key, v);
+        detail::ordered_lanes<Format>(ordered, key);
+        W below, above;
+        detail::widen_mask<Format>(below, (V)(key < lo_key) & ordered);
+        detail::widen_mask<Format>(above, (V)(key > hi_key) & ordered);
+        const W r = (below & lo_bits) | (above & hi_bits) |
+                    (~(below | above) & wide);
+        store<lanes>(out.data() + i, r);
+      }
+      ::opine::clamp_n<Format>(bits.subspan(i, n - i), lo, hi,
+                               out.subspan(i, n - i));
+      return n;
+    }
+  }
+#endif
+
+  return ::opine::clamp_n<Format>(bits, lo, hi, out);
+}
+
+// Same contract as opine::top_k_n()
+template <typename Format>
+constexpr std::size_t
+top_k_n(std::span<const typename Format::storage_type> bits,
+        std::span<std::size_t> indices) {
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (has_order_kernel<Format>) {
+    if (!std::is_constant_evaluated()) {
+      using S = detail::order_lane_t<Format>;
+      using V = detail::order_vec<Format>;
+      constexpr std::size_t lanes = order_lanes<Format>;
+      const std::size_t n = bits.size();
+
+      ::opine::detail::top_k_heap<Format> heap{bits, indices};
+      std::size_t i = heap.fill();
+      if (heap.count == indices.size() && heap.count > 0) {
+        for (; i + lanes <= n; i += lanes) {
+          V v, key;
+          detail::load_encodings<Format>(v, bits.data() + i);
+          detail::order_keys<Format>(key, v);
+          const V threshold = V{} + static_cast<S>(heap.threshold());
+          if (detail::any_lane<Format>((V)(key > threshold))) {
+            for (std::size_t j = i; j < i + lanes; ++j) {
+              heap.offer(j);
+            }
+          }
+        }
+        for (; i < n; ++i) {
+          heap.offer(i);
+        }
+      }
+      return heap.finish();
+    }
+  }
+#endif
+
+  return ::opine::top_k_n<Format>(bits, indices);
+}
+
+} // namespace opine::inline v1::simd
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <opine/operations/pack_unpack_n.hpp>
+#include <opine/platforms/simd/vector.hpp>
+#include <span>
+#include <type_traits>
+
+namespace opine::inline v1::simd {
+
+// SIMD field extraction for standard IEEE-like layouts
+//
+// unpack() pulls the sign, exponent and mantissa out of the storage bits with
+// shift-and-mask constants taken from the FormatDescriptor. For formats whose
+// fields are laid out [S][E][M] with no padding, those constants are the same
+// for every lane, so one vector shift and one vector AND extract a field from
+// a whole register of values at once:
+//
+//   storage  v = [s|eeee|mmm] x N lanes
+//   sign       = (v & sign_field) != 0
+//   exponent   = (v >> exp_offset) & exp_mask
+//   mantissa   = ((v & mant_mask) << guard_bits) | (exponent != 0 ? implicit)
+//
+// Every output stream is then narrowed or widened to its own lane width
+// (bool, exponent_type, mantissa_type) with one conversion per register.
+//
+// Configurations without a kernel (padded layouts, types that do not fit a
+// vector lane, compilers without vector extensions) and the tail of each span
+// go through the scalar opine::unpack_n(), so results are always identical to
+// the scalar reference path.
+
+// True if simd::unpack_n() has a vector kernel for this configuration
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+constexpr bool has_unpack_kernel =
+    enabled && Format::is_standard_layout() &&
+    is_lane_compatible<typename Format::storage_type> &&
+    is_lane_compatible<typename Format::exponent_type> &&
+    is_lane_compatible<unpacked_mantissa_t<Format, RoundingPolicy>>;
+
+// Number of elements the kernel processes per iteration (1 without a kernel)
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+constexpr std::size_t unpack_lanes =
+    has_unpack_kernel<Format, RoundingPolicy>
+        ? lanes_per_register<typename Format::storage_type>
+        : 1;
+
+#if defined(__GNUC__) || defined(__clang__)
+
+namespace detail {
+
+// Unpack exactly N consecutive elements
+template <typename Format, typename RoundingPolicy, std::size_t N>
+inline void
+unpack_block(const typename Format::storage_type *bits, bool *sign,
+             typename Format::exponent_type *exponent,
+             unpacked_mantissa_t<Format, RoundingPolicy> *mantissa) {
+  using S = lane_t<sizeof(typename Format::storage_type)>;
+  using E = lane_t<sizeof(typename Format::exponent_type)>;
+  using M = lane_t<sizeof(unpacked_mantissa_t<Format, RoundingPolicy>)>;
+  using B = lane_t<sizeof(bool)>;
+
+  constexpr S sign_field = static_cast<S>(
+      ((S{1} << Format::sign_bits) - 1) << Format::sign_offset);
+  constexpr S exp_mask = static_cast<S>((S{1} << Format::exp_bits) - 1);
+  constexpr S mant_mask = static_cast<S>((S{1} << Format::mant_bits) - 1);
+
+  vec<S, N> v;
+  load<N>(v, bits);
+
+  // Sign: comparison lanes are all-ones/all-zeros, reduce them to 0/1
+  vec<S, N> s = (vec<S, N>)((v & sign_field) != S{0}) & S{1};
+  vec<B, N> s_out = __builtin_convertvector(s, vec<B, N>);
+  store<N>(sign, s_out);
+
+  // Exponent
+  vec<S, N> e = (v >> Format::exp_offset) & exp_mask;
+  vec<E, N> e_out = __builtin_convertvector(e, vec<E, N>);
+  store<N>(exponent, e_out);
+
+  // Mantissa, computed at the width of the unpacked mantissa type
+  vec<S, N> m_stored = (v >> Format::mant_offset) & mant_mask;
+  vec<M, N> m = __builtin_convertvector(m_stored, vec<M, N>);
+  m = m << RoundingPolicy::guard_bits;
+
+  if constexpr (Format::has_implicit_bit) {
+    constexpr M implicit_bit = static_cast<M>(
+        M{1} << (Format::mant_bits + RoundingPolicy::guard_bits));
+    vec<M, N> e_wide = __builtin_convertvector(e, vec<M, N>);
+    m |= (vec<M, N>)(e_wide != M{0}) & implicit_bit;
+  }
+
+  store<N>(mantissa, m);
+}
+
+} // namespace detail
+
+#endif
+
+// Unpack a span of storage values into SoA buffers using the SIMD kernel
+//
+// Same contract as opine::unpack_n(): processes the smallest of the span sizes
+// and returns that count. Constant evaluation always takes the scalar path.
+template <typename Format,
+          typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy>
+constexpr std::size_t
+unpack_n(std::span<const typename Format::storage_type> bits,
+         std::span<bool> sign,
+         std::span<typename Format::exponent_type> exponent,
+         std::span<unpacked_mantissa_t<Format, RoundingPolicy>> mantissa) {
+#if defined(__GNUC__) || defined(__clang__)
+  if constexpr (has_unpack_kernel<Format, RoundingPolicy>) {
+    if (!std::is_constant_evaluated()) {
+      constexpr std::size_t lanes = unpack_lanes<Format, RoundingPolicy>;
+      const std::size_t n = std::min(
+          {bits.size(), sign.size(), exponent.size(), mantissa.size()});
+
+      std::size_t i = 0;
+      for (; i + lanes <= n; i += lanes) {
+        detail::unpack_block<Format, RoundingPolicy, lanes>(
+            bits.data() + i, sign.data() + i, exponent.data() + i,
+            mantissa.data() + i);
+      }
+
+      // Scalar tail
+      const std::size_t rest = n - i;
+      ::opine::unpack_n<Format, RoundingPolicy>(
+          bits.subspan(i, rest), sign.subspan(i, rest),
+          exponent.subspan(i, rest), mantissa.subspan(i, rest));
+      return n;
+    }
+  }
+#endif
+
+  return ::opine::unpack_n<Format, RoundingPolicy>(bits, sign, exponent,
+                                                   mantissa);
+}
+
+} // namespace opine::inline v1::simd
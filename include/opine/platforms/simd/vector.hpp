@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// SIMD platform layer: register width detection and portable vector types
+//
+// Kernels in opine/platforms/simd/ are written once against the GCC/Clang
+// generic vector extension (__attribute__((vector_size))). The compiler lowers
+// those vector types to whatever ISA the translation unit is built for, so
+// the same source becomes:
+//
+//   -mavx512bw          64-byte zmm vectors (64 fp8 / 32 fp16 lanes)
+//   -mavx2              32-byte ymm vectors (32 fp8 / 16 fp16 lanes)
+//   x86-64 baseline     16-byte xmm vectors (SSE2)
+//   AArch64             16-byte NEON vectors
+//
+// On compilers without the vector extension (MSVC) or on targets without a
+// vector unit (6502, Cortex-M0), simd::enabled is false and every kernel
+// forwards to the scalar templates. Nothing here changes results: the SIMD
+// kernels are bit-identical to the scalar reference path.
+
+namespace opine::inline v1::simd {
+
+namespace detail {
+
+#if defined(__GNUC__) || defined(__clang__)
+constexpr bool has_vector_extension = true;
+#else
+constexpr bool has_vector_extension = false;
+#endif
+
+#if defined(__AVX512BW__)
+constexpr std::size_t native_register_bytes = 64;
+constexpr const char *native_isa_name = "AVX-512BW";
+#elif defined(__AVX2__)
+constexpr std::size_t native_register_bytes = 32;
+constexpr const char *native_isa_name = "AVX2";
+#elif defined(__SSE2__)
+constexpr std::size_t native_register_bytes = 16;
+constexpr const char *native_isa_name = "SSE2";
+#elif defined(__ARM_NEON)
+constexpr std::size_t native_register_bytes = 16;
+constexpr const char *native_isa_name = "NEON";
+#else
+constexpr std::size_t native_register_bytes = 0;
+constexpr const char *native_isa_name = "none";
+#endif
+
+} // namespace detail
+
+// Width of one vector register in bytes (0 when there is no vector unit)
+constexpr std::size_t register_bytes = detail::native_register_bytes;
+
+// Human-readable name of the ISA the kernels are compiled for
+constexpr const char *isa_name = detail::native_isa_name;
+
+// True when SIMD kernels are compiled in
+constexpr bool enabled =
+    detail::has_vector_extension && detail::native_register_bytes > 0;
+
+// Unsigned lane type with the given size in bytes
+//
+// OPINE's field types (_BitInt(N), uint_fast*_t, ...) are not all valid vector
+// element types, so kernels compute on the standard unsigned integer of the
+// same size and copy the object representation in and out.
+template <std::size_t Bytes> struct lane;
+template <> struct lane<1> {
+  using type = std::uint8_t;
+};
+template <> struct lane<2> {
+  using type = std::uint16_t;
+};
+template <> struct lane<4> {
+  using type = std::uint32_t;
+};
+template <> struct lane<8> {
+  using type = std::uint64_t;
+};
+
+template <std::size_t Bytes> using lane_t = typename lane<Bytes>::type;
+
+// True if T can be processed as a vector lane: trivially copyable, and the
+// size of a standard unsigned integer. Unsigned integers of every width,
+// _BitInt(N) up to 64 bits and bool all qualify on the x86-64 and AArch64
+// ABIs, where those types share the representation of the equally sized
+// unsigned integer for every value they can hold.
+template <typename T>
+constexpr bool is_lane_compatible =
+    std::is_trivially_copyable_v<T> &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+// Number of T lanes in one native register (1 when there is no vector unit)
+template <typename T>
+constexpr std::size_t lanes_per_register =
+    register_bytes >= sizeof(T) ? register_bytes / sizeof(T) : 1;
+
+#if defined(__GNUC__) || defined(__clang__)
+
+namespace detail {
+template <typename T, std::size_t N> struct vector_type {
+  typedef T type __attribute__((vector_size(sizeof(T) * N)));
+};
+} // namespace detail
+
+// Vector of N lanes of the standard unsigned integer type T
+//
+// N need not match the native register: a vector of 64 uint32_t lanes is
+// lowered to several registers, which is how kernels that widen fields (8-bit
+// storage to 32-bit mantissas) keep one lane count across all their streams.
+template <typename T, std::size_t N>
+using vec = typename detail::vector_type<T, N>::type;
+
+// Load N elements of type T (any lane-compatible type) into a vector of the
+// same-sized unsigned lanes
+//
+// Vectors are passed by reference, never returned by value: a vector wider
+// than the enabled ISA has no register calling convention, and GCC warns
+// about the resulting ABI change (-Wpsabi).
+template <std::size_t N, typename T>
+inline void load(vec<lane_t<sizeof(T)>, N> &v, const T *src) {
+  static_assert(is_lane_compatible<T>);
+  std::memcpy(&v, src, sizeof(v));
+}
+
+// Store a vector of unsigned lanes into N elements of type T of the same size
+template <std::size_t N, typename T>
+inline void store(T *dst, const vec<lane_t<sizeof(T)>, N> &v) {
+  static_assert(is_lane_compatible<T>);
+  std::memcpy(dst, &v, sizeof(v));
+}
+
+#endif
+
+} // namespace opine::inline v1::simd
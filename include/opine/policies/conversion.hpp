@@ -0,0 +1,80 @@
+#pragma once
+
+#include <concepts>
+#include <opine/policies/instrumentation.hpp>
+#include <opine/policies/rounding.hpp>
+
+namespace opine::inline v1::conversion_policies {
+
+// Concept: A conversion policy must provide a rounding policy and saturate
+//
+// rounding_policy narrows the mantissa (and decides, like for arithmetic
+// results, whether an out-of-range value rounds to infinity). saturate
+// replaces that infinity with the largest finite value of the same sign
+// for finite inputs; Inf and NaN inputs are converted to Inf and NaN.
+template <typename T>
+concept ConversionPolicy = requires {
+  typename T::rounding_policy;
+  { T::saturate } -> std::convertible_to<bool>;
+};
+
+template <typename RoundingPolicy, bool Saturate> struct Conversion {
+  using rounding_policy = RoundingPolicy;
+  static constexpr bool saturate = Saturate;
+};
+
+// IEEE 754 convertFormat: round to nearest, overflow to infinity
+//
+// Use case: bit-exact agreement with hardware conversions (F16C, NEON)
+using IEEEConversion =
+    Conversion<rounding_policies::ToNearestTiesToEven, false>;
+
+// Round to nearest, saturate finite overflow
+//
+// Use case: default; quantizing weights and activations, where an
+// out-of-range value should clip to the largest finite value instead of
+// poisoning later arithmetic with infinities
+using SafeConversion =
+    Conversion<rounding_policies::ToNearestTiesToEven, true>;
+
+// Truncate the mantissa, saturate finite overflow
+//
+// Use case: fastest narrowing (no rounding increment, no carry), when the
+// half-ulp bias toward zero is acceptable
+using FastConversion = Conversion<rounding_policies::TowardZero, true>;
+
+// Default conversion policy
+using DefaultConversionPolicy = SafeConversion;
+
+// Base's conversions, counting their events with Instrumentation
+//
+// Use case: measuring rounding, saturation and underflow rates of a
+// quantization (instrumentation_policies::Counting). Instrumented
+// conversions take the Compute path of convert_n() and no native
+// instructions, since tables and hardware report no events.
+template <ConversionPolicy Base,
+          instrumentation_policies::InstrumentationPolicy Instrumentation =
+              instrumentation_policies::Counting<>>
+struct Instrumented : Base {
+  using instrumentation_policy = Instrumentation;
+};
+
+// Instrumentation policy of a conversion policy: None unless it names one
+template <typename T> struct instrumentation_policy_of {
+  using type = instrumentation_policies::None;
+};
+
+template <typename T>
+  requires requires { typename T::instrumentation_policy; }
+struct instrumentation_policy_of<T> {
+  using type = typename T::instrumentation_policy;
+};
+
+template <typename T>
+using instrumentation_policy_t = typename instrumentation_policy_of<T>::type;
+
+// True for conversion policies that count events
+template <typename T>
+constexpr bool is_instrumented = instrumentation_policy_t<T>::enabled;
+
+} // namespace opine::inline v1::conversion_policies
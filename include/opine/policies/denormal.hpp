@@ -4,10 +4,25 @@
 
 namespace opine::inline v1::denormal_policies {
 
-// Concept: A denormal policy must provide supports_denormals flag
+// Concept: A denormal policy must provide supports_denormals flag, and say
+// where denormals are flushed
+//
+//   flush_inputs    unpack() turns denormal encodings into signed zeros, and
+//                   arithmetic treats every value with a zero exponent field
+//                   as zero (x86 DAZ)
+//   flush_outputs   pack(), round() and arithmetic turn results in the
+//                   denormal range into signed zeros (x86 FTZ); tininess is
+//                   detected before rounding
+//
+// Both are compile-time constants: with a flush configured, the code that
+// handles denormals (the implicit-bit select in unpack(), the gradual
+// underflow shift in normalize(), the operand normalization in divide() and
+// fma()) is not generated at all.
 template <typename T>
 concept DenormalPolicy = requires {
   { T::supports_denormals } -> std::convertible_to<bool>;
+  { T::flush_inputs } -> std::convertible_to<bool>;
+  { T::flush_outputs } -> std::convertible_to<bool>;
 };
 
 // Full IEEE 754 denormal support (gradual underflow)
@@ -23,6 +38,8 @@ concept DenormalPolicy = requires {
 // Use case: IEEE 754 compliance, scientific computing, maximum accuracy
 struct FullSupport {
   static constexpr bool supports_denormals = true;
+  static constexpr bool flush_inputs = false;
+  static constexpr bool flush_outputs = false;
 
   // Description for debugging/documentation
   static constexpr const char *name = "FullSupport";
@@ -44,6 +61,8 @@ struct FullSupport {
 // Use case: GPU-style computation, ML inference, performance-critical code
 struct FlushToZero {
   static constexpr bool supports_denormals = false;
+  static constexpr bool flush_inputs = false;
+  static constexpr bool flush_outputs = true;
 
   static constexpr const char *name = "FlushToZero";
 };
@@ -63,6 +82,8 @@ struct FlushToZero {
 // Use case: Audio DSP, systems where denormal inputs cause slowdown
 struct FlushInputsToZero {
   static constexpr bool supports_denormals = false;
+  static constexpr bool flush_inputs = true;
+  static constexpr bool flush_outputs = false;
 
   static constexpr const char *name = "FlushInputsToZero";
 };
@@ -81,6 +102,8 @@ struct FlushInputsToZero {
 // Use case: Maximum performance mode, game math, approximate calculations
 struct FlushOnZero {
   static constexpr bool supports_denormals = false;
+  static constexpr bool flush_inputs = true;
+  static constexpr bool flush_outputs = true;
 
   static constexpr const char *name = "FlushOnZero";
 };
@@ -99,14 +122,16 @@ struct FlushOnZero {
 // implementations
 struct None {
   static constexpr bool supports_denormals = false;
+  static constexpr bool flush_inputs = true;
+  static constexpr bool flush_outputs = true;
 
   static constexpr const char *name = "None";
 };
 
 // Default denormal policy
 //
-// Currently matches the behavior of existing pack/unpack code, which correctly
-// handles denormals during unpacking. This provides IEEE 754 gradual underflow.
+// IEEE 754 gradual underflow; denormals are only flushed when a flushing
+// policy is configured.
 using DefaultDenormalPolicy = FullSupport;
 
 } // namespace opine::inline v1::denormal_policies
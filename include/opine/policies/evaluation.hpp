@@ -0,0 +1,70 @@
+#pragma once
+
+#include <concepts>
+
+namespace opine::inline v1::evaluation_policies {
+
+// Concept: An evaluation policy must provide round_every_step
+//
+// FloatEngine expressions such as a * b + c * d are evaluated on
+// UnpackedFloat values, never packing the intermediate results. The
+// evaluation policy decides whether those intermediates are rounded.
+template <typename T>
+concept EvaluationPolicy = requires {
+  { T::round_every_step } -> std::convertible_to<bool>;
+};
+
+// Round once, when the expression is assigned to a FloatEngine
+//
+// Intermediates keep their guard bits (with sticky) unrounded, so a chain
+// of operations costs one rounding and no pack()/unpack() round trips. The
+// result can differ from IEEE 754 per-operation rounding in the last bit.
+//
+// Use case: default; 8-bit targets, where the field shuffling of every
+// pack()/unpack() costs more than the arithmetic itself
+struct RoundOnce {
+  static constexpr bool round_every_step = false;
+};
+
+// Round every intermediate result, as IEEE 754 specifies
+//
+// Intermediates still stay unpacked (round() instead of pack()/unpack()),
+// but every operation is rounded to the storage format, so results are
+// bit-identical to evaluating one operation at a time.
+//
+// Use case: reproducing results of IEEE 754 hardware or reference code
+struct RoundEveryStep {
+  static constexpr bool round_every_step = true;
+};
+
+// Round once, and keep intermediates in ExtendedFloat (core/extended.hpp)
+//
+// Intermediates have an unbiased exponent with headroom beyond the format's
+// range and always-normalized significands, so the operations of a chain
+// skip the bias adjustments, the denormal shifts and the overflow checks;
+// the format's range is applied once, with the rounding, when the result is
+// packed. Results match RoundOnce unless an intermediate leaves the normal
+// range, where they are more accurate (a * b / c does not overflow when the
+// quotient is finite).
+//
+// Use case: long multiply/add chains whose intermediates are not stored
+struct ExtendedRange {
+  static constexpr bool round_every_step = false;
+  static constexpr bool extended_range = true;
+};
+
+// True if the policy keeps intermediates in ExtendedFloat (policies without
+// an extended_range member do not)
+template <typename Policy>
+constexpr bool uses_extended_range = [] {
+  if constexpr (requires { Policy::extended_range; }) {
+    return Policy::extended_range;
+  } else {
+    return false;
+  }
+}();
+
+// Default evaluation policy
+using DefaultEvaluationPolicy = RoundOnce;
+
+} // namespace opine::inline v1::evaluation_policies
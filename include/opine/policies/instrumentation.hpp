@@ -0,0 +1,117 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <utility>
+
+namespace opine::inline v1::instrumentation_policies {
+
+// Counts of the rounding and range events of conversions
+//
+// One conversion counts once in `conversions` and in each event it has:
+//
+//   round_ups          rounding incremented the stored mantissa
+//   carries            ... and carried into the exponent (1.111|GRS -> 10.000)
+//   overflows          a finite value that rounds (with an unbounded
+//                      exponent range) beyond the largest finite Dst value
+//   saturations        ... converted to the largest finite value instead of
+//                      Inf or NaN (a saturating conversion policy or format,
+//                      or rounding toward zero)
+//   underflows         a nonzero finite value rounded to zero
+//   denormal_inputs    a denormal Src value
+//   denormal_outputs   a denormal Dst result
+//   nan_inputs         a NaN Src value, or an MX element dequantized under
+//                      the NaN scale
+//   inf_inputs         an infinite Src value
+//
+// Overflowing values count no rounding events. The values of an MX block
+// quantized with the NaN scale (a NaN or Inf in the block) count only as
+// conversions and as NaN or Inf inputs.
+//
+// Counts from several threads or batches add with +=.
+struct EventCounts {
+  std::uint64_t conversions = 0;
+  std::uint64_t round_ups = 0;
+  std::uint64_t carries = 0;
+  std::uint64_t overflows = 0;
+  std::uint64_t saturations = 0;
+  std::uint64_t underflows = 0;
+  std::uint64_t denormal_inputs = 0;
+  std::uint64_t denormal_outputs = 0;
+  std::uint64_t nan_inputs = 0;
+  std::uint64_t inf_inputs = 0;
+
+  constexpr EventCounts &operator+=(const EventCounts &other) {
+    conversions += other.conversions;
+    round_ups += other.round_ups;
+    carries += other.carries;
+    overflows += other.overflows;
+    saturations += other.saturations;
+    underflows += other.underflows;
+    denormal_inputs += other.denormal_inputs;
+    denormal_outputs += other.denormal_outputs;
+    nan_inputs += other.nan_inputs;
+    inf_inputs += other.inf_inputs;
+    return *this;
+  }
+
+  friend constexpr EventCounts operator+(EventCounts a,
+                                         const EventCounts &b) {
+    return a += b;
+  }
+
+  friend constexpr bool operator==(const EventCounts &,
+                                   const EventCounts &) = default;
+};
+
+// Concept: An instrumentation policy must provide enabled and record()
+//
+// Conversions under a conversion policy with an enabled instrumentation
+// policy (conversion_policies::Instrumented) count their events into a
+// local EventCounts, and hand it to record() once per batch: per call of
+// convert_n(), per MX block, per scalar convert(). Constant evaluation
+// records nothing. A disabled policy is never called, and the counting code
+// is not compiled.
+template <typename T>
+concept InstrumentationPolicy = requires(const EventCounts &counts) {
+  { T::enabled } -> std::convertible_to<bool>;
+  T::record(counts);
+};
+
+// No instrumentation
+//
+// Use case: default; the conversions compile to exactly the uninstrumented
+// code
+struct None {
+  static constexpr bool enabled = false;
+
+  static void record(const EventCounts &) {}
+};
+
+// Per-thread counters
+//
+// Each thread adds its batches to its own EventCounts, so counting takes no
+// synchronization. take() returns the calling thread's counts and resets
+// them; the opine/parallel.hpp functions move their worker threads' counts
+// to the calling thread before they return. Tag separates independent sets
+// of counters (one per layer, say).
+//
+// Use case: choosing element formats and scale policies from data, e.g.
+// how often e4m3 saturates or e5m2 underflows on a layer's activations
+template <typename Tag = void> struct Counting {
+  static constexpr bool enabled = true;
+
+  static EventCounts &counts() {
+    thread_local EventCounts thread_counts;
+    return thread_counts;
+  }
+
+  static void record(const EventCounts &batch) { counts() += batch; }
+
+  static EventCounts take() { return std::exchange(counts(), EventCounts{}); }
+};
+
+// Default instrumentation policy
+using DefaultInstrumentationPolicy = None;
+
+} // namespace opine::inline v1::instrumentation_policies
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <concepts>
+#include <opine/policies/table.hpp>
+
+namespace opine::inline v1::multiply_policies {
+
+// Concept: A multiply policy describes how the platform multiplies integers
+//
+// Significand products (multiply(), fma()) go through
+// detail::multiply_integers() (operations/multiply_integers.hpp), which picks
+// one of four strategies at compile time from this description:
+//
+//   has_hardware_multiply   use the * operator (a multiply instruction, or a
+//                           compiler helper that is good enough)
+//   max_table_bits          otherwise, look the product up in a generated
+//                           table when both operands together fit the index
+//                           (as in table_policies)
+//
+// and otherwise multiply by shifting and adding.
+template <typename T>
+concept MultiplyPolicy = requires {
+  { T::has_hardware_multiply } -> std::convertible_to<bool>;
+  { T::max_table_bits } -> std::convertible_to<int>;
+};
+
+template <bool HardwareMultiply,
+          table_policies::TablePolicy TablePolicy =
+              table_policies::DefaultTablePolicy>
+struct Multiplier {
+  static constexpr bool has_hardware_multiply = HardwareMultiply;
+  static constexpr int max_table_bits = TablePolicy::max_table_bits;
+};
+
+// Multiply with the * operator
+//
+// Use case: every CPU with a multiply instruction at the product width
+using HardwareMultiply = Multiplier<true>;
+
+// No multiply instruction: product tables of up to 2^8 entries (one page on
+// the 6502: a 4x4-bit significand product, e.g. fp8_e4m3 with TowardZero),
+// shift-and-add otherwise
+//
+// Use case: 6502, Z80 and other 8-bit targets
+using SoftwareMultiply = Multiplier<false, table_policies::SmallTables>;
+
+// No multiply instruction and no ROM to spare: always shift-and-add (or
+// three-shift)
+//
+// Use case: 8-bit targets where every page of ROM is taken
+using SoftwareMultiplyNoTables = Multiplier<false, table_policies::NoTables>;
+
+// Default multiply policy: software on targets known to lack a multiplier,
+// hardware everywhere else. Define OPINE_HARDWARE_MULTIPLY to 0 or 1 to
+// override the detection.
+#ifndef OPINE_HARDWARE_MULTIPLY
+#if defined(__mos__)
+#define OPINE_HARDWARE_MULTIPLY 0
+#else
+#define OPINE_HARDWARE_MULTIPLY 1
+#endif
+#endif
+
+#if OPINE_HARDWARE_MULTIPLY
+using DefaultMultiplyPolicy = HardwareMultiply;
+#else
+using DefaultMultiplyPolicy = SoftwareMultiply;
+#endif
+
+} // namespace opine::inline v1::multiply_policies
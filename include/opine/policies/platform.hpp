@@ -0,0 +1,51 @@
+#pragma once
+
+#include <concepts>
+
+namespace opine::inline v1::platform_policies {
+
+// Concept: A platform policy must provide use_native and detect_at_runtime
+//
+// use_native lets the kernels in opine/platforms/native/ use the host's
+// fp16 instructions (F16C, AVX512-FP16, the Arm FP16 extensions) for the
+// format and policy combinations whose results they reproduce exactly.
+// detect_at_runtime also lets them use instructions the translation unit
+// was not compiled for when the CPU reports them, through functions built
+// with target attributes (x86 GCC and Clang). Results never depend on the
+// policy, only speed does.
+template <typename T>
+concept PlatformPolicy = requires {
+  { T::use_native } -> std::convertible_to<bool>;
+  { T::detect_at_runtime } -> std::convertible_to<bool>;
+};
+
+// Never use native fp16 instructions: always the portable templates
+//
+// Use case: reference results, and measuring the generic path
+struct Generic {
+  static constexpr bool use_native = false;
+  static constexpr bool detect_at_runtime = false;
+};
+
+// Native instructions of the ISA the translation unit is compiled for
+// (-mf16c, -mavx512fp16, -march=armv8.2-a+fp16), chosen at compile time
+//
+// Use case: default; no dispatch, and no native code in a baseline build
+struct CompileTime {
+  static constexpr bool use_native = true;
+  static constexpr bool detect_at_runtime = false;
+};
+
+// Native instructions the CPU supports, checked once at run time
+//
+// Use case: distributed x86-64 baseline binaries running on F16C and
+// AVX512-FP16 hosts; one predicted branch per call
+struct RuntimeDetect {
+  static constexpr bool use_native = true;
+  static constexpr bool detect_at_runtime = true;
+};
+
+// Default platform policy
+using DefaultPlatformPolicy = CompileTime;
+
+} // namespace opine::inline v1::platform_policies
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <concepts>
+#include <cstdint>
 #include <opine/core/types.hpp>
+#include <type_traits>
 
 namespace opine::inline v1::rounding_policies {
 
@@ -11,6 +13,17 @@ concept RoundingPolicy = requires {
   { T::guard_bits } -> std::convertible_to<int>;
 };
 
+// Result type of round_mantissa(): the M stored mantissa bits plus one carry
+// bit
+//
+// Rounding up an all-ones mantissa (1.111|GRS -> 10.000) carries out of the
+// stored bits. The carry is returned rather than discarded so that pack() can
+// propagate it into the exponent: a denormal becomes the smallest normal, and
+// the largest finite value becomes infinity.
+template <typename Format>
+using rounded_mantissa_t =
+    uint_t<Format::mant_bits + 1, typename Format::type_policy>;
+
 // Round toward zero (truncate)
 // Simplest rounding mode - no guard bits needed, just discard precision
 struct TowardZero {
@@ -18,12 +31,13 @@ struct TowardZero {
 
   // Round mantissa by removing guard bits and implicit bit
   // For TowardZero with 0 guard bits, this just removes the implicit bit if
-  // present
+  // present. Truncation never carries, so the carry bit of the result is
+  // always zero.
   template <typename Format, typename MantissaType>
   static constexpr auto round_mantissa(MantissaType wide_mantissa,
                                        bool is_negative // Unused for TowardZero
   ) {
-    using result_type = typename Format::mantissa_storage_type;
+    using result_type = rounded_mantissa_t<Format>;
 
     // No guard bits to remove, just extract the stored mantissa bits
     if constexpr (Format::has_implicit_bit) {
@@ -67,21 +81,15 @@ struct ToNearestTiesToEven {
   // Input mantissa layout:
   //   [implicit bit (if any)][M stored mantissa bits][G bit][R bit][S bit]
   //
-  // Output: M stored mantissa bits, with implicit bit removed
-  //
-  // Note: This implementation does NOT handle mantissa overflow.
-  // When rounding causes the mantissa to overflow (e.g., rounding 1.111...
-  // to 10.000...), the exponent should be incremented and mantissa reset.
-  // This overflow handling must be done in pack() - see TODO below.
-  //
-  // TODO: Modify pack() to detect mantissa overflow (rounded_mant > max_mant)
-  // and handle it by incrementing exponent and resetting mantissa to 0.
+  // Output: M stored mantissa bits, with implicit bit removed, plus the carry
+  // bit (bit M) when rounding up overflows the stored bits (e.g., rounding
+  // 1.111... to 10.000...). pack() adds the carry to the exponent.
   template <typename Format, typename MantissaType>
   static constexpr auto round_mantissa(
       MantissaType wide_mantissa,
       bool is_negative // Unused for round-to-nearest modes
   ) {
-    using result_type = typename Format::mantissa_storage_type;
+    using result_type = rounded_mantissa_t<Format>;
 
     // Step 1: Extract the stored mantissa bits by shifting away guard bits
     //
@@ -130,75 +138,213 @@ struct ToNearestTiesToEven {
                     (grs == guard_bits_type{4} && (stored_bits & 1));
 
     // Step 5: Apply rounding
+    //
+    // Widen first: when all mantissa bits are 1, rounding up carries into bit
+    // M (1.111 + 0.001 = 10.000). The result type has room for that bit, and
+    // pack() turns it into an exponent increment.
+    result_type rounded = static_cast<result_type>(stored_bits);
     if (round_up) {
-      stored_bits += 1;
-
-      // Check for mantissa overflow
-      //
-      // When all mantissa bits are 1 and we round up, we get overflow:
-      // Example: 1.111 + 0.001 (round up) = 10.000
-      //
-      // In this case, the mantissa should become 0 and the exponent should
-      // increment by 1. However, we can't modify the exponent here - that
-      // must be handled by pack().
-      //
-      // TODO: This overflow detection is here for documentation, but the
-      // actual handling must be in pack(). Either:
-      //   1. Modify pack() to detect stored_bits > max_mant after rounding
-      //   2. Change round_mantissa to return {mantissa, overflow_flag}
-      //   3. Saturate here (wrong, but safe) until proper handling is added
-      //
-      // For now, we let the overflow propagate and rely on the caller to
-      // handle it correctly.
-      constexpr MantissaType max_mant =
-          (MantissaType{1} << Format::mant_bits) - 1;
-      if (stored_bits > max_mant) {
-        // Mantissa overflowed - this should trigger exponent increment in pack()
-        // For now, document this is NOT handled yet
-        //
-        // WARNING: This case is not yet properly handled. The packed result
-        // will be incorrect if mantissa overflow occurs. This typically
-        // happens when rounding the maximum representable mantissa value.
-      }
+      rounded = static_cast<result_type>(rounded + result_type{1});
     }
 
     // Step 6: Return the rounded mantissa value
     //
-    // Cast to result_type (mantissa_storage_type), which is sized for exactly
-    // M bits (the stored mantissa width, without implicit bit or guard bits).
-    return static_cast<result_type>(stored_bits);
+    // result_type is sized for exactly M + 1 bits: the stored mantissa width
+    // (without implicit bit or guard bits) plus the carry.
+    return rounded;
   }
 };
 
+namespace detail {
+
+// Stored mantissa bits of a wide mantissa (guard bits shifted away, implicit
+// bit masked off), widened to the rounded result type
+template <typename Format, int GuardBits, typename MantissaType>
+constexpr rounded_mantissa_t<Format> stored_bits(MantissaType wide_mantissa) {
+  auto stored = static_cast<MantissaType>(wide_mantissa >> GuardBits);
+  if constexpr (Format::has_implicit_bit) {
+    constexpr MantissaType mant_mask =
+        (MantissaType{1} << Format::mant_bits) - 1;
+    stored = static_cast<MantissaType>(stored & mant_mask);
+  }
+  return static_cast<rounded_mantissa_t<Format>>(stored);
+}
+
+// The guard bits of a wide mantissa
+template <int GuardBits, typename MantissaType>
+constexpr MantissaType guard_value(MantissaType wide_mantissa) {
+  constexpr MantissaType guard_mask = (MantissaType{1} << GuardBits) - 1;
+  return static_cast<MantissaType>(wide_mantissa & guard_mask);
+}
+
+// Add the round-up decision (0 or 1) to the stored bits; an all-ones
+// mantissa carries into bit M, which pack() adds to the exponent
+template <typename Format>
+constexpr rounded_mantissa_t<Format>
+increment(rounded_mantissa_t<Format> stored, bool round_up) {
+  return static_cast<rounded_mantissa_t<Format>>(
+      stored + static_cast<rounded_mantissa_t<Format>>(round_up));
+}
+
+} // namespace detail
+
+// Directed rounding: toward +infinity / -infinity
+//
+// One guard bit is enough. Arithmetic results keep their lowest guard bit as
+// a sticky bit (everything shifted out is ORed into it), so with G = 1 the
+// guard bit says "inexact", and the magnitude is incremented when the value
+// is inexact and rounding away from zero is the requested direction:
+// positive values for TowardPositive, negative values for TowardNegative.
+//
+// Overflow follows IEEE 754: a positive result beyond the largest finite
+// value becomes +Inf under TowardPositive and the largest finite value under
+// TowardNegative (and the mirror image for negative results).
+//
+// The decision is computed with integer operations only (no branches), so
+// pack_n() loops vectorize.
+template <bool RoundNegativeUp> struct Directed {
+  static constexpr int guard_bits = 1;
+
+  template <typename Format, typename MantissaType>
+  static constexpr auto round_mantissa(MantissaType wide_mantissa,
+                                       bool is_negative) {
+    const bool inexact = detail::guard_value<1>(wide_mantissa) != 0;
+    const bool away_from_zero = is_negative == RoundNegativeUp;
+    return detail::increment<Format>(
+        detail::stored_bits<Format, guard_bits>(wide_mantissa),
+        inexact & away_from_zero);
+  }
+};
+
+// Round toward +infinity (ceiling)
+//
+// Use case: upper bounds in interval arithmetic
+using TowardPositive = Directed<false>;
+
+// Round toward -infinity (floor)
+//
+// Use case: lower bounds in interval arithmetic
+using TowardNegative = Directed<true>;
+
+// Round to nearest, ties away from zero (IEEE 754 roundTiesToAway)
+//
+// Same GRS bits as ToNearestTiesToEven, but a tie (GRS = 100) always rounds
+// up in magnitude, so the decision is just G: round up when GRS >= 4.
+//
+// Use case: decimal-style rounding, and formats (some ML accelerators) that
+// specify ties away
+struct ToNearestTiesAwayFromZero {
+  static constexpr int guard_bits = 3;
+
+  template <typename Format, typename MantissaType>
+  static constexpr auto round_mantissa(MantissaType wide_mantissa,
+                                       bool is_negative // Unused
+  ) {
+    return detail::increment<Format>(
+        detail::stored_bits<Format, guard_bits>(wide_mantissa),
+        (detail::guard_value<guard_bits>(wide_mantissa) >> 2) != 0);
+  }
+};
+
+// Counter-based random numbers for stochastic rounding
+//
+// random_bits(key, counter) is a pure function of its arguments (a 32-bit
+// integer hash, "lowbias32" by Chris Wellons, of the counter mixed with the
+// key): lane i of a bulk operation uses counter first + i, so the lanes are
+// independent, need no state, and the loop still vectorizes. Two 32-bit
+// multiplies per draw.
+constexpr std::uint32_t hash32(std::uint32_t x) {
+  x ^= x >> 16;
+  x *= 0x7FEB352Du;
+  x ^= x >> 15;
+  x *= 0x846CA68Bu;
+  x ^= x >> 16;
+  return x;
+}
+
+constexpr std::uint32_t random_bits(std::uint32_t key, std::uint32_t counter) {
+  return hash32(counter ^ hash32(key));
+}
+
+// Stochastic rounding
+//
+// Rounds up in magnitude with probability equal to the discarded fraction
+// of an ulp, so the rounding error is zero on average: the expected value of
+// the rounded result is the exact value (to 2^-RandomBits ulp). Used for
+// low-precision training, where round-to-nearest systematically loses small
+// updates.
+//
+// The RandomBits guard bits (the lowest one sticky) are the discarded
+// fraction f, and a random number r of RandomBits bits is drawn per value:
+// round up when f + r >= 2^RandomBits, the carry of the addition, so the
+// decision is branch-free.
+//
+// Random numbers come from random_bits(Seed, counter). round_mantissa(wide,
+// sign, random) takes the random bits explicitly; the two-argument form used
+// by pack() draws the next counter of a per-thread stream (advance()), and
+// pack_n() reserves one counter per element up front so its loop body is a
+// pure function of the lane index. In constant evaluation, where there is no
+// stream, the random bits are a hash of the mantissa.
+//
+// Overflow rounds to infinity with probability 1 - 2^-RandomBits, to the
+// largest finite value otherwise; saturating conversion policies clip it.
+template <int RandomBits = 6, std::uint32_t Seed = 0x9E3779B9u>
+struct Stochastic {
+  static_assert(RandomBits >= 1 && RandomBits <= 16,
+                "Stochastic rounding uses 1 to 16 random bits");
+
+  static constexpr int guard_bits = RandomBits;
+  static constexpr bool is_stochastic = true;
+
+  // Reserve count consecutive counters of this thread's stream, returning the
+  // first
+  static std::uint32_t advance(std::uint32_t count) {
+    static thread_local std::uint32_t next = 0;
+    const std::uint32_t first = next;
+    next += count;
+    return first;
+  }
+
+  // Random bits for one value, from a stream counter
+  static constexpr std::uint32_t random(std::uint32_t counter) {
+    return random_bits(Seed, counter) >> (32 - RandomBits);
+  }
+
+  template <typename Format, typename MantissaType>
+  static constexpr auto round_mantissa(MantissaType wide_mantissa,
+                                       bool is_negative, // Unused
+                                       std::uint32_t random) {
+    const auto fraction = static_cast<std::uint32_t>(
+        detail::guard_value<guard_bits>(wide_mantissa));
+    const bool round_up = ((fraction + random) >> guard_bits) != 0;
+    return detail::increment<Format>(
+        detail::stored_bits<Format, guard_bits>(wide_mantissa), round_up);
+  }
+
+  template <typename Format, typename MantissaType>
+  static constexpr auto round_mantissa(MantissaType wide_mantissa,
+                                       bool is_negative) {
+    std::uint32_t counter;
+    if (std::is_constant_evaluated()) {
+      counter = static_cast<std::uint32_t>(wide_mantissa) ^
+                static_cast<std::uint32_t>(
+                    static_cast<std::uint64_t>(wide_mantissa) >> 32);
+    } else {
+      counter = advance(1);
+    }
+    return round_mantissa<Format>(wide_mantissa, is_negative,
+                                  random(counter));
+  }
+};
+
+// True for rounding policies whose results are random (their results cannot
+// be tabulated)
+template <typename RoundingPolicy>
+constexpr bool is_stochastic = requires {
+  requires RoundingPolicy::is_stochastic;
+};
+
 // Default rounding policy
 using DefaultRoundingPolicy = TowardZero;
 
-/*
- * Future rounding policies (to be implemented):
- *
- * struct ToNearestTiesAwayFromZero {
- *     static constexpr int guard_bits = 3;  // G, R, S
- *
- *     template<typename Format, typename MantissaType>
- *     static constexpr auto round_mantissa(MantissaType wide_mantissa, bool
- * is_negative);
- * };
- *
- * struct TowardPositive {
- *     static constexpr int guard_bits = 1;
- *
- *     template<typename Format, typename MantissaType>
- *     static constexpr auto round_mantissa(MantissaType wide_mantissa, bool
- * is_negative);
- * };
- *
- * struct TowardNegative {
- *     static constexpr int guard_bits = 1;
- *
- *     template<typename Format, typename MantissaType>
- *     static constexpr auto round_mantissa(MantissaType wide_mantissa, bool
- * is_negative);
- * };
- */
-
 } // namespace opine::inline v1::rounding_policies
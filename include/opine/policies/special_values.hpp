@@ -0,0 +1,92 @@
+#pragma once
+
+#include <concepts>
+
+namespace opine::inline v1::special_value_policies {
+
+// Where a format keeps its special values
+//
+//   IEEE        the all-ones exponent is reserved: infinity (mantissa zero)
+//               and NaN (mantissa nonzero)
+//   FiniteNaN   no infinities; the all-ones exponent holds finite values
+//               except for one NaN per sign with an all-ones mantissa (OCP
+//               FP8 E4M3, "fn")
+//   FNUZ        no infinities and no -0: the -0 encoding is the only NaN,
+//               every other encoding is finite (finite and NaN, unsigned
+//               zero)
+//   Finite      every encoding is a finite number, -0 included (OCP FP6 and
+//               FP4)
+enum class SpecialValueEncoding { IEEE, FiniteNaN, FNUZ, Finite };
+
+// Concept: A special-value policy must say which special values the format
+// has, how they are encoded, and what a finite overflow becomes
+//
+//   has_infinity       Inf encodings exist
+//   has_nan            NaN encodings exist
+//   has_negative_zero  -0 is a distinct zero; without it every zero result
+//                      is +0
+//   saturate           a finite result beyond the largest finite value
+//                      becomes the largest finite value of its sign, in
+//                      every rounding direction; otherwise the rounding
+//                      policy picks infinity (or, without infinities, NaN)
+//                      or the largest finite value, as IEEE 754 does
+//
+// The flags are compile-time constants read by classify.hpp: is_inf() of a
+// format without infinities is the constant false, so the infinity branches
+// of unpack, arithmetic and comparison are not generated, and likewise for
+// NaN.
+template <typename T>
+concept SpecialValuePolicy = requires {
+  { T::encoding } -> std::convertible_to<SpecialValueEncoding>;
+  { T::has_infinity } -> std::convertible_to<bool>;
+  { T::has_nan } -> std::convertible_to<bool>;
+  { T::has_negative_zero } -> std::convertible_to<bool>;
+  { T::saturate } -> std::convertible_to<bool>;
+};
+
+template <SpecialValueEncoding Encoding, bool Saturate>
+struct SpecialValues {
+  static constexpr SpecialValueEncoding encoding = Encoding;
+  static constexpr bool has_infinity = Encoding == SpecialValueEncoding::IEEE;
+  static constexpr bool has_nan = Encoding != SpecialValueEncoding::Finite;
+  static constexpr bool has_negative_zero =
+      Encoding != SpecialValueEncoding::FNUZ;
+  // A format without infinity and NaN has nothing else to overflow to
+  static constexpr bool saturate =
+      Saturate || Encoding == SpecialValueEncoding::Finite;
+};
+
+// IEEE 754 special values: signed infinities, NaNs, signed zeros
+//
+// Use case: default; the IEEE binary formats and fp8_e5m2
+using IEEE = SpecialValues<SpecialValueEncoding::IEEE, false>;
+
+// IEEE 754 encodings, finite overflow clips to the largest finite value
+//
+// Inf is still produced by exact infinite results (x / 0) and Inf operands.
+//
+// Use case: accelerator arithmetic that saturates instead of overflowing
+using SaturatingIEEE = SpecialValues<SpecialValueEncoding::IEEE, true>;
+
+// No infinities, NaN at S.1111.111 (OCP FP8 E4M3: largest finite 448)
+//
+// Finite overflow is NaN, as for OCP's non-saturating conversion.
+using FiniteNaN = SpecialValues<SpecialValueEncoding::FiniteNaN, false>;
+
+// FiniteNaN with saturating overflow (OCP's saturating conversion)
+using SaturatingFiniteNaN =
+    SpecialValues<SpecialValueEncoding::FiniteNaN, true>;
+
+// No infinities, no -0, NaN at 1.0000.000 (fp8 "fnuz" formats)
+using FNUZ = SpecialValues<SpecialValueEncoding::FNUZ, false>;
+
+// No infinities and no NaN: every encoding is finite (OCP FP6, FP4)
+//
+// Overflow saturates. Invalid operations, which have no NaN to return
+// (0 / 0), return +0.
+using FiniteOnly = SpecialValues<SpecialValueEncoding::Finite, true>;
+
+// Default special-value policy
+using DefaultSpecialValuePolicy = IEEE;
+
+} // namespace opine::inline v1::special_value_policies
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <concepts>
+
+namespace opine::inline v1::table_policies {
+
+// Concept: A table policy must provide max_table_bits
+//
+// max_table_bits is the platform's ROM/RAM budget for generated lookup tables,
+// expressed as the width of the table index: a table may have at most
+// 2^max_table_bits entries. Operations that can be computed either bit by bit
+// or by a table lookup use the table only when its index fits the budget.
+template <typename T>
+concept TablePolicy = requires {
+  { T::max_table_bits } -> std::convertible_to<int>;
+};
+
+// Allow lookup tables with up to 2^Bits entries
+template <int Bits> struct MaxTableBits {
+  static_assert(Bits >= 0, "max_table_bits must be non-negative");
+
+  static constexpr int max_table_bits = Bits;
+};
+
+// Never use lookup tables: always compute
+//
+// Use case: targets where ROM is scarcer than cycles, or where the bit
+// manipulation is already cheap and vectorizes (x86, ARM with SIMD)
+using NoTables = MaxTableBits<0>;
+
+// 256-entry tables: every fp8 value, one page on the 6502
+//
+// Use case: 8-bit targets, where one indexed load (4-5 cycles) replaces
+// dozens of cycles of multi-byte shifting
+using SmallTables = MaxTableBits<8>;
+
+// 1024-entry tables (about 1 KB for 8-bit entries)
+//
+// Use case: default; enough for every fp8 decode table and for narrowing fp16
+// to fp8_e5m2 by table
+using MediumTables = MaxTableBits<10>;
+
+// 65536-entry tables
+//
+// Use case: hosts with large caches doing bulk conversion, where a 16-bit
+// indexed table covers every fp16 value and fp32 to fp8 narrowing
+using LargeTables = MaxTableBits<16>;
+
+// Default table policy
+using DefaultTablePolicy = MediumTables;
+
+} // namespace opine::inline v1::table_policies
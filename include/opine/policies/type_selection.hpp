@@ -1,7 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <concepts>
 #include <cstdint>
+#include <opine/core/wide_uint.hpp>
 
 namespace opine::inline v1::type_policies {
 
@@ -26,8 +28,7 @@ concept TypeSelectionPolicy = requires {
 // _BitInt support)
 struct ExactWidth {
   template <int Bits> static consteval auto select_unsigned() {
-    static_assert(Bits > 0 && Bits <= 128,
-                  "Bit width must be between 1 and 128");
+    static_assert(Bits > 0, "Bit width must be at least 1");
 
     if constexpr (detail::has_bitint_support) {
 #if defined(__clang__)
@@ -51,11 +52,8 @@ struct ExactWidth {
         return uint_fast32_t{};
       else if constexpr (Bits <= 64)
         return uint_fast64_t{};
-      else {
-        static_assert(
-            Bits <= 64,
-            "Bit widths > 64 require _BitInt support. Use Clang compiler.");
-      }
+      else
+        return WideUint<Bits>{};
     }
   }
 
@@ -91,7 +89,8 @@ struct ExactWidth {
       else {
         static_assert(
             Bits <= 64,
-            "Bit widths > 64 require _BitInt support. Use Clang compiler.");
+            "Signed bit widths > 64 require _BitInt support. Use Clang "
+            "compiler.");
       }
     }
   }
@@ -100,8 +99,7 @@ struct ExactWidth {
 // Policy 2: Least width (at least N bits)
 struct LeastWidth {
   template <int Bits> static consteval auto select_unsigned() {
-    static_assert(Bits > 0 && Bits <= 128,
-                  "Bit width must be between 1 and 128");
+    static_assert(Bits > 0, "Bit width must be at least 1");
 
     if constexpr (Bits <= 8)
       return uint_least8_t{};
@@ -112,16 +110,14 @@ struct LeastWidth {
     else if constexpr (Bits <= 64)
       return uint_least64_t{};
     else {
-      // For >64 bits, use _BitInt if available, otherwise error
+      // For >64 bits, use _BitInt if available, otherwise limbs
       if constexpr (detail::has_bitint_support) {
 #if defined(__clang__)
         using type = unsigned _BitInt(Bits);
         return type{};
 #endif
       } else {
-        static_assert(
-            Bits <= 64,
-            "Bit widths > 64 require _BitInt support. Use Clang compiler.");
+        return WideUint<Bits>{};
       }
     }
   }
@@ -151,7 +147,8 @@ struct LeastWidth {
       } else {
         static_assert(
             Bits <= 64,
-            "Bit widths > 64 require _BitInt support. Use Clang compiler.");
+            "Signed bit widths > 64 require _BitInt support. Use Clang "
+            "compiler.");
       }
     }
   }
@@ -160,8 +157,7 @@ struct LeastWidth {
 // Policy 3: Fastest (fastest type with at least N bits)
 struct Fastest {
   template <int Bits> static consteval auto select_unsigned() {
-    static_assert(Bits > 0 && Bits <= 128,
-                  "Bit width must be between 1 and 128");
+    static_assert(Bits > 0, "Bit width must be at least 1");
 
     if constexpr (Bits <= 8)
       return uint_fast8_t{};
@@ -172,16 +168,14 @@ struct Fastest {
     else if constexpr (Bits <= 64)
       return uint_fast64_t{};
     else {
-      // For >64 bits, use _BitInt if available, otherwise error
+      // For >64 bits, use _BitInt if available, otherwise limbs
       if constexpr (detail::has_bitint_support) {
 #if defined(__clang__)
         using type = unsigned _BitInt(Bits);
         return type{};
 #endif
       } else {
-        static_assert(
-            Bits <= 64,
-            "Bit widths > 64 require _BitInt support. Use Clang compiler.");
+        return WideUint<Bits>{};
       }
     }
   }
@@ -211,10 +205,79 @@ struct Fastest {
       } else {
         static_assert(
             Bits <= 64,
-            "Bit widths > 64 require _BitInt support. Use Clang compiler.");
+            "Signed bit widths > 64 require _BitInt support. Use Clang "
+            "compiler.");
       }
     }
   }
 };
 
+// Policy 4: Whole limbs (N bits rounded up to a multiple of LimbBits)
+//
+// Every integer is a whole number of target limbs, so each operation on it
+// touches only the limbs its value can occupy. On the 6502 a 24-bit fp32
+// significand is three bytes, where Fastest gives uint_fast32_t. The limb
+// width is visible to the arithmetic (limb_bits, limb_count below), which
+// plans its loops limb by limb: see detail::limb_three_shift_multiply().
+//
+// Without _BitInt widths round up further, to the next LeastWidth type
+template <int LimbBits = 8> struct LimbWidth {
+  static_assert(LimbBits > 0 && LimbBits <= 64,
+                "Limb width must be between 1 and 64 bits");
+
+  static constexpr int limb_bits = LimbBits;
+
+  template <int Bits> static consteval auto select_unsigned() {
+    static_assert(Bits > 0, "Bit width must be at least 1");
+    constexpr int width = (Bits + LimbBits - 1) / LimbBits * LimbBits;
+
+    if constexpr (detail::has_bitint_support) {
+#if defined(__clang__)
+      using type = unsigned _BitInt(width);
+      return type{};
+#endif
+    } else {
+      return LeastWidth::select_unsigned<width>();
+    }
+  }
+
+  template <int Bits> static consteval auto select_signed() {
+    static_assert(Bits > 0 && Bits <= 128,
+                  "Bit width must be between 1 and 128");
+    // Signed _BitInt has at least 2 bits (one limb of a 1-bit limb policy)
+    constexpr int width =
+        std::max((Bits + LimbBits - 1) / LimbBits * LimbBits, 2);
+
+    if constexpr (detail::has_bitint_support) {
+#if defined(__clang__)
+      using type = _BitInt(width);
+      return type{};
+#endif
+    } else {
+      return LeastWidth::select_signed<width>();
+    }
+  }
+};
+
+// Byte limbs, for 8-bit CPUs (6502, Z80, AVR)
+using ByteLimbs = LimbWidth<8>;
+
+// Limb width of a type policy's integers; 0 for policies that do not size
+// integers in limbs
+template <typename Policy>
+constexpr int limb_bits = [] {
+  if constexpr (requires { Policy::limb_bits; }) {
+    return Policy::limb_bits;
+  } else {
+    return 0;
+  }
+}();
+
+// Limbs of an N-bit integer under a type policy (1 without limbs)
+template <int Bits, typename Policy>
+constexpr int limb_count =
+    limb_bits<Policy> == 0
+        ? 1
+        : (Bits + limb_bits<Policy> - 1) / limb_bits<Policy>;
+
 } // namespace opine::inline v1::type_policies
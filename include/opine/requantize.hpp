@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <opine/core/aligned_allocator.hpp>
+#include <opine/microscaling.hpp>
+#include <opine/operations/convert_n.hpp>
+#include <opine/packed_array.hpp>
+#include <opine/policies/conversion.hpp>
+#include <opine/policies/table.hpp>
+#include <optional>
+#include <span>
+#include <stdexcept>
+
+namespace opine::inline v1 {
+
+// Streaming requantization into caller-provided memory
+//
+// Opt-in: this header is not part of opine.hpp. It starts no threads, but
+// RequantizeStream synchronizes a producer and a consumer thread through
+// atomics.
+//
+// requantize() encodes a span of Src values as one of two targets, in one
+// pass and with no allocation:
+//
+//   MicroscalingFormat<E, B>   MX blocks: per block, the scale search
+//                              (max_magnitude()), the scaled conversion and
+//                              the element packing of quantize_block().
+//                              The view is a MicroscaledView: scales first,
+//                              then the packed elements.
+//   any other Format           packed elements (PackedArray layout), through
+//                              a stack buffer of packed_chunk encodings:
+//                              convert_n(), then the word packing
+//
+// The results are those of quantize() and of convert_n() followed by
+// PackedArray(values). Each source element is read once and each
+// destination word written once, so a layer's activations requantize in
+// one pass over memory instead of a conversion, a quantize() and a pack.
+//
+// RequantizeStream splits the work into tiles of a cache-sized number of
+// elements and hands them from a producer to a consumer through a ring of
+// slots in memory the caller owns. With two or more slots the producer
+// requantizes tile k + 1 while the consumer computes on tile k (double
+// buffering); the producer waits when every slot is full, the consumer when
+// every slot is empty. Slots are whole cache lines, so the two threads
+// never write the same line. Exactly one thread may produce and one
+// consume.
+//
+// Usage:
+//   using Stream = RequantizeStream<MXFP8_E4M3, fp32_e8m23>;
+//   std::vector<std::uint64_t> ring(2 * Stream::slot_words(4096));
+//   Stream stream(ring, 4096);
+//   std::jthread producer([&] {
+//     stream.produce(activations);  // any number of calls, then close()
+//     stream.close();
+//   });
+//   while (auto tile = stream.acquire()) {
+//     compute(tile->offset, tile->view);  // MicroscaledView<MXFP8_E4M3>
+//     stream.release();
+//   }
+
+namespace detail {
+
+// Layout of a requantization target in 64-bit words
+template <typename Target> struct requantize_target {
+  using view_type = PackedView<Target>;
+  using storage_type = typename Target::storage_type;
+
+  // Tiles are whole word groups, so no word holds elements of two tiles
+  static constexpr std::size_t granule = view_type::group;
+
+  static constexpr std::size_t words(std::size_t size) {
+    return view_type::word_count(size);
+  }
+
+  static view_type view(std::span<const std::uint64_t> memory,
+                        std::size_t size) {
+    return view_type(memory.first(words(size)), size);
+  }
+
+  template <typename Src, typename ConversionPolicy, typename TablePolicy>
+  static view_type encode(std::span<const typename Src::storage_type> src,
+                          std::span<std::uint64_t> memory) {
+    std::array<storage_type, packed_chunk> chunk;
+    for (std::size_t i = 0; i < src.size(); i += packed_chunk) {
+      const std::size_t m = std::min(packed_chunk, src.size() - i);
+      convert_n<Target, Src, ConversionPolicy, TablePolicy>(
+          src.subspan(i, m), std::span(chunk).first(m));
+      pack_words<Target>(std::span<const storage_type>(chunk).first(m), i,
+                         memory);
+    }
+    return view(memory, src.size());
+  }
+};
+
+template <typename ElementFormat, std::size_t BlockSize>
+struct requantize_target<MicroscalingFormat<ElementFormat, BlockSize>> {
+  using mx_format = MicroscalingFormat<ElementFormat, BlockSize>;
+  using view_type = MicroscaledView<mx_format>;
+  static constexpr std::size_t block_bytes = mx_format::block_bytes;
+
+  // Tiles are whole blocks, so only the last block of a stream is partial
+  static constexpr std::size_t granule = BlockSize;
+
+  // One scale byte and block_bytes of elements per block
+  static constexpr std::size_t words(std::size_t size) {
+    return (view_type::block_count(size) * (1 + block_bytes) + 7) / 8;
+  }
+
+  static view_type view(std::span<const std::uint64_t> memory,
+                        std::size_t size) {
+    const std::size_t blocks = view_type::block_count(size);
+    const std::span<const std::uint8_t> bytes(
+        reinterpret_cast<const std::uint8_t *>(memory.data()),
+        blocks * (1 + block_bytes));
+    return view_type(size, bytes.first(blocks), bytes.subspan(blocks));
+  }
+
+  template <typename Src, typename ConversionPolicy, typename TablePolicy>
+  static view_type encode(std::span<const typename Src::storage_type> src,
+                          std::span<std::uint64_t> memory) {
+    const std::size_t blocks = view_type::block_count(src.size());
+    auto *scales = reinterpret_cast<std::uint8_t *>(memory.data());
+    auto *elements = scales + blocks;
+    for (std::size_t block = 0; block < blocks; ++block) {
+      const std::size_t offset = block * BlockSize;
+      scales[block] = quantize_block<mx_format, Src, ConversionPolicy>(
+          src.subspan(offset, std::min(BlockSize, src.size() - offset)),
+          std::span<std::uint8_t, block_bytes>(elements + block * block_bytes,
+                                               block_bytes));
+    }
+    return view(memory, src.size());
+  }
+};
+
+} // namespace detail
+
+// View type of requantized Target encodings: MicroscaledView or PackedView
+template <typename Target>
+using requantized_view_t =
+    typename detail::requantize_target<Target>::view_type;
+
+// 64-bit words requantize() needs for size elements of Target
+template <typename Target>
+constexpr std::size_t requantized_words(std::size_t size) {
+  return detail::requantize_target<Target>::words(size);
+}
+
+// Requantize src into memory (at least requantized_words<Target>(src.size())
+// words) and return a view of it; the view refers to memory
+template <typename Target, typename Src,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy>
+requantized_view_t<Target>
+requantize(std::span<const typename Src::storage_type> src,
+           std::span<std::uint64_t> memory) {
+  return detail::requantize_target<Target>::template encode<
+      Src, ConversionPolicy, TablePolicy>(src, memory);
+}
+
+// A requantized tile: the stream position of its first element, and its
+// encodings (valid until the consumer releases the tile)
+template <typename Target> struct RequantizedTile {
+  std::size_t offset = 0;
+  requantized_view_t<Target> view;
+};
+
+// Single-producer, single-consumer requantization over a ring of tiles
+template <typename Target, typename Src,
+          conversion_policies::ConversionPolicy ConversionPolicy =
+              conversion_policies::DefaultConversionPolicy,
+          typename TablePolicy = table_policies::DefaultTablePolicy>
+class RequantizeStream {
+  using target = detail::requantize_target<Target>;
+  using src_storage = typename Src::storage_type;
+
+  // Slot header: stream offset and element count of the tile
+  static constexpr std::size_t header_words = 2;
+  static constexpr std::size_t line_words = cache_line_size / 8;
+  static constexpr std::size_t closed = ~(~std::size_t{0} >> 1);
+
+public:
+  using tile_type = RequantizedTile<Target>;
+
+  // Elements per tile, rounded up to whole MX blocks or word groups
+  static constexpr std::size_t tile_size(std::size_t tile_elements) {
+    const std::size_t granule = target::granule;
+    return std::max<std::size_t>(
+        (tile_elements + granule - 1) / granule * granule, granule);
+  }
+
+  // Words of one ring slot for tiles of tile_elements: whole cache lines
+  static constexpr std::size_t slot_words(std::size_t tile_elements) {
+    const std::size_t words =
+        header_words + target::words(tile_size(tile_elements));
+    return (words + line_words - 1) / line_words * line_words;
+  }
+
+  // ring must hold at least slot_words(tile_elements) words (else
+  // std::invalid_argument); it is divided into
+  // ring.size() / slot_words(tile_elements) slots
+  RequantizeStream(std::span<std::uint64_t> ring, std::size_t tile_elements)
+      : ring_(ring), tile_(tile_size(tile_elements)),
+        slot_words_(slot_words(tile_elements)),
+        slots_(ring.size() / slot_words_) {
+    if (slots_ == 0) {
+      throw std::invalid_argument("RequantizeStream ring holds no slot");
+    }
+  }
+
+  RequantizeStream(const RequantizeStream &) = delete;
+  RequantizeStream &operator=(const RequantizeStream &) = delete;
+
+  std::size_t tile_elements() const { return tile_; }
+  std::size_t slots() const { return slots_; }
+
+  // Producer: requantize src a tile at a time into the ring, waiting for
+  // free slots; return the number of tiles. Successive calls continue the
+  // stream (each ends with a partial tile if its size is not a multiple of
+  // tile_elements()).
+  std::size_t produce(std::span<const src_storage> src) {
+    std::size_t tiles = 0;
+    for (std::size_t first = 0; first < src.size(); first += tile_) {
+      const std::size_t count = std::min(tile_, src.size() - first);
+      const std::size_t n = produced_.load(std::memory_order_relaxed);
+      for (std::size_t done = released_.load(std::memory_order_acquire);
+           n - done == slots_;
+           done = released_.load(std::memory_order_acquire)) {
+        released_.wait(done, std::memory_order_acquire);
+      }
+
+      const auto slot = slot_memory(n);
+      slot[0] = offset_;
+      slot[1] = count;
+      target::template encode<Src, ConversionPolicy, TablePolicy>(
+          src.subspan(first, count), slot.subspan(header_words));
+      offset_ += count;
+      ++tiles;
+
+      produced_.store(n + 1, std::memory_order_release);
+      produced_.notify_one();
+    }
+    return tiles;
+  }
+
+  // Producer: end the stream; acquire() returns no tile once the consumer
+  // has taken the tiles before it
+  void close() {
+    produced_.fetch_or(closed, std::memory_order_release);
+    produced_.notify_all();
+  }
+
+  // Consumer: wait for the next tile; std::nullopt at the end of the stream.
+  // Up to slots() tiles may be held before releasing the oldest.
+  std::optional<tile_type> acquire() {
+    std::size_t state = produced_.load(std::memory_order_acquire);
+    while ((state & ~closed) == acquired_) {
+      if ((state & closed) != 0) {
+        return std::nullopt;
+      }
+      produced_.wait(state, std::memory_order_acquire);
+      state = produced_.load(std::memory_order_acquire);
+    }
+
+    const auto slot = slot_memory(acquired_++);
+    return tile_type{static_cast<std::size_t>(slot[0]),
+                     target::view(slot.subspan(header_words),
+                                  static_cast<std::size_t>(slot[1]))};
+  }
+
+  // Consumer: hand the oldest acquired tile's slot back to the producer
+  void release() {
+    released_.fetch_add(1, std::memory_order_release);
+    released_.notify_one();
+  }
+
+private:
+  std::span<std::uint64_t> slot_memory(std::size_t tile) const {
+    return ring_.subspan(tile % slots_ * slot_words_, slot_words_);
+  }
+
+  std::span<std::uint64_t> ring_;
+  std::size_t tile_;
+  std::size_t slot_words_;
+  std::size_t slots_;
+
+  // Tiles written (with the closed bit), tiles released: each written by
+  // one side, on its own cache line
+  alignas(cache_line_size) std::atomic<std::size_t> produced_{0};
+  alignas(cache_line_size) std::atomic<std::size_t> released_{0};
+
+  // Producer and consumer state
+  alignas(cache_line_size) std::size_t offset_ = 0;
+  alignas(cache_line_size) std::size_t acquired_ = 0;
+};
+
+} // namespace opine::inline v1
@@ -0,0 +1,590 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <opine/core/aligned_allocator.hpp>
+#include <opine/core/format.hpp>
+#include <opine/microscaling.hpp>
+#include <opine/operations/pack_unpack_n.hpp>
+#include <opine/packed_array.hpp>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Memory-map tensor files where the platform can; elsewhere they are read
+// into a buffer
+#ifndef OPINE_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define OPINE_MMAP 1
+#else
+#define OPINE_MMAP 0
+#endif
+#endif
+
+#if OPINE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace opine::inline v1 {
+
+// Tensor files: OPINE encodings on disk, mapped in place
+//
+// Opt-in, like parallel.hpp: this header is not part of opine.hpp and is
+// the only one that uses the operating system.
+//
+// A tensor file is a 64-byte header followed by the data at a 64-byte
+// aligned offset, in the in-memory layout of one of three containers:
+//
+//   Storage      one storage_type per element (a std::span)
+//   Packed       PackedArray words, total_bits per element
+//   Microscaled  MicroscaledArray: one E8M0 scale byte per block, then the
+//                packed element blocks
+//
+// The header records the FormatDescriptor fields (bit offsets and widths,
+// bias, implicit bit, special values), the storage size and the MX block
+// size. TensorFile maps the file once and returns views of the data after
+// checking them against the Format the caller names, so loading a model is
+// a page-in, not a copy:
+//
+//   TensorFile file("weights.opine");
+//   PackedView<fp4_e2m1> w = file.packed<fp4_e2m1>();
+//   unpack_n<fp4_e2m1, RNE>(w, 0, sign, exponent, mantissa);
+//
+// TensorWriter streams a Storage or Packed tensor out in chunks, from
+// encodings or straight from SoA buffers through pack_n().
+//
+// Files are little-endian, which is also the in-memory byte order the views
+// assume.
+
+static_assert(std::endian::native == std::endian::little,
+              "Tensor files are mapped in place and are little-endian");
+
+enum class TensorLayout : std::uint8_t { Storage, Packed, Microscaled };
+
+// On-disk header: fixed-width fields, no implicit padding
+struct TensorFileHeader {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  TensorLayout layout;
+  std::uint8_t sign_bits;
+  std::uint8_t sign_offset;
+  std::uint8_t exp_bits;
+  std::uint8_t exp_offset;
+  std::uint8_t mant_bits;
+  std::uint8_t mant_offset;
+  std::uint8_t total_bits;
+  std::uint8_t has_implicit_bit;
+  std::uint8_t special_values; // SpecialValueEncoding
+  std::uint8_t saturate;
+  std::uint8_t storage_bytes; // sizeof(storage_type)
+  std::int32_t exp_bias;
+  std::uint32_t block_size; // MX block size, 0 unless Microscaled
+  std::uint64_t count;      // elements
+  std::uint64_t scales_offset;
+  std::uint64_t data_offset;
+  std::uint64_t data_bytes;
+};
+
+static_assert(sizeof(TensorFileHeader) == 64 &&
+              std::is_trivially_copyable_v<TensorFileHeader>);
+
+inline constexpr std::array<char, 8> tensor_file_magic = {
+    'O', 'P', 'I', 'N', 'E', 'T', 'N', 'S'};
+inline constexpr std::uint32_t tensor_file_version = 1;
+
+// Malformed file, or a file that does not hold what the caller asked for
+class TensorFileError : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+// Header describing Format in layout; count and offsets are left zero
+template <typename Format>
+constexpr TensorFileHeader describe_format(TensorLayout layout) {
+  TensorFileHeader header{};
+  header.magic = tensor_file_magic;
+  header.version = tensor_file_version;
+  header.layout = layout;
+  header.sign_bits = static_cast<std::uint8_t>(Format::sign_bits);
+  header.sign_offset = static_cast<std::uint8_t>(Format::sign_offset);
+  header.exp_bits = static_cast<std::uint8_t>(Format::exp_bits);
+  header.exp_offset = static_cast<std::uint8_t>(Format::exp_offset);
+  header.mant_bits = static_cast<std::uint8_t>(Format::mant_bits);
+  header.mant_offset = static_cast<std::uint8_t>(Format::mant_offset);
+  header.total_bits = static_cast<std::uint8_t>(Format::total_bits);
+  header.has_implicit_bit = Format::has_implicit_bit;
+  header.special_values =
+      static_cast<std::uint8_t>(Format::special_values::encoding);
+  header.saturate = Format::special_values::saturate;
+  header.storage_bytes =
+      static_cast<std::uint8_t>(sizeof(typename Format::storage_type));
+  header.exp_bias = Format::exp_bias;
+  return header;
+}
+
+// The format a header describes
+constexpr RuntimeFormat runtime_format(const TensorFileHeader &header) {
+  return {header.sign_bits,
+          header.sign_offset,
+          header.exp_bits,
+          header.exp_offset,
+          header.mant_bits,
+          header.mant_offset,
+          header.total_bits,
+          header.has_implicit_bit != 0,
+          header.exp_bias,
+          static_cast<special_value_policies::SpecialValueEncoding>(
+              header.special_values),
+          header.saturate != 0};
+}
+
+// True if header's format fields are those of Format (the storage size
+// only matters to the Storage layout, and is compared there)
+template <typename Format>
+constexpr bool describes_format(const TensorFileHeader &header) {
+  return runtime_format(header) == runtime_format<Format>();
+}
+
+// Offset of the data following a header (and the MX scales): 64-byte aligned
+constexpr std::uint64_t tensor_data_offset(std::uint64_t end) {
+  return (end + cache_line_size - 1) / cache_line_size * cache_line_size;
+}
+
+namespace detail {
+
+inline std::system_error file_error(const char *operation,
+                                    const std::filesystem::path &path) {
+  return std::system_error(errno, std::generic_category(),
+                           std::string(operation) + " " + path.string());
+}
+
+} // namespace detail
+
+// Read-only mapping of a whole file
+//
+// With OPINE_MMAP the pages are mapped (private, read-only) and loaded on
+// first access; otherwise the file is read into a 64-byte aligned buffer.
+class MappedFile {
+public:
+  MappedFile() = default;
+
+  explicit MappedFile(const std::filesystem::path &path) {
+#if OPINE_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw detail::file_error("open", path);
+    }
+    struct stat status{};
+    if (::fstat(fd, &status) != 0) {
+      const auto error = detail::file_error("stat", path);
+      ::close(fd);
+      throw error;
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (size_ > 0) {
+      void *data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        const auto error = detail::file_error("mmap", path);
+        ::close(fd);
+        throw error;
+      }
+      data_ = static_cast<const std::byte *>(data);
+    }
+    ::close(fd);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+      throw detail::file_error("open", path);
+    }
+    size_ = static_cast<std::size_t>(in.tellg());
+    buffer_.resize(size_);
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char *>(buffer_.data()),
+                 static_cast<std::streamsize>(size_))) {
+      throw detail::file_error("read", path);
+    }
+    data_ = buffer_.data();
+#endif
+  }
+
+  MappedFile(MappedFile &&other) noexcept { swap(other); }
+
+  MappedFile &operator=(MappedFile &&other) noexcept {
+    MappedFile(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  ~MappedFile() {
+#if OPINE_MMAP
+    if (data_ != nullptr) {
+      ::munmap(const_cast<std::byte *>(data_), size_);
+    }
+#endif
+  }
+
+  std::span<const std::byte> bytes() const { return {data_, size_}; }
+
+private:
+  void swap(MappedFile &other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+#if !OPINE_MMAP
+    std::swap(buffer_, other.buffer_);
+#endif
+  }
+
+  const std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+#if !OPINE_MMAP
+  std::vector<std::byte, detail::aligned_allocator<std::byte, cache_line_size>>
+      buffer_;
+#endif
+};
+
+// A mapped tensor file
+//
+// The constructor checks the header and that the data lies inside the file;
+// the accessors check the layout and format they are asked for and throw
+// TensorFileError on a mismatch. Views stay valid while the TensorFile
+// lives.
+class TensorFile {
+public:
+  explicit TensorFile(const std::filesystem::path &path) : file_(path) {
+    const auto bytes = file_.bytes();
+    if (bytes.size() < sizeof(TensorFileHeader)) {
+      throw TensorFileError("Tensor file too short: " + path.string());
+    }
+    std::memcpy(&header_, bytes.data(), sizeof(TensorFileHeader));
+    if (header_.magic != tensor_file_magic ||
+        header_.version != tensor_file_version) {
+      throw TensorFileError("Not an OPINE tensor file: " + path.string());
+    }
+    if (header_.data_offset % cache_line_size != 0 ||
+        header_.data_offset > bytes.size() ||
+        header_.data_bytes > bytes.size() - header_.data_offset) {
+      throw TensorFileError("Tensor data outside the file: " + path.string());
+    }
+    if constexpr (sizeof(std::size_t) < sizeof(std::uint64_t)) {
+      if (header_.count > std::numeric_limits<std::size_t>::max()) {
+        throw TensorFileError("Tensor too large for this platform: " +
+                              path.string());
+      }
+    }
+  }
+
+  const TensorFileHeader &header() const { return header_; }
+  TensorLayout layout() const { return header_.layout; }
+  std::size_t size() const { return static_cast<std::size_t>(header_.count); }
+  RuntimeFormat format() const { return runtime_format(header_); }
+
+  // Unchecked data and MX scale bytes, for formats chosen at run time
+  // (format_dispatch.hpp); the typed accessors below check the format
+  std::span<const std::byte> data_bytes() const {
+    return {data(), static_cast<std::size_t>(header_.data_bytes)};
+  }
+  std::span<const std::byte> scale_bytes() const {
+    const auto bytes = file_.bytes();
+    if (header_.layout != TensorLayout::Microscaled ||
+        header_.scales_offset > bytes.size()) {
+      return {};
+    }
+    const std::size_t blocks =
+        header_.block_size == 0
+            ? 0
+            : size() / header_.block_size +
+                  (size() % header_.block_size != 0 ? 1 : 0);
+    return bytes.subspan(
+        header_.scales_offset,
+        std::min<std::size_t>(blocks, bytes.size() - header_.scales_offset));
+  }
+
+  // One storage_type per element
+  template <typename Format>
+  std::span<const typename Format::storage_type> storage() const {
+    using storage_type = typename Format::storage_type;
+    check<Format>(TensorLayout::Storage,
+                  header_.data_bytes / sizeof(storage_type));
+    if (header_.storage_bytes != sizeof(storage_type)) {
+      throw TensorFileError("Tensor file storage size mismatch");
+    }
+    return {reinterpret_cast<const storage_type *>(data()), size()};
+  }
+
+  // Packed words, Format::total_bits per element
+  template <typename Format> PackedView<Format> packed() const {
+    using word_type = typename PackedView<Format>::word_type;
+    check<Format>(TensorLayout::Packed, header_.data_bytes / sizeof(word_type) *
+                                            64 / Format::total_bits);
+    const std::size_t words = PackedView<Format>::word_count(size());
+    return PackedView<Format>(
+        {reinterpret_cast<const word_type *>(data()), words}, size());
+  }
+
+  // MX scales and element blocks
+  template <typename MxFormat> MicroscaledView<MxFormat> microscaled() const {
+    check<typename MxFormat::element_format>(
+        TensorLayout::Microscaled,
+        header_.data_bytes / MxFormat::block_bytes * MxFormat::block_size);
+    const std::size_t blocks = MicroscaledView<MxFormat>::block_count(size());
+    if (header_.block_size != MxFormat::block_size) {
+      throw TensorFileError("Tensor file block size mismatch");
+    }
+    const auto bytes = file_.bytes();
+    if (header_.scales_offset > bytes.size() ||
+        blocks > bytes.size() - header_.scales_offset) {
+      throw TensorFileError("Tensor scales outside the file");
+    }
+    return MicroscaledView<MxFormat>(
+        size(),
+        {reinterpret_cast<const std::uint8_t *>(bytes.data() +
+                                                header_.scales_offset),
+         blocks},
+        {reinterpret_cast<const std::uint8_t *>(data()),
+         blocks * MxFormat::block_bytes});
+  }
+
+private:
+  // Layout and format as asked, and at least header_.count elements in the
+  // data; capacity is how many it holds, so the count from the file is
+  // compared before it is multiplied into a size
+  template <typename Format>
+  void check(TensorLayout layout, std::uint64_t capacity) const {
+    if (header_.layout != layout) {
+      throw TensorFileError("Tensor file layout mismatch");
+    }
+    if (!describes_format<Format>(header_)) {
+      throw TensorFileError("Tensor file format mismatch");
+    }
+    if (header_.count > capacity) {
+      throw TensorFileError("Tensor file data too short");
+    }
+  }
+
+  const std::byte *data() const {
+    return file_.bytes().data() + header_.data_offset;
+  }
+
+  MappedFile file_;
+  TensorFileHeader header_{};
+};
+
+// Chunked writer of a Storage or Packed tensor file
+//
+// Elements are appended with write(); close() completes the header (the
+// element count is not needed up front). For the Packed layout, elements
+// are buffered up to a whole word group, so every write outputs whole words,
+// and close() writes the last partial group. The destructor closes an open
+// writer but cannot report errors; call close() to see them.
+//
+// Usage:
+//   TensorWriter<fp4_e2m1> out("weights.opine");  // Packed
+//   for (...) {
+//     out.write<RNE>(sign, exponent, mantissa);    // through pack_n()
+//   }
+//   out.close();
+template <typename Format> class TensorWriter {
+  using packing = detail::word_packing<Format::total_bits>;
+
+public:
+  using storage_type = typename Format::storage_type;
+
+  explicit TensorWriter(const std::filesystem::path &path,
+                        TensorLayout layout = TensorLayout::Packed)
+      : path_(path), out_(path, std::ios::binary | std::ios::trunc),
+        header_(describe_format<Format>(layout)) {
+    if (layout == TensorLayout::Microscaled) {
+      throw TensorFileError("TensorWriter writes Storage or Packed tensors");
+    }
+    if (!out_) {
+      throw detail::file_error("open", path_);
+    }
+    header_.data_offset = tensor_data_offset(sizeof(TensorFileHeader));
+    const std::array<char, cache_line_size> zeros{};
+    write_bytes(zeros.data(), header_.data_offset);
+  }
+
+  TensorWriter(const TensorWriter &) = delete;
+  TensorWriter &operator=(const TensorWriter &) = delete;
+
+  ~TensorWriter() {
+    if (out_.is_open()) {
+      try {
+        close();
+      } catch (...) {
+      }
+    }
+  }
+
+  // Elements written so far
+  std::size_t size() const { return static_cast<std::size_t>(header_.count); }
+
+  // Append encodings
+  void write(std::span<const storage_type> values) {
+    header_.count += values.size();
+    if (header_.layout == TensorLayout::Storage) {
+      write_bytes(values.data(), values.size_bytes());
+      return;
+    }
+
+    // Complete a pending partial group first
+    if (pending_ > 0) {
+      const std::size_t n = std::min(packing::group - pending_, values.size());
+      std::copy_n(values.begin(), n, group_.begin() + pending_);
+      pending_ += n;
+      values = values.subspan(n);
+      if (pending_ < packing::group) {
+        return;
+      }
+      write_groups(group_);
+      pending_ = 0;
+    }
+
+    const std::size_t whole = values.size() / packing::group * packing::group;
+    for (std::size_t i = 0; i < whole; i += chunk_groups * packing::group) {
+      write_groups(values.subspan(
+          i, std::min(chunk_groups * packing::group, whole - i)));
+    }
+    std::copy(values.begin() + static_cast<std::ptrdiff_t>(whole),
+              values.end(), group_.begin());
+    pending_ = values.size() - whole;
+  }
+
+  // Append unpacked values, packed (and rounded) by pack_n()
+  template <typename RoundingPolicy = rounding_policies::DefaultRoundingPolicy,
+            typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+  void write(std::span<const bool> sign,
+             std::span<const typename Format::exponent_type> exponent,
+             std::span<const unpacked_mantissa_t<Format, RoundingPolicy>>
+                 mantissa) {
+    const std::size_t n =
+        std::min({sign.size(), exponent.size(), mantissa.size()});
+    std::array<storage_type, chunk_groups * packing::group> bits;
+    for (std::size_t i = 0; i < n; i += bits.size()) {
+      const std::size_t m = std::min(bits.size(), n - i);
+      pack_n<Format, RoundingPolicy, DenormalPolicy>(
+          sign.subspan(i, m), exponent.subspan(i, m), mantissa.subspan(i, m),
+          std::span(bits).first(m));
+      write(std::span<const storage_type>(bits.data(), m));
+    }
+  }
+
+  // Write the last partial group and the header, and close the file
+  void close() {
+    if (pending_ > 0) {
+      std::array<std::uint64_t, packing::group_words> words{};
+      detail::pack_words<Format>(
+          std::span<const storage_type>(group_.data(), pending_), 0, words);
+      write_bytes(words.data(),
+                  packing::word_count(pending_) * sizeof(std::uint64_t));
+      pending_ = 0;
+    }
+    header_.data_bytes =
+        static_cast<std::uint64_t>(out_.tellp()) - header_.data_offset;
+    out_.seekp(0);
+    write_bytes(&header_, sizeof(TensorFileHeader));
+    out_.close();
+    if (!out_) {
+      throw detail::file_error("write", path_);
+    }
+  }
+
+private:
+  // Word groups packed per write
+  static constexpr std::size_t chunk_groups =
+      std::max<std::size_t>(detail::packed_chunk / packing::group, 1);
+
+  // Pack and write whole groups (at most chunk_groups)
+  void write_groups(std::span<const storage_type> values) {
+    std::array<std::uint64_t, chunk_groups * packing::group_words> words;
+    const std::size_t n = values.size() / packing::group * packing::group_words;
+    detail::pack_words<Format>(values, 0, std::span(words).first(n));
+    write_bytes(words.data(), n * sizeof(std::uint64_t));
+  }
+
+  void write_bytes(const void *data, std::size_t size) {
+    if (!out_.write(static_cast<const char *>(data),
+                    static_cast<std::streamsize>(size))) {
+      throw detail::file_error("write", path_);
+    }
+  }
+
+  std::filesystem::path path_;
+  std::ofstream out_;
+  TensorFileHeader header_;
+  std::array<storage_type, packing::group> group_{};
+  std::size_t pending_ = 0;
+};
+
+// Write a PackedArray (or any PackedView) as a Packed tensor file
+template <typename Format>
+void write_tensor_file(const std::filesystem::path &path,
+                       PackedView<Format> values) {
+  TensorWriter<Format> out(path, TensorLayout::Packed);
+  std::array<typename Format::storage_type, detail::packed_chunk> bits;
+  for (std::size_t i = 0; i < values.size(); i += bits.size()) {
+    const std::size_t n = values.load(i, bits);
+    out.write(std::span<const typename Format::storage_type>(bits.data(), n));
+  }
+  out.close();
+}
+
+template <typename Format>
+void write_tensor_file(const std::filesystem::path &path,
+                       const PackedArray<Format> &values) {
+  write_tensor_file(path, values.view());
+}
+
+// Write a MicroscaledArray (or any MicroscaledView) as a Microscaled tensor
+// file: header, scales, then the element blocks at the next 64-byte offset
+template <typename MxFormat>
+void write_tensor_file(const std::filesystem::path &path,
+                       MicroscaledView<MxFormat> values) {
+  TensorFileHeader header = describe_format<typename MxFormat::element_format>(
+      TensorLayout::Microscaled);
+  header.block_size = static_cast<std::uint32_t>(MxFormat::block_size);
+  header.count = values.size();
+  header.scales_offset = tensor_data_offset(sizeof(TensorFileHeader));
+  header.data_offset =
+      tensor_data_offset(header.scales_offset + values.scales().size());
+  header.data_bytes = values.elements().size();
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  const std::array<char, cache_line_size> zeros{};
+  auto write = [&](const void *data, std::size_t size) {
+    out.write(static_cast<const char *>(data),
+              static_cast<std::streamsize>(size));
+  };
+  write(&header, sizeof(header));
+  write(zeros.data(), header.scales_offset - sizeof(header));
+  write(values.scales().data(), values.scales().size());
+  write(zeros.data(),
+        header.data_offset - header.scales_offset - values.scales().size());
+  write(values.elements().data(), values.elements().size());
+  out.close();
+  if (!out) {
+    throw detail::file_error("write", path);
+  }
+}
+
+template <typename MxFormat>
+void write_tensor_file(const std::filesystem::path &path,
+                       const MicroscaledArray<MxFormat> &values) {
+  write_tensor_file(path, values.view());
+}
+
+} // namespace opine::inline v1
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+// Reference oracle shared by the unit tests, independent of the library
+//
+// Decodes IEEE-layout formats to double (exact for every format up to fp32)
+// and picks the correctly rounded encoding of a double in a target format by
+// direct comparison, in any IEEE 754 rounding direction. Results of exact
+// double arithmetic on decoded operands, rounded with round_to(), are the
+// expected results for OPINE's operations.
+//
+// The special values are read from Format::special_values: with infinities
+// the all-ones exponent is Inf/NaN (IEEE); without them there is one NaN per
+// sign at the all-ones exponent and mantissa, or (without -0) a single NaN
+// at the -0 encoding, or (without NaN) none at all.
+namespace oracle {
+
+// True if bits encode a NaN in Format
+template <typename Format> bool is_nan(std::uint64_t bits) {
+  using specials = typename Format::special_values;
+  const std::uint64_t mant_mask = (std::uint64_t{1} << Format::mant_bits) - 1;
+  const std::uint64_t exp_mask = (std::uint64_t{1} << Format::exp_bits) - 1;
+  const std::uint64_t sign_bit = std::uint64_t{1} << Format::sign_offset;
+  const bool top_binade = ((bits >> Format::exp_offset) & exp_mask) == exp_mask;
+  if constexpr (specials::has_infinity) {
+    return top_binade && (bits & mant_mask) != 0;
+  } else if constexpr (!specials::has_nan) {
+    return false;
+  } else if constexpr (!specials::has_negative_zero) {
+    return bits == sign_bit;
+  } else {
+    return top_binade && (bits & mant_mask) == mant_mask;
+  }
+}
+
+template <typename Format> double to_double(std::uint64_t bits) {
+  const std::uint64_t mant_mask = (std::uint64_t{1} << Format::mant_bits) - 1;
+  const std::uint64_t exp_mask = (std::uint64_t{1} << Format::exp_bits) - 1;
+  const std::uint64_t mant = bits & mant_mask;
+  const int exp = static_cast<int>((bits >> Format::exp_offset) & exp_mask);
+  const bool sign = (bits >> Format::sign_offset) & 1;
+  double value;
+  if (is_nan<Format>(bits)) {
+    value = NAN;
+  } else if (Format::special_values::has_infinity &&
+             exp == (1 << Format::exp_bits) - 1) {
+    value = INFINITY;
+  } else if (exp == 0) {
+    value = std::ldexp(static_cast<double>(mant),
+                       1 - Format::exp_bias - Format::mant_bits);
+  } else {
+    value = std::ldexp(static_cast<double>(mant | (std::uint64_t{1}
+                                                   << Format::mant_bits)),
+                       exp - Format::exp_bias - Format::mant_bits);
+  }
+  return sign ? -value : value;
+}
+
+// Rounding directions of the oracle
+enum class Rounding {
+  TowardZero,
+  NearestEven,
+  NearestAway,
+  TowardPositive,
+  TowardNegative
+};
+
+// Correctly rounded encoding of value in Dst, in direction R (NaN becomes
+// the quiet NaN, or +0 without NaN)
+//
+// A finite value beyond the largest finite one overflows as IEEE 754 says
+// (to nearest and away from zero: infinity, otherwise the largest finite
+// value); without infinities the overflow is NaN, and a saturating Dst
+// always gives the largest finite value.
+template <typename Dst, Rounding R> std::uint64_t round_with(double value) {
+  using specials = typename Dst::special_values;
+  const std::uint64_t sign_bit = std::uint64_t{1} << Dst::sign_offset;
+  const std::uint64_t exp_mask = (std::uint64_t{1} << Dst::exp_bits) - 1;
+  const std::uint64_t mant_mask = (std::uint64_t{1} << Dst::mant_bits) - 1;
+  const std::uint64_t inf = exp_mask << Dst::exp_offset;
+  const std::uint64_t sign = std::signbit(value) ? sign_bit : 0;
+  const double magnitude = std::fabs(value);
+  constexpr bool nearest =
+      R == Rounding::NearestEven || R == Rounding::NearestAway;
+  // Directed rounding away from zero for this sign
+  const bool up = (R == Rounding::TowardPositive && !sign) ||
+                  (R == Rounding::TowardNegative && sign);
+
+  // First positive encoding above the largest finite one
+  std::uint64_t top = inf;
+  if constexpr (!specials::has_infinity) {
+    top = specials::has_nan && specials::has_negative_zero
+              ? inf | mant_mask
+              : (inf | mant_mask) + 1;
+  }
+  const std::uint64_t largest = top - 1;
+
+  auto nan = [&] {
+    if constexpr (specials::has_infinity) {
+      return sign | inf | (std::uint64_t{1} << (Dst::mant_bits - 1));
+    } else if constexpr (!specials::has_nan) {
+      return std::uint64_t{0};
+    } else if constexpr (!specials::has_negative_zero) {
+      return sign_bit;
+    } else {
+      return sign | inf | mant_mask;
+    }
+  };
+  auto overflow = [&] {
+    if constexpr (specials::saturate) {
+      return sign | largest;
+    } else if constexpr (specials::has_infinity) {
+      return sign | inf;
+    } else {
+      return nan();
+    }
+  };
+
+  if (std::isnan(value)) {
+    return nan();
+  }
+
+  // Positive encodings are ordered by value; treat top as one ulp above the
+  // largest finite value for rounding purposes
+  const int largest_exp =
+      static_cast<int>((largest >> Dst::exp_offset) & exp_mask);
+  const double above_largest =
+      to_double<Dst>(largest) +
+      std::ldexp(1.0, largest_exp - Dst::exp_bias - Dst::mant_bits);
+  auto value_of = [&](std::uint64_t k) {
+    return k == top ? above_largest : to_double<Dst>(k);
+  };
+
+  if (std::isinf(magnitude)) {
+    return specials::has_infinity ? sign | inf : overflow();
+  }
+  if (magnitude >= above_largest) {
+    return nearest || up ? overflow() : sign | largest;
+  }
+
+  // Largest k with value_of(k) <= magnitude < value_of(k + 1)
+  std::uint64_t k = 0;
+  std::uint64_t above = top;
+  while (above - k > 1) {
+    const std::uint64_t mid = k + (above - k) / 2;
+    (value_of(mid) <= magnitude ? k : above) = mid;
+  }
+  if (value_of(k) != magnitude) {
+    const double twice = 2.0 * magnitude;
+    const double midpoint = value_of(k) + value_of(k + 1);
+    if constexpr (R == Rounding::NearestEven) {
+      if (twice > midpoint || (twice == midpoint && (k & 1))) {
+        ++k;
+      }
+    } else if constexpr (R == Rounding::NearestAway) {
+      if (twice >= midpoint) {
+        ++k;
+      }
+    } else if (up) {
+      ++k;
+    }
+  }
+  if (k == top) {
+    return overflow();
+  }
+  if (k == 0 && !specials::has_negative_zero) {
+    return 0;
+  }
+  return sign | k;
+}
+
+// Correctly rounded encoding of value in Dst: to nearest with ties to even,
+// or toward zero
+template <typename Dst, bool Nearest> std::uint64_t round_to(double value) {
+  return round_with<Dst, Nearest ? Rounding::NearestEven
+                                 : Rounding::TowardZero>(value);
+}
+
+// a / b rounded to double with round-to-odd (see fma_to_odd() below), for
+// operands with at most 26 significand bits
+inline double divide_to_odd(double a, double b) {
+  const double quotient = a / b;
+  if (!std::isfinite(quotient) || quotient == 0) {
+    return quotient;
+  }
+  // The exact remainder a - quotient * b says on which side the exact
+  // quotient lies
+  const double remainder = std::fma(-quotient, b, a);
+  if (remainder == 0 || (std::bit_cast<std::uint64_t>(quotient) & 1) != 0) {
+    return quotient;
+  }
+  const bool above = (remainder > 0) == (b > 0);
+  return std::nextafter(quotient, above ? INFINITY : -INFINITY);
+}
+
+// a * b + c rounded to double with round-to-odd
+//
+// Round-to-odd keeps the information a second rounding needs: rounding the
+// result to any format with at most 51 significand bits, in any rounding
+// direction, gives the correctly rounded a * b + c. The product a * b must be
+// exact in double (true for operands of up to 26 significand bits).
+inline double fma_to_odd(double a, double b, double c) {
+  const double product = a * b;
+  const double sum = product + c;
+  // TwoSum: the exact rounding error of product + c
+  const double product_part = sum - c;
+  const double error = (product - product_part) + (c - (sum - product_part));
+  if (error == 0 || std::isinf(sum) ||
+      (std::bit_cast<std::uint64_t>(sum) & 1) != 0) {
+    return sum;
+  }
+  return std::nextafter(sum, error > 0 ? INFINITY : -INFINITY);
+}
+
+} // namespace oracle
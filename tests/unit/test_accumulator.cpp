@@ -0,0 +1,264 @@
+#include "float_oracle.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <span>
+#include <vector>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+
+using fp8_bits = fp8_e4m3::storage_type;
+using fp16_bits = fp16_e5m10::storage_type;
+
+// Widths from the exponent ranges: e4m3 products lie in [2^-18, 2^16)
+using fp8_accumulator = ExactAccumulator<fp8_e4m3>;
+static_assert(fp8_accumulator::fraction_bits == 18 &&
+              fp8_accumulator::integer_bits == 16 &&
+              fp8_accumulator::bits == 67);
+static_assert(ExactAccumulator<fp16_e5m10>::bits == 113);
+static_assert(ExactAccumulator<fp8_e4m3, fp16_e5m10, 8>::bits == 66);
+
+// Known results, in constant expressions
+constexpr bool test_known_values() {
+  // [1, 2, 3] . [4, 5, 6] = 32; smallest denormal squared is exact
+  constexpr std::array<fp8_bits, 3> a = {0x38, 0x40, 0x44};
+  constexpr std::array<fp16_bits, 3> b = {0x4400, 0x4500, 0x4600};
+  if (dot_exact<fp32_e8m23, fp8_e4m3, fp16_e5m10>(
+          std::span<const fp8_bits>(a), std::span<const fp16_bits>(b)) !=
+      0x42000000u) {
+    return false;
+  }
+  fp8_accumulator tiny;
+  tiny.add_product(0x01, 0x01); // 2^-9 * 2^-9
+  tiny.add_product(0x81, 0x01);
+  tiny.add_product(0x01, 0x01);
+  if (pack(tiny.value<fp32_e8m23, RNE>()) != 0x36800000u) { // 2^-18
+    return false;
+  }
+  // 240 * 240 - 240 * 240 + 2^-18: no cancellation error
+  fp8_accumulator cancel;
+  cancel.add_product(0x77, 0x77);
+  cancel.add_product(0x01, 0x01);
+  cancel.add_product(0xF7, 0x77);
+  if (pack(cancel.value<fp32_e8m23, RNE>()) != 0x36800000u) {
+    return false;
+  }
+  // Plain values: 1 + 2 - 0.5
+  fp8_accumulator values;
+  values.add(0x38);
+  values.add(0x40);
+  values.add(0xB0);
+  return pack(values.value<fp16_e5m10, RNE>()) == 0x4100; // 2.5
+}
+static_assert(test_known_values(), "Known exact sums");
+
+// Pseudo-random finite values of a format
+template <typename Format>
+std::vector<typename Format::storage_type> random_values(std::size_t n,
+                                                         std::uint32_t seed) {
+  constexpr std::uint64_t mask = (std::uint64_t{1} << Format::total_bits) - 1;
+  std::vector<typename Format::storage_type> values(n);
+  for (auto &value : values) {
+    do {
+      seed = seed * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+      value = static_cast<typename Format::storage_type>((seed >> 8) & mask);
+    } while (!std::isfinite(oracle::to_double<Format>(value)));
+  }
+  return values;
+}
+
+// fp8_e4m3 products have at most 8 significant bits between 2^-18 and 2^16,
+// so a double sum of fewer than 2^19 of them is exact: dot_exact() must be
+// its correctly rounded value, in fp32, fp16 and fp8
+template <typename RoundingPolicy> bool test_rounded_once() {
+  constexpr bool nearest = std::is_same_v<RoundingPolicy, RNE>;
+  for (std::size_t n : {1, 2, 17, 1000, 4096}) {
+    for (std::uint32_t seed = 1; seed <= 20; ++seed) {
+      const auto a = random_values<fp8_e4m3>(n, seed);
+      const auto b = random_values<fp8_e4m3>(n, seed * 7919u);
+      double exact = 0.0;
+      for (std::size_t i = 0; i < n; ++i) {
+        exact += oracle::to_double<fp8_e4m3>(a[i]) *
+                 oracle::to_double<fp8_e4m3>(b[i]);
+      }
+      const auto a_span = std::span<const fp8_bits>(a);
+      const auto b_span = std::span<const fp8_bits>(b);
+      if (dot_exact<fp32_e8m23, fp8_e4m3, fp8_e4m3, RoundingPolicy>(
+              a_span, b_span) !=
+              oracle::round_to<fp32_e8m23, nearest>(exact) ||
+          dot_exact<fp16_e5m10, fp8_e4m3, fp8_e4m3, RoundingPolicy>(
+              a_span, b_span) !=
+              oracle::round_to<fp16_e5m10, nearest>(exact) ||
+          dot_exact<fp8_e5m2, fp8_e4m3, fp8_e4m3, RoundingPolicy>(
+              a_span, b_span) != oracle::round_to<fp8_e5m2, nearest>(exact)) {
+        printf("\n  n = %zu, seed %u\n", n, seed);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// fp16 products span 2^-48 to 2^32: the raw sum must equal a 128-bit
+// integer sum of the significand products
+bool test_fp16_raw_sum() {
+  using accumulator = ExactAccumulator<fp16_e5m10>;
+  for (std::uint32_t seed = 1; seed <= 20; ++seed) {
+    const auto a = random_values<fp16_e5m10>(777, seed);
+    const auto b = random_values<fp16_e5m10>(777, seed * 31u);
+    accumulator acc;
+    acc.add_products(a, b);
+
+    __extension__ using int128 = __int128;
+    int128 expected = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      auto significand = [](fp16_bits bits, int &exponent) {
+        const int field = (bits >> 10) & 0x1F;
+        exponent = field == 0 ? 1 : field;
+        return static_cast<int128>((bits & 0x3FF) | (field == 0 ? 0 : 0x400));
+      };
+      int ea = 0;
+      int eb = 0;
+      const int128 product = significand(a[i], ea) * significand(b[i], eb)
+                             << (ea + eb - 2);
+      const bool negative = ((a[i] ^ b[i]) & 0x8000) != 0;
+      expected += negative ? -product : product;
+    }
+    const auto raw = static_cast<unsigned __int128>(expected);
+    const auto &sum = acc.sum();
+    if (sum.limb(0) != static_cast<std::uint64_t>(raw) ||
+        sum.limb(1) != (static_cast<std::uint64_t>(raw >> 64) &
+                        ((std::uint64_t{1} << (accumulator::bits - 64)) - 1))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Partial sums over any partition, merged in any order, hold the same bits
+bool test_merge_order() {
+  using accumulator = ExactAccumulator<fp8_e4m3, fp16_e5m10>;
+  const auto a = random_values<fp8_e4m3>(5000, 3);
+  const auto b = random_values<fp16_e5m10>(5000, 5);
+  accumulator whole;
+  whole.add_products(a, b);
+
+  std::uint32_t state = 17;
+  for (int trial = 0; trial < 20; ++trial) {
+    // Random cut points, partials merged in a shuffled order
+    std::vector<std::size_t> cuts = {0, a.size()};
+    for (int c = 0; c < 1 + trial; ++c) {
+      state = state * 1664525u + 1013904223u;
+      cuts.push_back(state % a.size());
+    }
+    std::sort(cuts.begin(), cuts.end());
+    std::vector<accumulator> partials(cuts.size() - 1);
+    for (std::size_t p = 0; p + 1 < cuts.size(); ++p) {
+      partials[p].add_products(
+          std::span<const fp8_bits>(a).subspan(cuts[p], cuts[p + 1] - cuts[p]),
+          std::span<const fp16_bits>(b).subspan(cuts[p],
+                                                cuts[p + 1] - cuts[p]));
+    }
+    std::reverse(partials.begin(), partials.end());
+    std::rotate(partials.begin(), partials.begin() + trial % partials.size(),
+                partials.end());
+    accumulator merged;
+    for (const auto &partial : partials) {
+      merged.merge(partial);
+    }
+    // The products in reverse order
+    accumulator reversed;
+    for (std::size_t i = a.size(); i-- > 0;) {
+      reversed.add_product(a[i], b[i]);
+    }
+    if (!(merged == whole) || !(reversed == whole) ||
+        pack(merged.value<fp32_e8m23, RNE>()) !=
+            pack(whole.value<fp32_e8m23, RNE>())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// gemv_exact() rows are dot_exact() of each row
+bool test_gemv_exact() {
+  constexpr std::size_t rows = 5;
+  constexpr std::size_t cols = 300;
+  const auto w = random_values<fp8_e4m3>(rows * cols, 21);
+  const auto x = random_values<fp16_e5m10>(cols, 23);
+  std::vector<fp16_bits> y(rows + 1, 0xBEEF);
+  if (gemv_exact<fp16_e5m10, fp8_e4m3, fp16_e5m10, RTZ>(
+          std::span<const fp8_bits>(w), std::span<const fp16_bits>(x),
+          std::span<fp16_bits>(y)) != rows) {
+    return false;
+  }
+  for (std::size_t r = 0; r < rows; ++r) {
+    if (y[r] != dot_exact<fp16_e5m10, fp8_e4m3, fp16_e5m10, RTZ>(
+                    std::span<const fp8_bits>(w).subspan(r * cols, cols),
+                    std::span<const fp16_bits>(x))) {
+      return false;
+    }
+  }
+  return y[rows] == 0xBEEF;
+}
+
+// Specials: NaN, Inf * 0 and opposite infinities give NaN, one infinity is
+// kept, an exact zero is +0; a sum beyond the destination overflows
+bool test_specials() {
+  using accumulator = ExactAccumulator<fp8_e5m2>;
+  auto sum_of = [](std::initializer_list<std::array<std::uint8_t, 2>> terms) {
+    accumulator acc;
+    for (const auto &term : terms) {
+      acc.add_product(term[0], term[1]);
+    }
+    return static_cast<std::uint32_t>(pack(acc.value<fp32_e8m23, RNE>()));
+  };
+  const auto is_nan = [](std::uint32_t bits) {
+    return std::isnan(std::bit_cast<float>(bits));
+  };
+  accumulator wide;
+  for (int i = 0; i < 1000; ++i) {
+    wide.add_product(0x7B, 0x7B); // 57344^2
+  }
+  return is_nan(sum_of({{0x7E, 0x3C}})) &&                  // NaN * 1
+         is_nan(sum_of({{0x7C, 0x00}})) &&                  // Inf * 0
+         is_nan(sum_of({{0x7C, 0x3C}, {0xFC, 0x3C}})) &&    // Inf - Inf
+         sum_of({{0x7C, 0xBC}, {0x3C, 0x3C}}) == 0xFF800000u && // -Inf
+         sum_of({{0x3C, 0x3C}, {0xBC, 0x3C}}) == 0 &&       // +0
+         sum_of({}) == 0 &&
+         pack(wide.value<fp16_e5m10, RNE>()) == 0x7C00 &&
+         pack(wide.value<fp16_e5m10, RTZ>()) == 0x7BFF &&
+         pack(wide.value<fp32_e8m23, RNE>()) == 0x543F6800u; // 3288334336000
+}
+
+int main() {
+  printf("=== OPINE Exact Accumulator Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("Known values", test_known_values());
+  report("fp8 dot_exact RNE rounded once", test_rounded_once<RNE>());
+  report("fp8 dot_exact RTZ rounded once", test_rounded_once<RTZ>());
+  report("fp16 raw sum vs 128-bit integers", test_fp16_raw_sum());
+  report("Partitions and merge order", test_merge_order());
+  report("gemv_exact rows vs dot_exact", test_gemv_exact());
+  report("Special values", test_specials());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,231 @@
+#include "float_oracle.hpp"
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+using RUP = rounding_policies::TowardPositive;
+using table_policies::DefaultTablePolicy;
+using table_policies::LargeTables;
+using table_policies::NoTables;
+using table_policies::SmallTables;
+
+// The plan: a seed table indexed by every stored mantissa bit needs no Newton
+// step, and a table covering every fraction bit of f no polynomial
+using fp8_plan = detail::approximation_traits<fp8_e4m3, DefaultTablePolicy>;
+static_assert(fp8_plan::recip_iterations == 0 &&
+              fp8_plan::rsqrt_iterations == 0 && fp8_plan::exp_degree == 0);
+using fp16_plan =
+    detail::approximation_traits<fp16_e5m10, DefaultTablePolicy>;
+static_assert(fp16_plan::recip_seed_bits == 10 &&
+              fp16_plan::recip_iterations == 0);
+static_assert(fp16_plan::rsqrt_iterations == 1 && fp16_plan::exp_degree == 1);
+static_assert(
+    detail::approximation_traits<fp16_e5m10, SmallTables>::recip_iterations ==
+    1);
+static_assert(
+    detail::approximation_traits<fp32_e8m23, DefaultTablePolicy>::
+            recip_iterations == 2);
+static_assert(
+    detail::approximation_traits<fp32_e8m23, NoTables>::recip_seed_bits == 0);
+
+// Exact cases, in constant expressions
+static_assert(pack(recip(unpack<fp16_e5m10, RNE>(0x4000))) == 0x3800); // 1/2
+static_assert(pack(recip(unpack<fp16_e5m10, RNE>(0xC400))) == 0xB400);
+static_assert(pack(rsqrt(unpack<fp16_e5m10, RNE>(0x4400))) == 0x3800); // 4
+static_assert(pack(rsqrt<NoTables>(unpack<fp16_e5m10, RNE>(0x2C00))) ==
+              0x4400); // 1/16
+static_assert(pack(exp(unpack<fp16_e5m10, RNE>(0x8000))) == 0x3C00);
+static_assert(pack(recip(unpack<fp8_e5m2, RNE>(0x00))) == 0x7C);
+static_assert(pack(rsqrt(unpack<fp8_e5m2, RNE>(0x80))) == 0xFC);
+
+enum class Function { Recip, Rsqrt, Exp };
+
+double exact(Function function, double x) {
+  switch (function) {
+  case Function::Recip:
+    return 1.0 / x;
+  case Function::Rsqrt:
+    return 1.0 / std::sqrt(x);
+  default: {
+    // Beyond the range of double, e^x is still finite: DBL_MAX stands in
+    const long double value = std::exp(static_cast<long double>(x));
+    return std::isinf(x) || !(value > DBL_MAX) ? static_cast<double>(value)
+                                                : DBL_MAX;
+  }
+  }
+}
+
+template <typename TablePolicy, typename Format, typename RoundingPolicy>
+typename Format::storage_type approximate(Function function,
+                                          std::uint64_t bits) {
+  const auto x = unpack<Format, RoundingPolicy>(
+      static_cast<typename Format::storage_type>(bits));
+  switch (function) {
+  case Function::Recip:
+    return pack(recip<TablePolicy>(x));
+  case Function::Rsqrt:
+    return pack(rsqrt<TablePolicy>(x));
+  default:
+    return pack(exp<TablePolicy>(x));
+  }
+}
+
+template <typename RoundingPolicy> constexpr oracle::Rounding direction() {
+  if constexpr (std::is_same_v<RoundingPolicy, RNE>) {
+    return oracle::Rounding::NearestEven;
+  } else if constexpr (std::is_same_v<RoundingPolicy, RTZ>) {
+    return oracle::Rounding::TowardZero;
+  } else {
+    return oracle::Rounding::TowardPositive;
+  }
+}
+
+// The documented bound: within 0.75 ulp of the exact value under
+// round-to-nearest, 1.25 ulp under directed rounding. The ulp is the exact
+// value's (the denormal ulp below the normal range), an overflowed result
+// counts as the largest finite value plus one top-binade ulp, and exact
+// values beyond that (or infinite, or NaN) must give the correctly rounded
+// result.
+template <typename Format, typename RoundingPolicy>
+bool within_bound(double expected, std::uint64_t result) {
+  constexpr auto rounding = direction<RoundingPolicy>();
+  constexpr double bound =
+      rounding == oracle::Rounding::NearestEven ? 0.75 : 1.25;
+  constexpr int min_exponent = 1 - Format::exp_bias;
+  const double largest = std::ldexp(
+      1.0 + std::ldexp(static_cast<double>(
+                           detail::max_finite_mantissa<Format>()),
+                       -Format::mant_bits),
+      static_cast<int>(detail::max_finite_exponent<Format>()) -
+          Format::exp_bias);
+  const double top_ulp =
+      std::ldexp(1.0, static_cast<int>(detail::max_finite_exponent<Format>()) -
+                          Format::exp_bias - Format::mant_bits);
+
+  if (std::isnan(expected) || std::isinf(expected) ||
+      std::fabs(expected) >= largest + top_ulp) {
+    const auto rounded = oracle::round_with<Format, rounding>(expected);
+    if (std::isnan(expected)) {
+      return oracle::is_nan<Format>(result) == oracle::is_nan<Format>(rounded);
+    }
+    return result == rounded;
+  }
+
+  double value = oracle::to_double<Format>(result);
+  if (std::isnan(value) || std::isinf(value)) {
+    value = std::copysign(largest + top_ulp, expected);
+  }
+  int exponent = 0;
+  std::frexp(expected, &exponent);
+  const double ulp = std::ldexp(
+      1.0, std::max(exponent - 1, min_exponent) - Format::mant_bits);
+  return std::fabs(value - expected) <= bound * ulp;
+}
+
+// Every encoding of a format (NaNs, infinities and denormals included)
+template <typename Format, typename RoundingPolicy,
+          typename TablePolicy = DefaultTablePolicy>
+bool test_exhaustive() {
+  for (Function function : {Function::Recip, Function::Rsqrt, Function::Exp}) {
+    for (std::uint64_t bits = 0; bits < (1u << Format::total_bits); ++bits) {
+      const double expected =
+          exact(function, oracle::to_double<Format>(bits));
+      const auto result =
+          approximate<TablePolicy, Format, RoundingPolicy>(function, bits);
+      if (!within_bound<Format, RoundingPolicy>(expected, result)) {
+        printf("\n  function %d, %04llX -> %04llX\n",
+               static_cast<int>(function),
+               static_cast<unsigned long long>(bits),
+               static_cast<unsigned long long>(result));
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Pseudo-random fp32 encodings
+template <typename RoundingPolicy, typename TablePolicy>
+bool test_fp32_sampled() {
+  std::uint32_t state = 7;
+  for (int i = 0; i < 100000; ++i) {
+    state = state * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    // Every other sample with 2^-9 <= |x| < 2^7, where exp() has finite,
+    // nonzero results
+    const std::uint32_t exponent = 118 + (state >> 24) % 16;
+    const std::uint32_t bits =
+        i % 2 == 0 ? state : (state & 0x807FFFFFu) | (exponent << 23);
+    for (Function function :
+         {Function::Recip, Function::Rsqrt, Function::Exp}) {
+      const double expected =
+          exact(function, oracle::to_double<fp32_e8m23>(bits));
+      const auto result =
+          approximate<TablePolicy, fp32_e8m23, RoundingPolicy>(function,
+                                                               bits);
+      if (!within_bound<fp32_e8m23, RoundingPolicy>(expected, result)) {
+        printf("\n  function %d, %08X -> %08llX\n",
+               static_cast<int>(function), static_cast<unsigned>(bits),
+               static_cast<unsigned long long>(result));
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// An unrounded arithmetic result is approximated at the value it packs to
+bool test_unrounded_operand() {
+  const auto three = unpack<fp16_e5m10, RNE>(0x4200);
+  const auto seven = unpack<fp16_e5m10, RNE>(0x4700);
+  const auto quotient = divide(seven, three); // 7/3, guard bits set
+  return pack(recip(quotient)) == pack(recip(round(quotient))) &&
+         pack(exp(quotient)) == pack(exp(round(quotient)));
+}
+
+int main() {
+  printf("=== OPINE Approximation Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("fp8_e5m2 RNE exhaustive", test_exhaustive<fp8_e5m2, RNE>());
+  report("fp8_e4m3 RTZ exhaustive", test_exhaustive<fp8_e4m3, RTZ>());
+  report("fp8_e4m3fn RNE exhaustive", test_exhaustive<fp8_e4m3fn, RNE>());
+  report("fp8_e4m3fnuz TowardPositive exhaustive",
+         test_exhaustive<fp8_e4m3fnuz, RUP>());
+  report("fp8_e4m3 RNE exhaustive (no tables)",
+         test_exhaustive<fp8_e4m3, RNE, NoTables>());
+  report("fp16_e5m10 RNE exhaustive", test_exhaustive<fp16_e5m10, RNE>());
+  report("fp16_e5m10 RTZ exhaustive", test_exhaustive<fp16_e5m10, RTZ>());
+  report("fp16_e5m10 TowardPositive exhaustive",
+         test_exhaustive<fp16_e5m10, RUP>());
+  report("fp16_e5m10 RNE exhaustive (no tables)",
+         test_exhaustive<fp16_e5m10, RNE, NoTables>());
+  report("fp16_e5m10 RNE exhaustive (small tables)",
+         test_exhaustive<fp16_e5m10, RNE, SmallTables>());
+  report("fp16_e5m10 RNE exhaustive (large tables)",
+         test_exhaustive<fp16_e5m10, RNE, LargeTables>());
+  report("fp32_e8m23 RNE sampled",
+         test_fp32_sampled<RNE, DefaultTablePolicy>());
+  report("fp32_e8m23 RTZ sampled (no tables)",
+         test_fp32_sampled<RTZ, NoTables>());
+  report("fp32_e8m23 RNE sampled (large tables)",
+         test_fp32_sampled<RNE, LargeTables>());
+  report("Unrounded operands", test_unrounded_operand());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
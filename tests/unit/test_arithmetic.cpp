@@ -0,0 +1,291 @@
+#include "float_oracle.hpp"
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <vector>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+
+enum class Op { Add, Subtract, Multiply, Divide };
+
+// Storage-level operation through the UnpackedFloat arithmetic
+template <typename Format, typename RoundingPolicy>
+constexpr typename Format::storage_type
+apply(Op op, typename Format::storage_type a, typename Format::storage_type b) {
+  const auto x = unpack<Format, RoundingPolicy>(a);
+  const auto y = unpack<Format, RoundingPolicy>(b);
+  switch (op) {
+  case Op::Add:
+    return pack<Format, RoundingPolicy>(add(x, y));
+  case Op::Subtract:
+    return pack<Format, RoundingPolicy>(subtract(x, y));
+  case Op::Multiply:
+    return pack<Format, RoundingPolicy>(multiply(x, y));
+  case Op::Divide:
+    return pack<Format, RoundingPolicy>(divide(x, y));
+  }
+  return 0;
+}
+
+double apply_double(Op op, double a, double b) {
+  switch (op) {
+  case Op::Add:
+    return a + b;
+  case Op::Subtract:
+    return a - b;
+  case Op::Multiply:
+    return a * b;
+  case Op::Divide:
+    return a / b;
+  }
+  return 0.0;
+}
+
+// Known results, checked at compile time
+constexpr bool test_known_values() {
+  // fp8_e5m2: 1.0 = 0x3C, 2.0 = 0x40, 1.5 = 0x3E, Inf = 0x7C
+  if (apply<fp8_e5m2, RNE>(Op::Add, 0x3C, 0x3C) != 0x40) {
+    return false;
+  }
+  if (apply<fp8_e5m2, RNE>(Op::Multiply, 0x3E, 0x3E) != 0x40) {
+    return false; // 1.5 * 1.5 = 2.25 -> 2.0 (RNE)
+  }
+  if (apply<fp8_e5m2, RTZ>(Op::Divide, 0x3C, 0x3E) != 0x39) {
+    return false; // 1.0 / 1.5 = 0.666 -> 0.625 (TowardZero)
+  }
+  if (apply<fp8_e5m2, RNE>(Op::Subtract, 0x3C, 0x3C) != 0x00) {
+    return false; // x - x = +0
+  }
+  // Specials: Inf - Inf = NaN, 1 / 0 = Inf, -1 / 0 = -Inf, 0 * Inf = NaN
+  const auto inf_minus_inf = apply<fp8_e5m2, RNE>(Op::Subtract, 0x7C, 0x7C);
+  if ((inf_minus_inf & 0x7C) != 0x7C || (inf_minus_inf & 0x03) == 0) {
+    return false;
+  }
+  if (apply<fp8_e5m2, RNE>(Op::Divide, 0x3C, 0x00) != 0x7C ||
+      apply<fp8_e5m2, RNE>(Op::Divide, 0xBC, 0x00) != 0xFC) {
+    return false;
+  }
+  if ((apply<fp8_e5m2, RNE>(Op::Multiply, 0x00, 0x7C) & 0x03) == 0) {
+    return false;
+  }
+  // Overflow: max * 2 is Inf under RNE, max finite under TowardZero
+  if (apply<fp8_e5m2, RNE>(Op::Multiply, 0x7B, 0x40) != 0x7C ||
+      apply<fp8_e5m2, RTZ>(Op::Multiply, 0x7B, 0x40) != 0x7B) {
+    return false;
+  }
+  // fp32: 1.0 + 2^-24 is a tie and stays 1.0, 1.0 + 3 * 2^-24 rounds up
+  if (apply<fp32_e8m23, RNE>(Op::Add, 0x3F800000u, 0x33800000u) !=
+          0x3F800000u ||
+      apply<fp32_e8m23, RNE>(Op::Add, 0x3F800000u, 0x34400000u) !=
+          0x3F800002u) {
+    return false;
+  }
+  return true;
+}
+
+static_assert(test_known_values(), "Known arithmetic results");
+
+// Chained operations stay unpacked and are rounded once
+constexpr bool test_round_once() {
+  using unpacked = UnpackedFloat<fp8_e5m2, RNE>;
+  const unpacked one = unpack<fp8_e5m2, RNE>(0x3C);
+  const unpacked eighth = unpack<fp8_e5m2, RNE>(0x30); // 0.125
+
+  // 1 + 0.125 is a tie (rounds to 1), plus another 0.125 is 1.25 exactly
+  const auto fused = add(add(one, eighth), eighth);
+  const auto stepped = add(round(add(one, eighth)), eighth);
+  return pack<fp8_e5m2, RNE>(fused) == 0x3D &&
+         pack<fp8_e5m2, RNE>(stepped) == 0x3C;
+}
+
+static_assert(test_round_once(), "Chains round once, round() rounds a step");
+
+// FloatEngine operators
+constexpr bool test_float_engine() {
+  using fp8 = FloatEngine<FloatConfig<fp8_e4m3, RNE>>;
+  const auto one = fp8::from_bits(0x38);
+  const auto two = fp8::from_bits(0x40);
+
+  auto x = one;
+  x += two; // 3.0
+  x *= two; // 6.0
+  x -= one; // 5.0
+  x /= two; // 2.5
+
+  return fp8(one * two).bits() == 0x40 && fp8(two - one).bits() == 0x38 &&
+         fp8(one / two).bits() == 0x30 && fp8(-one).bits() == 0xB8 &&
+         x.bits() == 0x42 &&
+         fp8::from_unpacked(x.unpacked()).bits() == x.bits();
+}
+
+static_assert(test_float_engine(), "FloatEngine operators");
+
+// Test helper: one operation over a set of operand pairs must match the
+// correctly rounded double result (NaN results only need to be NaN)
+template <typename Format, typename RoundingPolicy>
+bool test_matches_oracle(Op op, const std::vector<std::uint64_t> &values,
+                         std::size_t stride = 1) {
+  using storage_type = typename Format::storage_type;
+  constexpr bool nearest = std::is_same_v<RoundingPolicy, RNE>;
+
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    for (std::size_t j = i % stride; j < values.size(); j += stride) {
+      const auto a = static_cast<storage_type>(values[i]);
+      const auto b = static_cast<storage_type>(values[j]);
+      const auto actual =
+          static_cast<std::uint64_t>(apply<Format, RoundingPolicy>(op, a, b));
+      const double exact =
+          apply_double(op, oracle::to_double<Format>(values[i]),
+                       oracle::to_double<Format>(values[j]));
+      const auto expected = oracle::round_to<Format, nearest>(exact);
+      const bool match = oracle::is_nan<Format>(expected)
+                             ? oracle::is_nan<Format>(actual)
+                             : actual == expected;
+      if (!match) {
+        printf("\n  mismatch: op %d, 0x%llx, 0x%llx -> 0x%llx (want 0x%llx)\n",
+               static_cast<int>(op), static_cast<unsigned long long>(a),
+               static_cast<unsigned long long>(b),
+               static_cast<unsigned long long>(actual),
+               static_cast<unsigned long long>(expected));
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Test helper: all four operations on every pair of encodings
+template <typename Format, typename RoundingPolicy> bool test_exhaustive() {
+  std::vector<std::uint64_t> values(std::size_t{1} << Format::total_bits);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = i;
+  }
+  return test_matches_oracle<Format, RoundingPolicy>(Op::Add, values) &&
+         test_matches_oracle<Format, RoundingPolicy>(Op::Subtract, values) &&
+         test_matches_oracle<Format, RoundingPolicy>(Op::Multiply, values) &&
+         test_matches_oracle<Format, RoundingPolicy>(Op::Divide, values);
+}
+
+// Test helper: all four operations on fp16, each operand against a strided
+// subset of the others
+template <typename RoundingPolicy> bool test_fp16_sampled() {
+  std::vector<std::uint64_t> values(65536);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = i;
+  }
+  constexpr std::size_t stride = 4099; // prime: every j residue is visited
+  return test_matches_oracle<fp16_e5m10, RoundingPolicy>(Op::Add, values,
+                                                         stride) &&
+         test_matches_oracle<fp16_e5m10, RoundingPolicy>(Op::Subtract, values,
+                                                         stride) &&
+         test_matches_oracle<fp16_e5m10, RoundingPolicy>(Op::Multiply, values,
+                                                         stride) &&
+         test_matches_oracle<fp16_e5m10, RoundingPolicy>(Op::Divide, values,
+                                                         stride);
+}
+
+// Test helper: fp32 RNE must be bit-exact with the host's float arithmetic
+bool test_fp32_matches_host() {
+  std::uint32_t state = 0x9E3779B9u;
+  auto next = [&] {
+    state = state * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    return state;
+  };
+
+  for (int i = 0; i < 400000; ++i) {
+    std::uint32_t a = next();
+    std::uint32_t b = next();
+    if (i & 1) {
+      // Nearby exponents, where additions cancel and round most often
+      b = (b & 0x807FFFFFu) | (a & 0x7F800000u);
+    }
+    if ((i & 7) == 2) {
+      a &= 0x807FFFFFu; // denormal or zero
+    }
+
+    const float x = std::bit_cast<float>(a);
+    const float y = std::bit_cast<float>(b);
+    const float expected[] = {x + y, x - y, x * y, x / y};
+    const Op ops[] = {Op::Add, Op::Subtract, Op::Multiply, Op::Divide};
+    for (int k = 0; k < 4; ++k) {
+      const std::uint32_t actual = apply<fp32_e8m23, RNE>(ops[k], a, b);
+      const auto want = std::bit_cast<std::uint32_t>(expected[k]);
+      const bool match = expected[k] != expected[k]
+                             ? oracle::is_nan<fp32_e8m23>(actual)
+                             : actual == want;
+      if (!match) {
+        printf("\n  mismatch: op %d, 0x%08x, 0x%08x -> 0x%08x (want 0x%08x)\n",
+               k, a, b, actual, want);
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Test helper: round() must agree with pack() on arithmetic results
+template <typename Format, typename RoundingPolicy> bool test_round() {
+  using storage_type = typename Format::storage_type;
+  const std::size_t total_values = std::size_t{1} << Format::total_bits;
+
+  for (std::size_t i = 0; i < total_values; ++i) {
+    for (std::size_t j = 0; j < total_values; ++j) {
+      const auto a = static_cast<storage_type>(i);
+      const auto b = static_cast<storage_type>(j);
+      const auto x = unpack<Format, RoundingPolicy>(a);
+      const auto y = unpack<Format, RoundingPolicy>(b);
+      for (const auto &result : {add(x, y), multiply(x, y), divide(x, y)}) {
+        const auto rounded = round(result);
+        const auto packed = pack<Format, RoundingPolicy>(result);
+        if (pack<Format, RoundingPolicy>(rounded) != packed) {
+          return false;
+        }
+        const auto reunpacked = unpack<Format, RoundingPolicy>(packed);
+        if (is_finite(rounded) &&
+            (rounded.sign != reunpacked.sign ||
+             rounded.exponent != reunpacked.exponent ||
+             rounded.mantissa != reunpacked.mantissa)) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+int main() {
+  printf("=== OPINE Arithmetic Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("Known values", test_known_values());
+  report("Chains round once", test_round_once());
+  report("FloatEngine operators", test_float_engine());
+  report("fp8_e5m2 RNE (all pairs)", test_exhaustive<fp8_e5m2, RNE>());
+  report("fp8_e5m2 TowardZero (all pairs)", test_exhaustive<fp8_e5m2, RTZ>());
+  report("fp8_e4m3 RNE (all pairs)", test_exhaustive<fp8_e4m3, RNE>());
+  report("fp8_e4m3 TowardZero (all pairs)", test_exhaustive<fp8_e4m3, RTZ>());
+  report("fp16 RNE (sampled pairs)", test_fp16_sampled<RNE>());
+  report("fp16 TowardZero (sampled pairs)", test_fp16_sampled<RTZ>());
+  report("fp32 RNE vs host float (sampled)", test_fp32_matches_host());
+  report("round() vs pack()",
+         test_round<fp8_e5m2, RNE>() && test_round<fp8_e4m3, RTZ>());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
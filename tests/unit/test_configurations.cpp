@@ -0,0 +1,286 @@
+#include <compare>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Property tests over every policy combination
+//
+// The configurations are the CartesianProduct of formats, special-value
+// policies, rounding policies and denormal policies (design.md §11). The
+// build compiles this file once per shard (opine_add_sharded_executable),
+// each copy instantiating only its shard_t of the configurations and
+// registering them; shard 0 runs them all.
+//
+// Guard bits are not a dimension of their own here: every rounding policy
+// fixes its guard bits, and the stochastic policies cover other widths.
+
+#ifndef OPINE_SHARD_INDEX
+#define OPINE_SHARD_INDEX 0
+#define OPINE_SHARD_COUNT 1
+#endif
+
+using namespace opine;
+
+// A test registered by a shard (one registry shared by all shards)
+struct ConfigurationTest {
+  std::string name;
+  bool (*run)();
+};
+
+inline std::vector<ConfigurationTest> &configuration_tests() {
+  static std::vector<ConfigurationTest> tests;
+  return tests;
+}
+
+namespace {
+
+namespace rp = rounding_policies;
+namespace dp = denormal_policies;
+namespace sv = special_value_policies;
+
+using AllFormats =
+    TypeList<fp8_e5m2, fp8_e4m3, fp6_e3m2, fp6_e2m3, fp4_e2m1, fp16_e5m10>;
+using AllSpecialValues = TypeList<sv::IEEE, sv::SaturatingIEEE, sv::FiniteNaN,
+                                  sv::SaturatingFiniteNaN, sv::FNUZ,
+                                  sv::FiniteOnly>;
+using AllRoundingModes =
+    TypeList<rp::TowardZero, rp::ToNearestTiesToEven,
+             rp::ToNearestTiesAwayFromZero, rp::TowardPositive,
+             rp::TowardNegative, rp::Stochastic<>, rp::Stochastic<12>>;
+using AllDenormalPolicies =
+    TypeList<dp::FullSupport, dp::FlushToZero, dp::FlushInputsToZero>;
+
+using AllConfigurations = CartesianProduct<AllFormats, AllSpecialValues,
+                                           AllRoundingModes,
+                                           AllDenormalPolicies>;
+
+// Budget: wider formats only with IEEE special values and deterministic
+// rounding (sampled, and each configuration compiles the whole engine)
+template <typename Config> struct Affordable;
+template <typename Format, typename SpecialValues, typename RoundingPolicy,
+          typename DenormalPolicy>
+struct Affordable<
+    TypeList<Format, SpecialValues, RoundingPolicy, DenormalPolicy>> {
+  static constexpr bool value =
+      Format::total_bits <= 8 ||
+      (std::is_same_v<SpecialValues, sv::IEEE> &&
+       !rp::is_stochastic<RoundingPolicy>);
+};
+
+using Configurations = filter_t<Affordable, AllConfigurations>;
+
+static_assert(AllConfigurations::size == 6 * 6 * 7 * 3);
+static_assert(Configurations::size == 5 * 6 * 7 * 3 + 5 * 3);
+
+// The type list operations themselves
+static_assert(std::is_same_v<CartesianProduct<TypeList<int, char>,
+                                              TypeList<float, double>>,
+                             TypeList<TypeList<int, float>,
+                                      TypeList<int, double>,
+                                      TypeList<char, float>,
+                                      TypeList<char, double>>>);
+static_assert(std::is_same_v<CartesianProduct<>, TypeList<TypeList<>>>);
+static_assert(std::is_same_v<CartesianProduct<TypeList<int>, TypeList<>>,
+                             TypeList<>>);
+static_assert(std::is_same_v<shard_t<TypeList<int, char, float>, 1, 2>,
+                             TypeList<char>>);
+static_assert(shard_t<Configurations, 0, 8>::size +
+                  shard_t<Configurations, 7, 8>::size <=
+              2 * (Configurations::size / 8 + 1));
+static_assert(std::is_same_v<apply_t<UnpackedFloat,
+                                     TypeList<fp8_e4m3, rp::TowardZero>>,
+                             UnpackedFloat<fp8_e4m3, rp::TowardZero>>);
+
+template <typename RoundingPolicy> std::string rounding_name() {
+  if constexpr (rp::is_stochastic<RoundingPolicy>) {
+    return "SR" + std::to_string(RoundingPolicy::guard_bits);
+  } else if constexpr (std::is_same_v<RoundingPolicy, rp::TowardZero>) {
+    return "RTZ";
+  } else if constexpr (std::is_same_v<RoundingPolicy,
+                                      rp::ToNearestTiesToEven>) {
+    return "RNE";
+  } else if constexpr (std::is_same_v<RoundingPolicy,
+                                      rp::ToNearestTiesAwayFromZero>) {
+    return "RNA";
+  } else if constexpr (std::is_same_v<RoundingPolicy, rp::TowardPositive>) {
+    return "RUP";
+  } else {
+    return "RDN";
+  }
+}
+
+template <typename SpecialValues> std::string special_values_name() {
+  constexpr const char *names[] = {"IEEE", "FiniteNaN", "FNUZ", "Finite"};
+  return std::string(SpecialValues::saturate &&
+                             SpecialValues::encoding !=
+                                 sv::SpecialValueEncoding::Finite
+                         ? "Saturating"
+                         : "") +
+         names[static_cast<int>(SpecialValues::encoding)];
+}
+
+// Test helper: properties every configuration must have
+//
+//   round trip      pack(unpack(x)) == x (x not NaN, and not a flushed
+//                   denormal)
+//   commutativity   a + b and a * b equal b + a and b * a before rounding
+//                   (except on overflow under stochastic rounding, which
+//                   draws whether to overflow)
+//   identity        x * 1 and x + 0 (x nonzero) are x
+//   monotonicity    a < b implies round(a * c) <= round(b * c) for c > 0
+//                   (not for stochastic rounding, which may round a * c up
+//                   and b * c down)
+//
+// Formats up to 8 bits are tested exhaustively, wider ones on a sample;
+// monotonicity always on a sample.
+template <typename Base, typename SpecialValues, typename RoundingPolicy,
+          typename DenormalPolicy>
+bool test_properties() {
+  using Format = typename Base::template with_special_values<SpecialValues>;
+  using storage_type = typename Format::storage_type;
+  using Unpacked = UnpackedFloat<Format, RoundingPolicy, DenormalPolicy>;
+  constexpr std::uint64_t encodings = std::uint64_t{1} << Format::total_bits;
+  constexpr std::uint64_t step = encodings <= 256 ? 1 : encodings / 256 + 1;
+  constexpr bool flushes =
+      DenormalPolicy::flush_inputs || DenormalPolicy::flush_outputs;
+
+  auto up = [](std::uint64_t bits) {
+    return unpack<Format, RoundingPolicy, DenormalPolicy>(
+        static_cast<storage_type>(bits));
+  };
+  auto down = [](const Unpacked &value) {
+    return pack<Format, RoundingPolicy, DenormalPolicy>(value);
+  };
+  auto is_denormal = [](std::uint64_t bits) {
+    return detail::extract_exponent<Format>(static_cast<storage_type>(bits)) ==
+               0 &&
+           !is_zero(unpack<Format, RoundingPolicy>(
+               static_cast<storage_type>(bits)));
+  };
+  auto same_unrounded = [](const Unpacked &x, const Unpacked &y) {
+    if constexpr (rp::is_stochastic<RoundingPolicy>) {
+      const auto largest =
+          detail::largest_finite<Format, RoundingPolicy, DenormalPolicy>(
+              x.sign);
+      auto overflowed = [&](const Unpacked &z) {
+        return !is_finite(z) || (z.exponent == largest.exponent &&
+                                 z.mantissa == largest.mantissa);
+      };
+      if (overflowed(x) || overflowed(y)) {
+        return true;
+      }
+    }
+    return (is_nan(x) && is_nan(y)) ||
+           (x.sign == y.sign && x.exponent == y.exponent &&
+            x.mantissa == y.mantissa);
+  };
+
+  // Values under test: finite, not flushed
+  std::vector<std::uint64_t> values;
+  for (std::uint64_t bits = 0; bits < encodings; bits += step) {
+    const auto x = up(bits);
+    if (!is_nan(x) && !(flushes && is_denormal(bits))) {
+      values.push_back(bits);
+    }
+  }
+
+  const auto one = up(std::uint64_t{Format::exp_bias} << Format::exp_offset);
+  const auto zero = up(0);
+
+  for (const auto a_bits : values) {
+    const auto a = up(a_bits);
+    if (down(a) != a_bits) {
+      return false;
+    }
+    if (is_finite(a)) {
+      if (down(multiply(a, one)) != a_bits) {
+        return false;
+      }
+      if (!is_zero(a) && down(add(a, zero)) != a_bits) {
+        return false;
+      }
+    }
+    for (const auto b_bits : values) {
+      const auto b = up(b_bits);
+      if (!same_unrounded(add(a, b), add(b, a)) ||
+          !same_unrounded(multiply(a, b), multiply(b, a))) {
+        return false;
+      }
+    }
+  }
+
+  if constexpr (!rp::is_stochastic<RoundingPolicy>) {
+    const std::size_t stride = values.size() / 48 + 1;
+    for (std::size_t i = 0; i < values.size(); i += stride) {
+      const auto a = up(values[i]);
+      for (std::size_t j = 0; j < values.size(); j += stride) {
+        const auto b = up(values[j]);
+        if (!is_finite(a) || !is_finite(b) || compare(a, b) >= 0) {
+          continue;
+        }
+        for (std::size_t k = 0; k < values.size(); k += 7 * stride) {
+          const auto c = up(values[k]);
+          if (!is_finite(c) || c.sign || is_zero(c)) {
+            continue;
+          }
+          if (compare(up(down(multiply(a, c))), up(down(multiply(b, c)))) >
+              0) {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Register this shard's configurations
+const bool registered = [] {
+  for_each_type<shard_t<Configurations, OPINE_SHARD_INDEX, OPINE_SHARD_COUNT>>(
+      []<typename Config>() {
+        []<typename Format, typename SpecialValues, typename RoundingPolicy,
+           typename DenormalPolicy>(
+            TypeList<Format, SpecialValues, RoundingPolicy, DenormalPolicy> *) {
+          configuration_tests().push_back(
+              {"fp" + std::to_string(Format::total_bits) + "_e" +
+                   std::to_string(Format::exp_bits) + "m" +
+                   std::to_string(Format::mant_bits) + "/" +
+                   special_values_name<SpecialValues>() + "/" +
+                   rounding_name<RoundingPolicy>() + "/" +
+                   DenormalPolicy::name,
+               &test_properties<Format, SpecialValues, RoundingPolicy,
+                                DenormalPolicy>});
+        }(static_cast<Config *>(nullptr));
+      });
+  return true;
+}();
+
+} // namespace
+
+#if OPINE_SHARD_INDEX == 0
+int main() {
+  printf("=== OPINE Configuration Tests ===\n\n");
+
+  std::size_t failures = 0;
+  for (const auto &test : configuration_tests()) {
+    if (!test.run()) {
+      printf("%s: FAIL\n", test.name.c_str());
+      ++failures;
+    }
+  }
+
+  const bool ok = failures == 0 &&
+                  configuration_tests().size() == Configurations::size;
+  printf("%zu configurations in %d shards: %s\n", configuration_tests().size(),
+         OPINE_SHARD_COUNT, ok ? "PASS" : "FAIL");
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
+#endif
@@ -0,0 +1,294 @@
+#include "float_oracle.hpp"
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <vector>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using conversion_policies::FastConversion;
+using conversion_policies::IEEEConversion;
+using conversion_policies::SafeConversion;
+using table_policies::LargeTables;
+using table_policies::NoTables;
+
+using fp16_bits = fp16_e5m10::storage_type;
+using fp32_bits = fp32_e8m23::storage_type;
+
+// Padded format from test_pack_unpack.cpp: [pad:3][S:1][E:4][M:3][pad:1]
+using PaddedFormat = FormatDescriptor<1, 8, 4, 4, 3, 1, 12, true>;
+
+// Strategy selection
+static_assert(conversion_strategy<fp16_e5m10, fp32_e8m23> ==
+              ConversionStrategy::Widen);
+static_assert(conversion_strategy<fp8_e4m3, fp16_e5m10> ==
+              ConversionStrategy::Widen);
+static_assert(conversion_strategy<PaddedFormat, fp16_e5m10> ==
+              ConversionStrategy::Widen);
+static_assert(conversion_strategy<fp8_e5m2, fp8_e4m3> ==
+                  ConversionStrategy::Direct,
+              "e5m2 has values below the e4m3 range: not a widening");
+static_assert(conversion_strategy<fp8_e4m3, fp8_e5m2> ==
+                  ConversionStrategy::Direct,
+              "e4m3 has mantissa bits e5m2 lacks: not a widening");
+static_assert(conversion_strategy<fp16_e5m10, fp8_e4m3, SafeConversion,
+                                  LargeTables> == ConversionStrategy::Encode,
+              "The encode table is smaller than a direct fp16 table");
+static_assert(conversion_strategy<fp16_e5m10, fp8_e5m2> ==
+              ConversionStrategy::Encode);
+static_assert(conversion_strategy<fp32_e8m23, fp8_e4m3> ==
+              ConversionStrategy::Compute);
+static_assert(conversion_strategy<fp32_e8m23, fp8_e4m3, SafeConversion,
+                                  LargeTables> == ConversionStrategy::Encode);
+static_assert(conversion_strategy<fp32_e8m23, fp16_e5m10, SafeConversion,
+                                  LargeTables> == ConversionStrategy::Compute);
+
+// Known results, checked at compile time
+constexpr bool test_known_values() {
+  // 1.0 -> 1.0
+  if (convert<fp8_e4m3, fp32_e8m23>(0x3F800000u) != 0x38) {
+    return false;
+  }
+  // 1e6: saturates to 240 by default, overflows to Inf under IEEE
+  if (convert<fp8_e4m3, fp32_e8m23>(0x49742400u) != 0x77 ||
+      convert<fp8_e4m3, fp32_e8m23, IEEEConversion>(0x49742400u) != 0x78 ||
+      convert<fp8_e4m3, fp32_e8m23>(0xC9742400u) != 0xF7) {
+    return false;
+  }
+  // Inf stays Inf even when saturating
+  if (convert<fp8_e4m3, fp32_e8m23>(0xFF800000u) != 0xF8) {
+    return false;
+  }
+  // NaN -> quiet NaN, sign kept
+  if (convert<fp8_e4m3, fp32_e8m23>(0xFF800001u) != 0xFC ||
+      convert<fp32_e8m23, fp8_e4m3>(0x7F) != 0x7FC00000u) {
+    return false;
+  }
+  // Signed zero
+  if (convert<fp8_e5m2, fp32_e8m23>(0x80000000u) != 0x80 ||
+      convert<fp32_e8m23, fp8_e5m2>(0x80) != 0x80000000u) {
+    return false;
+  }
+  // 1.875: rounds to 2.0 in e5m2, truncates to 1.75 under FastConversion
+  if (convert<fp8_e5m2, fp32_e8m23>(0x3FF00000u) != 0x40 ||
+      convert<fp8_e5m2, fp32_e8m23, FastConversion>(0x3FF00000u) != 0x3F) {
+    return false;
+  }
+  // Smallest e4m3 denormal (2^-9) -> normal fp16
+  if (convert<fp16_e5m10, fp8_e4m3>(0x01) != 0x1800) {
+    return false;
+  }
+  // e5m2 2^-16 (denormal) underflows to +0 in e4m3 (denormals down to 2^-9)
+  if (convert<fp8_e4m3, fp8_e5m2>(0x01) != 0x00) {
+    return false;
+  }
+  return true;
+}
+
+static_assert(test_known_values(), "Known conversion results");
+
+// Test helper: unpacked convert() round-trips every finite value of a
+// format through a wider one
+template <typename Format, typename Wide> constexpr bool test_round_trip() {
+  using storage_type = typename Format::storage_type;
+  constexpr std::size_t total_values = std::size_t{1} << Format::total_bits;
+
+  for (std::size_t i = 0; i < total_values; ++i) {
+    const auto bits = static_cast<storage_type>(i);
+    const auto value = unpack<Format, RNE>(bits);
+    if (!is_finite(value)) {
+      continue;
+    }
+    const auto wide = convert<Wide, IEEEConversion>(value);
+    if (pack(convert<Format, IEEEConversion>(wide)) != bits) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(test_round_trip<fp8_e5m2, fp16_e5m10>(),
+              "fp8_e5m2 -> fp16 -> fp8_e5m2 must be the identity");
+static_assert(test_round_trip<fp8_e4m3, fp32_e8m23>(),
+              "fp8_e4m3 -> fp32 -> fp8_e4m3 must be the identity");
+
+// Test helper: scalar convert() must match the oracle, with saturation
+// replacing finite overflow when the policy saturates
+template <typename Src, typename Dst, typename ConversionPolicy>
+bool test_convert_matches_oracle(const std::vector<std::uint64_t> &values) {
+  constexpr bool nearest =
+      std::is_same_v<typename ConversionPolicy::rounding_policy, RNE>;
+  const std::uint64_t inf = ((std::uint64_t{1} << Dst::exp_bits) - 1)
+                            << Dst::exp_offset;
+  const std::uint64_t sign_bit = std::uint64_t{1} << Dst::sign_offset;
+
+  for (std::uint64_t value : values) {
+    const double input = oracle::to_double<Src>(value);
+    std::uint64_t expected = oracle::round_to<Dst, nearest>(input);
+    if (ConversionPolicy::saturate && std::isfinite(input) &&
+        (expected & ~sign_bit) == inf) {
+      expected -= std::uint64_t{1} << Dst::mant_offset;
+    }
+    const auto actual = static_cast<std::uint64_t>(
+        convert<Dst, Src, ConversionPolicy>(
+            static_cast<typename Src::storage_type>(value)));
+    if (actual != expected) {
+      printf("\n  mismatch: 0x%llx -> 0x%llx (want 0x%llx)\n",
+             static_cast<unsigned long long>(value),
+             static_cast<unsigned long long>(actual),
+             static_cast<unsigned long long>(expected));
+      return false;
+    }
+  }
+  return true;
+}
+
+// Test helper: convert_n() must match scalar convert() for every value
+template <typename Src, typename Dst, typename ConversionPolicy,
+          typename TablePolicy>
+bool test_convert_n(const std::vector<std::uint64_t> &values) {
+  std::vector<typename Src::storage_type> src(values.begin(), values.end());
+  std::vector<typename Dst::storage_type> dst(values.size() + 1, 0x5A);
+
+  if (convert_n<Dst, Src, ConversionPolicy, TablePolicy>(
+          src, std::span(dst).first(values.size())) != values.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    if (dst[i] != convert<Dst, Src, ConversionPolicy>(src[i])) {
+      printf("\n  mismatch: 0x%llx -> 0x%llx\n",
+             static_cast<unsigned long long>(src[i]),
+             static_cast<unsigned long long>(dst[i]));
+      return false;
+    }
+  }
+  // Nothing is written past the shorter span
+  return dst[values.size()] == 0x5A;
+}
+
+// Test helper: exact widening of every fp16 value must match the host's
+// double -> float conversion (NaN: the quiet NaN with the sign kept)
+bool test_widen_fp16_matches_host() {
+  std::vector<fp16_bits> src(65536);
+  std::vector<fp32_bits> dst(src.size());
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<fp16_bits>(i);
+  }
+
+  convert_n<fp32_e8m23, fp16_e5m10>(src, dst);
+
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    const double value = oracle::to_double<fp16_e5m10>(i);
+    std::uint32_t expected = std::bit_cast<std::uint32_t>(
+        static_cast<float>(value));
+    if (std::isnan(value)) {
+      expected = (std::signbit(value) ? 0x80000000u : 0) | 0x7FC00000u;
+    }
+    if (dst[i] != expected) {
+      printf("\n  mismatch: 0x%04zx -> 0x%08x (want 0x%08x)\n", i,
+             static_cast<std::uint32_t>(dst[i]), expected);
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Format> std::vector<std::uint64_t> all_values() {
+  std::vector<std::uint64_t> values(std::size_t{1} << Format::total_bits);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = i;
+  }
+  return values;
+}
+
+// Pseudo-random fp32 encodings, half of them within the fp8 range
+std::vector<std::uint64_t> sampled_fp32_values() {
+  std::vector<std::uint64_t> values = {0x7F7FFFFFu, 0x43700000u, 0x43780000u,
+                                       0x47800000u, 0xFF800000u, 0x7FC00000u};
+  std::uint32_t state = 0x9E3779B9u;
+  for (int i = 0; i < 100000; ++i) {
+    state = state * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    std::uint32_t bits = state;
+    if (i & 1) {
+      const std::uint32_t exp = 105u + ((state >> 8) % 40u);
+      bits = (bits & 0x807FFFFFu) | (exp << 23);
+    }
+    values.push_back(bits);
+  }
+  return values;
+}
+
+int main() {
+  printf("=== OPINE Conversion Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("Known values", test_known_values());
+  report("Unpacked round trips",
+         test_round_trip<fp8_e5m2, fp16_e5m10>() &&
+             test_round_trip<fp8_e4m3, fp32_e8m23>());
+
+  const auto e5m2_values = all_values<fp8_e5m2>();
+  const auto e4m3_values = all_values<fp8_e4m3>();
+  const auto fp16_values = all_values<fp16_e5m10>();
+  const auto fp32_values = sampled_fp32_values();
+
+  report("fp8_e5m2 -> fp8_e4m3 vs oracle (Safe, IEEE, Fast)",
+         test_convert_matches_oracle<fp8_e5m2, fp8_e4m3, SafeConversion>(
+             e5m2_values) &&
+             test_convert_matches_oracle<fp8_e5m2, fp8_e4m3, IEEEConversion>(
+                 e5m2_values) &&
+             test_convert_matches_oracle<fp8_e5m2, fp8_e4m3, FastConversion>(
+                 e5m2_values));
+  report("fp32 -> fp8_e4m3 vs oracle (sampled, Safe and IEEE)",
+         test_convert_matches_oracle<fp32_e8m23, fp8_e4m3, SafeConversion>(
+             fp32_values) &&
+             test_convert_matches_oracle<fp32_e8m23, fp8_e4m3,
+                                         IEEEConversion>(fp32_values));
+  report("fp16 -> fp32 widening vs host (all 65536)",
+         test_widen_fp16_matches_host());
+
+  report("convert_n fp8 <-> fp8, direct table",
+         test_convert_n<fp8_e5m2, fp8_e4m3, SafeConversion, LargeTables>(
+             e5m2_values) &&
+             test_convert_n<fp8_e4m3, fp8_e5m2, FastConversion, LargeTables>(
+                 e4m3_values) &&
+             test_convert_n<PaddedFormat, fp8_e5m2, SafeConversion,
+                            LargeTables>(all_values<PaddedFormat>()));
+  report("convert_n fp8 -> fp16/fp32, widening",
+         test_convert_n<fp8_e4m3, fp16_e5m10, SafeConversion, NoTables>(
+             e4m3_values) &&
+             test_convert_n<fp8_e5m2, fp32_e8m23, SafeConversion, NoTables>(
+                 e5m2_values) &&
+             test_convert_n<PaddedFormat, fp32_e8m23, SafeConversion,
+                            NoTables>(all_values<PaddedFormat>()));
+  report("convert_n fp16 -> fp32, widening",
+         test_convert_n<fp16_e5m10, fp32_e8m23, SafeConversion, NoTables>(
+             fp16_values));
+  report("convert_n fp16 -> fp8, encode table",
+         test_convert_n<fp16_e5m10, fp8_e5m2, SafeConversion, LargeTables>(
+             fp16_values) &&
+             test_convert_n<fp16_e5m10, fp8_e4m3, IEEEConversion,
+                            LargeTables>(fp16_values));
+  report("convert_n fp32 -> fp8, encode table and computed",
+         test_convert_n<fp32_e8m23, fp8_e4m3, SafeConversion, LargeTables>(
+             fp32_values) &&
+             test_convert_n<fp32_e8m23, fp8_e4m3, SafeConversion, NoTables>(
+                 fp32_values) &&
+             test_convert_n<fp32_e8m23, fp8_e5m2, FastConversion,
+                            LargeTables>(fp32_values));
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
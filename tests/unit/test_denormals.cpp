@@ -0,0 +1,384 @@
+#include "float_oracle.hpp"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+using denormal_policies::FlushInputsToZero;
+using denormal_policies::FlushOnZero;
+using denormal_policies::FlushToZero;
+using denormal_policies::FullSupport;
+
+enum class Op { Add, Subtract, Multiply, Divide };
+
+// Storage-level operation through the UnpackedFloat arithmetic; also checks
+// that round() agrees with pack() on the unrounded result
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+constexpr typename Format::storage_type
+apply(Op op, typename Format::storage_type a, typename Format::storage_type b,
+      bool &round_matches) {
+  const auto x = unpack<Format, RoundingPolicy, DenormalPolicy>(a);
+  const auto y = unpack<Format, RoundingPolicy, DenormalPolicy>(b);
+  UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> result{};
+  switch (op) {
+  case Op::Add:
+    result = add(x, y);
+    break;
+  case Op::Subtract:
+    result = subtract(x, y);
+    break;
+  case Op::Multiply:
+    result = multiply(x, y);
+    break;
+  case Op::Divide:
+    result = divide(x, y);
+    break;
+  }
+  const auto bits = pack(result);
+  round_matches = pack(round(result)) == bits;
+  return bits;
+}
+
+// unpack() flushes denormal encodings to signed zeros exactly when the
+// policy flushes inputs; everything else unpacks as with FullSupport
+template <typename Format, typename DenormalPolicy>
+constexpr bool test_unpack() {
+  using storage_type = typename Format::storage_type;
+  for (std::uint32_t i = 0; i < (1u << Format::total_bits); ++i) {
+    const auto bits = static_cast<storage_type>(i);
+    const auto full = unpack<Format, RNE, FullSupport>(bits);
+    const auto flushed = unpack<Format, RNE, DenormalPolicy>(bits);
+    const bool denormal = is_denormal(full);
+    if (flushed.sign != full.sign || flushed.exponent != full.exponent) {
+      return false;
+    }
+    if (denormal && DenormalPolicy::flush_inputs) {
+      if (flushed.mantissa != 0 || !is_zero(flushed) ||
+          is_denormal(flushed)) {
+        return false;
+      }
+    } else if (flushed.mantissa != full.mantissa) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(test_unpack<fp8_e5m2, FullSupport>());
+static_assert(test_unpack<fp8_e5m2, FlushToZero>());
+static_assert(test_unpack<fp8_e5m2, FlushInputsToZero>());
+static_assert(test_unpack<fp8_e4m3, FlushOnZero>());
+
+// Known results (fp8_e5m2: smallest normal 0x04 = 2^-14, largest denormal
+// 0x03, 1.0 = 0x3C, 0.5 = 0x38)
+constexpr bool test_known_values() {
+  bool round_matches = true;
+  // 0x04 * 0.5 is a denormal (0x02), flushed to zero on output
+  if (apply<fp8_e5m2, RNE, FullSupport>(Op::Multiply, 0x04, 0x38,
+                                        round_matches) != 0x02 ||
+      apply<fp8_e5m2, RNE, FlushToZero>(Op::Multiply, 0x04, 0x38,
+                                        round_matches) != 0x00 ||
+      apply<fp8_e5m2, RNE, FlushToZero>(Op::Multiply, 0x84, 0x38,
+                                        round_matches) != 0x80) {
+    return false;
+  }
+  // A denormal input is kept under FTZ, zero under DAZ: 0x03 * 2^15
+  if (apply<fp8_e5m2, RNE, FlushToZero>(Op::Multiply, 0x03, 0x78,
+                                        round_matches) != 0x3E ||
+      apply<fp8_e5m2, RNE, FlushInputsToZero>(Op::Multiply, 0x03, 0x78,
+                                              round_matches) != 0x00) {
+    return false;
+  }
+  // 1 / denormal is a division by zero under DAZ
+  if (apply<fp8_e5m2, RNE, FlushOnZero>(Op::Divide, 0x3C, 0x81,
+                                        round_matches) != 0xFC) {
+    return false;
+  }
+  // Denormal results of DAZ arithmetic are still packed (0x04 - 0x03)
+  if (apply<fp8_e5m2, RNE, FlushInputsToZero>(Op::Subtract, 0x05, 0x04,
+                                              round_matches) != 0x01) {
+    return false;
+  }
+  // Tininess is detected before rounding: the largest denormal plus a bit
+  // would round to the smallest normal, and is flushed
+  UnpackedFloat<fp8_e5m2, RNE, FlushToZero> tiny{};
+  tiny.mantissa = 0b11111; // 0x03 and GRS = 111
+  return round_matches && pack(tiny) == 0x00 && is_zero(round(tiny));
+}
+
+static_assert(test_known_values(), "Flush-to-zero known values");
+
+// Reference result under a denormal policy: denormal operands are zeros when
+// inputs are flushed, and results below the normal range (before rounding)
+// are signed zeros when outputs are flushed
+template <typename Format, typename DenormalPolicy, bool Nearest>
+std::uint64_t expected_result(Op op, std::uint64_t a, std::uint64_t b) {
+  const double min_normal = std::ldexp(1.0, 1 - Format::exp_bias);
+  auto input = [&](std::uint64_t bits) {
+    const double value = oracle::to_double<Format>(bits);
+    return DenormalPolicy::flush_inputs && std::fabs(value) < min_normal
+               ? std::copysign(0.0, value)
+               : value;
+  };
+  const double x = input(a);
+  const double y = input(b);
+  double exact = 0.0;
+  switch (op) {
+  case Op::Add:
+    exact = x + y;
+    break;
+  case Op::Subtract:
+    exact = x - y;
+    break;
+  case Op::Multiply:
+    exact = x * y;
+    break;
+  case Op::Divide:
+    exact = oracle::divide_to_odd(x, y);
+    break;
+  }
+  if (DenormalPolicy::flush_outputs && std::fabs(exact) < min_normal) {
+    exact = std::copysign(0.0, exact);
+  }
+  return oracle::round_to<Format, Nearest>(exact);
+}
+
+// Test helper: all four operations on every pair of encodings (NaN results
+// only need to be NaN)
+template <typename Format, typename RoundingPolicy, typename DenormalPolicy>
+bool test_exhaustive() {
+  using storage_type = typename Format::storage_type;
+  constexpr bool nearest = std::is_same_v<RoundingPolicy, RNE>;
+  constexpr std::uint64_t count = std::uint64_t{1} << Format::total_bits;
+
+  for (const Op op : {Op::Add, Op::Subtract, Op::Multiply, Op::Divide}) {
+    for (std::uint64_t a = 0; a < count; ++a) {
+      for (std::uint64_t b = 0; b < count; ++b) {
+        bool round_matches = false;
+        const auto actual = static_cast<std::uint64_t>(
+            apply<Format, RoundingPolicy, DenormalPolicy>(
+                op, static_cast<storage_type>(a),
+                static_cast<storage_type>(b), round_matches));
+        const auto expected =
+            expected_result<Format, DenormalPolicy, nearest>(op, a, b);
+        const bool match = oracle::is_nan<Format>(expected)
+                               ? oracle::is_nan<Format>(actual)
+                               : actual == expected;
+        if (!match || !round_matches) {
+          printf("\n  mismatch: op %d, 0x%llx, 0x%llx -> 0x%llx (want "
+                 "0x%llx)\n",
+                 static_cast<int>(op), static_cast<unsigned long long>(a),
+                 static_cast<unsigned long long>(b),
+                 static_cast<unsigned long long>(actual),
+                 static_cast<unsigned long long>(expected));
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Test helper: fma() flushes its operands and its single rounded result
+template <typename Format, typename DenormalPolicy> bool test_fma() {
+  using storage_type = typename Format::storage_type;
+  const double min_normal = std::ldexp(1.0, 1 - Format::exp_bias);
+  auto input = [&](std::uint64_t bits) {
+    const double value = oracle::to_double<Format>(bits);
+    return DenormalPolicy::flush_inputs && std::fabs(value) < min_normal
+               ? std::copysign(0.0, value)
+               : value;
+  };
+
+  for (std::uint64_t a = 0; a < 256; ++a) {
+    for (std::uint64_t b = 0; b < 256; ++b) {
+      const std::uint64_t c = (a * 37 + b * 11) & 0xFF;
+      const auto result = fma(
+          unpack<Format, RNE, DenormalPolicy>(static_cast<storage_type>(a)),
+          unpack<Format, RNE, DenormalPolicy>(static_cast<storage_type>(b)),
+          unpack<Format, RNE, DenormalPolicy>(static_cast<storage_type>(c)));
+      const auto actual = static_cast<std::uint64_t>(pack(result));
+      double exact = oracle::fma_to_odd(input(a), input(b), input(c));
+      if (DenormalPolicy::flush_outputs && std::fabs(exact) < min_normal) {
+        exact = std::copysign(0.0, exact);
+      }
+      const auto expected = oracle::round_to<Format, true>(exact);
+      const bool match = oracle::is_nan<Format>(expected)
+                             ? oracle::is_nan<Format>(actual)
+                             : actual == expected;
+      if (!match) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Test helper: unpack_n/pack_n flush exactly like unpack()/pack()
+template <typename Format, typename DenormalPolicy>
+constexpr bool test_bulk_matches_scalar() {
+  using storage_type = typename Format::storage_type;
+  using exponent_type = typename Format::exponent_type;
+  using mantissa_type = unpacked_mantissa_t<Format, RNE>;
+  constexpr std::size_t count = std::size_t{1} << Format::total_bits;
+
+  std::array<storage_type, count> bits{};
+  for (std::size_t i = 0; i < count; ++i) {
+    bits[i] = static_cast<storage_type>(i);
+  }
+  std::array<bool, count> sign{};
+  std::array<exponent_type, count> exponent{};
+  std::array<mantissa_type, count> mantissa{};
+  std::array<storage_type, count> packed{};
+
+  unpack_n<Format, RNE, DenormalPolicy>(bits, sign, exponent, mantissa);
+  // Halve the smallest normals, so that they are results in the denormal
+  // range
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto scalar = unpack<Format, RNE, DenormalPolicy>(bits[i]);
+    if (sign[i] != scalar.sign || exponent[i] != scalar.exponent ||
+        mantissa[i] != scalar.mantissa) {
+      return false;
+    }
+    if (exponent[i] == 1) {
+      exponent[i] = 0;
+      mantissa[i] = static_cast<mantissa_type>(mantissa[i] >> 1);
+    }
+  }
+  pack_n<Format, RNE, DenormalPolicy>(sign, exponent, mantissa, packed);
+  for (std::size_t i = 0; i < count; ++i) {
+    UnpackedFloat<Format, RNE, DenormalPolicy> value{};
+    value.sign = sign[i];
+    value.exponent = exponent[i];
+    value.mantissa = mantissa[i];
+    if (packed[i] != pack(value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(test_bulk_matches_scalar<fp8_e5m2, FlushToZero>());
+static_assert(test_bulk_matches_scalar<fp8_e4m3, FlushInputsToZero>());
+static_assert(test_bulk_matches_scalar<fp8_e4m3, FlushOnZero>());
+
+// Flushing only inputs, an unrounded denormal product is zero to the next
+// operation: fp8_e5m2 2^-12 * 0.5 + 2^-12 is 2^-12, as with a rounded (and
+// flushed) product
+constexpr bool test_chained_denormal_result() {
+  using unpacked = UnpackedFloat<fp8_e5m2, RNE, FlushInputsToZero>;
+  const auto tiny = unpack<fp8_e5m2, RNE, FlushInputsToZero>(0x04);
+  const auto half = unpack<fp8_e5m2, RNE, FlushInputsToZero>(0x38);
+  const unpacked product = multiply(tiny, half);
+  return product.exponent == 0 && product.mantissa != 0 &&
+         pack(add(product, tiny)) == 0x04 &&
+         pack(add(tiny, product)) == 0x04 &&
+         pack(subtract(product, tiny)) == 0x84 &&
+         pack(add(product, product)) == 0x00 &&
+         pack(fma(half, half, product)) == 0x34;
+}
+
+static_assert(test_chained_denormal_result());
+
+// Test helper: RoundEveryStep expressions match the storage-level
+// operations one at a time when the results of the first are denormal
+template <typename Format, typename DenormalPolicy>
+bool test_round_every_step_chain() {
+  using engine =
+      FloatEngine<FloatConfig<Format, RNE, evaluation_policies::RoundEveryStep,
+                              DefaultOps, DenormalPolicy>>;
+  using storage_type = typename Format::storage_type;
+
+  for (unsigned i = 0; i < 256; ++i) {
+    for (unsigned j = 0; j < 256; ++j) {
+      const auto a = engine::from_bits(static_cast<storage_type>(i));
+      const auto b = engine::from_bits(static_cast<storage_type>(j));
+      for (unsigned k = 0; k < 256; k += 11) {
+        const auto c = engine::from_bits(static_cast<storage_type>(k));
+        const engine mul_add = a * b + c;
+        const engine div_sub = a / b - c;
+        if (mul_add.bits() !=
+                engine::add(engine::multiply(a.bits(), b.bits()), c.bits()) ||
+            div_sub.bits() != engine::subtract(engine::divide(a.bits(),
+                                                              b.bits()),
+                                               c.bits())) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// FloatEngine with a flushing configuration
+using fp8_ftz =
+    FloatEngine<FloatConfig<fp8_e5m2, RNE, evaluation_policies::RoundOnce,
+                            DefaultOps, FlushOnZero>>;
+static_assert(
+    std::is_same_v<fp8_ftz::unpacked_type,
+                   UnpackedFloat<fp8_e5m2, RNE, FlushOnZero>>);
+static_assert(
+    fp8_ftz(fp8_ftz::from_bits(0x04) * fp8_ftz::from_bits(0x38)).bits() ==
+    0x00);
+static_assert(
+    fp8_ftz(fp8_ftz::from_bits(0x04) + fp8_ftz::from_bits(0x83)).bits() ==
+    0x04);
+static_assert(fp8_ftz::divide(0x3C, 0x01) == 0x7C);
+
+// The soft-float runtime library has gradual underflow: flushing
+// configurations do not use it
+static_assert(RuntimeLibraryOps<FloatConfig<fp32_e8m23, RNE>>::uses_library);
+static_assert(
+    !RuntimeLibraryOps<FloatConfig<fp32_e8m23, RNE,
+                                   evaluation_policies::RoundOnce,
+                                   RuntimeLibraryOps, FlushToZero>>::
+        uses_library);
+
+int main() {
+  printf("=== OPINE Denormal Policy Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("unpack flushes inputs",
+         test_unpack<fp8_e5m2, FlushInputsToZero>() &&
+             test_unpack<fp8_e4m3, FlushOnZero>() &&
+             test_unpack<fp8_e4m3, FlushToZero>());
+  report("Known values", test_known_values());
+  report("fp8_e5m2 RNE FlushToZero exhaustive",
+         test_exhaustive<fp8_e5m2, RNE, FlushToZero>());
+  report("fp8_e4m3 RNE FlushToZero exhaustive",
+         test_exhaustive<fp8_e4m3, RNE, FlushToZero>());
+  report("fp8_e5m2 RNE FlushInputsToZero exhaustive",
+         test_exhaustive<fp8_e5m2, RNE, FlushInputsToZero>());
+  report("fp8_e4m3 TowardZero FlushInputsToZero exhaustive",
+         test_exhaustive<fp8_e4m3, RTZ, FlushInputsToZero>());
+  report("fp8_e5m2 TowardZero FlushOnZero exhaustive",
+         test_exhaustive<fp8_e5m2, RTZ, FlushOnZero>());
+  report("fp8_e4m3 RNE FlushOnZero exhaustive",
+         test_exhaustive<fp8_e4m3, RNE, FlushOnZero>());
+  report("fp8 fma under FTZ, DAZ and both",
+         test_fma<fp8_e5m2, FlushToZero>() &&
+             test_fma<fp8_e4m3, FlushInputsToZero>() &&
+             test_fma<fp8_e4m3, FlushOnZero>());
+  report("Chained results under FlushInputsToZero",
+         test_round_every_step_chain<fp8_e5m2, FlushInputsToZero>() &&
+             test_round_every_step_chain<fp8_e4m3, FlushInputsToZero>());
+  report("Bulk pack/unpack match scalar",
+         test_bulk_matches_scalar<fp8_e5m2, FlushOnZero>());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
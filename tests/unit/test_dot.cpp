@@ -0,0 +1,167 @@
+#include "float_oracle.hpp"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <vector>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+
+using fp8_bits = fp8_e4m3::storage_type;
+using fp16_bits = fp16_e5m10::storage_type;
+using fp32_bits = fp32_e8m23::storage_type;
+
+// Known results, checked at compile time
+constexpr bool test_known_values() {
+  // fp8_e4m3 [1, 2, 3] . fp16 [4, 5, 6] = 32 in fp32
+  constexpr std::array<fp8_bits, 3> a = {0x38, 0x40, 0x44};
+  constexpr std::array<fp16_bits, 3> b = {0x4400, 0x4500, 0x4600};
+  const auto a_span = std::span<const fp8_bits>(a);
+  const auto b_span = std::span<const fp16_bits>(b);
+  if (dot<fp32_e8m23, fp8_e4m3, fp16_e5m10>(a_span, b_span) != 0x42000000u) {
+    return false;
+  }
+  // Empty dot product is +0; extra elements of the longer span are ignored
+  if (dot<fp32_e8m23, fp8_e4m3, fp16_e5m10>(a_span.first(0), b_span) != 0) {
+    return false;
+  }
+  if (dot<fp32_e8m23, fp8_e4m3, fp16_e5m10>(a_span, b_span.first(2)) !=
+      0x41600000u) { // 14
+    return false;
+  }
+  // 2x3 matrix times [4, 5, 6]: rows [1, 2, 3] and [3, 2, 1] -> 32, 28
+  constexpr std::array<fp8_bits, 6> w = {0x38, 0x40, 0x44,
+                                         0x44, 0x40, 0x38};
+  std::array<fp32_bits, 2> y{};
+  if (gemv<fp32_e8m23, fp8_e4m3, fp16_e5m10>(std::span<const fp8_bits>(w),
+                                             b_span, std::span(y)) != 2 ||
+      y[0] != 0x42000000u || y[1] != 0x41E00000u) {
+    return false;
+  }
+  return true;
+}
+
+static_assert(test_known_values(), "Known dot and gemv results");
+
+// Pseudo-random finite values of a format
+template <typename Format>
+std::vector<typename Format::storage_type> random_values(std::size_t n,
+                                                         std::uint32_t seed) {
+  constexpr std::uint64_t mask = (std::uint64_t{1} << Format::total_bits) - 1;
+  std::vector<typename Format::storage_type> values(n);
+  for (auto &value : values) {
+    do {
+      seed = seed * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+      value = static_cast<typename Format::storage_type>(
+          ((std::uint64_t{seed} << 32) | (seed * 2654435761u)) & mask);
+    } while (!std::isfinite(oracle::to_double<Format>(value)));
+  }
+  return values;
+}
+
+// Reference: an fma loop on the host's float (round to nearest), from +0
+template <typename FormatA, typename FormatB>
+std::uint32_t host_dot(std::span<const typename FormatA::storage_type> a,
+                       std::span<const typename FormatB::storage_type> b) {
+  float acc = 0.0f;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    acc = std::fma(static_cast<float>(oracle::to_double<FormatA>(a[i])),
+                   static_cast<float>(oracle::to_double<FormatB>(b[i])), acc);
+  }
+  return std::bit_cast<std::uint32_t>(acc);
+}
+
+// Test helper: dot() into fp32 must match the host fma loop bit for bit
+template <typename FormatA, typename FormatB> bool test_dot_matches_host() {
+  for (std::size_t n : {1, 63, 64, 65, 1000}) {
+    for (std::uint32_t seed = 1; seed <= 20; ++seed) {
+      const auto a = random_values<FormatA>(n, seed);
+      const auto b = random_values<FormatB>(n, seed * 7919u);
+      const auto actual = dot<fp32_e8m23, FormatA, FormatB, RNE>(
+          std::span<const typename FormatA::storage_type>(a),
+          std::span<const typename FormatB::storage_type>(b));
+      const auto expected = host_dot<FormatA, FormatB>(a, b);
+      const auto actual_bits = static_cast<std::uint32_t>(actual);
+      const bool match = std::isnan(std::bit_cast<float>(expected))
+                             ? std::isnan(std::bit_cast<float>(actual_bits))
+                             : actual_bits == expected;
+      if (!match) {
+        printf("\n  mismatch: n = %zu, seed %u: 0x%08x (want 0x%08x)\n", n,
+               seed, actual_bits, expected);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Test helper: every gemv() row must match dot() of that row
+bool test_gemv_matches_dot() {
+  constexpr std::size_t rows = 7;
+  constexpr std::size_t cols = 130;
+  const auto w = random_values<fp8_e4m3>(rows * cols + 5, 11);
+  const auto x = random_values<fp16_e5m10>(cols, 13);
+  std::vector<fp32_bits> y(rows + 2, 0xDEADBEEFu);
+
+  const std::size_t done = gemv<fp32_e8m23, fp8_e4m3, fp16_e5m10, RNE>(
+      std::span<const fp8_bits>(w), std::span<const fp16_bits>(x),
+      std::span<fp32_bits>(y));
+  if (done != rows) {
+    return false;
+  }
+  for (std::size_t r = 0; r < rows; ++r) {
+    const auto row = std::span<const fp8_bits>(w).subspan(r * cols, cols);
+    const auto x_span = std::span<const fp16_bits>(x);
+    if (y[r] != dot<fp32_e8m23, fp8_e4m3, fp16_e5m10, RNE>(row, x_span) ||
+        y[r] != host_dot<fp8_e4m3, fp16_e5m10>(row, x_span)) {
+      return false;
+    }
+  }
+  // Rows beyond the matrix are left alone
+  return y[rows] == 0xDEADBEEFu && y[rows + 1] == 0xDEADBEEFu;
+}
+
+// Test helper: specials propagate through the accumulator
+bool test_specials() {
+  std::vector<fp8_bits> a = {0x3C, 0x7C, 0x3C};       // 1, Inf, 1 (e5m2)
+  std::vector<fp16_bits> b = {0x3C00, 0x0000, 0x3C00}; // 1, 0, 1
+  const auto inf_times_zero = dot<fp32_e8m23, fp8_e5m2, fp16_e5m10>(
+      std::span<const fp8_bits>(a), std::span<const fp16_bits>(b));
+  b[1] = 0x3C00;
+  const auto inf = dot<fp32_e8m23, fp8_e5m2, fp16_e5m10>(
+      std::span<const fp8_bits>(a), std::span<const fp16_bits>(b));
+  const auto nan_bits = static_cast<std::uint32_t>(inf_times_zero);
+  return std::isnan(std::bit_cast<float>(nan_bits)) &&
+         inf == 0x7F800000u;
+}
+
+int main() {
+  printf("=== OPINE Dot Product Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("Known values", test_known_values());
+  report("fp8_e4m3 . fp16 -> fp32 vs host fma loop",
+         test_dot_matches_host<fp8_e4m3, fp16_e5m10>());
+  report("fp8_e5m2 . fp32 -> fp32 vs host fma loop",
+         test_dot_matches_host<fp8_e5m2, fp32_e8m23>());
+  report("fp16 . fp16 -> fp32 vs host fma loop",
+         test_dot_matches_host<fp16_e5m10, fp16_e5m10>());
+  report("gemv rows vs dot", test_gemv_matches_dot());
+  report("Special values", test_specials());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,181 @@
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <type_traits>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+using evaluation_policies::RoundEveryStep;
+using evaluation_policies::RoundOnce;
+
+using fp8_once = FloatEngine<FloatConfig<fp8_e5m2, RNE, RoundOnce>>;
+using fp8_step = FloatEngine<FloatConfig<fp8_e5m2, RNE, RoundEveryStep>>;
+
+// Operators build expressions; only conversion to FloatEngine evaluates
+static_assert(std::is_same_v<FloatConfig<fp8_e5m2, RNE>::evaluation_policy,
+                             RoundOnce>);
+static_assert(FloatExpression<fp8_once>);
+static_assert(FloatExpression<decltype(fp8_once{} * fp8_once{} +
+                                       fp8_once{} * fp8_once{})>);
+static_assert(!std::is_same_v<decltype(fp8_once{} + fp8_once{}), fp8_once>);
+static_assert(!std::is_convertible_v<decltype(fp8_once{} + fp8_once{}),
+                                     fp8_step>,
+              "Expressions convert only to their own configuration");
+static_assert(sizeof(decltype(fp8_once{} * fp8_once{} + fp8_once{})) == 3,
+              "Nodes hold their operands by value, nothing else");
+
+// fp8_e5m2: 1.0 + 0.125 is a tie; rounded every step it stays 1.0, and
+// adding another 0.125 ties again. Rounded once the sum is exactly 1.25.
+template <typename Engine> constexpr std::uint8_t chained_sum() {
+  const auto one = Engine::from_bits(0x3C);
+  const auto eighth = Engine::from_bits(0x30);
+  const Engine result = one + eighth + eighth;
+  return result.bits();
+}
+
+static_assert(chained_sum<fp8_once>() == 0x3D, "RoundOnce: 1.25");
+static_assert(chained_sum<fp8_step>() == 0x3C, "RoundEveryStep: 1.0");
+
+// Expressions are values: saving one with auto and evaluating it after its
+// operands are gone is fine
+constexpr bool test_saved_expression() {
+  auto make = [] {
+    const auto two = fp8_once::from_bits(0x40);
+    const auto three = fp8_once::from_bits(0x42);
+    return two * three - two; // 6 - 2
+  };
+  const auto expression = make();
+  const fp8_once result = expression;
+  return result.bits() == 0x44; // 4.0
+}
+
+static_assert(test_saved_expression());
+
+// Compound assignment evaluates the whole right-hand side unpacked
+constexpr bool test_compound_assignment() {
+  auto x = fp8_once::from_bits(0x3C);
+  const auto eighth = fp8_once::from_bits(0x30);
+  x += eighth + eighth; // 1.25, exact
+  x *= -x;              // -1.5625 -> -1.5 (RNE)
+  x /= fp8_once::from_bits(0x40);
+  return x.bits() == 0xBA; // -0.75
+}
+
+static_assert(test_compound_assignment());
+
+// Without -0 (fnuz: NaN 0x80, 1.0 = 0x40 in both fp8 layouts), negation
+// leaves zero and NaN alone
+template <typename Format, typename EvaluationPolicy>
+constexpr bool test_negate_fnuz() {
+  using engine = FloatEngine<FloatConfig<Format, RNE, EvaluationPolicy>>;
+  const auto zero = engine::from_bits(0x00);
+  const auto nan = engine::from_bits(0x80);
+  const auto one = engine::from_bits(0x40);
+  const engine negated_zero = -zero;
+  const engine negated_nan = -nan;
+  const engine negated_difference = -(one - one);
+  const engine negated_one = -one;
+  return negated_zero.bits() == 0x00 && negated_nan.bits() == 0x80 &&
+         negated_difference.bits() == 0x00 && negated_one.bits() == 0xC0;
+}
+
+static_assert(
+    test_negate_fnuz<fp8_e4m3fnuz, RoundOnce>() &&
+        test_negate_fnuz<fp8_e4m3fnuz, RoundEveryStep>() &&
+        test_negate_fnuz<fp8_e4m3fnuz, evaluation_policies::ExtendedRange>() &&
+        test_negate_fnuz<fp8_e5m2fnuz, RoundOnce>() &&
+        test_negate_fnuz<fp8_e5m2fnuz, RoundEveryStep>(),
+    "fnuz negation keeps +0 and NaN");
+
+// Test helper: RoundEveryStep expressions must match evaluating one
+// operation at a time with the storage-level operations
+template <typename Format, typename RoundingPolicy>
+bool test_round_every_step_matches_per_operation() {
+  using engine =
+      FloatEngine<FloatConfig<Format, RoundingPolicy, RoundEveryStep>>;
+  using storage_type = typename Format::storage_type;
+  const unsigned total_values = 1u << Format::total_bits;
+
+  for (unsigned i = 0; i < total_values; ++i) {
+    for (unsigned j = 0; j < total_values; ++j) {
+      const auto a = engine::from_bits(static_cast<storage_type>(i));
+      const auto b = engine::from_bits(static_cast<storage_type>(j));
+      const auto c = engine::from_bits(static_cast<storage_type>(i ^ j));
+
+      const engine fused = a * b + c / (a - b);
+      const auto stepped = engine::add(
+          engine::multiply(a.bits(), b.bits()),
+          engine::divide(c.bits(), engine::subtract(a.bits(), b.bits())));
+      if (fused.bits() != stepped) {
+        printf("\n  mismatch: 0x%x, 0x%x: 0x%x (want 0x%x)\n", i, j,
+               static_cast<unsigned>(fused.bits()),
+               static_cast<unsigned>(stepped));
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Test helper: RoundOnce expressions must match the same chain of unpacked
+// operations, packed once
+template <typename Format, typename RoundingPolicy>
+bool test_round_once_matches_unpacked_chain() {
+  using engine = FloatEngine<FloatConfig<Format, RoundingPolicy, RoundOnce>>;
+  using storage_type = typename Format::storage_type;
+  const unsigned total_values = 1u << Format::total_bits;
+
+  for (unsigned i = 0; i < total_values; ++i) {
+    for (unsigned j = 0; j < total_values; ++j) {
+      const auto a = engine::from_bits(static_cast<storage_type>(i));
+      const auto b = engine::from_bits(static_cast<storage_type>(j));
+      const auto c = engine::from_bits(static_cast<storage_type>(i ^ j));
+
+      const engine fused = a * b + c * c;
+      const auto x = a.unpacked();
+      const auto y = b.unpacked();
+      const auto z = c.unpacked();
+      const auto expected = pack<Format, RoundingPolicy>(
+          add(multiply(x, y), multiply(z, z)));
+      if (fused.bits() != expected) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+int main() {
+  printf("=== OPINE Expression Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("RoundOnce vs RoundEveryStep chain",
+         chained_sum<fp8_once>() == 0x3D && chained_sum<fp8_step>() == 0x3C);
+  report("Saved expression", test_saved_expression());
+  report("Compound assignment", test_compound_assignment());
+  report("fnuz negation",
+         test_negate_fnuz<fp8_e4m3fnuz, RoundEveryStep>() &&
+             test_negate_fnuz<fp8_e5m2fnuz, RoundOnce>());
+  report("RoundEveryStep vs per-operation (fp8_e5m2 RNE)",
+         test_round_every_step_matches_per_operation<fp8_e5m2, RNE>());
+  report("RoundEveryStep vs per-operation (fp8_e4m3 RTZ)",
+         test_round_every_step_matches_per_operation<fp8_e4m3, RTZ>());
+  report("RoundOnce vs unpacked chain (fp8_e4m3 RNE)",
+         test_round_once_matches_unpacked_chain<fp8_e4m3, RNE>());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,211 @@
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <type_traits>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+using RNA = rounding_policies::ToNearestTiesAwayFromZero;
+using evaluation_policies::ExtendedRange;
+using evaluation_policies::RoundOnce;
+
+// A signed exponent 8 bits wider than the field, the unpacked significand
+using fp32_extended = ExtendedFloat<fp32_e8m23, RNE>;
+static_assert(fp32_extended::exponent_bits == 16);
+static_assert(std::is_signed_v<fp32_extended::exponent_type>);
+static_assert(std::is_same_v<fp32_extended::mantissa_type,
+                             UnpackedFloat<fp32_e8m23, RNE>::mantissa_type>);
+static_assert(fp32_extended::lead_position == 26);
+
+// 1.0 has exponent 0; the smallest fp8_e5m2 denormal is normalized to 2^-16
+static_assert(unpack_extended<fp8_e5m2, RNE>(0x3C).exponent == 0);
+static_assert(unpack_extended<fp8_e5m2, RNE>(0x01).exponent == -16);
+static_assert(unpack_extended<fp8_e5m2, RNE>(0x01).mantissa ==
+              UnpackedFloat<fp8_e5m2, RNE>::implicit_bit_mask());
+static_assert(unpack_extended<fp8_e5m2, RNE>(0x7C).kind ==
+              FloatClass::Infinite);
+static_assert(unpack_extended<fp8_e5m2, RNE>(0x80).kind == FloatClass::Zero &&
+              unpack_extended<fp8_e5m2, RNE>(0x80).sign);
+static_assert(unpack_extended<fp8_e4m3fn, RNE>(0x7F).kind == FloatClass::NaN);
+static_assert(
+    unpack_extended<fp8_e5m2, RNE, denormal_policies::FlushInputsToZero>(0x01)
+        .kind == FloatClass::Zero);
+
+// Evaluation policy selection
+static_assert(evaluation_policies::uses_extended_range<ExtendedRange>);
+static_assert(!evaluation_policies::uses_extended_range<RoundOnce>);
+static_assert(std::is_same_v<intermediate_t<FloatConfig<fp32_e8m23, RNE,
+                                                        ExtendedRange>>,
+                             fp32_extended>);
+
+// Test helper: every single operation on extended values packs to the same
+// bits as on unpacked values, and extend() / to_unpacked() round-trip (except
+// for denormals under output flushing, which to_unpacked() flushes as any
+// result), for all fp8 operand pairs (fma with a few addends)
+template <typename Format, typename RoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+bool test_single_operations() {
+  using storage_type = typename Format::storage_type;
+  auto up = [](unsigned bits) {
+    return unpack<Format, RoundingPolicy, DenormalPolicy>(
+        static_cast<storage_type>(bits));
+  };
+  auto same = [](const auto &extended, const auto &unpacked) {
+    return pack(extended) == pack(unpacked);
+  };
+
+  for (unsigned i = 0; i < 256; ++i) {
+    const auto a = up(i);
+    const auto ea = extend(a);
+    const auto back = to_unpacked(ea);
+    const bool flushed = DenormalPolicy::flush_outputs && is_denormal(a);
+    if (!flushed && (back.sign != a.sign || back.exponent != a.exponent ||
+                     back.mantissa != a.mantissa)) {
+      return false;
+    }
+    for (unsigned j = 0; j < 256; ++j) {
+      const auto b = up(j);
+      const auto eb = extend(b);
+      const auto c = up((i * 37 + j * 11) & 0xFF);
+      if (!same(add(ea, eb), add(a, b)) ||
+          !same(subtract(ea, eb), subtract(a, b)) ||
+          !same(multiply(ea, eb), multiply(a, b)) ||
+          !same(divide(ea, eb), divide(a, b)) ||
+          !same(fma(ea, eb, extend(c)), fma(a, b, c))) {
+        printf("\n  %02X, %02X\n", i, j);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// In-range fp32 chains (x = x * a + b, x = x / a - b) pack to the same bits
+// as the same chains on unpacked values
+bool test_fp32_chains() {
+  using F = fp32_e8m23;
+  using storage_type = F::storage_type;
+  auto bits = [](float x) {
+    return static_cast<storage_type>(std::bit_cast<std::uint32_t>(x));
+  };
+
+  std::uint32_t state = 99;
+  auto next = [&] {
+    state = state * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    return 0.5f + static_cast<float>(state >> 8) * 0x1p-24f;
+  };
+  for (int chain = 0; chain < 200; ++chain) {
+    auto x = unpack<F, RNE>(bits(next()));
+    auto ex = extend(x);
+    for (int step = 0; step < 50; ++step) {
+      const auto a = unpack<F, RNE>(bits(next()));
+      const auto b = unpack<F, RNE>(bits(next() - 1.0f));
+      if (step % 2 == 0) {
+        x = fma(x, a, b);
+        ex = fma(ex, extend(a), extend(b));
+      } else {
+        x = subtract(divide(x, a), b);
+        ex = subtract(divide(ex, extend(a)), extend(b));
+      }
+      if (pack(ex) != pack(x)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Intermediates beyond the format's range: a * b / c with a * b above the
+// largest fp16 value, (d * d) * e with d * d below the smallest denormal
+bool test_extended_range() {
+  using F = fp16_e5m10;
+  const auto big = unpack<F, RNE>(0x7000);   // 8192
+  const auto small = unpack<F, RNE>(0x0400); // 2^-14
+  const auto huge = unpack<F, RNE>(0x7800);  // 32768
+
+  bool ok = pack(multiply(big, big)) == 0x7C00; // +Inf
+  ok &= pack(divide(multiply(extend(big), extend(big)), extend(huge))) ==
+        0x6800; // 2048
+  ok &= pack(multiply(round(multiply(small, small)), huge)) == 0;
+  ok &= pack(multiply(multiply(extend(small), extend(small)), extend(huge))) ==
+        0x0800; // 2^-28 * 2^15 = 2^-13
+  ok &= pack(multiply(extend(huge), extend(huge))) == 0x7C00;
+  return ok;
+}
+
+// FloatEngine: ExtendedRange expressions match RoundOnce when the
+// intermediate is a normal number or a special value, and keep intermediate
+// overflows out of the result
+bool test_float_engine() {
+  using once = FloatEngine<FloatConfig<fp8_e4m3, RNE, RoundOnce>>;
+  using extended = FloatEngine<FloatConfig<fp8_e4m3, RNE, ExtendedRange>>;
+
+  for (unsigned i = 0; i < 256; ++i) {
+    for (unsigned j = 0; j < 256; ++j) {
+      const auto a = static_cast<std::uint8_t>(i);
+      const auto b = static_cast<std::uint8_t>(j);
+      const auto product = multiply(once::from_bits(a).unpacked(),
+                                    once::from_bits(b).unpacked());
+      const bool overflowed = is_inf(product) &&
+                              is_finite(once::from_bits(a).unpacked()) &&
+                              is_finite(once::from_bits(b).unpacked());
+      if (overflowed || is_denormal(product)) {
+        continue;
+      }
+      const once r1 = once::from_bits(a) * once::from_bits(b) +
+                      once::from_bits(a);
+      const extended r2 = extended::from_bits(a) * extended::from_bits(b) +
+                          extended::from_bits(a);
+      if (r1.bits() != r2.bits()) {
+        return false;
+      }
+    }
+  }
+
+  const auto big = extended::from_bits(0x70);  // 128
+  const auto four = extended::from_bits(0x48); // 4
+  const extended quotient = big * big / (four * four * four * four);
+  const once overflowed = once::from_bits(0x70) * once::from_bits(0x70) /
+                          once::from_bits(0x48);
+  return quotient.bits() == 0x68 && // 64
+         overflowed.bits() == 0x78; // +Inf: 16384 overflows fp8_e4m3
+}
+
+int main() {
+  printf("=== OPINE Extended Representation Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("fp8_e5m2 RNE single operations",
+         test_single_operations<fp8_e5m2, RNE>());
+  report("fp8_e4m3 RTZ single operations",
+         test_single_operations<fp8_e4m3, RTZ>());
+  report("fp8_e4m3fn RNA single operations",
+         test_single_operations<fp8_e4m3fn, RNA>());
+  report("fp8_e4m3fnuz RNE single operations",
+         test_single_operations<fp8_e4m3fnuz, RNE>());
+  report("fp8_e5m2 RNE flush-to-zero single operations",
+         test_single_operations<fp8_e5m2, RNE,
+                                denormal_policies::FlushToZero>());
+  report("fp8_e5m2 RNE flush-inputs single operations",
+         test_single_operations<fp8_e5m2, RNE,
+                                denormal_policies::FlushInputsToZero>());
+  report("fp32 RNE chains", test_fp32_chains());
+  report("Intermediates beyond the range", test_extended_range());
+  report("FloatEngine ExtendedRange", test_float_engine());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,240 @@
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <opine/extern_ops.hpp>
+#include <opine/opine.hpp>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+using evaluation_policies::RoundOnce;
+
+// Calls into the extern functions defined below
+static int extern_calls = 0;
+
+// Soft-float entry points of RuntimeLibraryOps, implemented here with the
+// host's float and double (round to nearest, ties to even)
+extern "C" {
+float OPINE_C_NAME(addsf3)(float a, float b) { return ++extern_calls, a + b; }
+float OPINE_C_NAME(subsf3)(float a, float b) { return ++extern_calls, a - b; }
+float OPINE_C_NAME(mulsf3)(float a, float b) { return ++extern_calls, a * b; }
+float OPINE_C_NAME(divsf3)(float a, float b) { return ++extern_calls, a / b; }
+double OPINE_C_NAME(adddf3)(double a, double b) {
+  return ++extern_calls, a + b;
+}
+double OPINE_C_NAME(subdf3)(double a, double b) {
+  return ++extern_calls, a - b;
+}
+double OPINE_C_NAME(muldf3)(double a, double b) {
+  return ++extern_calls, a * b;
+}
+double OPINE_C_NAME(divdf3)(double a, double b) {
+  return ++extern_calls, a / b;
+}
+}
+
+// A "ROM routine" with integer parameters: fp8_e5m2 multiply, as the
+// generic engine computes it
+extern "C" std::uint8_t rom_fp8_multiply(std::uint8_t a, std::uint8_t b) {
+  ++extern_calls;
+  return static_cast<std::uint8_t>(
+      DefaultOps<FloatConfig<fp8_e5m2, RNE>>::multiply(a, b));
+}
+
+// Implementation policy replacing multiply only
+template <typename Config> struct RomMultiplyOps : DefaultOps<Config> {
+  using storage_type = typename DefaultOps<Config>::storage_type;
+
+  static storage_type multiply(storage_type a, storage_type b) {
+    return call_extern<rom_fp8_multiply, storage_type>(a, b);
+  }
+};
+
+// Implementation policy replacing unpack only, counting its calls
+static int unpack_calls = 0;
+
+template <typename Config> struct CountingUnpackOps : DefaultOps<Config> {
+  using base = DefaultOps<Config>;
+
+  static typename base::unpacked_type
+  unpack(typename base::storage_type bits) {
+    ++unpack_calls;
+    return base::unpack(bits);
+  }
+};
+
+using fp8_default = FloatEngine<FloatConfig<fp8_e5m2, RNE>>;
+using fp8_rom = FloatEngine<FloatConfig<fp8_e5m2, RNE, RoundOnce,
+                                        RomMultiplyOps>>;
+using fp8_counting = FloatEngine<FloatConfig<fp8_e5m2, RNE, RoundOnce,
+                                             CountingUnpackOps>>;
+
+static_assert(StorageOps<DefaultOps<FloatConfig<fp8_e5m2, RNE>>>);
+static_assert(StorageOps<fp8_rom::ops>);
+static_assert(std::is_same_v<fp8_default::ops,
+                             DefaultOps<FloatConfig<fp8_e5m2, RNE>>>,
+              "DefaultOps is the default implementation policy");
+
+using library_fp32 = RuntimeLibraryOps<FloatConfig<fp32_e8m23, RNE>>;
+static_assert(library_fp32::uses_library);
+static_assert(RuntimeLibraryOps<FloatConfig<fp64_e11m52, RNE>>::uses_library);
+static_assert(!RuntimeLibraryOps<FloatConfig<fp32_e8m23, RTZ>>::uses_library,
+              "The soft-float ABI rounds to nearest only");
+static_assert(!RuntimeLibraryOps<FloatConfig<fp16_e5m10, RNE>>::uses_library);
+
+// binary32 layouts with other special values: the library's Inf and NaN
+// results would be wrong for them
+using fp32_saturating =
+    IEEE_Format<8, 23, DefaultTypeSelectionPolicy,
+                special_value_policies::SaturatingIEEE>;
+using fp32_finite = IEEE_Format<8, 23, DefaultTypeSelectionPolicy,
+                                special_value_policies::FiniteNaN>;
+static_assert(
+    !RuntimeLibraryOps<FloatConfig<fp32_saturating, RNE>>::uses_library &&
+        !RuntimeLibraryOps<FloatConfig<fp32_finite, RNE>>::uses_library,
+    "Only IEEE special values use the soft-float ABI");
+
+// Non-overridden operations stay usable in constant expressions
+static_assert(fp8_rom::add(0x3C, 0x3C) == 0x40, "1 + 1 = 2");
+
+// Same encoding, or both NaN (NaN results of host arithmetic may differ
+// from the generic engine in sign and payload)
+template <typename Format, typename Storage>
+bool same_value(Storage actual, Storage expected) {
+  using generic = DefaultOps<FloatConfig<Format, RNE>>;
+  return actual == expected || (is_nan(generic::unpack(actual)) &&
+                                is_nan(generic::unpack(expected)));
+}
+
+// Test helper: an implementation policy must give the same results as
+// DefaultOps, calling the extern function for the replaced operations only
+template <typename Format, typename Ops, typename Generator>
+bool test_matches_default(Generator next_operand, bool replaces_arithmetic,
+                          bool replaces_multiply) {
+  using storage_type = typename Format::storage_type;
+  using generic = DefaultOps<FloatConfig<Format, RNE>>;
+
+  for (int i = 0; i < 2000; ++i) {
+    const storage_type a = next_operand();
+    const storage_type b = next_operand();
+    const storage_type c = next_operand();
+
+    const int calls = extern_calls;
+    const bool same =
+        same_value<Format>(Ops::add(a, b), generic::add(a, b)) &&
+        same_value<Format>(Ops::subtract(a, b), generic::subtract(a, b)) &&
+        same_value<Format>(Ops::multiply(a, b), generic::multiply(a, b)) &&
+        same_value<Format>(Ops::divide(a, b), generic::divide(a, b)) &&
+        Ops::fma(a, b, c) == generic::fma(a, b, c);
+    const int expected_calls = replaces_arithmetic ? 4 : replaces_multiply;
+    if (!same || extern_calls - calls != expected_calls) {
+      printf("\n  mismatch for 0x%llx, 0x%llx, 0x%llx\n",
+             static_cast<unsigned long long>(a),
+             static_cast<unsigned long long>(b),
+             static_cast<unsigned long long>(c));
+      return false;
+    }
+  }
+  return true;
+}
+
+// Pseudo-random encodings of a format (all classes)
+template <typename Format> auto random_operands(std::uint64_t seed) {
+  return [seed]() mutable {
+    seed = seed * 6364136223846793005u + 1442695040888963407u; // PCG LCG
+    return static_cast<typename Format::storage_type>(
+        (seed >> (64 - Format::total_bits)));
+  };
+}
+
+bool test_runtime_library_fp32() {
+  return test_matches_default<fp32_e8m23, library_fp32>(
+      random_operands<fp32_e8m23>(1), true, true);
+}
+
+// binary64 arithmetic needs wider integers than this compiler provides
+// (_BitInt), so the library result is checked against the host directly
+bool test_runtime_library_fp64() {
+  using library = RuntimeLibraryOps<FloatConfig<fp64_e11m52, RNE>>;
+  using storage_type = fp64_e11m52::storage_type;
+  auto bits = [](double x) {
+    return static_cast<storage_type>(std::bit_cast<std::uint64_t>(x));
+  };
+
+  const int calls = extern_calls;
+  return library::add(bits(1.5), bits(0.25)) == bits(1.75) &&
+         library::subtract(bits(1.5), bits(0.25)) == bits(1.25) &&
+         library::multiply(bits(1.5), bits(-3.0)) == bits(-4.5) &&
+         library::divide(bits(1.0), bits(3.0)) == bits(1.0 / 3.0) &&
+         extern_calls - calls == 4;
+}
+
+bool test_runtime_library_fallback() {
+  return test_matches_default<
+      fp16_e5m10, RuntimeLibraryOps<FloatConfig<fp16_e5m10, RNE>>>(
+      random_operands<fp16_e5m10>(3), false, false);
+}
+
+bool test_runtime_library_special_values() {
+  return test_matches_default<
+             fp32_saturating,
+             RuntimeLibraryOps<FloatConfig<fp32_saturating, RNE>>>(
+             random_operands<fp32_saturating>(5), false, false) &&
+         test_matches_default<
+             fp32_finite, RuntimeLibraryOps<FloatConfig<fp32_finite, RNE>>>(
+             random_operands<fp32_finite>(6), false, false);
+}
+
+bool test_rom_multiply() {
+  return test_matches_default<fp8_e5m2, fp8_rom::ops>(
+      random_operands<fp8_e5m2>(4), false, true);
+}
+
+// FloatEngine dispatches its storage-level operations through the policy
+bool test_engine_dispatch() {
+  const int calls = extern_calls;
+  const auto product = fp8_rom::multiply(0x40, 0x42); // 2 * 3
+  const auto sum = fp8_rom::add(0x40, 0x42);
+  return product == 0x46 && sum == 0x45 && extern_calls - calls == 1;
+}
+
+// Expression leaves and results go through the policy's unpack() and pack()
+bool test_engine_unpack_dispatch() {
+  unpack_calls = 0;
+  const auto a = fp8_counting::from_bits(0x40);
+  const auto b = fp8_counting::from_bits(0x42);
+  const fp8_counting r = a * b + a; // 2 * 3 + 2
+  return r.bits() == 0x48 && unpack_calls == 3 &&
+         a.unpacked().exponent == fp8_default::from_bits(0x40)
+                                      .unpacked()
+                                      .exponent &&
+         unpack_calls == 4;
+}
+
+int main() {
+  printf("=== OPINE Extern Ops Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("RuntimeLibraryOps binary32", test_runtime_library_fp32());
+  report("RuntimeLibraryOps binary64", test_runtime_library_fp64());
+  report("RuntimeLibraryOps fallback (binary16)",
+         test_runtime_library_fallback());
+  report("RuntimeLibraryOps fallback (saturating, finite binary32)",
+         test_runtime_library_special_values());
+  report("Extern multiply, integer parameters", test_rom_multiply());
+  report("FloatEngine storage-level dispatch", test_engine_dispatch());
+  report("FloatEngine unpack dispatch", test_engine_unpack_dispatch());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,262 @@
+#include "float_oracle.hpp"
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+
+// Padded format from test_pack_unpack.cpp: [pad:3][S:1][E:4][M:3][pad:1],
+// the fields of fp8_e4m3 shifted left by one
+using PaddedFormat = FormatDescriptor<1, 8, 4, 4, 3, 1, 12, true>;
+
+// Storage-level fma through the UnpackedFloat arithmetic
+template <typename Format, typename RoundingPolicy>
+constexpr std::uint64_t fma_bits(std::uint64_t a, std::uint64_t b,
+                                 std::uint64_t c) {
+  using storage_type = typename Format::storage_type;
+  return pack<Format, RoundingPolicy>(
+      fma(unpack<Format, RoundingPolicy>(static_cast<storage_type>(a)),
+          unpack<Format, RoundingPolicy>(static_cast<storage_type>(b)),
+          unpack<Format, RoundingPolicy>(static_cast<storage_type>(c))));
+}
+
+// Known results, checked at compile time
+constexpr bool test_known_values() {
+  // fp8_e5m2: 1.25 * 1.25 - 1.5 = 0.0625 exactly. Rounding the product
+  // first (1.5625 -> 1.5) would give 0.
+  if (fma_bits<fp8_e5m2, RNE>(0x3D, 0x3D, 0xBE) != 0x2C) {
+    return false;
+  }
+  using unpacked = UnpackedFloat<fp8_e5m2, RNE>;
+  const unpacked x = unpack<fp8_e5m2, RNE>(0x3D);
+  const unpacked y = unpack<fp8_e5m2, RNE>(0xBE);
+  if (pack<fp8_e5m2, RNE>(add(round(multiply(x, x)), y)) != 0x00) {
+    return false;
+  }
+  // 1.5 * 1.25 + 1 = 2.875 -> 3.0 (RNE), 2.5 (TowardZero)
+  if (fma_bits<fp8_e5m2, RNE>(0x3E, 0x3D, 0x3C) != 0x42 ||
+      fma_bits<fp8_e5m2, RTZ>(0x3E, 0x3D, 0x3C) != 0x41) {
+    return false;
+  }
+  // Specials: 0 * Inf + 1 = NaN, Inf * 1 - Inf = NaN, 1 * 1 + Inf = Inf,
+  // x * y + 0 = x * y
+  if ((fma_bits<fp8_e5m2, RNE>(0x00, 0x7C, 0x3C) & 0x03) == 0 ||
+      (fma_bits<fp8_e5m2, RNE>(0x7C, 0x3C, 0xFC) & 0x03) == 0 ||
+      fma_bits<fp8_e5m2, RNE>(0x3C, 0x3C, 0x7C) != 0x7C ||
+      fma_bits<fp8_e5m2, RNE>(0x40, 0x42, 0x80) != 0x46) {
+    return false;
+  }
+  // Zeros: -0 * 1 + -0 = -0, -0 * 1 + 0 = +0
+  if (fma_bits<fp8_e5m2, RNE>(0x80, 0x3C, 0x80) != 0x80 ||
+      fma_bits<fp8_e5m2, RNE>(0x80, 0x3C, 0x00) != 0x00) {
+    return false;
+  }
+  return true;
+}
+
+static_assert(test_known_values(), "Known fma results");
+
+// fma works for padded layouts: results are the fp8_e4m3 results, shifted
+constexpr bool test_padded_known_values() {
+  return fma_bits<PaddedFormat, RNE>(0x3A << 1, 0x3A << 1, 0xBC << 1) ==
+             (fma_bits<fp8_e4m3, RNE>(0x3A, 0x3A, 0xBC) << 1) &&
+         fma_bits<PaddedFormat, RTZ>(0x41 << 1, 0x43 << 1, 0x15 << 1) ==
+             (fma_bits<fp8_e4m3, RTZ>(0x41, 0x43, 0x15) << 1);
+}
+
+static_assert(test_padded_known_values(), "fma on a padded layout");
+
+// FloatEngine: fma() is an expression node, and a single operation
+constexpr bool test_float_engine() {
+  using fp8 = FloatEngine<FloatConfig<fp8_e5m2, RNE>>;
+  using evaluation_policies::RoundEveryStep;
+  using fp8_step = FloatEngine<FloatConfig<fp8_e5m2, RNE, RoundEveryStep>>;
+  const fp8 fused = fma(fp8::from_bits(0x3D), fp8::from_bits(0x3D),
+                        fp8::from_bits(0xBE));
+  const fp8_step stepped =
+      fma(fp8_step::from_bits(0x3D), fp8_step::from_bits(0x3D),
+          fp8_step::from_bits(0xBE));
+  return fused.bits() == 0x2C && stepped.bits() == 0x2C &&
+         fp8::fma(0x3D, 0x3D, 0xBE) == 0x2C;
+}
+
+static_assert(test_float_engine(), "FloatEngine fma");
+
+// Pseudo-random generator for sampling operands
+struct Lcg {
+  std::uint32_t state;
+  std::uint32_t next() {
+    state = state * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    return state;
+  }
+};
+
+// Test helper: every pair (a, b) with a sample of addends c must match the
+// correctly rounded a * b + c (NaN results only need to be NaN)
+template <typename Format, typename RoundingPolicy>
+bool test_matches_oracle(int addends_per_pair) {
+  constexpr bool nearest = std::is_same_v<RoundingPolicy, RNE>;
+  constexpr std::uint64_t mask = (std::uint64_t{1} << Format::total_bits) - 1;
+  const std::uint64_t total_values = mask + 1;
+  Lcg random{0x1234567u};
+
+  for (std::uint64_t a = 0; a < total_values; ++a) {
+    for (std::uint64_t b = 0; b < total_values; ++b) {
+      for (int k = 0; k < addends_per_pair; ++k) {
+        // Half the addends near the product's magnitude, where the sum
+        // cancels or rounds
+        std::uint64_t c = random.next() & mask;
+        if (k & 1) {
+          c = (a + b - (mask >> 1) + (random.next() & 0xF)) & mask;
+        }
+        const auto actual = fma_bits<Format, RoundingPolicy>(a, b, c);
+        const double odd = oracle::fma_to_odd(oracle::to_double<Format>(a),
+                                              oracle::to_double<Format>(b),
+                                              oracle::to_double<Format>(c));
+        const auto expected = oracle::round_to<Format, nearest>(odd);
+        const bool match = oracle::is_nan<Format>(expected)
+                               ? oracle::is_nan<Format>(actual)
+                               : actual == expected;
+        if (!match) {
+          printf("\n  mismatch: 0x%llx * 0x%llx + 0x%llx -> 0x%llx "
+                 "(want 0x%llx)\n",
+                 static_cast<unsigned long long>(a),
+                 static_cast<unsigned long long>(b),
+                 static_cast<unsigned long long>(c),
+                 static_cast<unsigned long long>(actual),
+                 static_cast<unsigned long long>(expected));
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+// Test helper: fma on the padded layout matches fp8_e4m3 for every pair
+template <typename RoundingPolicy> bool test_padded_matches_e4m3() {
+  Lcg random{0xBADC0DEu};
+  for (std::uint64_t a = 0; a < 256; ++a) {
+    for (std::uint64_t b = 0; b < 256; ++b) {
+      const std::uint64_t c = random.next() & 0xFF;
+      if (fma_bits<PaddedFormat, RoundingPolicy>(a << 1, b << 1, c << 1) !=
+          fma_bits<fp8_e4m3, RoundingPolicy>(a, b, c) << 1) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Test helper: sampled fp16 triples against the oracle
+template <typename RoundingPolicy> bool test_fp16_sampled() {
+  constexpr bool nearest = std::is_same_v<RoundingPolicy, RNE>;
+  Lcg random{0xC0FFEEu};
+
+  for (int i = 0; i < 1000000; ++i) {
+    const std::uint64_t a = random.next() >> 16;
+    const std::uint64_t b = random.next() >> 16;
+    std::uint64_t c = random.next() >> 16;
+    if (i & 1) {
+      // Addend exponent near the product's
+      const std::uint64_t exp = ((a >> 10 & 0x1F) + (b >> 10 & 0x1F) +
+                                 (random.next() >> 29) - 18) & 0x1F;
+      c = (c & 0x83FF) | (exp << 10);
+    }
+    const auto actual = fma_bits<fp16_e5m10, RoundingPolicy>(a, b, c);
+    const auto expected = oracle::round_to<fp16_e5m10, nearest>(
+        oracle::fma_to_odd(oracle::to_double<fp16_e5m10>(a),
+                           oracle::to_double<fp16_e5m10>(b),
+                           oracle::to_double<fp16_e5m10>(c)));
+    const bool match = oracle::is_nan<fp16_e5m10>(expected)
+                           ? oracle::is_nan<fp16_e5m10>(actual)
+                           : actual == expected;
+    if (!match) {
+      printf("\n  mismatch: 0x%04llx * 0x%04llx + 0x%04llx -> 0x%04llx "
+             "(want 0x%04llx)\n",
+             static_cast<unsigned long long>(a),
+             static_cast<unsigned long long>(b),
+             static_cast<unsigned long long>(c),
+             static_cast<unsigned long long>(actual),
+             static_cast<unsigned long long>(expected));
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Test helper: fp32 RNE must be bit-exact with the host's std::fma(float)
+bool test_fp32_matches_host() {
+  Lcg random{0x9E3779B9u};
+
+  for (int i = 0; i < 400000; ++i) {
+    const std::uint32_t a = random.next();
+    const std::uint32_t b = random.next();
+    std::uint32_t c = random.next();
+    if (i & 1) {
+      // Addend exponent near the product's, where the sum cancels
+      const std::uint32_t exp = ((a >> 23 & 0xFF) + (b >> 23 & 0xFF) +
+                                 (random.next() >> 28) - 134) & 0xFF;
+      c = (c & 0x807FFFFFu) | (exp << 23);
+    }
+
+    const float expected =
+        std::fma(std::bit_cast<float>(a), std::bit_cast<float>(b),
+                 std::bit_cast<float>(c));
+    const auto actual =
+        static_cast<std::uint32_t>(fma_bits<fp32_e8m23, RNE>(a, b, c));
+    const auto want = std::bit_cast<std::uint32_t>(expected);
+    const bool match = std::isnan(expected)
+                           ? oracle::is_nan<fp32_e8m23>(actual)
+                           : actual == want;
+    if (!match) {
+      printf("\n  mismatch: 0x%08x * 0x%08x + 0x%08x -> 0x%08x "
+             "(want 0x%08x)\n",
+             a, b, c, actual, want);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int main() {
+  printf("=== OPINE FMA Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("Known values", test_known_values());
+  report("Padded layout known values", test_padded_known_values());
+  report("FloatEngine fma", test_float_engine());
+  report("fp8_e5m2 RNE (all pairs, sampled addends)",
+         test_matches_oracle<fp8_e5m2, RNE>(16));
+  report("fp8_e5m2 TowardZero (all pairs, sampled addends)",
+         test_matches_oracle<fp8_e5m2, RTZ>(16));
+  report("fp8_e4m3 RNE (all pairs, sampled addends)",
+         test_matches_oracle<fp8_e4m3, RNE>(16));
+  report("fp8_e4m3 TowardZero (all pairs, sampled addends)",
+         test_matches_oracle<fp8_e4m3, RTZ>(16));
+  report("Padded layout vs fp8_e4m3 (all pairs)",
+         test_padded_matches_e4m3<RNE>() && test_padded_matches_e4m3<RTZ>());
+  report("fp16 RNE (sampled)", test_fp16_sampled<RNE>());
+  report("fp16 TowardZero (sampled)", test_fp16_sampled<RTZ>());
+  report("fp32 RNE vs host std::fma (sampled)", test_fp32_matches_host());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <opine/format_dispatch.hpp>
+#include <opine/opine.hpp>
+#include <opine/tensor_file.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace opine;
+
+using fp32_bits = fp32_e8m23::storage_type;
+using Kernels = FormatKernels<fp32_e8m23>;
+
+// 12-bit format: not registered
+using PaddedFormat = FormatDescriptor<1, 8, 4, 4, 3, 1, 12, true>;
+
+static_assert(runtime_format<fp8_e4m3>() ==
+              runtime_format<IEEE_Format<4, 3, type_policies::Fastest>>());
+static_assert(runtime_format<fp8_e4m3>() != runtime_format<fp8_e4m3fn>());
+static_assert(runtime_format<fp8_e4m3fn>() != runtime_format<fp8_e4m3fnuz>());
+static_assert(format_kernels<fp32_e8m23>().size() == PredefinedFormats::size);
+static_assert(find_format_kernels<fp32_e8m23>(
+                  runtime_format<fp6_e2m3>())->storage_bytes == 1);
+static_assert(find_format_kernels<fp32_e8m23>(
+                  runtime_format<PaddedFormat>()) == nullptr);
+static_assert(find_mx_kernels<fp32_e8m23>(runtime_format<fp4_e2m1fn>(), 32)
+                  ->block_bytes == 16);
+static_assert(find_mx_kernels<fp32_e8m23>(runtime_format<fp4_e2m1fn>(), 16) ==
+              nullptr);
+static_assert(find_mx_kernels<fp32_e8m23>(runtime_format<fp4_e2m1>(), 32) ==
+                  nullptr,
+              "MX elements use the OCP encodings");
+
+std::filesystem::path temp_file(const char *name) {
+  return std::filesystem::temp_directory_path() /
+         (std::string("opine_test_") + name + ".opine");
+}
+
+// Test pattern: distinct, covering the whole element width
+template <typename Format>
+std::vector<typename Format::storage_type> pattern(std::size_t n) {
+  constexpr std::uint64_t mask =
+      Format::total_bits == 64 ? ~std::uint64_t{0}
+                               : (std::uint64_t{1} << Format::total_bits) - 1;
+  std::vector<typename Format::storage_type> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    values[i] = static_cast<typename Format::storage_type>(
+        (i * 0x9E3779B97F4A7C15u + 11) & mask);
+  }
+  return values;
+}
+
+// Working values: finite fp32 numbers over the range of every format
+std::vector<fp32_bits> working_pattern(std::size_t n) {
+  std::vector<fp32_bits> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const float magnitude = static_cast<float>(i % 97) * 0.37f *
+                            static_cast<float>(1u << (i % 11));
+    values[i] = static_cast<fp32_bits>(
+        std::bit_cast<std::uint32_t>(i % 2 ? -magnitude : magnitude));
+  }
+  return values;
+}
+
+// Every format is registered once, found by its fields and its name
+bool test_registry() {
+  bool ok = true;
+  std::size_t index = 0;
+  for_each_type<PredefinedFormats>([&]<typename Format>() {
+    const auto *kernels =
+        find_format_kernels<fp32_e8m23>(runtime_format<Format>());
+    ok &= kernels == &format_kernels<fp32_e8m23>()[index++];
+    ok &= kernels->storage_bytes == sizeof(typename Format::storage_type);
+    ok &= find_format_kernels<fp32_e8m23>(
+              format_name(runtime_format<Format>())) == kernels;
+  });
+  ok &= format_name(runtime_format<fp8_e4m3fnuz>()) == "fp8_e4m3fnuz";
+  ok &= format_name(runtime_format<fp6_e2m3fn>()) == "fp6_e2m3fn";
+  ok &= find_format_kernels<fp32_e8m23>("fp8_e4m3")->format ==
+        runtime_format<fp8_e4m3>();
+  ok &= find_format_kernels<fp32_e8m23>("bf16") == nullptr;
+  return ok;
+}
+
+// Storage-layout kernels: the same encodings as compile-time convert_n()
+template <typename Format> bool test_storage_kernels() {
+  using storage_type = typename Format::storage_type;
+  const Kernels &kernels =
+      *find_format_kernels<fp32_e8m23>(runtime_format<Format>());
+
+  const auto encodings = pattern<Format>(1000);
+  std::vector<fp32_bits> decoded(encodings.size());
+  std::vector<fp32_bits> expected(encodings.size());
+  bool ok = kernels.decode(std::as_bytes(std::span(encodings)), decoded) ==
+            encodings.size();
+  convert_n<fp32_e8m23, Format>(std::span<const storage_type>(encodings),
+                                std::span<fp32_bits>(expected));
+  ok &= decoded == expected;
+
+  const auto values = working_pattern(1000);
+  std::vector<storage_type> encoded(values.size() - 1);
+  std::vector<storage_type> expected_encoded(encoded.size());
+  ok &= kernels.encode(values, std::as_writable_bytes(std::span(encoded))) ==
+        encoded.size();
+  convert_n<Format, fp32_e8m23>(std::span<const fp32_bits>(values),
+                                std::span<storage_type>(expected_encoded));
+  ok &= encoded == expected_encoded;
+  return ok;
+}
+
+// Packed kernels: the same encodings as PackedArray load() / store()
+template <typename Format> bool test_packed_kernels() {
+  using storage_type = typename Format::storage_type;
+  const Kernels &kernels =
+      *find_format_kernels<fp32_e8m23>(runtime_format<Format>());
+
+  const auto encodings = pattern<Format>(301);
+  const PackedArray<Format> array{std::span<const storage_type>(encodings)};
+  std::vector<fp32_bits> decoded(200);
+  bool ok = kernels.decode_packed(array.words(), array.size(), 5, decoded) ==
+            decoded.size();
+  std::vector<fp32_bits> expected(decoded.size());
+  convert_n<fp32_e8m23, Format>(
+      std::span<const storage_type>(encodings).subspan(5, decoded.size()),
+      std::span<fp32_bits>(expected));
+  ok &= decoded == expected;
+  // Clamped to the array
+  ok &= kernels.decode_packed(array.words(), array.size(), 250, decoded) ==
+        51;
+
+  const auto values = working_pattern(150);
+  std::vector<storage_type> narrowed(values.size());
+  convert_n<Format, fp32_e8m23>(std::span<const fp32_bits>(values),
+                                std::span<storage_type>(narrowed));
+  PackedArray<Format> reference(301);
+  reference.store(7, narrowed);
+  std::vector<std::uint64_t> words(reference.words().size());
+  ok &= kernels.encode_packed(values, 7, words) == values.size();
+  ok &= std::ranges::equal(words, reference.words());
+  return ok;
+}
+
+// MX kernels: the same scales and elements as quantize(), the same values as
+// dequantize()
+template <typename MxFormat> bool test_mx_kernels() {
+  const auto &kernels = *find_mx_kernels<fp32_e8m23>(
+      runtime_format<typename MxFormat::element_format>(),
+      MxFormat::block_size);
+
+  const auto values = working_pattern(1000);
+  const auto reference =
+      quantize<MxFormat, fp32_e8m23>(std::span<const fp32_bits>(values));
+
+  std::vector<std::uint8_t> scales(reference.block_count());
+  std::vector<std::uint8_t> elements(reference.elements().size());
+  bool ok = kernels.quantize(values, scales, elements) == values.size();
+  ok &= std::ranges::equal(scales, reference.scales()) &&
+        std::ranges::equal(elements, reference.elements());
+
+  std::vector<fp32_bits> decoded(values.size());
+  std::vector<fp32_bits> expected(values.size());
+  ok &= kernels.dequantize(values.size(), scales, elements, decoded) ==
+        values.size();
+  reference.template dequantize<fp32_e8m23>(std::span<fp32_bits>(expected));
+  ok &= decoded == expected;
+  return ok;
+}
+
+// Tensor files of a format only known at run time
+bool test_tensor_files() {
+  bool ok = true;
+  const auto path = temp_file("dispatch");
+  const auto encodings = pattern<fp8_e4m3fn>(777);
+  {
+    TensorWriter<fp8_e4m3fn> out(path, TensorLayout::Storage);
+    out.write(std::span<const std::uint8_t>(encodings));
+    out.close();
+  }
+  {
+    const TensorFile file(path);
+    const auto *kernels = find_format_kernels<fp32_e8m23>(file.format());
+    ok &= kernels != nullptr &&
+          kernels->format == runtime_format<fp8_e4m3fn>();
+    std::vector<fp32_bits> decoded(file.size());
+    std::vector<fp32_bits> expected(file.size());
+    ok &= kernels->decode(file.data_bytes(), decoded) == file.size();
+    convert_n<fp32_e8m23, fp8_e4m3fn>(
+        std::span<const std::uint8_t>(encodings),
+        std::span<fp32_bits>(expected));
+    ok &= decoded == expected;
+  }
+
+  const auto values = working_pattern(500);
+  const auto weights =
+      quantize<MXFP6_E2M3, fp32_e8m23>(std::span<const fp32_bits>(values));
+  write_tensor_file(path, weights);
+  {
+    const TensorFile file(path);
+    const auto *kernels = find_mx_kernels<fp32_e8m23>(
+        file.format(), file.header().block_size);
+    ok &= kernels != nullptr;
+    std::vector<fp32_bits> decoded(file.size());
+    std::vector<fp32_bits> expected(file.size());
+    const auto scales = file.scale_bytes();
+    const auto elements = file.data_bytes();
+    ok &= kernels->dequantize(
+              file.size(),
+              {reinterpret_cast<const std::uint8_t *>(scales.data()),
+               scales.size()},
+              {reinterpret_cast<const std::uint8_t *>(elements.data()),
+               elements.size()},
+              decoded) == file.size();
+    weights.dequantize<fp32_e8m23>(std::span<fp32_bits>(expected));
+    ok &= decoded == expected;
+    ok &= find_format_kernels<fp32_e8m23>(file.format())->format ==
+          runtime_format<fp6_e2m3fn>();
+  }
+  std::filesystem::remove(path);
+  return ok;
+}
+
+int main() {
+  printf("=== OPINE Format Dispatch Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const std::string &name, bool result) {
+    printf("%s: %s\n", name.c_str(), result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("Registry", test_registry());
+  for_each_type<PredefinedFormats>([&]<typename Format>() {
+    const std::string name = format_name(runtime_format<Format>());
+    report(name + " storage kernels", test_storage_kernels<Format>());
+    report(name + " packed kernels", test_packed_kernels<Format>());
+  });
+  for_each_type<PredefinedMxFormats>([&]<typename MxFormat>() {
+    report("MX " +
+               format_name(runtime_format<
+                           typename MxFormat::element_format>()) +
+               " kernels",
+           test_mx_kernels<MxFormat>());
+  });
+  report("Tensor files", test_tensor_files());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <span>
+#include <vector>
+
+using namespace opine;
+using namespace opine::conversion_policies;
+
+using instrumentation_policies::Counting;
+using instrumentation_policies::EventCounts;
+
+using fp32_bits = fp32_e8m23::storage_type;
+using fp16_bits = fp16_e5m10::storage_type;
+
+// Which policies count
+static_assert(!is_instrumented<SafeConversion> &&
+              !is_instrumented<Conversion<rounding_policies::TowardZero,
+                                          false>>);
+static_assert(is_instrumented<Instrumented<SafeConversion>>);
+static_assert(!is_instrumented<
+              Instrumented<SafeConversion, instrumentation_policies::None>>);
+static_assert(ConversionPolicy<Instrumented<IEEEConversion>>);
+static_assert(conversion_strategy<fp8_e4m3, fp8_e5m2> ==
+                  ConversionStrategy::Direct &&
+              conversion_strategy<fp8_e4m3, fp8_e5m2,
+                                  Instrumented<IEEEConversion>> ==
+                  ConversionStrategy::Compute &&
+              conversion_strategy<fp16_e5m10, fp32_e8m23,
+                                  Instrumented<SafeConversion>> ==
+                  ConversionStrategy::Compute);
+
+// Constant evaluation converts as usual and records nothing
+static_assert(convert<fp8_e4m3, fp32_e8m23, Instrumented<SafeConversion>>(
+                  0x3FF80000u) == 0x40,
+              "1.9375 rounds to 2.0");
+
+// fp32 values with known events in fp8_e4m3 (largest finite 240, smallest
+// normal 2^-6, smallest denormal 2^-9)
+const std::vector<fp32_bits> fp8_cases = {
+    0x3F800000u, // 1.0: exact
+    0x3F8C0000u, // 1.09375: round up to 1.125
+    0x3FF80000u, // 1.9375: round up to 2.0, carry
+    0x447A0000u, // 1000: overflow
+    0x43740000u, // 244: rounds to 240
+    0x437A0000u, // 250: rounds up to 256, overflow
+    0x39800000u, // 2^-12: underflow
+    0x3B800000u, // 2^-8: exact denormal
+    0x00000001u, // fp32 denormal: underflow
+    0x7FC00000u, // NaN
+    0xFF800000u, // -Inf
+    0x00000000u, // +0
+    0x80000000u, // -0
+    0x3AC00000u, // 1.5 * 2^-10: round up to the smallest denormal
+    0x3C780000u, // 2^-6 - 2^-12: round up to the smallest normal, carry
+};
+
+// Test helper: the counts of converting src with ConversionPolicy,
+// element by element through convert() and with one convert_n()
+template <typename Dst, typename Src, typename ConversionPolicy>
+bool test_counts(const std::vector<typename Src::storage_type> &src,
+                 const EventCounts &expected) {
+  using instrumentation = instrumentation_policy_t<ConversionPolicy>;
+  instrumentation::take();
+
+  std::vector<typename Dst::storage_type> scalar(src.size());
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    scalar[i] = convert<Dst, Src, ConversionPolicy>(src[i]);
+  }
+  const auto scalar_counts = instrumentation::take();
+
+  std::vector<typename Dst::storage_type> bulk(src.size());
+  convert_n<Dst, Src, ConversionPolicy>(
+      std::span<const typename Src::storage_type>(src),
+      std::span<typename Dst::storage_type>(bulk));
+  const auto bulk_counts = instrumentation::take();
+
+  return scalar_counts == expected && bulk_counts == expected &&
+         bulk == scalar;
+}
+
+bool test_fp8_counts() {
+  EventCounts safe;
+  safe.conversions = 15;
+  safe.round_ups = 4;
+  safe.carries = 2;
+  safe.overflows = 2;
+  safe.saturations = 2;
+  safe.underflows = 2;
+  safe.denormal_inputs = 1;
+  safe.denormal_outputs = 2;
+  safe.nan_inputs = 1;
+  safe.inf_inputs = 1;
+
+  // Overflow to Inf without saturation
+  EventCounts ieee = safe;
+  ieee.saturations = 0;
+
+  // Toward zero: 250 truncates to 240, the small values lose their
+  // round-ups (1.5 * 2^-10 to zero, 2^-6 - 2^-12 to a denormal)
+  EventCounts fast = safe;
+  fast.round_ups = 0;
+  fast.carries = 0;
+  fast.overflows = 1;
+  fast.saturations = 1;
+  fast.underflows = 3;
+
+  return test_counts<fp8_e4m3, fp32_e8m23, Instrumented<SafeConversion>>(
+             fp8_cases, safe) &&
+         test_counts<fp8_e4m3, fp32_e8m23, Instrumented<IEEEConversion>>(
+             fp8_cases, ieee) &&
+         test_counts<fp8_e4m3, fp32_e8m23, Instrumented<FastConversion>>(
+             fp8_cases, fast);
+}
+
+// fp32 -> fp16 around the largest finite value (65504), and fp16 -> fp32
+// widening, which only meets denormal and special inputs
+bool test_fp16_counts() {
+  const std::vector<fp32_bits> narrow = {
+      0x477FE000u, // 65504: exact
+      0x477FEFFFu, // just below 65520: rounds to 65504
+      0x477FF000u, // 65520: ties to even, overflow
+      0x33800000u, // 2^-24: smallest denormal, exact
+      0x33000000u, // 2^-25: ties to even, underflow
+  };
+  EventCounts narrowed;
+  narrowed.conversions = 5;
+  narrowed.overflows = 1;
+  narrowed.underflows = 1;
+  narrowed.denormal_outputs = 1;
+
+  const std::vector<fp16_bits> wide = {0x0001, 0x83FF, 0x3C00, 0x7C00,
+                                       0xFE00};
+  EventCounts widened;
+  widened.conversions = 5;
+  widened.denormal_inputs = 2;
+  widened.inf_inputs = 1;
+  widened.nan_inputs = 1;
+
+  return test_counts<fp16_e5m10, fp32_e8m23, Instrumented<IEEEConversion>>(
+             narrow, narrowed) &&
+         test_counts<fp32_e8m23, fp16_e5m10, Instrumented<IEEEConversion>>(
+             wide, widened);
+}
+
+// Pseudo-random encodings of the given width (every bit pattern, NaNs
+// included)
+template <typename Storage>
+std::vector<Storage> random_bits(std::size_t n, std::uint32_t seed) {
+  std::vector<Storage> values(n);
+  for (auto &value : values) {
+    seed = seed * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    value = static_cast<Storage>(seed);
+  }
+  return values;
+}
+
+// Test helper: instrumented results are those of Base (its tables and
+// native paths included), and convert_n() counts what convert() counts
+template <typename Dst, typename Src, typename Base> bool test_same_results() {
+  using Counted = Instrumented<Base>;
+  const auto src = random_bits<typename Src::storage_type>(20000, 3);
+  const auto in = std::span<const typename Src::storage_type>(src);
+
+  std::vector<typename Dst::storage_type> expected(src.size());
+  std::vector<typename Dst::storage_type> counted(src.size());
+  convert_n<Dst, Src, Base>(in, std::span(expected));
+  Counting<>::take();
+  convert_n<Dst, Src, Counted>(in, std::span(counted));
+  const auto bulk = Counting<>::take();
+
+  EventCounts sum;
+  for (const auto bits : src) {
+    convert<Dst, Src, Counted>(bits);
+    sum += Counting<>::take();
+  }
+  return counted == expected && bulk == sum &&
+         bulk.conversions == src.size();
+}
+
+// Counting tags keep separate counts; take() resets
+bool test_tags() {
+  struct Activations;
+  using Counted = Instrumented<SafeConversion, Counting<Activations>>;
+  Counting<>::take();
+  Counting<Activations>::take();
+
+  convert<fp8_e4m3, fp32_e8m23, Counted>(0x447A0000u);
+  convert<fp8_e4m3, fp32_e8m23, Instrumented<SafeConversion>>(0x3F800000u);
+  convert<fp8_e4m3, fp32_e8m23, SafeConversion>(0x447A0000u);
+
+  const auto tagged = Counting<Activations>::take();
+  const auto untagged = Counting<>::take();
+  return tagged.conversions == 1 && tagged.saturations == 1 &&
+         untagged.conversions == 1 && untagged.saturations == 0 &&
+         Counting<Activations>::take() == EventCounts{} &&
+         Counting<Activations>::counts() == EventCounts{};
+}
+
+// MX quantization counts the scaled conversions; a block with a NaN has
+// the NaN scale, and its elements dequantize as NaN inputs
+bool test_mx_counts() {
+  using Counted = Instrumented<SafeConversion>;
+  std::vector<fp32_bits> src(64 + 5, 0x3F800000u); // 1.0
+  src[1] = 0x35800000u;                            // 2^-20: underflows
+  src[2] = 0x3F8C0000u;                            // 1.09375: rounds up
+  src[40] = 0x7FC00000u;                           // NaN block
+  src[41] = 0xFF800000u;
+  const auto in = std::span<const fp32_bits>(src);
+
+  Counting<>::take();
+  const auto array = quantize<MXFP8_E4M3, fp32_e8m23, Counted>(in);
+  const auto quantized = Counting<>::take();
+  const auto reference = quantize<MXFP8_E4M3, fp32_e8m23>(in);
+
+  std::vector<fp32_bits> out(src.size());
+  array.dequantize<fp32_e8m23, Counted>(std::span<fp32_bits>(out));
+  const auto dequantized = Counting<>::take();
+
+  return std::ranges::equal(array.scales(), reference.scales()) &&
+         std::ranges::equal(array.elements(), reference.elements()) &&
+         quantized.conversions == src.size() && quantized.underflows == 1 &&
+         quantized.round_ups == 1 && quantized.nan_inputs == 1 &&
+         quantized.inf_inputs == 1 &&
+         dequantized.conversions == src.size() &&
+         dequantized.nan_inputs == 32;
+}
+
+int main() {
+  printf("=== OPINE Instrumentation Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("fp32 -> fp8_e4m3 event counts", test_fp8_counts());
+  report("fp32 <-> fp16 event counts", test_fp16_counts());
+  report("fp16 -> fp8_e4m3 results",
+         test_same_results<fp8_e4m3, fp16_e5m10, SafeConversion>());
+  report("fp16 -> fp32 results (widen)",
+         test_same_results<fp32_e8m23, fp16_e5m10, IEEEConversion>());
+  report("fp32 -> fp16 results (compute)",
+         test_same_results<fp16_e5m10, fp32_e8m23, SafeConversion>());
+  report("fp8_e4m3 -> fp8_e5m2 results (direct table)",
+         test_same_results<fp8_e5m2, fp8_e4m3, IEEEConversion>());
+  report("Counting tags and take()", test_tags());
+  report("MX quantize/dequantize counts", test_mx_counts());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
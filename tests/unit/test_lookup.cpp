@@ -0,0 +1,268 @@
+#include "float_oracle.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <opine/opine.hpp>
+#include <vector>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+
+// Padded format from test_pack_unpack.cpp: [pad:3][S:1][E:4][M:3][pad:1]
+using PaddedFormat = FormatDescriptor<1, 8, 4, 4, 3, 1, 12, true>;
+
+// Strategy selection follows max_table_bits
+static_assert(has_decode_table<fp8_e4m3, table_policies::SmallTables>);
+static_assert(!has_decode_table<fp8_e4m3, table_policies::NoTables>);
+static_assert(!has_decode_table<fp16_e5m10, table_policies::MediumTables>);
+static_assert(has_decode_table<fp16_e5m10, table_policies::LargeTables>);
+
+static_assert(detail::encode_index<fp16_e5m10, fp8_e5m2>::bits == 10);
+static_assert(detail::encode_index<fp16_e5m10, fp8_e4m3>::bits == 11);
+static_assert(detail::encode_index<fp32_e8m23, fp8_e4m3>::bits == 14);
+static_assert(has_encode_table<fp16_e5m10, fp8_e5m2>,
+              "fp16 -> fp8_e5m2 fits the default table budget");
+static_assert(!has_encode_table<fp16_e5m10, fp8_e4m3>);
+static_assert(has_encode_table<fp32_e8m23, fp8_e4m3,
+                               table_policies::LargeTables>);
+static_assert(!has_encode_table<fp8_e4m3, fp16_e5m10,
+                                table_policies::LargeTables>,
+              "Widening has no encode table (Dst range is larger)");
+
+// Test helper: the decode table must match unpack() for every encoding
+template <typename Format, typename RoundingPolicy>
+constexpr bool test_decode_table() {
+  using storage_type = typename Format::storage_type;
+  constexpr std::size_t total_values = std::size_t{1} << Format::total_bits;
+
+  for (std::size_t i = 0; i < total_values; ++i) {
+    const auto bits = static_cast<storage_type>(i);
+    const auto expected = unpack<Format, RoundingPolicy>(bits);
+    const auto actual =
+        decode<Format, RoundingPolicy, table_policies::LargeTables>(bits);
+    if (actual.sign != expected.sign || actual.exponent != expected.exponent ||
+        actual.mantissa != expected.mantissa) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static_assert(test_decode_table<fp8_e5m2, RTZ>(),
+              "fp8_e5m2: decode table must match unpack");
+static_assert(test_decode_table<fp8_e4m3, RNE>(),
+              "fp8_e4m3: decode table must match unpack");
+static_assert(test_decode_table<PaddedFormat, RTZ>(),
+              "Padded format: decode table must match unpack");
+
+// Test helper: a few known fp16 -> fp8 conversions, table and computed
+template <typename TablePolicy> constexpr bool test_encode_known_values() {
+  // 1.0 -> 1.0
+  if (encode<fp16_e5m10, fp8_e5m2, RNE, TablePolicy>(0x3C00) != 0x3C) {
+    return false;
+  }
+  // 1.375 (1.011) -> 1.5 (1.10) under RNE (G=1, S=1: round up)
+  if (encode<fp16_e5m10, fp8_e5m2, RNE, TablePolicy>(0x3D80) != 0x3E) {
+    return false;
+  }
+  // 1.625 (1.101) -> 1.5 (1.10) under RNE (tie, keep even)
+  if (encode<fp16_e5m10, fp8_e5m2, RNE, TablePolicy>(0x3E80) != 0x3E) {
+    return false;
+  }
+  // -1.875 (1.111, tie with odd LSB) -> -2.0 (carry into exponent)
+  if (encode<fp16_e5m10, fp8_e5m2, RNE, TablePolicy>(0xBF80) != 0xC0) {
+    return false;
+  }
+  // 1.875 -> 1.75 under TowardZero
+  if (encode<fp16_e5m10, fp8_e5m2, RTZ, TablePolicy>(0x3F80) != 0x3F) {
+    return false;
+  }
+  // 65504 (fp16 max) -> Inf under RNE, 57344 (max finite) under TowardZero
+  if (encode<fp16_e5m10, fp8_e5m2, RNE, TablePolicy>(0x7BFF) != 0x7C) {
+    return false;
+  }
+  if (encode<fp16_e5m10, fp8_e5m2, RTZ, TablePolicy>(0x7BFF) != 0x7B) {
+    return false;
+  }
+  // NaN -> quiet NaN, sign kept
+  if (encode<fp16_e5m10, fp8_e5m2, RNE, TablePolicy>(0xFC01) != 0xFE) {
+    return false;
+  }
+  return true;
+}
+
+static_assert(test_encode_known_values<table_policies::NoTables>(),
+              "fp16 -> fp8_e5m2 computed encode");
+static_assert(test_encode_known_values<table_policies::MediumTables>(),
+              "fp16 -> fp8_e5m2 table encode");
+
+// Test helper: encode() (table and computed) must match the oracle
+template <typename Src, typename Dst, typename RoundingPolicy,
+          typename TablePolicy>
+bool test_encode_matches_oracle(const std::vector<std::uint64_t> &values) {
+  constexpr bool nearest = std::is_same_v<RoundingPolicy, RNE>;
+
+  for (std::uint64_t value : values) {
+    const auto bits = static_cast<typename Src::storage_type>(value);
+    const auto actual = static_cast<std::uint64_t>(
+        encode<Src, Dst, RoundingPolicy, TablePolicy>(bits));
+    const auto expected =
+        oracle::round_to<Dst, nearest>(oracle::to_double<Src>(value));
+    if (actual != expected) {
+      printf("\n  mismatch: 0x%llx -> 0x%llx\n",
+             static_cast<unsigned long long>(value),
+             static_cast<unsigned long long>(actual));
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Test helper: encode_n() must match scalar encode()
+template <typename Src, typename Dst, typename RoundingPolicy,
+          typename TablePolicy>
+bool test_encode_n(const std::vector<std::uint64_t> &values) {
+  std::vector<typename Src::storage_type> src(values.begin(), values.end());
+  std::vector<typename Dst::storage_type> dst(values.size());
+
+  if (encode_n<Src, Dst, RoundingPolicy, TablePolicy>(src, dst) !=
+      values.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    if (dst[i] != encode<Src, Dst, RoundingPolicy, TablePolicy>(src[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Test helper: decode_n() must match unpack_n()
+template <typename Format, typename RoundingPolicy, typename TablePolicy>
+bool test_decode_n() {
+  using exponent_type = typename Format::exponent_type;
+  using mantissa_type = unpacked_mantissa_t<Format, RoundingPolicy>;
+  const std::size_t total_values = std::size_t{1} << Format::total_bits;
+
+  std::vector<typename Format::storage_type> bits(total_values);
+  for (std::size_t i = 0; i < total_values; ++i) {
+    bits[i] = static_cast<typename Format::storage_type>(i);
+  }
+
+  auto sign_table = std::make_unique<bool[]>(total_values);
+  auto sign_ref = std::make_unique<bool[]>(total_values);
+  std::vector<exponent_type> exp_table(total_values), exp_ref(total_values);
+  std::vector<mantissa_type> mant_table(total_values), mant_ref(total_values);
+
+  decode_n<Format, RoundingPolicy, TablePolicy>(
+      bits, {sign_table.get(), total_values}, exp_table, mant_table);
+  unpack_n<Format, RoundingPolicy>(bits, {sign_ref.get(), total_values},
+                                   exp_ref, mant_ref);
+
+  for (std::size_t i = 0; i < total_values; ++i) {
+    if (sign_table[i] != sign_ref[i] || exp_table[i] != exp_ref[i] ||
+        mant_table[i] != mant_ref[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::vector<std::uint64_t> all_fp16_values() {
+  std::vector<std::uint64_t> values(65536);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = i;
+  }
+  return values;
+}
+
+// Pseudo-random fp32 encodings, biased toward the fp8 range, plus boundaries
+std::vector<std::uint64_t> sampled_fp32_values() {
+  std::vector<std::uint64_t> values = {
+      0x00000000u, 0x80000000u, 0x00000001u, 0x007FFFFFu, 0x00800000u,
+      0x3F800000u, 0x43700000u, 0x43780000u, 0x7F7FFFFFu, 0x7F800000u,
+      0xFF800000u, 0x7FC00000u, 0xFFFFFFFFu, 0x3B000000u, 0x3A800000u};
+  std::uint32_t state = 0x2545F491u;
+  for (int i = 0; i < 200000; ++i) {
+    state = state * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    std::uint32_t bits = state;
+    if (i & 1) {
+      // Exponent within +-16 of 1.0: the interesting part of the fp8 range
+      const std::uint32_t exp = 111u + ((state >> 8) % 33u);
+      bits = (bits & 0x807FFFFFu) | (exp << 23);
+    }
+    values.push_back(bits);
+  }
+  return values;
+}
+
+int main() {
+  printf("=== OPINE Lookup Table Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  using table_policies::LargeTables;
+  using table_policies::NoTables;
+
+  report("fp8 decode tables vs unpack",
+         test_decode_table<fp8_e5m2, RTZ>() &&
+             test_decode_table<fp8_e4m3, RNE>() &&
+             test_decode_table<PaddedFormat, RTZ>());
+  report("fp16 decode table vs unpack (65536 entries)",
+         test_decode_table<fp16_e5m10, RNE>());
+  report("decode_n vs unpack_n",
+         test_decode_n<fp8_e4m3, RNE, LargeTables>() &&
+             test_decode_n<fp16_e5m10, RTZ, LargeTables>());
+
+  const auto fp16_values = all_fp16_values();
+  report("fp16 -> fp8_e5m2 RNE, table (all 65536)",
+         test_encode_matches_oracle<fp16_e5m10, fp8_e5m2, RNE, LargeTables>(
+             fp16_values));
+  report("fp16 -> fp8_e5m2 RNE, computed (all 65536)",
+         test_encode_matches_oracle<fp16_e5m10, fp8_e5m2, RNE, NoTables>(
+             fp16_values));
+  report("fp16 -> fp8_e4m3 RNE, table (all 65536)",
+         test_encode_matches_oracle<fp16_e5m10, fp8_e4m3, RNE, LargeTables>(
+             fp16_values));
+  report("fp16 -> fp8_e4m3 TowardZero, table (all 65536)",
+         test_encode_matches_oracle<fp16_e5m10, fp8_e4m3, RTZ, LargeTables>(
+             fp16_values));
+  report("fp16 -> fp8_e4m3 TowardZero, computed (all 65536)",
+         test_encode_matches_oracle<fp16_e5m10, fp8_e4m3, RTZ, NoTables>(
+             fp16_values));
+
+  const auto fp32_values = sampled_fp32_values();
+  report("fp32 -> fp8_e4m3 RNE, table (sampled)",
+         test_encode_matches_oracle<fp32_e8m23, fp8_e4m3, RNE, LargeTables>(
+             fp32_values));
+  report("fp32 -> fp8_e4m3 RNE, computed (sampled)",
+         test_encode_matches_oracle<fp32_e8m23, fp8_e4m3, RNE, NoTables>(
+             fp32_values));
+  report("fp32 -> fp8_e5m2 TowardZero, table (sampled)",
+         test_encode_matches_oracle<fp32_e8m23, fp8_e5m2, RTZ, LargeTables>(
+             fp32_values));
+  report("fp32 -> fp16_e5m10 RNE, computed (sampled)",
+         test_encode_matches_oracle<fp32_e8m23, fp16_e5m10, RNE, NoTables>(
+             fp32_values));
+
+  report("encode_n vs encode",
+         test_encode_n<fp32_e8m23, fp8_e4m3, RNE, LargeTables>(fp32_values) &&
+             test_encode_n<fp16_e5m10, fp8_e5m2, RNE, NoTables>(fp16_values));
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,261 @@
+#include "float_oracle.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <type_traits>
+#include <vector>
+
+using namespace opine;
+
+using fp32_bits = fp32_e8m23::storage_type;
+
+static_assert(MXFP8_E4M3::block_bytes == 32);
+static_assert(MXFP6_E3M2::block_bytes == 24);
+static_assert(MXFP4_E2M1::block_bytes == 16);
+static_assert(MXFP8_E4M3::element_emax == 8 && MXFP8_E5M2::element_emax == 15);
+static_assert(MXFP6_E3M2::element_emax == 4 && MXFP6_E2M3::element_emax == 2);
+static_assert(MXFP4_E2M1::element_emax == 2);
+static_assert(std::is_same_v<MXFP8_E4M3::element_format, fp8_e4m3fn> &&
+                  std::is_same_v<MXFP4_E2M1::element_format, fp4_e2m1fn>,
+              "OCP element encodings: E4M3 without Inf, FP6/FP4 all finite");
+
+// Test helper: packing a block of element encodings and unpacking it again
+// is the identity, and extract_element() agrees with unpack_elements()
+template <typename MxFormat> constexpr bool test_element_packing() {
+  using element_storage = typename MxFormat::element_format::storage_type;
+  constexpr std::size_t n = MxFormat::block_size;
+  constexpr std::uint64_t mask =
+      (std::uint64_t{1} << MxFormat::element_bits) - 1;
+
+  std::array<element_storage, n> elements{};
+  for (std::size_t i = 0; i < n; ++i) {
+    elements[i] = static_cast<element_storage>((i * 37 + 11) & mask);
+  }
+  std::array<std::uint8_t, MxFormat::block_bytes> bytes{};
+  detail::pack_elements<MxFormat>(elements, bytes);
+
+  std::array<element_storage, n> unpacked{};
+  detail::unpack_elements<MxFormat>(bytes, unpacked);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (unpacked[i] != elements[i] ||
+        detail::extract_element<MxFormat>(bytes, i) != elements[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(test_element_packing<MXFP8_E4M3>());
+static_assert(test_element_packing<MXFP6_E2M3>());
+static_assert(test_element_packing<MXFP4_E2M1>());
+static_assert(test_element_packing<MicroscalingFormat<fp6_e3m2, 4>>(),
+              "One fp6 group: 4 elements in 3 bytes");
+
+// fp6 packing is LSB first: elements 1, 2, 3, 4 -> 0x81 0x30 0x10
+constexpr bool test_fp6_layout() {
+  using Mx = MicroscalingFormat<fp6_e3m2, 4>;
+  constexpr std::array<fp6_e3m2::storage_type, 4> elements = {1, 2, 3, 4};
+  std::array<std::uint8_t, 3> bytes{};
+  detail::pack_elements<Mx>(elements, bytes);
+  return bytes[0] == 0x81 && bytes[1] == 0x30 && bytes[2] == 0x10;
+}
+
+static_assert(test_fp6_layout());
+
+// Known block scales and elements, checked at compile time
+constexpr bool test_known_values() {
+  // max |x| = 1.0: scale 2^(0 - 8) for e4m3fn, 1.0 becomes 2^8 (0x78)
+  std::array<fp32_bits, 32> values{};
+  values[0] = 0x3F800000u; // 1.0
+  values[1] = 0xBF000000u; // -0.5
+  std::array<std::uint8_t, 32> bytes{};
+  const auto span = std::span<const fp32_bits>(values);
+  auto scale = detail::quantize_block<MXFP8_E4M3, fp32_e8m23,
+                                      conversion_policies::SafeConversion>(
+      span, bytes);
+  if (scale != 119 || bytes[0] != 0x78 || bytes[1] != 0xF0 || bytes[2] != 0) {
+    return false;
+  }
+  if (detail::dequantize_element<MXFP8_E4M3, fp32_e8m23,
+                                 conversion_policies::SafeConversion>(
+          scale, 0xF0) != 0xBF000000u) {
+    return false;
+  }
+  // All-zero block: smallest scale, zero elements
+  if (detail::quantize_block<MXFP8_E4M3, fp32_e8m23,
+                             conversion_policies::SafeConversion>(
+          span.subspan(2), bytes) != 0) {
+    return false;
+  }
+  // Inf or NaN in the block: NaN scale, every element decodes to NaN
+  values[5] = 0x7F800000u;
+  scale = detail::quantize_block<MXFP4_E2M1, fp32_e8m23,
+                                 conversion_policies::SafeConversion>(
+      span, std::span<std::uint8_t, 16>(bytes.data(), 16));
+  if (scale != e8m0_nan ||
+      detail::dequantize_element<MXFP4_E2M1, fp32_e8m23,
+                                 conversion_policies::SafeConversion>(
+          scale, 0) != 0x7FC00000u) {
+    return false;
+  }
+  // A denormal maximum: 2^-149 -> scale exponent -149 - 8, clamped to -127
+  if (detail::block_scale<MXFP8_E4M3, fp32_e8m23>(0x00000001u) != 0) {
+    return false;
+  }
+  return true;
+}
+
+static_assert(test_known_values(), "Known MX scales and elements");
+
+// Pseudo-random fp32 values, with a magnitude range that varies per block
+std::vector<fp32_bits> random_tensor(std::size_t n, std::uint32_t seed) {
+  std::vector<fp32_bits> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    seed = seed * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    const std::uint32_t block_exp = 100u + (i / 32 * 7) % 50u;
+    const std::uint32_t exp = block_exp + ((seed >> 8) % 12u);
+    values[i] = (seed & 0x807FFFFFu) | (exp << 23);
+  }
+  return values;
+}
+
+// Oracle quantize + dequantize of one value: OCP scale from the block
+// maximum, element rounded to nearest and saturated, then scaled back
+template <typename MxFormat>
+float oracle_round_trip(std::span<const fp32_bits> block, fp32_bits bits) {
+  using element_format = typename MxFormat::element_format;
+  float max_abs = 0;
+  for (const auto value : block) {
+    max_abs = std::max(max_abs, std::fabs(std::bit_cast<float>(
+                                    static_cast<std::uint32_t>(value))));
+  }
+  if (max_abs == 0) {
+    return 0;
+  }
+  const int scale = std::clamp(std::ilogb(max_abs) - MxFormat::element_emax,
+                               -e8m0_bias, e8m0_bias);
+  const double x =
+      std::ldexp(std::bit_cast<float>(static_cast<std::uint32_t>(bits)),
+                 -scale);
+  std::uint64_t element = oracle::round_to<element_format, true>(x);
+  const std::uint64_t inf = ((std::uint64_t{1} << element_format::exp_bits) -
+                             1)
+                            << element_format::exp_offset;
+  // Overflow is Inf, or NaN for elements without Inf (e4m3fn): saturate
+  const bool overflow =
+      element_format::special_values::has_infinity
+          ? (element & ~(std::uint64_t{1} << element_format::sign_offset)) ==
+                inf
+          : oracle::is_nan<element_format>(element);
+  if (overflow) {
+    element -= 1;
+  }
+  return static_cast<float>(
+      std::ldexp(oracle::to_double<element_format>(element), scale));
+}
+
+// Test helper: quantize, then get(), dequantize() and blocks() must all give
+// the oracle's values
+template <typename MxFormat> bool test_round_trip_matches_oracle() {
+  for (std::size_t n : {1, 31, 32, 33, 1000}) {
+    const auto values = random_tensor(n, static_cast<std::uint32_t>(n));
+    const auto array = quantize<MxFormat, fp32_e8m23>(
+        std::span<const fp32_bits>(values));
+
+    std::vector<fp32_bits> decoded(n);
+    if (array.size() != n ||
+        array.template dequantize<fp32_e8m23>(std::span(decoded)) != n) {
+      return false;
+    }
+    std::vector<fp32_bits> streamed;
+    for (const auto block : array.template blocks<fp32_e8m23>()) {
+      streamed.insert(streamed.end(), block.begin(), block.end());
+    }
+    if (streamed != decoded) {
+      return false;
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+      const std::size_t first = i / 32 * 32;
+      const auto block = std::span<const fp32_bits>(values).subspan(
+          first, std::min<std::size_t>(32, n - first));
+      const float expected = oracle_round_trip<MxFormat>(block, values[i]);
+      const auto actual = array.template get<fp32_e8m23>(i);
+      if (actual != decoded[i] ||
+          std::bit_cast<float>(static_cast<std::uint32_t>(actual)) !=
+              expected) {
+        printf("\n  mismatch at %zu (n = %zu): 0x%08x -> %g (want %g)\n", i,
+               n, static_cast<std::uint32_t>(values[i]),
+               std::bit_cast<float>(static_cast<std::uint32_t>(actual)),
+               expected);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Test helper: quantizing disjoint block ranges separately (as threads
+// would) gives the same encoding as quantizing the whole array
+bool test_block_ranges() {
+  const auto values = random_tensor(1000, 7);
+  const auto src = std::span<const fp32_bits>(values);
+  const auto whole = quantize<MXFP6_E2M3, fp32_e8m23>(src);
+
+  MicroscaledArray<MXFP6_E2M3> parts(values.size());
+  parts.quantize_blocks<fp32_e8m23>(src, 20, 100);
+  parts.quantize_blocks<fp32_e8m23>(src, 0, 20);
+
+  return std::ranges::equal(whole.scales(), parts.scales()) &&
+         std::ranges::equal(whole.elements(), parts.elements());
+}
+
+// Test helper: buffers are cache-line aligned and padded to whole blocks
+bool test_layout() {
+  MicroscaledArray<MXFP4_E2M1> array(100);
+  const auto scales = reinterpret_cast<std::uintptr_t>(array.scales().data());
+  const auto elements =
+      reinterpret_cast<std::uintptr_t>(array.elements().data());
+  return scales % cache_line_size == 0 && elements % cache_line_size == 0 &&
+         array.block_count() == 4 && array.scales().size() == 4 &&
+         array.elements().size() == 4 * 16 && array.block_length(3) == 4;
+}
+
+int main() {
+  printf("=== OPINE Microscaling Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("Element packing (8, 6, 4 bits)",
+         test_element_packing<MXFP8_E4M3>() &&
+             test_element_packing<MXFP6_E3M2>() &&
+             test_element_packing<MXFP4_E2M1>() && test_fp6_layout());
+  report("Known values", test_known_values());
+  report("MXFP8_E4M3 round trip vs oracle",
+         test_round_trip_matches_oracle<MXFP8_E4M3>());
+  report("MXFP8_E5M2 round trip vs oracle",
+         test_round_trip_matches_oracle<MXFP8_E5M2>());
+  report("MXFP6_E3M2 round trip vs oracle",
+         test_round_trip_matches_oracle<MXFP6_E3M2>());
+  report("MXFP6_E2M3 round trip vs oracle",
+         test_round_trip_matches_oracle<MXFP6_E2M3>());
+  report("MXFP4_E2M1 round trip vs oracle",
+         test_round_trip_matches_oracle<MXFP4_E2M1>());
+  report("Block ranges", test_block_ranges());
+  report("Layout", test_layout());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
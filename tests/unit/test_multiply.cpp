@@ -0,0 +1,257 @@
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+using multiply_policies::HardwareMultiply;
+using multiply_policies::SoftwareMultiply;
+using multiply_policies::SoftwareMultiplyNoTables;
+
+// Strategy selection: hardware first, then a table within the budget, then
+// shift-and-add (three-shift for multipliers wider than a byte)
+static_assert(multiply_strategy<27, 27, HardwareMultiply> ==
+              MultiplyStrategy::Hardware);
+static_assert(multiply_strategy<3, 3, HardwareMultiply> ==
+                  MultiplyStrategy::Hardware,
+              "A multiply instruction beats a table load");
+static_assert(multiply_strategy<3, 3, SoftwareMultiply> ==
+                  MultiplyStrategy::Table,
+              "fp8_e5m2, TowardZero: 64-entry table");
+static_assert(multiply_strategy<4, 4, SoftwareMultiply> ==
+                  MultiplyStrategy::Table,
+              "fp8_e4m3, TowardZero: 256-entry table");
+static_assert(multiply_strategy<6, 6, SoftwareMultiply> ==
+              MultiplyStrategy::ShiftAdd);
+static_assert(multiply_strategy<24, 24, SoftwareMultiply> ==
+                  MultiplyStrategy::ThreeShift,
+              "fp32, TowardZero: 24-bit significands");
+static_assert(multiply_strategy<3, 3, SoftwareMultiplyNoTables> ==
+              MultiplyStrategy::ShiftAdd);
+static_assert(multiply_strategy<6, 6,
+                                multiply_policies::Multiplier<
+                                    false, table_policies::LargeTables>> ==
+              MultiplyStrategy::Table);
+
+// The 3x3-bit table is the one in design.md: 64 bytes, a * b at (a << 3) | b
+static_assert(detail::multiply_table<3, 3>.size() == 64);
+static_assert(sizeof(detail::multiply_table<3, 3>) == 64);
+static_assert(detail::multiply_table<3, 3>[(5 << 3) | 6] == 30);
+static_assert(detail::multiply_table<3, 3>[(7 << 3) | 7] == 49);
+
+// Test helper: a strategy must give the exact product of every pair of
+// A-bit and B-bit operands
+template <int BitsA, int BitsB, MultiplyStrategy Strategy,
+          typename TypePolicy = DefaultTypeSelectionPolicy>
+constexpr bool test_exhaustive() {
+  using type_policy = TypePolicy;
+  for (std::uint64_t a = 0; a < (std::uint64_t{1} << BitsA); ++a) {
+    for (std::uint64_t b = 0; b < (std::uint64_t{1} << BitsB); ++b) {
+      const auto product =
+          detail::multiply_integers<BitsA, BitsB, SoftwareMultiply,
+                                    type_policy, Strategy>(
+              static_cast<uint_t<BitsA, type_policy>>(a),
+              static_cast<uint_t<BitsB, type_policy>>(b));
+      if (static_cast<std::uint64_t>(product) != a * b) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static_assert(test_exhaustive<3, 3, MultiplyStrategy::Table>());
+static_assert(test_exhaustive<4, 4, MultiplyStrategy::Table>());
+static_assert(test_exhaustive<3, 5, MultiplyStrategy::Table>());
+static_assert(test_exhaustive<4, 4, MultiplyStrategy::ShiftAdd>());
+static_assert(test_exhaustive<4, 4, MultiplyStrategy::ThreeShift>());
+static_assert(test_exhaustive<5, 3, MultiplyStrategy::ThreeShift>());
+
+// Limbed type policies: three-shift one multiplier limb at a time, with a
+// partial last limb
+using NibbleLimbs = type_policies::LimbWidth<4>;
+using type_policies::ByteLimbs;
+static_assert(test_exhaustive<4, 6, MultiplyStrategy::ThreeShift,
+                              NibbleLimbs>());
+static_assert(detail::limb_three_shift_multiply<24, 24, ByteLimbs>(
+                  0xFFFFFF, 0xFFFFFF) == 0xFFFFFE000001u);
+
+// Test helper: shift-and-add strategies on pseudo-random wide operands,
+// including the largest ones (the three-shift carry)
+template <int BitsA, int BitsB, MultiplyStrategy Strategy,
+          typename TypePolicy = DefaultTypeSelectionPolicy>
+bool test_wide_operands() {
+  using type_policy = TypePolicy;
+  constexpr std::uint64_t max_a = (std::uint64_t{1} << BitsA) - 1;
+  constexpr std::uint64_t max_b = (std::uint64_t{1} << BitsB) - 1;
+
+  std::uint64_t state = 0x9E3779B97F4A7C15u;
+  for (int i = 0; i < 100000; ++i) {
+    state = state * 6364136223846793005u + 1442695040888963407u; // PCG LCG
+    const std::uint64_t a = i == 0 ? max_a : (state >> 11) & max_a;
+    const std::uint64_t b = i == 0 ? max_b : (state >> 33) & max_b;
+    const auto product =
+        detail::multiply_integers<BitsA, BitsB, SoftwareMultiply, type_policy,
+                                  Strategy>(
+            static_cast<uint_t<BitsA, type_policy>>(a),
+            static_cast<uint_t<BitsB, type_policy>>(b));
+    if (static_cast<std::uint64_t>(product) != a * b) {
+      printf("\n  %llu * %llu\n", static_cast<unsigned long long>(a),
+             static_cast<unsigned long long>(b));
+      return false;
+    }
+  }
+  return true;
+}
+
+// Test helper: multiply() and fma() must give identical results under every
+// multiply policy, for all pairs of fp8 values (fma with a few addends)
+template <typename Format, typename RoundingPolicy, typename MultiplyPolicy>
+bool test_arithmetic_matches_hardware() {
+  using unpacked_type = UnpackedFloat<Format, RoundingPolicy>;
+  using storage_type = typename Format::storage_type;
+  auto same = [](const unpacked_type &x, const unpacked_type &y) {
+    return x.sign == y.sign && x.exponent == y.exponent &&
+           x.mantissa == y.mantissa;
+  };
+
+  for (unsigned i = 0; i < 256; ++i) {
+    const auto a =
+        unpack<Format, RoundingPolicy>(static_cast<storage_type>(i));
+    for (unsigned j = 0; j < 256; ++j) {
+      const auto b =
+          unpack<Format, RoundingPolicy>(static_cast<storage_type>(j));
+      if (!same(multiply<Format, RoundingPolicy, MultiplyPolicy>(a, b),
+                multiply<Format, RoundingPolicy, HardwareMultiply>(a, b))) {
+        return false;
+      }
+      const auto c = unpack<Format, RoundingPolicy>(
+          static_cast<storage_type>((i * 31 + j * 17) & 0xFF));
+      if (!same(fma<Format, RoundingPolicy, MultiplyPolicy>(a, b, c),
+                fma<Format, RoundingPolicy, HardwareMultiply>(a, b, c))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Chained results keep guard bits: the software strategies must handle
+// nonzero guard bits too (fp32 with RNE, 27-bit significands)
+bool test_fp32_unrounded_chain() {
+  using unpacked_type = UnpackedFloat<fp32_e8m23, RNE>;
+  using storage_type = fp32_e8m23::storage_type;
+  auto same = [](const unpacked_type &x, const unpacked_type &y) {
+    return x.sign == y.sign && x.exponent == y.exponent &&
+           x.mantissa == y.mantissa;
+  };
+
+  std::uint32_t state = 12345;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    const auto a = unpack<fp32_e8m23, RNE>(
+        static_cast<storage_type>((state & 0x807FFFFFu) | (100u << 23)));
+    state = state * 1664525u + 1013904223u;
+    const auto b = unpack<fp32_e8m23, RNE>(
+        static_cast<storage_type>((state & 0x807FFFFFu) | (140u << 23)));
+
+    const auto product = multiply<fp32_e8m23, RNE, HardwareMultiply>(a, b);
+    if (!same(multiply<fp32_e8m23, RNE, SoftwareMultiply>(product, a),
+              multiply<fp32_e8m23, RNE, HardwareMultiply>(product, a)) ||
+        !same(
+            multiply<fp32_e8m23, RNE, SoftwareMultiplyNoTables>(product, b),
+            multiply<fp32_e8m23, RNE, HardwareMultiply>(product, b))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// fp32 in byte limbs (24-bit significands in three bytes, three-shift by
+// limbs): the same encodings as the default type policy
+bool test_fp32_byte_limbs() {
+  using LimbFormat = IEEE_Format<8, 23, type_policies::ByteLimbs>;
+  using limb_storage = LimbFormat::storage_type;
+  using storage_type = fp32_e8m23::storage_type;
+  static_assert(type_policies::limb_count<
+                    UnpackedFloat<LimbFormat, RTZ>::mantissa_bits,
+                    type_policies::ByteLimbs> == 3);
+
+  std::uint32_t state = 777;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    const std::uint32_t x = (state & 0x807FFFFFu) | ((100u + i % 50) << 23);
+    state = state * 1664525u + 1013904223u;
+    const std::uint32_t y = (state & 0x807FFFFFu) | ((90u + i % 70) << 23);
+
+    const auto a = unpack<LimbFormat, RNE>(static_cast<limb_storage>(x));
+    const auto b = unpack<LimbFormat, RNE>(static_cast<limb_storage>(y));
+    const auto ra = unpack<fp32_e8m23, RNE>(static_cast<storage_type>(x));
+    const auto rb = unpack<fp32_e8m23, RNE>(static_cast<storage_type>(y));
+    auto same = [](auto result, auto expected) {
+      return static_cast<std::uint32_t>(pack(result)) ==
+             static_cast<std::uint32_t>(pack(expected));
+    };
+    if (!same(multiply<LimbFormat, RNE, SoftwareMultiply>(a, b),
+              multiply<fp32_e8m23, RNE, HardwareMultiply>(ra, rb)) ||
+        !same(fma<LimbFormat, RNE, SoftwareMultiply>(a, b, a),
+              fma<fp32_e8m23, RNE, HardwareMultiply>(ra, rb, ra)) ||
+        !same(add(a, b), add(ra, rb))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  printf("=== OPINE Multiply Strategy Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("Tables (3x3, 4x4, 3x5 exhaustive)",
+         test_exhaustive<3, 3, MultiplyStrategy::Table>() &&
+             test_exhaustive<4, 4, MultiplyStrategy::Table>() &&
+             test_exhaustive<3, 5, MultiplyStrategy::Table>());
+  report("Shift-add (8x8 exhaustive)",
+         test_exhaustive<8, 8, MultiplyStrategy::ShiftAdd>());
+  report("Three-shift (8x8 exhaustive)",
+         test_exhaustive<8, 8, MultiplyStrategy::ThreeShift>());
+  report("Shift-add 27x27",
+         test_wide_operands<27, 27, MultiplyStrategy::ShiftAdd>());
+  report("Three-shift 24x24",
+         test_wide_operands<24, 24, MultiplyStrategy::ThreeShift>());
+  report("Three-shift 27x27",
+         test_wide_operands<27, 27, MultiplyStrategy::ThreeShift>());
+  report("Three-shift by nibble limbs (8x8 exhaustive)",
+         test_exhaustive<8, 8, MultiplyStrategy::ThreeShift, NibbleLimbs>());
+  report("Three-shift by byte limbs 24x24, 27x27",
+         test_wide_operands<24, 24, MultiplyStrategy::ThreeShift,
+                            ByteLimbs>() &&
+             test_wide_operands<27, 27, MultiplyStrategy::ThreeShift,
+                                ByteLimbs>());
+  report("fp8_e5m2 TowardZero, software (table)",
+         test_arithmetic_matches_hardware<fp8_e5m2, RTZ, SoftwareMultiply>());
+  report("fp8_e4m3 TowardZero, software (table)",
+         test_arithmetic_matches_hardware<fp8_e4m3, RTZ, SoftwareMultiply>());
+  report("fp8_e5m2 RNE, software (shift-add)",
+         test_arithmetic_matches_hardware<fp8_e5m2, RNE, SoftwareMultiply>());
+  report("fp8_e4m3 RNE, software without tables",
+         test_arithmetic_matches_hardware<fp8_e4m3, RNE,
+                                          SoftwareMultiplyNoTables>());
+  report("fp32 RNE unrounded chains, software",
+         test_fp32_unrounded_chain());
+  report("fp32 RNE in byte limbs, software", test_fp32_byte_limbs());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,247 @@
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <opine/platforms/native/arithmetic.hpp>
+#include <opine/platforms/native/convert.hpp>
+#include <opine/policies/platform.hpp>
+#include <span>
+#include <vector>
+
+using namespace opine;
+using namespace opine::conversion_policies;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+using RUP = rounding_policies::TowardPositive;
+using RDN = rounding_policies::TowardNegative;
+using RNA = rounding_policies::ToNearestTiesAwayFromZero;
+using Full = denormal_policies::FullSupport;
+using FTZ = denormal_policies::FlushToZero;
+
+using platform_policies::CompileTime;
+using platform_policies::Generic;
+using platform_policies::RuntimeDetect;
+
+using fp16_bits = fp16_e5m10::storage_type;
+using fp32_bits = fp32_e8m23::storage_type;
+
+// Which configurations have native paths
+static_assert(platform_policies::PlatformPolicy<Generic> &&
+              platform_policies::PlatformPolicy<CompileTime> &&
+              platform_policies::PlatformPolicy<RuntimeDetect>);
+static_assert(!native::has_native_conversion<fp8_e4m3, fp32_e8m23>);
+static_assert(!native::has_native_conversion<fp16_e5m10, fp16_e5m10>);
+static_assert(!native::has_native_conversion<fp32_e8m23, fp16_e5m10,
+                                             Conversion<RNA, false>>);
+static_assert(!native::has_native_conversion<fp32_e8m23, fp16_e5m10,
+                                             Instrumented<IEEEConversion>>);
+static_assert(!native::has_native_conversion<fp16_e5m10, fp32_e8m23,
+                                             Instrumented<IEEEConversion>>);
+static_assert(!native::has_native_arithmetic<fp8_e5m2, RNE, Full>);
+static_assert(!native::has_native_arithmetic<fp16_e5m10, RNE, FTZ>);
+static_assert(!native::has_native_arithmetic<fp16_e5m10, RNA, Full>);
+static_assert(!native::has_native_arithmetic<
+              fp16_e5m10, rounding_policies::Stochastic<>, Full>);
+#if defined(OPINE_NATIVE_X86_KERNELS) || defined(OPINE_NATIVE_ARM_KERNELS)
+static_assert(native::has_native_conversion<fp16_e5m10, fp32_e8m23>);
+static_assert(
+    native::has_native_conversion<fp32_e8m23, fp16_e5m10, IEEEConversion>);
+static_assert(native::has_native_arithmetic<fp16_e5m10, RNE, Full>);
+#endif
+
+// Constant evaluation takes the generic path. main() calls it at run time
+// too, so the buffers hold a whole AVX512FP16 vector: GCC otherwise warns
+// about the kernels' vector loads (-Warray-bounds).
+constexpr bool test_constexpr() {
+  constexpr std::array<fp16_bits, 32> a = {0x3C00, 0x4000, 0x7C00};
+  constexpr std::array<fp16_bits, 32> b = {0x3C00, 0x4200, 0x3C00};
+  std::array<fp16_bits, 32> sum{};
+  std::array<fp32_bits, 32> wide{};
+  native::add_n<fp16_e5m10, RNE, Full>(std::span<const fp16_bits>(a),
+                                       std::span<const fp16_bits>(b),
+                                       std::span<fp16_bits>(sum));
+  native::convert_n<fp32_e8m23, fp16_e5m10>(std::span<const fp16_bits>(a),
+                                            std::span<fp32_bits>(wide));
+  return sum[0] == 0x4000 && sum[1] == 0x4500 && sum[2] == 0x7C00 &&
+         sum[31] == 0 && wide[0] == 0x3F800000u && wide[2] == 0x7F800000u &&
+         wide[31] == 0;
+}
+static_assert(test_constexpr(), "Constant-evaluated native paths");
+
+// Every fp16 encoding widened, and fp32 encodings at every fp16 rounding
+// boundary, in the fp16 range, near overflow, and at random, narrowed:
+// the same bits under every platform policy
+template <typename ConversionPolicy> bool test_convert() {
+  std::vector<fp16_bits> halves(65536 + 13);
+  for (std::size_t i = 0; i < halves.size(); ++i) {
+    halves[i] = static_cast<fp16_bits>(i & 0xFFFF);
+  }
+  std::vector<fp32_bits> floats;
+  std::uint32_t seed = 1;
+  for (std::uint32_t top = 0; top < 0x10000; ++top) {
+    for (std::uint32_t low : {0x0000u, 0x1000u, 0x0FFFu, 0x1001u}) {
+      floats.push_back(top << 16 | low);
+      floats.push_back((top << 13 | low) ^ 0x38000000u);
+    }
+    seed = seed * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    floats.push_back(seed);
+  }
+  floats.resize(floats.size() + 5, 0x477FF000u); // 65520: ties to Inf
+
+  auto widen = [&]<typename PlatformPolicy>() {
+    std::vector<fp32_bits> out(halves.size());
+    native::convert_n<fp32_e8m23, fp16_e5m10, ConversionPolicy,
+                      table_policies::DefaultTablePolicy, PlatformPolicy>(
+        std::span<const fp16_bits>(halves), std::span<fp32_bits>(out));
+    return out;
+  };
+  auto narrow = [&]<typename PlatformPolicy>() {
+    std::vector<fp16_bits> out(floats.size());
+    native::convert_n<fp16_e5m10, fp32_e8m23, ConversionPolicy,
+                      table_policies::DefaultTablePolicy, PlatformPolicy>(
+        std::span<const fp32_bits>(floats), std::span<fp16_bits>(out));
+    return out;
+  };
+
+  const auto wide = widen.template operator()<Generic>();
+  const auto narrowed = narrow.template operator()<Generic>();
+  std::vector<fp32_bits> reference(halves.size());
+  opine::convert_n<fp32_e8m23, fp16_e5m10, ConversionPolicy>(
+      std::span<const fp16_bits>(halves), std::span<fp32_bits>(reference));
+  return wide == reference &&
+         widen.template operator()<CompileTime>() == wide &&
+         widen.template operator()<RuntimeDetect>() == wide &&
+         narrow.template operator()<CompileTime>() == narrowed &&
+         narrow.template operator()<RuntimeDetect>() == narrowed;
+}
+
+// Pseudo-random fp16 encodings, with every class (NaN, Inf, denormal) and
+// a tail that is not a whole register
+std::vector<fp16_bits> random_halves(std::size_t n, std::uint32_t seed) {
+  std::vector<fp16_bits> values(n);
+  for (auto &value : values) {
+    seed = seed * 1664525u + 1013904223u;
+    value = static_cast<fp16_bits>(seed >> 16);
+  }
+  return values;
+}
+
+// The five operations under every platform policy against Generic
+template <typename RoundingPolicy, typename DenormalPolicy>
+bool test_arithmetic() {
+  constexpr std::size_t n = (1 << 16) + 37;
+  const auto a = random_halves(n, 1);
+  const auto b = random_halves(n, 2);
+  auto c = random_halves(n, 3);
+  // Cancellation in fma: c = -(a * b) rounded
+  for (std::size_t i = 0; i < n; i += 7) {
+    c[i] = static_cast<fp16_bits>(
+        pack(multiply(unpack<fp16_e5m10, RoundingPolicy>(a[i]),
+                      unpack<fp16_e5m10, RoundingPolicy>(b[i]))) ^
+        0x8000);
+  }
+  const auto sa = std::span<const fp16_bits>(a);
+  const auto sb = std::span<const fp16_bits>(b);
+  const auto sc = std::span<const fp16_bits>(c);
+
+  auto run = [&]<typename PlatformPolicy>() {
+    using F = fp16_e5m10;
+    using R = RoundingPolicy;
+    using D = DenormalPolicy;
+    using P = PlatformPolicy;
+    std::array<std::vector<fp16_bits>, 5> out;
+    for (auto &results : out) {
+      results.assign(n, 0);
+    }
+    native::add_n<F, R, D, P>(sa, sb, std::span<fp16_bits>(out[0]));
+    native::subtract_n<F, R, D, P>(sa, sb, std::span<fp16_bits>(out[1]));
+    native::multiply_n<F, R, D, P>(sa, sb, std::span<fp16_bits>(out[2]));
+    native::divide_n<F, R, D, P>(sa, sb, std::span<fp16_bits>(out[3]));
+    native::fma_n<F, R, D, P>(sa, sb, sc, std::span<fp16_bits>(out[4]));
+    return out;
+  };
+
+  const auto reference = run.template operator()<Generic>();
+  // Generic is unpack, the opine:: operation and pack
+  for (std::size_t i = 0; i < n; i += 101) {
+    const auto x = unpack<fp16_e5m10, RoundingPolicy, DenormalPolicy>(a[i]);
+    const auto y = unpack<fp16_e5m10, RoundingPolicy, DenormalPolicy>(b[i]);
+    const auto z = unpack<fp16_e5m10, RoundingPolicy, DenormalPolicy>(c[i]);
+    if (reference[0][i] != pack(add(x, y)) ||
+        reference[2][i] != pack(multiply(x, y)) ||
+        reference[4][i] != pack(fma(x, y, z))) {
+      printf("\n  generic mismatch at %zu\n", i);
+      return false;
+    }
+  }
+  return run.template operator()<CompileTime>() == reference &&
+         run.template operator()<RuntimeDetect>() == reference;
+}
+
+// Shorter spans than a register, and mismatched span sizes
+bool test_lengths() {
+  const auto a = random_halves(100, 5);
+  const auto b = random_halves(100, 6);
+  for (std::size_t n = 0; n <= 70; ++n) {
+    std::vector<fp16_bits> expected(n + 1, 0xBEEF);
+    std::vector<fp16_bits> actual(n + 1, 0xBEEF);
+    const auto sa = std::span<const fp16_bits>(a).first(n);
+    const auto sb = std::span<const fp16_bits>(b);
+    if (native::multiply_n<fp16_e5m10, RNE, Full, Generic>(
+            sa, sb, std::span<fp16_bits>(expected).first(n)) != n ||
+        native::multiply_n<fp16_e5m10, RNE, Full, RuntimeDetect>(
+            sa, sb, std::span<fp16_bits>(actual)) != n ||
+        actual != expected) {
+      return false;
+    }
+    std::vector<fp32_bits> wide(n + 1, 0xBEEF);
+    if (native::convert_n<fp32_e8m23, fp16_e5m10, SafeConversion,
+                          table_policies::DefaultTablePolicy, RuntimeDetect>(
+            sa, std::span<fp32_bits>(wide).first(n)) != n ||
+        wide[n] != 0xBEEF) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  printf("=== OPINE Native Path Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  using native::Feature;
+  printf("Compiled for F16C %d, AVX512FP16 %d; CPU has F16C %d, "
+         "AVX512FP16 %d\n\n",
+         native::compiled_for(Feature::F16C),
+         native::compiled_for(Feature::AVX512FP16),
+         native::cpu_supports(Feature::F16C),
+         native::cpu_supports(Feature::AVX512FP16));
+
+  report("Constant evaluation", test_constexpr());
+  report("Convert IEEEConversion", test_convert<IEEEConversion>());
+  report("Convert SafeConversion", test_convert<SafeConversion>());
+  report("Convert FastConversion", test_convert<FastConversion>());
+  report("Convert RUP saturating", test_convert<Conversion<RUP, true>>());
+  report("Convert RDN", test_convert<Conversion<RDN, false>>());
+  report("Convert RNA (generic)", test_convert<Conversion<RNA, false>>());
+  report("Arithmetic RNE", test_arithmetic<RNE, Full>());
+  report("Arithmetic RTZ", test_arithmetic<RTZ, Full>());
+  report("Arithmetic RUP", test_arithmetic<RUP, Full>());
+  report("Arithmetic RDN", test_arithmetic<RDN, Full>());
+  report("Arithmetic RNA (generic)", test_arithmetic<RNA, Full>());
+  report("Arithmetic FlushToZero (generic)", test_arithmetic<RNE, FTZ>());
+  report("Span lengths", test_lengths());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <opine/platforms/simd/order.hpp>
+#include <vector>
+
+using namespace opine;
+
+// Padded format from test_pack_unpack.cpp: [pad:3][S:1][E:4][M:3][pad:1]
+using PaddedFormat = FormatDescriptor<1, 8, 4, 4, 3, 1, 12, true>;
+
+// Keys follow the IEEE 754 total order: -NaN < -Inf < -0 < +0 < +Inf < +NaN
+static_assert(order_key<fp8_e5m2>(0x80) + 1 == order_key<fp8_e5m2>(0x00));
+static_assert(order_key<fp8_e5m2>(0xFC) < order_key<fp8_e5m2>(0x80));
+static_assert(order_key<fp8_e5m2>(0xFF) < order_key<fp8_e5m2>(0xFC));
+static_assert(order_key<fp8_e5m2>(0x7C) < order_key<fp8_e5m2>(0x7D));
+static_assert(!is_ordered_key<fp8_e5m2>(order_key<fp8_e5m2>(0x7D)) &&
+              is_ordered_key<fp8_e5m2>(order_key<fp8_e5m2>(0xFC)));
+static_assert(std::is_same_v<order_key_t<PaddedFormat>, std::uint8_t>);
+
+// FNUZ: the NaN (the -0 encoding) is key 0, -largest key 1, +0 halfway
+static_assert(order_key<fp8_e4m3fnuz>(0x80) == 0);
+static_assert(order_key<fp8_e4m3fnuz>(0xFF) == 1);
+static_assert(order_key<fp8_e4m3fnuz>(0x00) == 0x80);
+static_assert(from_order_key<fp8_e4m3fnuz>(0) == 0x80);
+
+// No NaN: every key is a number
+static_assert(is_ordered_key<fp6_e3m2fn>(0) && is_ordered_key<fp6_e3m2fn>(63));
+
+// The scalar functions are usable in constant expressions
+constexpr bool test_constexpr_order() {
+  //                   1.0   -2.0  NaN   +Inf  -0    +0    1.0
+  std::array<std::uint8_t, 7> bits = {0x3C, 0xC0, 0x7E, 0x7C,
+                                      0x80, 0x00, 0x3C};
+  std::array<std::size_t, 3> top{};
+  const bool top_ok = top_k_n<fp8_e5m2>(bits, top) == 3 && top[0] == 3 &&
+                      top[1] == 0 && top[2] == 6;
+  return argmax_n<fp8_e5m2>(bits) == 3 && argmin_n<fp8_e5m2>(bits) == 1 &&
+         max_n<fp8_e5m2>(std::span(bits).first(2)) == 0x3C &&
+         from_order_key<PaddedFormat>(order_key<PaddedFormat>(0x1FE)) ==
+             0x1FE &&
+         top_ok;
+}
+static_assert(test_constexpr_order(), "Ordering in constexpr");
+
+// Reference order: compare() on unpacked values, with -0 below +0
+template <typename Format> bool total_less(unsigned a, unsigned b) {
+  using storage_type = typename Format::storage_type;
+  const auto ua = unpack<Format>(static_cast<storage_type>(a));
+  const auto ub = unpack<Format>(static_cast<storage_type>(b));
+  const auto order = compare(ua, ub);
+  return order == std::partial_ordering::less ||
+         (order == std::partial_ordering::equivalent && ua.sign && !ub.sign);
+}
+
+template <typename Format> bool is_nan_bits(unsigned bits) {
+  using storage_type = typename Format::storage_type;
+  return is_nan(unpack<Format>(static_cast<storage_type>(bits)));
+}
+
+// Every pair of encodings: keys order numbers as compare() does, NaNs are
+// outside the ordered range on the side of their sign, and the key map is a
+// bijection that from_order_key() inverts
+template <typename Format> bool test_key_order() {
+  using storage_type = typename Format::storage_type;
+  constexpr int value_bits = 1 + Format::exp_bits + Format::mant_bits;
+  std::vector<storage_type> encodings;
+  for (unsigned i = 0; i < (1u << Format::total_bits); ++i) {
+    const auto bits = static_cast<storage_type>(i);
+    const auto canonical = from_order_key<Format>(order_key<Format>(bits));
+    if (canonical == bits) {
+      encodings.push_back(bits);
+    }
+  }
+  if (encodings.size() != (std::size_t{1} << value_bits)) {
+    return false;
+  }
+
+  std::vector<order_key_t<Format>> keys(encodings.size());
+  order_keys_n<Format>(encodings, keys);
+  std::vector<order_key_t<Format>> sorted = keys;
+  std::sort(sorted.begin(), sorted.end());
+  if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < encodings.size(); ++i) {
+    const bool nan = is_nan_bits<Format>(encodings[i]);
+    if (is_ordered_key<Format>(keys[i]) == nan) {
+      return false;
+    }
+    if (nan) {
+      const bool sign = unpack<Format>(encodings[i]).sign;
+      if (sign ? keys[i] >= detail::smallest_ordered_key<Format>
+               : keys[i] <= detail::largest_ordered_key<Format>) {
+        return false;
+      }
+      continue;
+    }
+    for (std::size_t j = 0; j < encodings.size(); ++j) {
+      if (is_nan_bits<Format>(encodings[j])) {
+        continue;
+      }
+      if ((keys[i] < keys[j]) !=
+          total_less<Format>(encodings[i], encodings[j])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Pseudo-random encodings, NaNs and padding bits included
+template <typename Format>
+std::vector<typename Format::storage_type> random_values(std::size_t n,
+                                                         std::uint32_t seed) {
+  using storage_type = typename Format::storage_type;
+  constexpr auto mask =
+      static_cast<std::uint64_t>(std::uint64_t{1} << Format::total_bits) - 1;
+  std::vector<storage_type> values(n);
+  std::uint64_t state = seed;
+  for (auto &value : values) {
+    state = state * 6364136223846793005u + 1442695040888963407u; // Knuth
+    value = static_cast<storage_type>((state >> 24) & mask);
+  }
+  return values;
+}
+
+// Reductions, clamp and top-k, opine:: and simd::, against the reference
+// order, at lengths around multiples of the vector width
+template <typename Format> bool test_reductions() {
+  using storage_type = typename Format::storage_type;
+  constexpr std::size_t lanes = simd::order_lanes<Format>;
+  const std::size_t lengths[] = {0, 1, 2, lanes - 1, lanes, lanes + 1,
+                                 3 * lanes + 5, 1000};
+
+  std::uint32_t seed = 1;
+  for (std::size_t length : lengths) {
+    for (int round = 0; round < 20; ++round) {
+      const auto values = random_values<Format>(length, seed++);
+      std::span<const storage_type> bits(values);
+
+      // Reference: stable sort of the numbers, largest first
+      std::vector<std::size_t> order;
+      for (std::size_t i = 0; i < length; ++i) {
+        if (!is_nan_bits<Format>(values[i])) {
+          order.push_back(i);
+        }
+      }
+      std::stable_sort(order.begin(), order.end(),
+                       [&](std::size_t a, std::size_t b) {
+                         return total_less<Format>(values[b], values[a]);
+                       });
+      std::size_t first_min = length;
+      for (std::size_t i = 0; i < length && !order.empty(); ++i) {
+        const auto smallest = values[order.back()];
+        if (!is_nan_bits<Format>(values[i]) &&
+            !total_less<Format>(values[i], smallest) &&
+            !total_less<Format>(smallest, values[i])) {
+          first_min = i;
+          break;
+        }
+      }
+      const std::size_t max_index = order.empty() ? length : order.front();
+
+      if (argmax_n<Format>(bits) != max_index ||
+          simd::argmax_n<Format>(bits) != max_index ||
+          argmin_n<Format>(bits) != first_min ||
+          simd::argmin_n<Format>(bits) != first_min) {
+        return false;
+      }
+      if (max_n<Format>(bits) != simd::max_n<Format>(bits) ||
+          min_n<Format>(bits) != simd::min_n<Format>(bits)) {
+        return false;
+      }
+
+      for (std::size_t k : {std::size_t{1}, std::size_t{5}, length + 1}) {
+        std::vector<std::size_t> top(k), top_simd(k);
+        const std::size_t count = top_k_n<Format>(bits, top);
+        const std::size_t count_simd = simd::top_k_n<Format>(bits, top_simd);
+        const std::size_t expected = std::min(k, order.size());
+        if (count != expected || count_simd != expected ||
+            !std::equal(top.begin(), top.begin() + count, order.begin()) ||
+            !std::equal(top_simd.begin(), top_simd.begin() + count,
+                        order.begin())) {
+          return false;
+        }
+      }
+
+      if (order.size() >= 2) {
+        const auto hi = values[order[order.size() / 4]];
+        const auto lo = values[order[order.size() * 3 / 4]];
+        std::vector<storage_type> out(length), out_simd(length);
+        clamp_n<Format>(bits, lo, hi, out);
+        simd::clamp_n<Format>(bits, lo, hi, out_simd);
+        for (std::size_t i = 0; i < length; ++i) {
+          const auto x = values[i];
+          const auto expected = is_nan_bits<Format>(x)        ? x
+                                : total_less<Format>(x, lo)   ? lo
+                                : total_less<Format>(hi, x)   ? hi
+                                                              : x;
+          if (out[i] != expected || out_simd[i] != expected) {
+            return false;
+          }
+        }
+      }
+
+      std::vector<order_key_t<Format>> keys(length), keys_simd(length);
+      order_keys_n<Format>(bits, keys);
+      simd::order_keys_n<Format>(bits, keys_simd);
+      if (keys != keys_simd) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Spans without numbers: no index, and the format's NaN
+bool test_no_numbers() {
+  const std::vector<fp16_e5m10::storage_type> nans = {0x7E00, 0xFE01, 0x7C01,
+                                                      0xFFFF};
+  std::vector<std::size_t> top(2);
+  return argmax_n<fp16_e5m10>(nans) == 4 &&
+         simd::argmax_n<fp16_e5m10>(nans) == 4 &&
+         simd::argmin_n<fp16_e5m10>(nans) == 4 &&
+         is_nan_bits<fp16_e5m10>(max_n<fp16_e5m10>(nans)) &&
+         is_nan_bits<fp16_e5m10>(simd::min_n<fp16_e5m10>({})) &&
+         simd::top_k_n<fp16_e5m10>(nans, top) == 0 &&
+         max_n<fp6_e3m2fn>({}) == 0;
+}
+
+int main() {
+  printf("=== OPINE Ordering Tests ===\n\n");
+  printf("ISA: %s (%zu-byte registers)\n\n", simd::isa_name,
+         simd::register_bytes);
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("fp8_e5m2 key order", test_key_order<fp8_e5m2>());
+  report("fp8_e4m3fn key order", test_key_order<fp8_e4m3fn>());
+  report("fp8_e4m3fnuz key order", test_key_order<fp8_e4m3fnuz>());
+  report("fp6_e3m2fn key order", test_key_order<fp6_e3m2fn>());
+  report("Padded format key order", test_key_order<PaddedFormat>());
+
+  report("fp16_e5m10 reductions", test_reductions<fp16_e5m10>());
+  report("fp8_e4m3 reductions", test_reductions<fp8_e4m3>());
+  report("fp8_e4m3fn reductions", test_reductions<fp8_e4m3fn>());
+  report("fp8_e5m2fnuz reductions", test_reductions<fp8_e5m2fnuz>());
+  report("fp6_e3m2fn reductions", test_reductions<fp6_e3m2fn>());
+  report("fp32_e8m23 reductions", test_reductions<fp32_e8m23>());
+  report("Padded format reductions (scalar fallback)",
+         test_reductions<PaddedFormat>());
+  report("Spans without numbers", test_no_numbers());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
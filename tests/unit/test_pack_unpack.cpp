@@ -144,6 +144,45 @@ template <typename Format> constexpr bool test_guard_bits_zero() {
   return true;
 }
 
+// Test helper: rounding up an all-ones mantissa carries into the exponent
+//
+// For every exponent below the maximum, 1.111...|GRS=100 (a tie with an odd
+// LSB) must round up to the next binade with a zero mantissa. This covers the
+// largest denormal becoming the smallest normal (exponent 0 -> 1) and the
+// largest finite value becoming infinity (exponent max-1 -> max).
+template <typename Format> constexpr bool test_rounding_carry() {
+  using RoundingPolicy = rounding_policies::ToNearestTiesToEven;
+  using unpacked_type = UnpackedFloat<Format, RoundingPolicy>;
+  using mantissa_type = typename unpacked_type::mantissa_type;
+  using storage_type = typename Format::storage_type;
+  constexpr int exp_max = (1 << Format::exp_bits) - 1;
+
+  for (int exp = 0; exp < exp_max; ++exp) {
+    for (int sign = 0; sign <= 1; ++sign) {
+      unpacked_type unpacked{};
+      unpacked.sign = sign != 0;
+      unpacked.exponent = static_cast<typename Format::exponent_type>(exp);
+
+      // [implicit][all ones][GRS = 100]
+      auto mantissa = static_cast<mantissa_type>(
+          unpacked_type::stored_bits_mask() | mantissa_type{0b100});
+      if (exp != 0) {
+        mantissa |= unpacked_type::implicit_bit_mask();
+      }
+      unpacked.mantissa = mantissa;
+
+      const storage_type expected = static_cast<storage_type>(
+          (static_cast<storage_type>(sign) << Format::sign_offset) |
+          (static_cast<storage_type>(exp + 1) << Format::exp_offset));
+      if (pack<Format, RoundingPolicy>(unpacked) != expected) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 // Compile-time tests
 // FP8 E5M2 exhaustive identity test
 static_assert(test_identity_exhaustive<fp8_e5m2>(),
@@ -208,6 +247,14 @@ using PaddedFormat = FormatDescriptor<1,   // SignBits
 static_assert(test_identity_exhaustive<PaddedFormat>(),
               "Padded format: pack(unpack(x)) must equal x for all values");
 
+// Rounding carry tests
+static_assert(test_rounding_carry<fp8_e5m2>(),
+              "fp8_e5m2: rounding carry must increment the exponent");
+static_assert(test_rounding_carry<fp8_e4m3>(),
+              "fp8_e4m3: rounding carry must increment the exponent");
+static_assert(test_rounding_carry<PaddedFormat>(),
+              "Padded format: rounding carry must increment the exponent");
+
 // Runtime tests with output
 int main() {
   printf("=== OPINE Pack/Unpack Tests ===\n\n");
@@ -275,6 +322,16 @@ int main() {
     return 1;
   }
 
+  // Rounding carry tests
+  printf("Rounding carry into exponent: ");
+  bool carry_ok = true;
+  carry_ok &= test_rounding_carry<fp8_e5m2>();
+  carry_ok &= test_rounding_carry<fp8_e4m3>();
+  carry_ok &= test_rounding_carry<PaddedFormat>();
+  printf("%s\n", carry_ok ? "PASS" : "FAIL");
+  if (!carry_ok)
+    return 1;
+
   printf("\n=== All tests passed! ===\n");
   return 0;
 }
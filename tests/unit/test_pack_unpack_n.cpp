@@ -0,0 +1,207 @@
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <opine/opine.hpp>
+#include <vector>
+
+using namespace opine;
+
+// Test helper: unpack_n over every encoding must match scalar unpack()
+template <typename Format, typename RoundingPolicy>
+constexpr bool test_unpack_n_matches_scalar() {
+  using storage_type = typename Format::storage_type;
+  using exponent_type = typename Format::exponent_type;
+  using mantissa_type = unpacked_mantissa_t<Format, RoundingPolicy>;
+  constexpr std::size_t total_values = std::size_t{1} << Format::total_bits;
+
+  std::array<storage_type, total_values> bits{};
+  for (std::size_t i = 0; i < total_values; ++i) {
+    bits[i] = static_cast<storage_type>(i);
+  }
+
+  std::array<bool, total_values> sign{};
+  std::array<exponent_type, total_values> exponent{};
+  std::array<mantissa_type, total_values> mantissa{};
+
+  if (unpack_n<Format, RoundingPolicy>(bits, sign, exponent, mantissa) !=
+      total_values) {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < total_values; ++i) {
+    auto expected = unpack<Format, RoundingPolicy>(bits[i]);
+    if (sign[i] != expected.sign || exponent[i] != expected.exponent ||
+        mantissa[i] != expected.mantissa) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Test helper: pack_n(unpack_n(x)) must match scalar pack(unpack(x))
+template <typename Format, typename RoundingPolicy>
+constexpr bool test_pack_n_round_trip() {
+  using storage_type = typename Format::storage_type;
+  using exponent_type = typename Format::exponent_type;
+  using mantissa_type = unpacked_mantissa_t<Format, RoundingPolicy>;
+  constexpr std::size_t total_values = std::size_t{1} << Format::total_bits;
+
+  std::array<storage_type, total_values> bits{};
+  for (std::size_t i = 0; i < total_values; ++i) {
+    bits[i] = static_cast<storage_type>(i);
+  }
+
+  std::array<bool, total_values> sign{};
+  std::array<exponent_type, total_values> exponent{};
+  std::array<mantissa_type, total_values> mantissa{};
+  std::array<storage_type, total_values> repacked{};
+
+  unpack_n<Format, RoundingPolicy>(bits, sign, exponent, mantissa);
+  if (pack_n<Format, RoundingPolicy>(sign, exponent, mantissa, repacked) !=
+      total_values) {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < total_values; ++i) {
+    auto expected =
+        pack<Format, RoundingPolicy>(unpack<Format, RoundingPolicy>(bits[i]));
+    if (repacked[i] != expected) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Test helper: mismatched buffer sizes process only the common prefix
+template <typename Format> constexpr bool test_short_buffers() {
+  using storage_type = typename Format::storage_type;
+  using exponent_type = typename Format::exponent_type;
+  using mantissa_type = unpacked_mantissa_t<Format>;
+
+  std::array<storage_type, 8> bits{};
+  std::array<bool, 8> sign{};
+  std::array<exponent_type, 5> exponent{};
+  std::array<mantissa_type, 8> mantissa{};
+  std::array<storage_type, 3> repacked{};
+
+  if (unpack_n<Format>(bits, sign, exponent, mantissa) != 5) {
+    return false;
+  }
+  if (pack_n<Format>(sign, exponent, mantissa, repacked) != 3) {
+    return false;
+  }
+
+  return true;
+}
+
+// Padded format from test_pack_unpack.cpp: [pad:3][S:1][E:4][M:3][pad:1]
+using PaddedFormat = FormatDescriptor<1, 8, 4, 4, 3, 1, 12, true>;
+
+// Compile-time tests
+static_assert(test_unpack_n_matches_scalar<fp8_e5m2,
+                                           rounding_policies::TowardZero>(),
+              "fp8_e5m2: unpack_n must match unpack (TowardZero)");
+static_assert(test_unpack_n_matches_scalar<fp8_e4m3,
+                                           rounding_policies::TowardZero>(),
+              "fp8_e4m3: unpack_n must match unpack (TowardZero)");
+static_assert(
+    test_unpack_n_matches_scalar<fp8_e5m2,
+                                 rounding_policies::ToNearestTiesToEven>(),
+    "fp8_e5m2: unpack_n must match unpack (ToNearestTiesToEven)");
+static_assert(
+    test_unpack_n_matches_scalar<fp8_e4m3,
+                                 rounding_policies::ToNearestTiesToEven>(),
+    "fp8_e4m3: unpack_n must match unpack (ToNearestTiesToEven)");
+
+static_assert(test_pack_n_round_trip<fp8_e5m2, rounding_policies::TowardZero>(),
+              "fp8_e5m2: pack_n must match pack");
+static_assert(test_pack_n_round_trip<fp8_e4m3, rounding_policies::TowardZero>(),
+              "fp8_e4m3: pack_n must match pack");
+
+static_assert(test_short_buffers<fp8_e4m3>(),
+              "unpack_n/pack_n must clamp to the shortest buffer");
+
+// Runtime tests with output
+//
+// The larger formats are checked at runtime: their tables are too big for
+// constant evaluation, and this also exercises the optimized (vectorized)
+// code paths rather than the constant evaluator.
+template <typename Format, typename RoundingPolicy>
+bool test_runtime_exhaustive() {
+  using storage_type = typename Format::storage_type;
+  using exponent_type = typename Format::exponent_type;
+  using mantissa_type = unpacked_mantissa_t<Format, RoundingPolicy>;
+  const std::size_t total_values = std::size_t{1} << Format::total_bits;
+
+  std::vector<storage_type> bits(total_values);
+  for (std::size_t i = 0; i < total_values; ++i) {
+    bits[i] = static_cast<storage_type>(i);
+  }
+
+  // std::vector<bool> is not contiguous, so sign uses a plain array
+  auto sign = std::make_unique<bool[]>(total_values);
+  std::vector<exponent_type> exponent(total_values);
+  std::vector<mantissa_type> mantissa(total_values);
+  std::vector<storage_type> repacked(total_values);
+
+  std::span<bool> sign_span(sign.get(), total_values);
+  unpack_n<Format, RoundingPolicy>(bits, sign_span, exponent, mantissa);
+  pack_n<Format, RoundingPolicy>(sign_span, exponent, mantissa, repacked);
+
+  for (std::size_t i = 0; i < total_values; ++i) {
+    auto expected = unpack<Format, RoundingPolicy>(bits[i]);
+    if (sign[i] != expected.sign || exponent[i] != expected.exponent ||
+        mantissa[i] != expected.mantissa) {
+      return false;
+    }
+    if (repacked[i] != pack<Format, RoundingPolicy>(expected)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int main() {
+  printf("=== OPINE Batched Pack/Unpack Tests ===\n\n");
+
+  bool ok = true;
+
+  printf("fp8_e5m2 unpack_n/pack_n vs scalar: ");
+  bool result =
+      test_runtime_exhaustive<fp8_e5m2, rounding_policies::TowardZero>();
+  printf("%s\n", result ? "PASS (all 256 values)" : "FAIL");
+  ok &= result;
+
+  printf("fp8_e4m3 unpack_n/pack_n vs scalar: ");
+  result = test_runtime_exhaustive<fp8_e4m3,
+                                   rounding_policies::ToNearestTiesToEven>();
+  printf("%s\n", result ? "PASS (all 256 values)" : "FAIL");
+  ok &= result;
+
+  printf("Padded format unpack_n/pack_n vs scalar: ");
+  result =
+      test_runtime_exhaustive<PaddedFormat, rounding_policies::TowardZero>();
+  printf("%s\n", result ? "PASS (all 4096 values)" : "FAIL");
+  ok &= result;
+
+  printf("fp16_e5m10 unpack_n/pack_n vs scalar: ");
+  result = test_runtime_exhaustive<fp16_e5m10,
+                                   rounding_policies::ToNearestTiesToEven>();
+  printf("%s\n", result ? "PASS (all 65536 values)" : "FAIL");
+  ok &= result;
+
+  printf("Short buffer clamping: ");
+  result = test_short_buffers<fp8_e4m3>();
+  printf("%s\n", result ? "PASS" : "FAIL");
+  ok &= result;
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
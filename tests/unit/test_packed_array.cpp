@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <opine/opine.hpp>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+
+// 12-bit format: elements straddle 64-bit words (16 elements per 3 words)
+using PaddedFormat = FormatDescriptor<1, 8, 4, 4, 3, 1, 12, true>;
+// 5-bit format: 64 elements per 5 words
+using fp5_e2m2 = IEEE_Format<2, 2>;
+
+static_assert(PackedArray<fp4_e2m1>::group == 16);
+static_assert(PackedArray<fp4_e2m1>::group_words == 1);
+static_assert(PackedArray<fp6_e3m2>::group == 32);
+static_assert(PackedArray<fp6_e3m2>::group_words == 3);
+static_assert(PackedArray<PaddedFormat>::group == 16);
+static_assert(PackedArray<PaddedFormat>::group_words == 3);
+static_assert(PackedArray<fp5_e2m2>::group == 64);
+static_assert(PackedArray<fp5_e2m2>::group_words == 5);
+
+static_assert(std::random_access_iterator<PackedArray<fp4_e2m1>::iterator>);
+static_assert(
+    std::random_access_iterator<PackedArray<fp4_e2m1>::const_iterator>);
+static_assert(std::output_iterator<PackedArray<fp6_e3m2>::iterator,
+                                   fp6_e3m2::storage_type>);
+
+// Test pattern: distinct, covering the whole element width
+template <typename Format>
+constexpr typename Format::storage_type pattern(std::size_t i) {
+  constexpr std::uint64_t mask =
+      (std::uint64_t{1} << Format::total_bits) - 1;
+  return static_cast<typename Format::storage_type>((i * 37 + 11) & mask);
+}
+
+// Test helper: packing words and unpacking them again is the identity for
+// every starting element (aligned and unaligned to a group), and single
+// element extraction agrees with it
+template <typename Format> constexpr bool test_word_round_trip() {
+  using packing = detail::word_packing<Format::total_bits>;
+  using storage_type = typename Format::storage_type;
+  constexpr std::size_t n = 3 * packing::group + 5;
+
+  std::array<storage_type, n> elements{};
+  for (std::size_t i = 0; i < n; ++i) {
+    elements[i] = pattern<Format>(i);
+  }
+
+  for (std::size_t first = 0; first < packing::group + 2; ++first) {
+    std::array<std::uint64_t, packing::word_count(2 * n)> words{};
+    detail::pack_words<Format>(std::span(elements).first(n - first), first,
+                               words);
+
+    std::array<storage_type, n> unpacked{};
+    detail::unpack_words<Format>(words, first,
+                                 std::span(unpacked).first(n - first));
+    for (std::size_t i = 0; i < n - first; ++i) {
+      if (unpacked[i] != elements[i] ||
+          packing::extract(words.data(), first + i) != elements[i]) {
+        return false;
+      }
+    }
+    // Elements before first are untouched
+    for (std::size_t i = 0; i < first; ++i) {
+      if (packing::extract(words.data(), i) != 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static_assert(test_word_round_trip<fp4_e2m1>());
+static_assert(test_word_round_trip<fp6_e3m2>());
+static_assert(test_word_round_trip<fp5_e2m2>());
+static_assert(test_word_round_trip<PaddedFormat>());
+static_assert(test_word_round_trip<fp8_e4m3>());
+
+// Layout: element 0 in the low bits of word 0, fp6 element 10 straddles
+// words 0 and 1
+constexpr bool test_layout() {
+  std::array<std::uint64_t, 2> words{};
+  detail::word_packing<4>::insert(words.data(), 0, 0x1);
+  detail::word_packing<4>::insert(words.data(), 1, 0x2);
+  detail::word_packing<4>::insert(words.data(), 15, 0xF);
+  if (words[0] != 0xF000000000000021) {
+    return false;
+  }
+
+  words = {};
+  detail::word_packing<6>::insert(words.data(), 10, 0x3F);
+  return words[0] == 0xF000000000000000 && words[1] == 0x3 &&
+         detail::word_packing<6>::extract(words.data(), 10) == 0x3F;
+}
+
+static_assert(test_layout());
+
+// Insertion into a straddling element leaves its neighbours alone
+constexpr bool test_insert_preserves_neighbours() {
+  using packing = detail::word_packing<6>;
+  std::array<std::uint64_t, 3> words{};
+  for (std::size_t i = 0; i < 32; ++i) {
+    packing::insert(words.data(), i, 0x3F);
+  }
+  packing::insert(words.data(), 10, 0);
+  packing::insert(words.data(), 21, 0x15);
+  for (std::size_t i = 0; i < 32; ++i) {
+    const std::uint64_t expected = i == 10 ? 0 : i == 21 ? 0x15 : 0x3F;
+    if (packing::extract(words.data(), i) != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(test_insert_preserves_neighbours());
+
+// Test helper: element access, proxy references and iterators on an array
+// whose length is not a multiple of the group
+template <typename Format> bool test_element_access() {
+  using storage_type = typename Format::storage_type;
+  const std::size_t n = 5 * PackedArray<Format>::group + 3;
+
+  PackedArray<Format> array(n);
+  if (array.size() != n ||
+      !std::all_of(array.begin(), array.end(),
+                   [](storage_type value) { return value == 0; })) {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    array[i] = pattern<Format>(i);
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    if (array.get(i) != pattern<Format>(i)) {
+      return false;
+    }
+  }
+
+  // Proxy to proxy assignment and swap
+  array[0] = array[1];
+  if (array[0] != pattern<Format>(1)) {
+    return false;
+  }
+  swap(array[2], array[3]);
+  if (array[2] != pattern<Format>(3) || array[3] != pattern<Format>(2)) {
+    return false;
+  }
+
+  // Iterators
+  std::vector<storage_type> copy(array.begin(), array.end());
+  if (copy.size() != n || !std::equal(copy.begin(), copy.end(),
+                                      std::as_const(array).begin())) {
+    return false;
+  }
+  std::fill(array.begin() + 4, array.end(), storage_type{1});
+  if (array.end() - array.begin() != static_cast<std::ptrdiff_t>(n) ||
+      array.begin()[4] != 1 || array[n - 1] != 1 || array[3] == 1) {
+    return false;
+  }
+  return true;
+}
+
+// Test helper: load() and store() at every offset within a group match
+// element access, and a span-constructed array holds the span's encodings
+template <typename Format> bool test_bulk_access() {
+  using storage_type = typename Format::storage_type;
+  const std::size_t n = 4 * PackedArray<Format>::group + 7;
+
+  std::vector<storage_type> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    values[i] = pattern<Format>(i);
+  }
+  const PackedArray<Format> array(
+      std::span<const storage_type>(values.data(), n));
+
+  for (std::size_t first = 0; first <= PackedArray<Format>::group; ++first) {
+    std::vector<storage_type> out(n + 1);
+    if (array.load(first, out) != n - first) {
+      return false;
+    }
+    for (std::size_t i = 0; i < n - first; ++i) {
+      if (out[i] != values[first + i] ||
+          array[first + i] != values[first + i]) {
+        return false;
+      }
+    }
+
+    PackedArray<Format> copy(n);
+    copy.store(first, std::span<const storage_type>(values).first(n - first));
+    for (std::size_t i = 0; i < n; ++i) {
+      if (copy[i] != (i < first ? 0 : values[i - first])) {
+        return false;
+      }
+    }
+  }
+  return array.load(n, std::span<storage_type>(values)) == 0;
+}
+
+// Test helper: PackedArray unpack_n()/pack_n() match the span versions
+template <typename Format> bool test_unpack_pack_n() {
+  using storage_type = typename Format::storage_type;
+  using exponent_type = typename Format::exponent_type;
+  using mantissa_type = unpacked_mantissa_t<Format, RNE>;
+  const std::size_t n = 3 * detail::packed_chunk + 9;
+  const std::size_t first = 5;
+
+  std::vector<storage_type> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    values[i] = pattern<Format>(i);
+  }
+  const PackedArray<Format> array{std::span<const storage_type>(values)};
+
+  const std::size_t m = n - first;
+  // std::vector<bool> is not contiguous, so signs use plain arrays
+  auto sign = std::make_unique<bool[]>(m);
+  auto expected_sign = std::make_unique<bool[]>(m);
+  std::span<bool> sign_span(sign.get(), m);
+  std::span<bool> expected_sign_span(expected_sign.get(), m);
+  std::vector<exponent_type> exponent(m), expected_exponent(m);
+  std::vector<mantissa_type> mantissa(m), expected_mantissa(m);
+
+  if (unpack_n<Format, RNE>(array, first, sign_span, exponent, mantissa) !=
+      m) {
+    return false;
+  }
+  unpack_n<Format, RNE>(std::span<const storage_type>(values).subspan(first),
+                        expected_sign_span, expected_exponent,
+                        expected_mantissa);
+  if (!std::equal(sign_span.begin(), sign_span.end(),
+                  expected_sign_span.begin()) ||
+      exponent != expected_exponent || mantissa != expected_mantissa) {
+    return false;
+  }
+
+  PackedArray<Format> packed(n);
+  if (pack_n<Format, RNE>(sign_span, exponent, mantissa, packed, first) !=
+      m) {
+    return false;
+  }
+  // The span pack_n() result (padding bits of the inputs are not kept)
+  std::vector<storage_type> expected(m);
+  pack_n<Format, RNE>(sign_span, exponent, mantissa,
+                      std::span<storage_type>(expected));
+  for (std::size_t i = 0; i < n; ++i) {
+    if (packed[i] != (i < first ? 0 : expected[i - first])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Memory: fp4 elements take half a byte, fp6 three quarters
+bool test_storage_size() {
+  const PackedArray<fp4_e2m1> fp4(4096);
+  const PackedArray<fp6_e3m2> fp6(4096);
+  const PackedArray<PaddedFormat> padded(100);
+  return fp4.storage_bytes() == 2048 && fp6.storage_bytes() == 3072 &&
+         padded.storage_bytes() == 152 && PackedArray<fp4_e2m1>{}.empty() &&
+         reinterpret_cast<std::uintptr_t>(fp4.words().data()) %
+                 cache_line_size ==
+             0;
+}
+
+int main() {
+  printf("=== OPINE Packed Array Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("Word packing (4, 5, 6, 8, 12 bits)",
+         test_word_round_trip<fp4_e2m1>() && test_word_round_trip<fp6_e3m2>() &&
+             test_word_round_trip<fp5_e2m2>() &&
+             test_word_round_trip<PaddedFormat>() &&
+             test_word_round_trip<fp8_e4m3>() && test_layout() &&
+             test_insert_preserves_neighbours());
+  report("Element access fp4_e2m1", test_element_access<fp4_e2m1>());
+  report("Element access fp6_e3m2", test_element_access<fp6_e3m2>());
+  report("Element access 12-bit", test_element_access<PaddedFormat>());
+  report("Bulk load/store fp4_e2m1", test_bulk_access<fp4_e2m1>());
+  report("Bulk load/store fp6_e2m3", test_bulk_access<fp6_e2m3>());
+  report("Bulk load/store fp5_e2m2", test_bulk_access<fp5_e2m2>());
+  report("Bulk load/store 12-bit", test_bulk_access<PaddedFormat>());
+  report("unpack_n/pack_n fp4_e2m1", test_unpack_pack_n<fp4_e2m1>());
+  report("unpack_n/pack_n fp6_e3m2", test_unpack_pack_n<fp6_e3m2>());
+  report("unpack_n/pack_n 12-bit", test_unpack_pack_n<PaddedFormat>());
+  report("Storage size", test_storage_size());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <opine/parallel.hpp>
+#include <span>
+#include <vector>
+
+using namespace opine;
+
+using fp32_bits = fp32_e8m23::storage_type;
+using fp16_bits = fp16_e5m10::storage_type;
+using fp8_bits = fp8_e4m3::storage_type;
+using conversion_policies::IEEEConversion;
+using conversion_policies::SafeConversion;
+
+// Pseudo-random encodings of the given width (every bit pattern, NaNs
+// included)
+template <typename Storage>
+std::vector<Storage> random_bits(std::size_t n, std::uint32_t seed) {
+  std::vector<Storage> values(n);
+  for (auto &value : values) {
+    seed = seed * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    value = static_cast<Storage>(seed);
+  }
+  return values;
+}
+
+// Executions covering one thread, more threads than chunks, one-unit chunks
+// and the defaults
+const ParallelExecution executions[] = {
+    {.threads = 1},
+    {.threads = 3, .chunk_bytes = 1},
+    {.threads = 64, .chunk_bytes = 4096},
+    parallel,
+};
+
+// Test helper: parallel convert_n() matches the serial one for lengths that
+// are not multiples of the chunk
+template <typename Dst, typename Src, typename ConversionPolicy>
+bool test_convert_n_matches_serial() {
+  for (const std::size_t n : {std::size_t{0}, std::size_t{1000},
+                              std::size_t{100003}}) {
+    const auto src = random_bits<typename Src::storage_type>(
+        n, static_cast<std::uint32_t>(n));
+    std::vector<typename Dst::storage_type> expected(n);
+    convert_n<Dst, Src, ConversionPolicy>(src, expected);
+
+    for (const auto &execution : executions) {
+      std::vector<typename Dst::storage_type> dst(n);
+      if (convert_n<Dst, Src, ConversionPolicy>(execution, src, dst) != n ||
+          dst != expected) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Test helper: parallel quantize() and dequantize() match the serial ones
+template <typename MxFormat> bool test_quantize_matches_serial() {
+  for (const std::size_t n : {std::size_t{0}, std::size_t{33},
+                              std::size_t{70001}}) {
+    const auto src = random_bits<fp32_bits>(n, static_cast<std::uint32_t>(n));
+    const auto expected = quantize<MxFormat, fp32_e8m23>(src);
+    std::vector<fp16_bits> expected_out(n);
+    expected.template dequantize<fp16_e5m10>(expected_out);
+
+    for (const auto &execution : executions) {
+      const auto array = quantize<MxFormat, fp32_e8m23>(execution, src);
+      if (!std::ranges::equal(array.scales(), expected.scales()) ||
+          !std::ranges::equal(array.elements(), expected.elements())) {
+        return false;
+      }
+
+      // One element short: the last block is decoded partially
+      std::vector<fp16_bits> out(n, 0xFFFF);
+      const std::size_t m = n > 0 ? n - 1 : 0;
+      if (dequantize<fp16_e5m10>(execution, expected,
+                                 std::span<fp16_bits>(out).first(m)) != m) {
+        return false;
+      }
+      for (std::size_t i = 0; i < n; ++i) {
+        if (out[i] != (i < m ? expected_out[i] : 0xFFFF)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Test helper: parallel dot_exact() and gemv_exact() match the serial ones
+// bit for bit, whatever the chunking (finite operands: the top exponent bit
+// cleared, so that the sums are not all NaN)
+bool test_exact_reductions_match_serial() {
+  for (std::size_t n : {0, 1, 1000, 100003}) {
+    auto a = random_bits<fp8_bits>(n, static_cast<std::uint32_t>(n + 1));
+    auto b = random_bits<fp16_bits>(n, static_cast<std::uint32_t>(n + 2));
+    for (auto &value : a) {
+      value &= 0xBF;
+    }
+    for (auto &value : b) {
+      value &= 0xBFFF;
+    }
+    const auto expected = dot_exact<fp32_e8m23, fp8_e4m3, fp16_e5m10>(
+        std::span<const fp8_bits>(a), std::span<const fp16_bits>(b));
+
+    constexpr std::size_t cols = 100;
+    std::vector<fp16_bits> serial(n / cols + 1);
+    std::vector<fp16_bits> threaded(n / cols + 1);
+    const std::size_t rows = gemv_exact<fp16_e5m10, fp8_e4m3, fp16_e5m10>(
+        std::span<const fp8_bits>(a),
+        std::span<const fp16_bits>(b).first(std::min(n, cols)),
+        std::span<fp16_bits>(serial));
+    for (const auto &execution : executions) {
+      std::fill(threaded.begin(), threaded.end(), fp16_bits{0});
+      if (dot_exact<fp32_e8m23, fp8_e4m3, fp16_e5m10>(
+              execution, std::span<const fp8_bits>(a),
+              std::span<const fp16_bits>(b)) != expected ||
+          gemv_exact<fp16_e5m10, fp8_e4m3, fp16_e5m10>(
+              execution, std::span<const fp8_bits>(a),
+              std::span<const fp16_bits>(b).first(std::min(n, cols)),
+              std::span<fp16_bits>(threaded)) != rows ||
+          threaded != serial) {
+        printf("\n  n = %zu, threads %u\n", n, execution.threads);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// The counts of instrumented conversions on every thread reach the caller:
+// those of the serial function
+bool test_instrumented_counts() {
+  using Counted = conversion_policies::Instrumented<SafeConversion>;
+  using instrumentation = instrumentation_policies::Counting<>;
+  const auto src = random_bits<fp32_bits>(100003, 11);
+  std::vector<fp16_bits> dst(src.size());
+  std::vector<fp32_bits> out(src.size());
+
+  instrumentation::take();
+  convert_n<fp16_e5m10, fp32_e8m23, Counted>(src, dst);
+  const auto serial = instrumentation::take();
+  quantize<MXFP8_E4M3, fp32_e8m23, Counted>(std::span<const fp32_bits>(src))
+      .template dequantize<fp32_e8m23, Counted>(std::span<fp32_bits>(out));
+  const auto serial_mx = instrumentation::take();
+
+  for (const auto &execution : executions) {
+    convert_n<fp16_e5m10, fp32_e8m23, Counted>(execution, src, dst);
+    const auto threaded = instrumentation::take();
+    dequantize<fp32_e8m23, Counted>(
+        execution,
+        quantize<MXFP8_E4M3, fp32_e8m23, Counted>(
+            execution, std::span<const fp32_bits>(src)),
+        std::span<fp32_bits>(out));
+    if (threaded != serial || instrumentation::take() != serial_mx) {
+      printf("\n  threads %u\n", execution.threads);
+      return false;
+    }
+  }
+  return serial.conversions == src.size();
+}
+
+int main() {
+  printf("=== OPINE Parallel Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("convert_n fp16 -> fp32 (widen)",
+         test_convert_n_matches_serial<fp32_e8m23, fp16_e5m10,
+                                       IEEEConversion>());
+  report("convert_n fp16 -> fp8_e4m3 (encode table)",
+         test_convert_n_matches_serial<fp8_e4m3, fp16_e5m10,
+                                       IEEEConversion>());
+  report("convert_n fp32 -> fp16 (compute, saturating)",
+         test_convert_n_matches_serial<fp16_e5m10, fp32_e8m23,
+                                       SafeConversion>());
+  report("MXFP4_E2M1 quantize/dequantize",
+         test_quantize_matches_serial<MXFP4_E2M1>());
+  report("MXFP6_E3M2 quantize/dequantize",
+         test_quantize_matches_serial<MXFP6_E3M2>());
+  report("MXFP8_E4M3 quantize/dequantize",
+         test_quantize_matches_serial<MXFP8_E4M3>());
+  report("dot_exact/gemv_exact", test_exact_reductions_match_serial());
+  report("Instrumented counts", test_instrumented_counts());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <opine/opine.hpp>
+#include <opine/requantize.hpp>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace opine;
+
+using fp32_bits = fp32_e8m23::storage_type;
+using fp16_bits = fp16_e5m10::storage_type;
+using conversion_policies::IEEEConversion;
+using conversion_policies::SafeConversion;
+
+// Allocations counted while counting is set
+std::atomic<bool> counting{false};
+std::atomic<std::size_t> allocations{0};
+
+void *operator new(std::size_t size) {
+  if (counting.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (void *p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+// Pseudo-random encodings of the given width (every bit pattern, NaNs
+// included)
+template <typename Storage>
+std::vector<Storage> random_bits(std::size_t n, std::uint32_t seed) {
+  std::vector<Storage> values(n);
+  for (auto &value : values) {
+    seed = seed * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    value = static_cast<Storage>(seed);
+  }
+  return values;
+}
+
+// Same encodings as quantize(): scales and elements of every block
+template <typename MxFormat>
+bool same_mx(MicroscaledView<MxFormat> view,
+             const MicroscaledArray<MxFormat> &expected) {
+  return view.size() == expected.size() &&
+         std::ranges::equal(view.scales(), expected.scales()) &&
+         std::ranges::equal(view.elements(), expected.elements());
+}
+
+// Same elements as PackedArray(values)
+template <typename Format>
+bool same_packed(PackedView<Format> view, const PackedArray<Format> &expected) {
+  return view.size() == expected.size() &&
+         std::ranges::equal(view, expected.view());
+}
+
+// Test helper: requantize() to MX matches quantize() for lengths with
+// partial blocks
+template <typename MxFormat, typename Src, typename ConversionPolicy>
+bool test_mx_matches_quantize() {
+  for (const std::size_t n : {std::size_t{0}, std::size_t{1},
+                              std::size_t{32}, std::size_t{1001}}) {
+    const auto src = random_bits<typename Src::storage_type>(
+        n, static_cast<std::uint32_t>(n + 1));
+    std::vector<std::uint64_t> memory(requantized_words<MxFormat>(n), ~0ull);
+    const auto view =
+        requantize<MxFormat, Src, ConversionPolicy>(src, memory);
+    if (!same_mx(view, quantize<MxFormat, Src, ConversionPolicy>(
+                           std::span<const typename Src::storage_type>(src)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Test helper: requantize() to a plain format matches convert_n() followed
+// by PackedArray(values), over words that held other bits
+template <typename Format, typename Src, typename ConversionPolicy>
+bool test_packed_matches_convert() {
+  for (const std::size_t n : {std::size_t{0}, std::size_t{5},
+                              std::size_t{64}, std::size_t{1001}}) {
+    const auto src = random_bits<typename Src::storage_type>(
+        n, static_cast<std::uint32_t>(n + 7));
+    std::vector<typename Format::storage_type> values(n);
+    convert_n<Format, Src, ConversionPolicy>(
+        std::span<const typename Src::storage_type>(src),
+        std::span<typename Format::storage_type>(values));
+    std::vector<std::uint64_t> memory(requantized_words<Format>(n), ~0ull);
+    const auto view = requantize<Format, Src, ConversionPolicy>(src, memory);
+    if (!same_packed(view, PackedArray<Format>(
+                               std::span<const typename Format::storage_type>(
+                                   values)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Tiles are whole MX blocks or word groups
+template <typename Target> constexpr std::size_t granule() {
+  if constexpr (requires { Target::block_size; }) {
+    return Target::block_size;
+  } else {
+    return PackedView<Target>::group;
+  }
+}
+
+// Test helper: a producer thread streams chunks of several sizes through a
+// ring of `slots` slots; the consumer's tiles cover the stream in order and
+// match requantize() of their source ranges
+template <typename Target, typename Src>
+bool test_stream(std::size_t slots, std::size_t tile_elements) {
+  using Stream = RequantizeStream<Target, Src>;
+  using src_storage = typename Src::storage_type;
+  const auto src = random_bits<src_storage>(20000, 99);
+  const std::size_t cuts[] = {0, 1, 4097, 4160, 11111, 20000};
+
+  std::vector<std::uint64_t> ring(slots * Stream::slot_words(tile_elements));
+  Stream stream(ring, tile_elements);
+  if (stream.slots() != slots ||
+      stream.tile_elements() % granule<Target>() != 0) {
+    return false;
+  }
+
+  std::size_t produced = 0;
+  std::jthread producer([&] {
+    for (std::size_t c = 0; c + 1 < std::size(cuts); ++c) {
+      produced += stream.produce(std::span<const src_storage>(src).subspan(
+          cuts[c], cuts[c + 1] - cuts[c]));
+    }
+    stream.close();
+  });
+
+  bool ok = true;
+  std::size_t next = 0;
+  std::size_t tiles = 0;
+  std::vector<std::uint64_t> expected;
+  while (auto tile = stream.acquire()) {
+    const std::size_t size = tile->view.size();
+    ok &= tile->offset == next && size > 0 && size <= stream.tile_elements();
+    // A tile never crosses a chunk boundary
+    ok &= std::ranges::none_of(cuts, [&](std::size_t cut) {
+      return cut > next && cut < next + size;
+    });
+    expected.assign(requantized_words<Target>(size), 0);
+    const auto reference = requantize<Target, Src>(
+        std::span<const src_storage>(src).subspan(next, size), expected);
+    if constexpr (requires { reference.scales(); }) {
+      ok &= std::ranges::equal(tile->view.scales(), reference.scales()) &&
+            std::ranges::equal(tile->view.elements(), reference.elements());
+    } else {
+      ok &= std::ranges::equal(tile->view, reference);
+    }
+    next += size;
+    ++tiles;
+    stream.release();
+  }
+  producer.join();
+  return ok && next == src.size() && tiles == produced &&
+         !stream.acquire().has_value();
+}
+
+// With a slot per tile, producing and consuming on one thread allocates
+// nothing
+bool test_no_allocation() {
+  using Stream = RequantizeStream<MXFP4_E2M1, fp32_e8m23>;
+  const auto src = random_bits<fp32_bits>(10000, 5);
+  std::vector<std::uint64_t> ring(3 * Stream::slot_words(4096));
+  Stream stream(ring, 4096);
+
+  allocations = 0;
+  counting = true;
+  const std::size_t tiles = stream.produce(src);
+  stream.close();
+  std::size_t elements = 0;
+  while (auto tile = stream.acquire()) {
+    elements += tile->view.size();
+    stream.release();
+  }
+  counting = false;
+  return tiles == 3 && elements == src.size() && allocations == 0;
+}
+
+// A ring smaller than one slot is rejected
+bool test_ring_too_small() {
+  using Stream = RequantizeStream<MXFP8_E4M3, fp32_e8m23>;
+  std::vector<std::uint64_t> ring(Stream::slot_words(4096) - 1);
+  try {
+    Stream stream(ring, 4096);
+  } catch (const std::invalid_argument &) {
+    try {
+      Stream empty(std::span<std::uint64_t>{}, 1);
+    } catch (const std::invalid_argument &) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int main() {
+  printf("=== OPINE Requantization Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("fp32 -> MXFP8_E4M3 requantize vs quantize",
+         test_mx_matches_quantize<MXFP8_E4M3, fp32_e8m23, SafeConversion>());
+  report("fp16 -> MXFP6_E3M2 requantize vs quantize",
+         test_mx_matches_quantize<MXFP6_E3M2, fp16_e5m10, IEEEConversion>());
+  report("fp32 -> MXFP4_E2M1 requantize vs quantize",
+         test_mx_matches_quantize<MXFP4_E2M1, fp32_e8m23, SafeConversion>());
+  report("fp32 -> fp8_e4m3 requantize vs convert_n + pack",
+         test_packed_matches_convert<fp8_e4m3, fp32_e8m23, SafeConversion>());
+  report("fp16 -> fp6_e2m3 requantize vs convert_n + pack",
+         test_packed_matches_convert<fp6_e2m3, fp16_e5m10, IEEEConversion>());
+  report("fp32 -> fp4_e2m1 requantize vs convert_n + pack",
+         test_packed_matches_convert<fp4_e2m1, fp32_e8m23, SafeConversion>());
+  report("MXFP8 stream, 2 slots", test_stream<MXFP8_E4M3, fp32_e8m23>(2, 4096));
+  report("MXFP6 stream, 1 slot", test_stream<MXFP6_E2M3, fp16_e5m10>(1, 1000));
+  report("fp8 stream, 4 slots", test_stream<fp8_e5m2, fp32_e8m23>(4, 512));
+  report("fp6 stream, 2 slots", test_stream<fp6_e3m2, fp32_e8m23>(2, 333));
+  report("No allocation", test_no_allocation());
+  report("Ring smaller than a slot", test_ring_too_small());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,304 @@
+#include "float_oracle.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <opine/opine.hpp>
+#include <vector>
+
+using namespace opine;
+
+using RTP = rounding_policies::TowardPositive;
+using RTN = rounding_policies::TowardNegative;
+using RNA = rounding_policies::ToNearestTiesAwayFromZero;
+using SR = rounding_policies::Stochastic<>;
+
+enum class Op { Add, Subtract, Multiply, Divide };
+
+// Storage-level operation through the UnpackedFloat arithmetic
+template <typename Format, typename RoundingPolicy>
+constexpr typename Format::storage_type
+apply(Op op, typename Format::storage_type a, typename Format::storage_type b) {
+  const auto x = unpack<Format, RoundingPolicy>(a);
+  const auto y = unpack<Format, RoundingPolicy>(b);
+  switch (op) {
+  case Op::Add:
+    return pack<Format, RoundingPolicy>(add(x, y));
+  case Op::Subtract:
+    return pack<Format, RoundingPolicy>(subtract(x, y));
+  case Op::Multiply:
+    return pack<Format, RoundingPolicy>(multiply(x, y));
+  case Op::Divide:
+    return pack<Format, RoundingPolicy>(divide(x, y));
+  }
+  return 0;
+}
+
+// Unrounded value with the given stored mantissa and guard bits
+template <typename Format, typename RoundingPolicy>
+constexpr UnpackedFloat<Format, RoundingPolicy>
+make_unpacked(bool sign, int exponent, std::uint64_t mantissa) {
+  using unpacked_type = UnpackedFloat<Format, RoundingPolicy>;
+  unpacked_type result{};
+  result.sign = sign;
+  result.exponent = static_cast<typename Format::exponent_type>(exponent);
+  result.mantissa = static_cast<typename unpacked_type::mantissa_type>(
+      mantissa | (exponent != 0 ? unpacked_type::implicit_bit_mask() : 0));
+  return result;
+}
+
+// Known results, checked at compile time (fp8_e5m2: 1.0 = 0x3C, max finite
+// 0x7B, Inf 0x7C, largest denormal 0x03, smallest normal 0x04)
+constexpr bool test_known_values() {
+  // Directed: [11|1] is inexact, rounded up only in the chosen direction
+  if (pack(make_unpacked<fp8_e5m2, RTP>(false, 15, 0b011)) != 0x3E ||
+      pack(make_unpacked<fp8_e5m2, RTP>(true, 15, 0b011)) != 0xBD ||
+      pack(make_unpacked<fp8_e5m2, RTN>(false, 15, 0b011)) != 0x3D ||
+      pack(make_unpacked<fp8_e5m2, RTN>(true, 15, 0b011)) != 0xBE) {
+    return false;
+  }
+  // Exact values are untouched
+  if (pack(make_unpacked<fp8_e5m2, RTP>(false, 15, 0b010)) != 0x3D ||
+      pack(make_unpacked<fp8_e5m2, RTN>(true, 15, 0b010)) != 0xBD) {
+    return false;
+  }
+  // The carry: max finite rounds to infinity, the largest denormal to the
+  // smallest normal
+  if (pack(make_unpacked<fp8_e5m2, RTP>(false, 30, 0b111)) != 0x7C ||
+      pack(make_unpacked<fp8_e5m2, RTN>(false, 30, 0b111)) != 0x7B ||
+      pack(make_unpacked<fp8_e5m2, RTN>(true, 30, 0b111)) != 0xFC ||
+      pack(make_unpacked<fp8_e5m2, RTP>(false, 0, 0b111)) != 0x04 ||
+      pack(make_unpacked<fp8_e5m2, RTN>(true, 0, 0b111)) != 0x84) {
+    return false;
+  }
+  // Ties away: GRS = 100 always rounds up in magnitude, below it never
+  if (pack(make_unpacked<fp8_e5m2, RNA>(false, 15, 0b00100)) != 0x3D ||
+      pack(make_unpacked<fp8_e5m2, RNA>(true, 15, 0b01100)) != 0xBE ||
+      pack(make_unpacked<fp8_e5m2, RNA>(false, 15, 0b00011)) != 0x3C ||
+      pack(make_unpacked<fp8_e5m2, RNA>(false, 30, 0b11100)) != 0x7C) {
+    return false;
+  }
+  // Exact cancellation is -0 toward negative, +0 otherwise
+  if (apply<fp8_e5m2, RTN>(Op::Subtract, 0x3C, 0x3C) != 0x80 ||
+      apply<fp8_e5m2, RTP>(Op::Subtract, 0x3C, 0x3C) != 0x00 ||
+      apply<fp8_e5m2, RTN>(Op::Add, 0x00, 0x80) != 0x80 ||
+      apply<fp8_e5m2, RNA>(Op::Add, 0x00, 0x80) != 0x00) {
+    return false;
+  }
+  return true;
+}
+
+static_assert(test_known_values(), "Directed and ties-away rounding");
+
+// Stochastic rounding with explicit random bits: round up exactly when the
+// discarded fraction plus the random number carries, for every fp8_e5m2
+// significand, fraction and random number
+constexpr bool test_stochastic_rule() {
+  constexpr int random_bits = SR::guard_bits;
+  for (std::uint32_t stored = 0; stored < 4; ++stored) {
+    for (std::uint32_t fraction = 0; fraction < (1u << random_bits);
+         ++fraction) {
+      const auto wide = static_cast<std::uint32_t>(
+          (((4u | stored) << random_bits) | fraction));
+      for (std::uint32_t random = 0; random < (1u << random_bits); ++random) {
+        const auto rounded =
+            SR::round_mantissa<fp8_e5m2>(wide, false, random);
+        const std::uint32_t expected =
+            stored + (fraction + random >= (1u << random_bits) ? 1 : 0);
+        if (static_cast<std::uint32_t>(rounded) != expected) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+static_assert(test_stochastic_rule(), "Stochastic rounding decision");
+
+// Stochastic rounding is usable in constant expressions, and stays within
+// one ulp: 1.0 + 1/16 ulp rounds to 1.0 or to 1.25
+constexpr auto constexpr_stochastic =
+    pack(make_unpacked<fp8_e5m2, SR>(false, 15, 0b00000100));
+static_assert(constexpr_stochastic == 0x3C || constexpr_stochastic == 0x3D);
+
+// Stochastic results cannot be tabulated: conversions always compute
+static_assert(
+    conversion_strategy<fp8_e4m3, fp8_e5m2,
+                        conversion_policies::Conversion<SR, false>> ==
+    ConversionStrategy::Compute);
+
+// Exact result of a binary operation on two doubles (division rounded to
+// odd, so that rounding it again in any direction is correct), with the sign
+// of an exact zero sum under RoundingPolicy
+template <typename RoundingPolicy>
+double exact_result(Op op, double a, double b) {
+  switch (op) {
+  case Op::Add:
+  case Op::Subtract: {
+    const double addend = op == Op::Add ? b : -b;
+    const double sum = a + addend;
+    if (sum == 0 && std::is_same_v<RoundingPolicy, RTN>) {
+      return std::signbit(a) || std::signbit(addend) ? -0.0 : 0.0;
+    }
+    return sum;
+  }
+  case Op::Multiply:
+    return a * b;
+  case Op::Divide:
+    return oracle::divide_to_odd(a, b);
+  }
+  return 0.0;
+}
+
+// Test helper: all four operations on every pair of encodings must match the
+// oracle in the policy's direction (NaN results only need to be NaN)
+template <typename Format, typename RoundingPolicy, oracle::Rounding Direction>
+bool test_exhaustive() {
+  using storage_type = typename Format::storage_type;
+  constexpr std::uint64_t count = std::uint64_t{1} << Format::total_bits;
+
+  for (const Op op : {Op::Add, Op::Subtract, Op::Multiply, Op::Divide}) {
+    for (std::uint64_t a = 0; a < count; ++a) {
+      for (std::uint64_t b = 0; b < count; ++b) {
+        const auto actual = static_cast<std::uint64_t>(
+            apply<Format, RoundingPolicy>(op, static_cast<storage_type>(a),
+                                          static_cast<storage_type>(b)));
+        const auto expected = oracle::round_with<Format, Direction>(
+            exact_result<RoundingPolicy>(op, oracle::to_double<Format>(a),
+                                         oracle::to_double<Format>(b)));
+        const bool match = oracle::is_nan<Format>(expected)
+                               ? oracle::is_nan<Format>(actual)
+                               : actual == expected;
+        if (!match) {
+          printf("\n  mismatch: op %d, 0x%llx, 0x%llx -> 0x%llx (want "
+                 "0x%llx)\n",
+                 static_cast<int>(op), static_cast<unsigned long long>(a),
+                 static_cast<unsigned long long>(b),
+                 static_cast<unsigned long long>(actual),
+                 static_cast<unsigned long long>(expected));
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Test helper: every stochastically rounded result is one of the two
+// neighbours of the exact result (its truncation, or one ulp away from zero)
+template <typename Format> bool test_stochastic_neighbours() {
+  using storage_type = typename Format::storage_type;
+  using oracle::Rounding;
+  constexpr std::uint64_t count = std::uint64_t{1} << Format::total_bits;
+
+  for (const Op op : {Op::Add, Op::Subtract, Op::Multiply, Op::Divide}) {
+    for (std::uint64_t a = 0; a < count; ++a) {
+      for (std::uint64_t b = 0; b < count; ++b) {
+        const auto actual = static_cast<std::uint64_t>(
+            apply<Format, SR>(op, static_cast<storage_type>(a),
+                              static_cast<storage_type>(b)));
+        const double exact =
+            exact_result<SR>(op, oracle::to_double<Format>(a),
+                             oracle::to_double<Format>(b));
+        const auto down =
+            oracle::round_with<Format, Rounding::TowardZero>(exact);
+        const auto up =
+            std::signbit(exact)
+                ? oracle::round_with<Format, Rounding::TowardNegative>(exact)
+                : oracle::round_with<Format, Rounding::TowardPositive>(exact);
+        const bool match = oracle::is_nan<Format>(down)
+                               ? oracle::is_nan<Format>(actual)
+                               : actual == down || actual == up;
+        if (!match) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Test helper: values a quarter of an ulp above 1.0 must round up a quarter
+// of the time, through pack() and through pack_n() (within 5 sigma)
+bool test_stochastic_unbiased() {
+  constexpr std::size_t n = 1 << 16;
+  // Not const: pack(value) must not be a constant expression, which would
+  // take the constant-evaluation random bits
+  auto value = make_unpacked<fp8_e5m2, SR>(false, 15, 0b00010000);
+  auto unbiased = [](std::size_t rounded_up) {
+    const double expected = n * 0.25;
+    const double sigma = std::sqrt(n * 0.25 * 0.75);
+    return std::fabs(static_cast<double>(rounded_up) - expected) <
+           5 * sigma;
+  };
+
+  std::size_t scalar_up = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto bits = pack(value);
+    if (bits != 0x3C && bits != 0x3D) {
+      return false;
+    }
+    scalar_up += bits == 0x3D ? 1 : 0;
+  }
+
+  using mantissa_type = unpacked_mantissa_t<fp8_e5m2, SR>;
+  const std::unique_ptr<bool[]> sign(new bool[n]());
+  std::vector<fp8_e5m2::exponent_type> exponent(n, value.exponent);
+  std::vector<mantissa_type> mantissa(n, value.mantissa);
+  std::vector<fp8_e5m2::storage_type> first(n);
+  std::vector<fp8_e5m2::storage_type> second(n);
+  pack_n<fp8_e5m2, SR>(std::span<const bool>(sign.get(), n), exponent,
+                       mantissa, first);
+  pack_n<fp8_e5m2, SR>(std::span<const bool>(sign.get(), n), exponent,
+                       mantissa, second);
+
+  std::size_t bulk_up = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    if (first[i] != 0x3C && first[i] != 0x3D) {
+      return false;
+    }
+    bulk_up += first[i] == 0x3D ? 1 : 0;
+  }
+
+  // Successive calls draw fresh random numbers
+  return unbiased(scalar_up) && unbiased(bulk_up) && first != second;
+}
+
+int main() {
+  printf("=== OPINE Rounding Mode Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  using oracle::Rounding;
+  report("Known values (directed, ties away, carry)", test_known_values());
+  report("fp8_e5m2 TowardPositive exhaustive",
+         test_exhaustive<fp8_e5m2, RTP, Rounding::TowardPositive>());
+  report("fp8_e4m3 TowardPositive exhaustive",
+         test_exhaustive<fp8_e4m3, RTP, Rounding::TowardPositive>());
+  report("fp8_e5m2 TowardNegative exhaustive",
+         test_exhaustive<fp8_e5m2, RTN, Rounding::TowardNegative>());
+  report("fp8_e4m3 TowardNegative exhaustive",
+         test_exhaustive<fp8_e4m3, RTN, Rounding::TowardNegative>());
+  report("fp8_e5m2 ToNearestTiesAwayFromZero exhaustive",
+         test_exhaustive<fp8_e5m2, RNA, Rounding::NearestAway>());
+  report("fp8_e4m3 ToNearestTiesAwayFromZero exhaustive",
+         test_exhaustive<fp8_e4m3, RNA, Rounding::NearestAway>());
+  report("Stochastic rounding decision", test_stochastic_rule());
+  report("fp8_e5m2 Stochastic neighbours exhaustive",
+         test_stochastic_neighbours<fp8_e5m2>());
+  report("fp8_e4m3 Stochastic neighbours exhaustive",
+         test_stochastic_neighbours<fp8_e4m3>());
+  report("Stochastic unbiased (pack, pack_n)", test_stochastic_unbiased());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
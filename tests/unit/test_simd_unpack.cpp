@@ -0,0 +1,148 @@
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <opine/opine.hpp>
+#include <opine/platforms/simd/unpack.hpp>
+#include <vector>
+
+using namespace opine;
+
+// Padded format from test_pack_unpack.cpp: [pad:3][S:1][E:4][M:3][pad:1]
+using PaddedFormat = FormatDescriptor<1, 8, 4, 4, 3, 1, 12, true>;
+
+// Kernel availability is decided at compile time from the layout
+static_assert(!simd::has_unpack_kernel<PaddedFormat>,
+              "Padded layouts must fall back to the scalar path");
+static_assert(simd::has_unpack_kernel<fp8_e4m3> == simd::enabled,
+              "fp8_e4m3 has a kernel whenever SIMD is enabled");
+static_assert(simd::has_unpack_kernel<fp16_e5m10> == simd::enabled,
+              "fp16_e5m10 has a kernel whenever SIMD is enabled");
+static_assert(simd::has_unpack_kernel<fp32_e8m23> == simd::enabled,
+              "fp32_e8m23 has a kernel whenever SIMD is enabled");
+
+// The SIMD entry point stays usable in constant expressions (scalar path)
+constexpr bool test_constexpr_unpack() {
+  fp8_e4m3::storage_type bits[3] = {0xB5, 0x07, 0x00};
+  bool sign[3] = {};
+  fp8_e4m3::exponent_type exponent[3] = {};
+  unpacked_mantissa_t<fp8_e4m3> mantissa[3] = {};
+
+  simd::unpack_n<fp8_e4m3>(bits, sign, exponent, mantissa);
+
+  return sign[0] && exponent[0] == 6 && mantissa[0] == 0b1101 && !sign[1] &&
+         exponent[1] == 0 && mantissa[1] == 0b0111;
+}
+static_assert(test_constexpr_unpack(), "simd::unpack_n in constexpr");
+
+// Test helper: simd::unpack_n must match the scalar unpack_n over `values`
+//
+// Runs several lengths so that every combination of full vector blocks and
+// scalar tail is exercised.
+template <typename Format, typename RoundingPolicy>
+bool test_matches_scalar(
+    const std::vector<typename Format::storage_type> &values) {
+  using exponent_type = typename Format::exponent_type;
+  using mantissa_type = unpacked_mantissa_t<Format, RoundingPolicy>;
+
+  constexpr std::size_t lanes = simd::unpack_lanes<Format, RoundingPolicy>;
+  const std::size_t lengths[] = {0,         1,         lanes - 1,
+                                 lanes,     lanes + 1, 3 * lanes + 5,
+                                 values.size()};
+
+  for (std::size_t length : lengths) {
+    if (length > values.size()) {
+      continue;
+    }
+    std::span<const typename Format::storage_type> bits(values.data(), length);
+
+    auto sign_simd = std::make_unique<bool[]>(length + 1);
+    auto sign_ref = std::make_unique<bool[]>(length + 1);
+    std::vector<exponent_type> exp_simd(length), exp_ref(length);
+    std::vector<mantissa_type> mant_simd(length), mant_ref(length);
+
+    std::size_t n_simd = simd::unpack_n<Format, RoundingPolicy>(
+        bits, {sign_simd.get(), length}, exp_simd, mant_simd);
+    std::size_t n_ref = unpack_n<Format, RoundingPolicy>(
+        bits, {sign_ref.get(), length}, exp_ref, mant_ref);
+
+    if (n_simd != length || n_ref != length) {
+      return false;
+    }
+    for (std::size_t i = 0; i < length; ++i) {
+      if (sign_simd[i] != sign_ref[i] || exp_simd[i] != exp_ref[i] ||
+          mant_simd[i] != mant_ref[i]) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Every encoding of a format up to 16 bits, in order
+template <typename Format>
+std::vector<typename Format::storage_type> all_values() {
+  std::vector<typename Format::storage_type> values(std::size_t{1}
+                                                    << Format::total_bits);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<typename Format::storage_type>(i);
+  }
+  return values;
+}
+
+// Pseudo-random 32-bit encodings plus the field boundaries
+std::vector<fp32_e8m23::storage_type> sampled_fp32_values() {
+  std::vector<fp32_e8m23::storage_type> values = {
+      0x00000000u, 0x80000000u, 0x00000001u, 0x007FFFFFu, 0x00800000u,
+      0x3F800000u, 0x7F7FFFFFu, 0x7F800000u, 0xFF800000u, 0x7FC00000u,
+      0xFFFFFFFFu};
+  std::uint32_t state = 0x12345678u;
+  for (int i = 0; i < 100000; ++i) {
+    state = state * 1664525u + 1013904223u; // LCG (Numerical Recipes)
+    values.push_back(static_cast<fp32_e8m23::storage_type>(state));
+  }
+  return values;
+}
+
+int main() {
+  printf("=== OPINE SIMD Unpack Tests ===\n\n");
+  printf("ISA: %s (%zu-byte registers)\n\n", simd::isa_name,
+         simd::register_bytes);
+
+  bool ok = true;
+  auto report = [&](const char *name, std::size_t lanes, bool result) {
+    printf("%s (%zu lanes): %s\n", name, lanes, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  using RNE = rounding_policies::ToNearestTiesToEven;
+  using RTZ = rounding_policies::TowardZero;
+
+  report("fp8_e5m2 all values", simd::unpack_lanes<fp8_e5m2, RTZ>,
+         test_matches_scalar<fp8_e5m2, RTZ>(all_values<fp8_e5m2>()));
+  report("fp8_e4m3 all values", simd::unpack_lanes<fp8_e4m3, RTZ>,
+         test_matches_scalar<fp8_e4m3, RTZ>(all_values<fp8_e4m3>()));
+  report("fp8_e4m3 all values, 3 guard bits", simd::unpack_lanes<fp8_e4m3, RNE>,
+         test_matches_scalar<fp8_e4m3, RNE>(all_values<fp8_e4m3>()));
+  report("fp16_e5m10 all values", simd::unpack_lanes<fp16_e5m10, RNE>,
+         test_matches_scalar<fp16_e5m10, RNE>(all_values<fp16_e5m10>()));
+
+  using fp16_least = IEEE_Format<5, 10, type_policies::LeastWidth>;
+  report("fp16_e5m10 all values, LeastWidth",
+         simd::unpack_lanes<fp16_least, RNE>,
+         test_matches_scalar<fp16_least, RNE>(all_values<fp16_least>()));
+
+  report("fp32_e8m23 sampled", simd::unpack_lanes<fp32_e8m23, RNE>,
+         test_matches_scalar<fp32_e8m23, RNE>(sampled_fp32_values()));
+
+  report("Padded format all values (scalar fallback)",
+         simd::unpack_lanes<PaddedFormat, RTZ>,
+         test_matches_scalar<PaddedFormat, RTZ>(all_values<PaddedFormat>()));
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
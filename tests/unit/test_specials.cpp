@@ -0,0 +1,400 @@
+#include "float_oracle.hpp"
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <cstdio>
+#include <opine/opine.hpp>
+#include <vector>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using RTZ = rounding_policies::TowardZero;
+using RTP = rounding_policies::TowardPositive;
+using RTN = rounding_policies::TowardNegative;
+using conversion_policies::IEEEConversion;
+using conversion_policies::SafeConversion;
+
+// fp8_e5m2 encodings with saturating overflow
+using fp8_e5m2sat = IEEE_Format<5, 2, DefaultTypeSelectionPolicy,
+                                special_value_policies::SaturatingIEEE>;
+
+enum class Op { Add, Subtract, Multiply, Divide };
+
+// Storage-level operation through the UnpackedFloat arithmetic, also
+// checking that round() agrees with pack()
+template <typename Format, typename RoundingPolicy,
+          typename DenormalPolicy = denormal_policies::DefaultDenormalPolicy>
+constexpr typename Format::storage_type
+apply(Op op, typename Format::storage_type a, typename Format::storage_type b) {
+  const auto x = unpack<Format, RoundingPolicy, DenormalPolicy>(a);
+  const auto y = unpack<Format, RoundingPolicy, DenormalPolicy>(b);
+  UnpackedFloat<Format, RoundingPolicy, DenormalPolicy> result{};
+  switch (op) {
+  case Op::Add:
+    result = add(x, y);
+    break;
+  case Op::Subtract:
+    result = subtract(x, y);
+    break;
+  case Op::Multiply:
+    result = multiply(x, y);
+    break;
+  case Op::Divide:
+    result = divide(x, y);
+    break;
+  }
+  const auto bits = pack(result);
+  if (pack(opine::round(result)) != bits) {
+    return static_cast<typename Format::storage_type>(~bits);
+  }
+  return bits;
+}
+
+// The flags of the predefined policies
+static_assert(!special_value_policies::FiniteNaN::has_infinity &&
+              special_value_policies::FiniteNaN::has_nan &&
+              special_value_policies::FiniteNaN::has_negative_zero);
+static_assert(!special_value_policies::FNUZ::has_negative_zero &&
+              !special_value_policies::FNUZ::saturate);
+static_assert(!special_value_policies::FiniteOnly::has_nan &&
+              special_value_policies::FiniteOnly::saturate);
+static_assert(std::is_same_v<fp8_e4m3::special_values,
+                             special_value_policies::IEEE>);
+
+// Known values, checked at compile time
+//
+// fp8_e4m3fn: 1.0 = 0x38, 256 = 0x78, largest finite 448 = 0x7E, NaN 0x7F.
+// fp8_e4m3fnuz: 1.0 = 0x40, largest finite 240 = 0x7F, NaN 0x80.
+// fp4_e2m1fn: 1.0 = 0x2, largest finite 6 = 0x7.
+constexpr bool test_known_values() {
+  using e4m3fn = fp8_e4m3fn;
+  using fnuz = fp8_e4m3fnuz;
+
+  // The all-ones exponent holds finite values, only S.1111.111 is NaN
+  if (!is_finite(unpack<e4m3fn>(0x78)) || !is_nan(unpack<e4m3fn>(0x7F)) ||
+      !is_nan(unpack<e4m3fn>(0xFF)) || is_inf(unpack<e4m3fn>(0x78))) {
+    return false;
+  }
+  if (apply<e4m3fn, RNE>(Op::Multiply, 0x78, 0x3C) != 0x7C || // 256 * 1.5
+      apply<e4m3fn, RNE>(Op::Add, 0x7E, 0x38) != 0x7E ||      // 448 + 1
+      apply<e4m3fn, RNE>(Op::Multiply, 0x7E, 0x40) != 0x7F || // overflow
+      apply<e4m3fn, RTZ>(Op::Multiply, 0x7E, 0x40) != 0x7E ||
+      apply<e4m3fn, RNE>(Op::Divide, 0xB8, 0x00) != 0xFF ||   // -1 / 0
+      apply<e4m3fn, RNE>(Op::Add, 0x7F, 0x38) != 0x7F) {
+    return false;
+  }
+
+  // fnuz: one zero, NaN in its place
+  if (!is_nan(unpack<fnuz>(0x80)) || !is_zero(unpack<fnuz>(0x00)) ||
+      is_zero(unpack<fnuz>(0x80)) || !is_finite(unpack<fnuz>(0x7F))) {
+    return false;
+  }
+  if (apply<fnuz, RTN>(Op::Subtract, 0x40, 0x40) != 0x00 ||
+      apply<fnuz, RNE>(Op::Multiply, 0xC0, 0x00) != 0x00 ||
+      apply<fnuz, RNE>(Op::Subtract, 0x40, 0x00) != 0x40 ||
+      apply<fnuz, RNE>(Op::Subtract, 0x40, 0x80) != 0x80 ||
+      apply<fnuz, RTZ>(Op::Multiply, 0x81, 0x01) != 0x00 || // -tiny to +0
+      apply<fnuz, RNE>(Op::Divide, 0x40, 0x00) != 0x80 ||
+      apply<fnuz, RNE>(Op::Multiply, 0x7F, 0x48) != 0x80 || // overflow
+      apply<fnuz, RTZ>(Op::Multiply, 0x7F, 0x48) != 0x7F) {
+    return false;
+  }
+  // Flushed negative denormals are +0, not NaN
+  using FOZ = denormal_policies::FlushOnZero;
+  if (!is_zero(unpack<fnuz, RNE, FOZ>(0x81)) ||
+      apply<fnuz, RNE, FOZ>(Op::Multiply, 0x81, 0x40) != 0x00 ||
+      apply<fnuz, RNE, FOZ>(Op::Multiply, 0x84, 0x04) != 0x00) {
+    return false;
+  }
+
+  // Finite only: saturation in every direction, 0 / 0 = +0
+  if (apply<fp4_e2m1fn, RNE>(Op::Multiply, 0x7, 0x7) != 0x7 ||
+      apply<fp4_e2m1fn, RTP>(Op::Multiply, 0xF, 0x7) != 0xF ||
+      apply<fp4_e2m1fn, RNE>(Op::Divide, 0x2, 0x0) != 0x7 ||
+      apply<fp4_e2m1fn, RNE>(Op::Divide, 0x0, 0x0) != 0x0) {
+    return false;
+  }
+
+  // Saturating IEEE: finite overflow clips, Inf stays Inf
+  if (apply<fp8_e5m2sat, RNE>(Op::Multiply, 0x7B, 0x40) != 0x7B ||
+      apply<fp8_e5m2sat, RTP>(Op::Add, 0x7B, 0x7B) != 0x7B ||
+      apply<fp8_e5m2sat, RNE>(Op::Divide, 0x3C, 0x00) != 0x7C ||
+      apply<fp8_e5m2sat, RNE>(Op::Add, 0x7C, 0x3C) != 0x7C) {
+    return false;
+  }
+  return true;
+}
+
+static_assert(test_known_values(), "Special-value encodings");
+
+// MX element formats in OCP encoding: the top binade is finite
+static_assert(MicroscalingFormat<fp8_e4m3fn>::element_emax == 8);
+static_assert(MicroscalingFormat<fp4_e2m1fn>::element_emax == 2);
+
+// Comparisons on FloatEngine values
+using e4m3fn_engine = FloatEngine<FloatConfig<fp8_e4m3fn, RNE>>;
+static_assert(e4m3fn_engine::from_bits(0x7E) > e4m3fn_engine::from_bits(0x78));
+static_assert(e4m3fn_engine::from_bits(0x00) == e4m3fn_engine::from_bits(0x80));
+static_assert(e4m3fn_engine::from_bits(0x7F) != e4m3fn_engine::from_bits(0x7F));
+static_assert(std::is_lt(e4m3fn_engine::from_bits(0xB8) <=>
+                         e4m3fn_engine::from_bits(0x38)));
+
+// Test helper: classification of every encoding matches the oracle
+template <typename Format> bool test_classification() {
+  constexpr std::uint64_t count = std::uint64_t{1} << Format::total_bits;
+  for (std::uint64_t bits = 0; bits < count; ++bits) {
+    const auto value =
+        unpack<Format>(static_cast<typename Format::storage_type>(bits));
+    const double expected = oracle::to_double<Format>(bits);
+    if (is_nan(value) != oracle::is_nan<Format>(bits) ||
+        is_inf(value) != std::isinf(expected) ||
+        is_zero(value) != (expected == 0) ||
+        is_finite(value) != std::isfinite(expected)) {
+      printf("\n  mismatch: 0x%llx\n", static_cast<unsigned long long>(bits));
+      return false;
+    }
+  }
+  return true;
+}
+
+// Exact result of a binary operation (division rounded to odd), with the
+// sign of an exact zero sum under RoundingPolicy
+template <typename RoundingPolicy>
+double exact_result(Op op, double a, double b) {
+  switch (op) {
+  case Op::Add:
+  case Op::Subtract: {
+    const double addend = op == Op::Add ? b : -b;
+    const double sum = a + addend;
+    if (sum == 0 && std::is_same_v<RoundingPolicy, RTN>) {
+      return std::signbit(a) || std::signbit(addend) ? -0.0 : 0.0;
+    }
+    return sum;
+  }
+  case Op::Multiply:
+    return a * b;
+  case Op::Divide:
+    return oracle::divide_to_odd(a, b);
+  }
+  return 0.0;
+}
+
+// Test helper: all four operations on every pair of encodings match the
+// oracle (NaN results only need to be NaN)
+template <typename Format, typename RoundingPolicy, oracle::Rounding Direction>
+bool test_exhaustive() {
+  using storage_type = typename Format::storage_type;
+  constexpr std::uint64_t count = std::uint64_t{1} << Format::total_bits;
+
+  for (const Op op : {Op::Add, Op::Subtract, Op::Multiply, Op::Divide}) {
+    for (std::uint64_t a = 0; a < count; ++a) {
+      for (std::uint64_t b = 0; b < count; ++b) {
+        const auto actual = static_cast<std::uint64_t>(
+            apply<Format, RoundingPolicy>(op, static_cast<storage_type>(a),
+                                          static_cast<storage_type>(b)));
+        const auto expected = oracle::round_with<Format, Direction>(
+            exact_result<RoundingPolicy>(op, oracle::to_double<Format>(a),
+                                         oracle::to_double<Format>(b)));
+        const bool match = oracle::is_nan<Format>(expected)
+                               ? oracle::is_nan<Format>(actual)
+                               : actual == expected;
+        if (!match) {
+          printf("\n  mismatch: op %d, 0x%llx, 0x%llx -> 0x%llx (want "
+                 "0x%llx)\n",
+                 static_cast<int>(op), static_cast<unsigned long long>(a),
+                 static_cast<unsigned long long>(b),
+                 static_cast<unsigned long long>(actual),
+                 static_cast<unsigned long long>(expected));
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Test helper: fma on every triple of encodings matches the oracle
+template <typename Format> bool test_fma_exhaustive() {
+  using storage_type = typename Format::storage_type;
+  constexpr std::uint64_t count = std::uint64_t{1} << Format::total_bits;
+
+  for (std::uint64_t a = 0; a < count; ++a) {
+    for (std::uint64_t b = 0; b < count; ++b) {
+      for (std::uint64_t c = 0; c < count; ++c) {
+        const auto actual = static_cast<std::uint64_t>(pack(fma(
+            unpack<Format, RNE>(static_cast<storage_type>(a)),
+            unpack<Format, RNE>(static_cast<storage_type>(b)),
+            unpack<Format, RNE>(static_cast<storage_type>(c)))));
+        const auto expected = oracle::round_to<Format, true>(
+            oracle::fma_to_odd(oracle::to_double<Format>(a),
+                               oracle::to_double<Format>(b),
+                               oracle::to_double<Format>(c)));
+        const bool match = oracle::is_nan<Format>(expected)
+                               ? oracle::is_nan<Format>(actual)
+                               : actual == expected;
+        if (!match) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Test helper: every fp16 value converts to Dst as the oracle rounds it,
+// through convert() and convert_n(), with and without saturation
+template <typename Dst> bool test_convert_from_fp16() {
+  using src_bits = fp16_e5m10::storage_type;
+  std::vector<src_bits> src(65536);
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<src_bits>(i);
+  }
+  std::vector<typename Dst::storage_type> ieee(src.size());
+  std::vector<typename Dst::storage_type> safe(src.size());
+  convert_n<Dst, fp16_e5m10, IEEEConversion>(src, ieee);
+  convert_n<Dst, fp16_e5m10, SafeConversion>(src, safe);
+
+  const std::uint64_t largest =
+      pack(detail::largest_finite<Dst, RNE,
+                                  denormal_policies::DefaultDenormalPolicy>(
+          false));
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    const double value = oracle::to_double<fp16_e5m10>(src[i]);
+    const auto expected = oracle::round_to<Dst, true>(value);
+    auto saturated = expected;
+    if (std::isfinite(value) &&
+        (oracle::is_nan<Dst>(expected) ||
+         std::isinf(oracle::to_double<Dst>(expected)))) {
+      const std::uint64_t sign = std::signbit(value)
+                                     ? std::uint64_t{1} << Dst::sign_offset
+                                     : 0;
+      saturated = sign | largest;
+    }
+    auto matches = [](std::uint64_t actual, std::uint64_t want) {
+      return oracle::is_nan<Dst>(want) ? oracle::is_nan<Dst>(actual)
+                                       : actual == want;
+    };
+    const std::uint64_t scalar =
+        convert<Dst, fp16_e5m10, IEEEConversion>(src[i]);
+    if (!matches(scalar, expected) || ieee[i] != scalar ||
+        !matches(safe[i], saturated)) {
+      printf("\n  mismatch: 0x%llx -> 0x%llx (want 0x%llx)\n",
+             static_cast<unsigned long long>(src[i]),
+             static_cast<unsigned long long>(scalar),
+             static_cast<unsigned long long>(expected));
+      return false;
+    }
+  }
+  return true;
+}
+
+// Test helper: every Src value widens to fp32 exactly
+template <typename Src> bool test_convert_to_fp32() {
+  constexpr std::uint64_t count = std::uint64_t{1} << Src::total_bits;
+  for (std::uint64_t bits = 0; bits < count; ++bits) {
+    const double value = oracle::to_double<Src>(bits);
+    const std::uint64_t actual = convert<fp32_e8m23, Src, IEEEConversion>(
+        static_cast<typename Src::storage_type>(bits));
+    const double result = oracle::to_double<fp32_e8m23>(actual);
+    const bool match = std::isnan(value)
+                           ? std::isnan(result)
+                           : result == value &&
+                                 std::signbit(result) == std::signbit(value);
+    if (!match) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Test helper: compare() on every pair of encodings orders like the doubles
+template <typename Format> bool test_compare_exhaustive() {
+  using storage_type = typename Format::storage_type;
+  constexpr std::uint64_t count = std::uint64_t{1} << Format::total_bits;
+  for (std::uint64_t a = 0; a < count; ++a) {
+    for (std::uint64_t b = 0; b < count; ++b) {
+      const auto actual =
+          compare(unpack<Format, RNE>(static_cast<storage_type>(a)),
+                  unpack<Format, RNE>(static_cast<storage_type>(b)));
+      const auto expected =
+          oracle::to_double<Format>(a) <=> oracle::to_double<Format>(b);
+      if (actual != expected) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main() {
+  printf("=== OPINE Special Value Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  using oracle::Rounding;
+  report("Known values (fn, fnuz, finite, saturating)", test_known_values());
+
+  report("fp8_e4m3fn classification", test_classification<fp8_e4m3fn>());
+  report("fp8_e4m3fnuz classification",
+         test_classification<fp8_e4m3fnuz>());
+  report("fp8_e5m2fnuz classification",
+         test_classification<fp8_e5m2fnuz>());
+  report("fp6_e3m2fn classification", test_classification<fp6_e3m2fn>());
+  report("fp4_e2m1fn classification", test_classification<fp4_e2m1fn>());
+
+  report("fp8_e4m3fn RNE exhaustive",
+         test_exhaustive<fp8_e4m3fn, RNE, Rounding::NearestEven>());
+  report("fp8_e4m3fn TowardZero exhaustive",
+         test_exhaustive<fp8_e4m3fn, RTZ, Rounding::TowardZero>());
+  report("fp8_e4m3fn TowardNegative exhaustive",
+         test_exhaustive<fp8_e4m3fn, RTN, Rounding::TowardNegative>());
+  report("fp8_e4m3fnuz RNE exhaustive",
+         test_exhaustive<fp8_e4m3fnuz, RNE, Rounding::NearestEven>());
+  report("fp8_e4m3fnuz TowardNegative exhaustive",
+         test_exhaustive<fp8_e4m3fnuz, RTN, Rounding::TowardNegative>());
+  report("fp8_e5m2fnuz RNE exhaustive",
+         test_exhaustive<fp8_e5m2fnuz, RNE, Rounding::NearestEven>());
+  report("fp8_e5m2fnuz TowardPositive exhaustive",
+         test_exhaustive<fp8_e5m2fnuz, RTP, Rounding::TowardPositive>());
+  report("fp6_e3m2fn RNE exhaustive",
+         test_exhaustive<fp6_e3m2fn, RNE, Rounding::NearestEven>());
+  report("fp6_e2m3fn TowardPositive exhaustive",
+         test_exhaustive<fp6_e2m3fn, RTP, Rounding::TowardPositive>());
+  report("fp4_e2m1fn TowardZero exhaustive",
+         test_exhaustive<fp4_e2m1fn, RTZ, Rounding::TowardZero>());
+  report("fp8_e5m2 saturating RNE exhaustive",
+         test_exhaustive<fp8_e5m2sat, RNE, Rounding::NearestEven>());
+  report("fp8_e5m2 saturating TowardPositive exhaustive",
+         test_exhaustive<fp8_e5m2sat, RTP, Rounding::TowardPositive>());
+
+  report("fp6_e2m3fn fma exhaustive", test_fma_exhaustive<fp6_e2m3fn>());
+  report("fp4_e2m1fn fma exhaustive", test_fma_exhaustive<fp4_e2m1fn>());
+
+  report("fp16 -> fp8_e4m3fn", test_convert_from_fp16<fp8_e4m3fn>());
+  report("fp16 -> fp8_e4m3fnuz", test_convert_from_fp16<fp8_e4m3fnuz>());
+  report("fp16 -> fp8_e5m2fnuz", test_convert_from_fp16<fp8_e5m2fnuz>());
+  report("fp16 -> fp4_e2m1fn", test_convert_from_fp16<fp4_e2m1fn>());
+  report("fp8_e4m3fn -> fp32", test_convert_to_fp32<fp8_e4m3fn>());
+  report("fp8_e4m3fnuz -> fp32", test_convert_to_fp32<fp8_e4m3fnuz>());
+  report("fp6_e3m2fn -> fp32", test_convert_to_fp32<fp6_e3m2fn>());
+
+  report("fp8_e4m3 compare exhaustive", test_compare_exhaustive<fp8_e4m3>());
+  report("fp8_e4m3fn compare exhaustive",
+         test_compare_exhaustive<fp8_e4m3fn>());
+  report("fp8_e4m3fnuz compare exhaustive",
+         test_compare_exhaustive<fp8_e4m3fnuz>());
+  report("fp4_e2m1fn compare exhaustive",
+         test_compare_exhaustive<fp4_e2m1fn>());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <opine/opine.hpp>
+#include <opine/tensor_file.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using fp16_bits = fp16_e5m10::storage_type;
+using fp32_bits = fp32_e8m23::storage_type;
+
+// 12-bit format: elements straddle 64-bit words
+using PaddedFormat = FormatDescriptor<1, 8, 4, 4, 3, 1, 12, true>;
+
+static_assert(describes_format<fp4_e2m1>(
+    describe_format<fp4_e2m1>(TensorLayout::Packed)));
+static_assert(!describes_format<fp4_e2m1fn>(
+                  describe_format<fp4_e2m1>(TensorLayout::Packed)),
+              "Special values are part of the format");
+static_assert(!describes_format<fp8_e5m2>(
+    describe_format<fp8_e4m3>(TensorLayout::Storage)));
+static_assert(tensor_data_offset(64) == 64 && tensor_data_offset(65) == 128);
+
+std::filesystem::path temp_file(const char *name) {
+  return std::filesystem::temp_directory_path() /
+         (std::string("opine_test_") + name + ".opine");
+}
+
+// Test pattern: distinct, covering the whole element width
+template <typename Format>
+std::vector<typename Format::storage_type> pattern(std::size_t n) {
+  constexpr std::uint64_t mask =
+      (std::uint64_t{1} << Format::total_bits) - 1;
+  std::vector<typename Format::storage_type> values(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    values[i] =
+        static_cast<typename Format::storage_type>((i * 37 + 11) & mask);
+  }
+  return values;
+}
+
+// Overwrite the element count in a tensor file's header
+void set_count(const std::filesystem::path &path, std::uint64_t count) {
+  std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+  file.seekp(offsetof(TensorFileHeader, count));
+  file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+}
+
+// Storage layout: the mapped span is the data written, 64-byte aligned
+bool test_storage_round_trip() {
+  const auto path = temp_file("storage");
+  const auto values = pattern<fp16_e5m10>(1001);
+  {
+    TensorWriter<fp16_e5m10> out(path, TensorLayout::Storage);
+    out.write(std::span<const fp16_bits>(values).first(500));
+    out.write(std::span<const fp16_bits>(values).subspan(500));
+    out.close();
+  }
+
+  const TensorFile file(path);
+  const auto data = file.storage<fp16_e5m10>();
+  const bool ok =
+      file.layout() == TensorLayout::Storage && file.size() == values.size() &&
+      std::ranges::equal(data, values) &&
+      reinterpret_cast<std::uintptr_t>(data.data()) % cache_line_size == 0;
+  std::filesystem::remove(path);
+  return ok;
+}
+
+// Test helper: Packed layout written in chunks of every size up to past a
+// word group, read back as a PackedView
+template <typename Format> bool test_packed_round_trip() {
+  using storage_type = typename Format::storage_type;
+  const auto path = temp_file("packed");
+  const std::size_t n = 5 * PackedView<Format>::group + 7;
+  const auto values = pattern<Format>(n);
+
+  for (std::size_t chunk = 1; chunk <= PackedView<Format>::group + 1;
+       ++chunk) {
+    {
+      TensorWriter<Format> out(path);
+      for (std::size_t i = 0; i < n; i += chunk) {
+        out.write(std::span<const storage_type>(values).subspan(
+            i, std::min(chunk, n - i)));
+      }
+      if (out.size() != n) {
+        return false;
+      }
+    } // closed by the destructor
+
+    const TensorFile file(path);
+    const auto view = file.template packed<Format>();
+    if (file.header().data_bytes !=
+            PackedView<Format>::word_count(n) * sizeof(std::uint64_t) ||
+        view.size() != n || !std::ranges::equal(view, values)) {
+      return false;
+    }
+  }
+
+  // The words are a PackedArray's
+  const PackedArray<Format> array{std::span<const storage_type>(values)};
+  write_tensor_file(path, array);
+  const TensorFile file(path);
+  const bool ok =
+      std::ranges::equal(file.template packed<Format>().words(), array.words());
+  std::filesystem::remove(path);
+  return ok;
+}
+
+// Streaming from SoA buffers through pack_n(): the file holds what pack_n()
+// produces, and unpack_n() on the mapped view gives the buffers back
+bool test_soa_streaming() {
+  using mantissa_type = unpacked_mantissa_t<fp6_e3m2, RNE>;
+  const auto path = temp_file("soa");
+  const std::size_t n = 300;
+  const auto values = pattern<fp6_e3m2>(n);
+
+  auto sign = std::make_unique<bool[]>(n);
+  std::span<bool> sign_span(sign.get(), n);
+  std::vector<fp6_e3m2::exponent_type> exponent(n);
+  std::vector<mantissa_type> mantissa(n);
+  unpack_n<fp6_e3m2, RNE>(values, sign_span, exponent, mantissa);
+  {
+    TensorWriter<fp6_e3m2> out(path);
+    out.write<RNE>(sign_span.first(100), std::span(exponent).first(100),
+                   std::span(mantissa).first(100));
+    out.write<RNE>(sign_span.subspan(100), std::span(exponent).subspan(100),
+                   std::span(mantissa).subspan(100));
+    out.close();
+  }
+
+  const TensorFile file(path);
+  const auto view = file.packed<fp6_e3m2>();
+  auto read_sign = std::make_unique<bool[]>(n);
+  std::span<bool> read_sign_span(read_sign.get(), n);
+  std::vector<fp6_e3m2::exponent_type> read_exponent(n);
+  std::vector<mantissa_type> read_mantissa(n);
+  const bool ok =
+      std::ranges::equal(view, values) &&
+      unpack_n<fp6_e3m2, RNE>(view, 0, read_sign_span, read_exponent,
+                              read_mantissa) == n &&
+      std::ranges::equal(read_sign_span, sign_span) &&
+      read_exponent == exponent && read_mantissa == mantissa;
+  std::filesystem::remove(path);
+  return ok;
+}
+
+// Microscaled layout: the mapped view decodes like the array
+bool test_microscaled_round_trip() {
+  const auto path = temp_file("mx");
+  const std::size_t n = 1000;
+  std::vector<fp32_bits> src(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    src[i] = 0x3F800000u + static_cast<fp32_bits>(i * 0x9E3779u % 0x1000000u) +
+             static_cast<fp32_bits>((i / 32 % 8) << 23);
+  }
+  const auto array = quantize<MXFP4_E2M1, fp32_e8m23>(src);
+  write_tensor_file(path, array);
+
+  const TensorFile file(path);
+  const auto view = file.microscaled<MXFP4_E2M1>();
+  std::vector<fp16_bits> expected(n), out(n);
+  array.dequantize<fp16_e5m10>(expected);
+  view.dequantize<fp16_e5m10>(out);
+  const bool ok = file.header().block_size == 32 && view.size() == n &&
+                  std::ranges::equal(view.scales(), array.scales()) &&
+                  std::ranges::equal(view.elements(), array.elements()) &&
+                  out == expected &&
+                  view.get<fp32_e8m23>(999) == array.get<fp32_e8m23>(999);
+  std::filesystem::remove(path);
+  return ok;
+}
+
+// Test helper: true if f() throws TensorFileError
+template <typename F> bool throws_tensor_file_error(F f) {
+  try {
+    f();
+  } catch (const TensorFileError &) {
+    return true;
+  }
+  return false;
+}
+
+// Mismatched requests and malformed files are rejected
+bool test_errors() {
+  const auto path = temp_file("errors");
+  const auto values = pattern<fp8_e4m3>(100);
+  {
+    TensorWriter<fp8_e4m3> out(path, TensorLayout::Storage);
+    out.write(values);
+  }
+
+  bool ok = true;
+  {
+    const TensorFile file(path);
+    ok &= throws_tensor_file_error([&] { file.storage<fp8_e5m2>(); });
+    ok &= throws_tensor_file_error([&] { file.storage<fp8_e4m3fn>(); });
+    ok &= throws_tensor_file_error([&] { file.packed<fp8_e4m3>(); });
+    ok &= throws_tensor_file_error(
+        [&] { file.microscaled<MXFP8_E4M3>(); });
+    ok &= std::ranges::equal(file.storage<fp8_e4m3>(), values);
+  }
+
+  // Corrupted counts whose byte sizes wrap around
+  {
+    TensorWriter<fp16_e5m10> out(path, TensorLayout::Storage);
+    out.write(pattern<fp16_e5m10>(32));
+  }
+  set_count(path, std::uint64_t{1} << 61);
+  ok &= throws_tensor_file_error(
+      [&] { TensorFile(path).storage<fp16_e5m10>(); });
+  write_tensor_file(path, PackedArray<fp4_e2m1>(
+                              std::span<const fp4_e2m1::storage_type>(
+                                  pattern<fp4_e2m1>(100))));
+  set_count(path, std::uint64_t{1} << 62);
+  ok &= throws_tensor_file_error([&] { TensorFile(path).packed<fp4_e2m1>(); });
+  write_tensor_file(path, quantize<MXFP4_E2M1, fp32_e8m23>(
+                              std::vector<fp32_bits>(100, 0x3F800000u)));
+  set_count(path, ~std::uint64_t{0});
+  ok &= throws_tensor_file_error(
+      [&] { TensorFile(path).microscaled<MXFP4_E2M1>(); });
+
+  // Truncated data
+  {
+    TensorWriter<fp8_e4m3> out(path, TensorLayout::Storage);
+    out.write(values);
+  }
+  std::filesystem::resize_file(path, 64 + 50);
+  ok &= throws_tensor_file_error([&] { TensorFile file(path); });
+
+  // Not a tensor file
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const std::string text(100, 'x');
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+  }
+  ok &= throws_tensor_file_error([&] { TensorFile file(path); });
+  std::filesystem::resize_file(path, 10);
+  ok &= throws_tensor_file_error([&] { TensorFile file(path); });
+  std::filesystem::remove(path);
+
+  // Missing file: an operating system error
+  try {
+    TensorFile file(path);
+    ok = false;
+  } catch (const std::system_error &) {
+  }
+  return ok;
+}
+
+int main() {
+  printf("=== OPINE Tensor File Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("Storage layout round trip", test_storage_round_trip());
+  report("Packed fp4_e2m1 round trip", test_packed_round_trip<fp4_e2m1>());
+  report("Packed fp6_e2m3 round trip", test_packed_round_trip<fp6_e2m3>());
+  report("Packed 12-bit round trip", test_packed_round_trip<PaddedFormat>());
+  report("SoA streaming through pack_n", test_soa_streaming());
+  report("Microscaled layout round trip", test_microscaled_round_trip());
+  report("Errors", test_errors());
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}
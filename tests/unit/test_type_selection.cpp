@@ -92,6 +92,23 @@ static_assert(std::is_same_v<int_t<9, type_policies::Fastest>, int_fast16_t>,
 static_assert(std::is_same_v<int_t<32, type_policies::Fastest>, int_fast32_t>,
               "Fastest: 32 bits signed should give int_fast32_t");
 
+// LimbWidth Policy Tests - limb metadata
+
+static_assert(type_policies::limb_bits<type_policies::ByteLimbs> == 8);
+static_assert(type_policies::limb_bits<type_policies::Fastest> == 0,
+              "Policies without limbs have limb_bits 0");
+static_assert(type_policies::limb_count<24, type_policies::ByteLimbs> == 3,
+              "fp32 significand: three bytes");
+static_assert(type_policies::limb_count<27, type_policies::ByteLimbs> == 4);
+static_assert(type_policies::limb_count<27, type_policies::LimbWidth<16>> ==
+              2);
+static_assert(type_policies::limb_count<48, type_policies::ExactWidth> == 1,
+              "Policies without limbs count one limb");
+static_assert(
+    std::is_same_v<uint_t<65, type_policies::ByteLimbs>,
+                   uint_t<72, type_policies::ByteLimbs>>,
+    "ByteLimbs: 65 bits should give the 72-bit type");
+
 // Realistic Format Type Aliases
 
 // fp8_e5m2: 1 sign + 5 exponent + 2 mantissa = 8 bits
@@ -160,6 +177,27 @@ static_assert(
     std::is_same_v<int_t<7, type_policies::ExactWidth>, int_fast8_t>,
     "Explicit ExactWidth fallback: 7 bits signed should give int_fast8_t");
 
+// Widths over 64 bits: multi-limb WideUint for every policy
+static_assert(std::is_same_v<uint_t<65>, WideUint<65>>,
+              "ExactWidth fallback: 65 bits should give WideUint<65>");
+static_assert(
+    std::is_same_v<uint_t<112, type_policies::LeastWidth>, WideUint<112>>,
+    "LeastWidth: 112 bits should give WideUint<112>");
+static_assert(
+    std::is_same_v<uint_t<232, type_policies::Fastest>, WideUint<232>>,
+    "Fastest: 232 bits should give WideUint<232>");
+
+// LimbWidth: whole limbs, then the next LeastWidth type
+static_assert(
+    std::is_same_v<uint_t<24, type_policies::ByteLimbs>, uint_least32_t>,
+    "ByteLimbs fallback: 24 bits should give uint_least32_t");
+static_assert(
+    std::is_same_v<int_t<11, type_policies::ByteLimbs>, int_least16_t>,
+    "ByteLimbs fallback: 11 bits signed should give int_least16_t");
+static_assert(
+    std::is_same_v<uint_t<65, type_policies::ByteLimbs>, WideUint<72>>,
+    "ByteLimbs fallback: 65 bits should give WideUint<72>");
+
 #endif // !defined(__clang__)
 
 // ============================================================================
@@ -252,6 +290,17 @@ static_assert(std::is_same_v<fp32_e8m23_mant_t, unsigned _BitInt(23)>);
 
 static_assert(std::is_same_v<fp32_mant_with_guards, unsigned _BitInt(26)>);
 
+// LimbWidth: exact multiples of the limb width
+static_assert(std::is_same_v<uint_t<24, type_policies::ByteLimbs>,
+                             unsigned _BitInt(24)>);
+static_assert(std::is_same_v<uint_t<27, type_policies::ByteLimbs>,
+                             unsigned _BitInt(32)>);
+static_assert(
+    std::is_same_v<int_t<11, type_policies::ByteLimbs>, _BitInt(16)>);
+static_assert(
+    std::is_same_v<int_t<1, type_policies::LimbWidth<1>>, _BitInt(2)>,
+    "Signed _BitInt requires at least 2 bits");
+
 #endif // defined(__clang__)
 
 // ============================================================================
@@ -0,0 +1,216 @@
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <opine/opine.hpp>
+#include <random>
+
+using namespace opine;
+
+using RNE = rounding_policies::ToNearestTiesToEven;
+using U128 = WideUint<128>;
+using U200 = WideUint<200>;
+
+// Compile-time arithmetic, with the carries between limbs
+constexpr U128 two_64 = U128(1) << 64;
+static_assert(U128(~std::uint64_t{0}) + 1 == two_64);
+static_assert(two_64 - 1 == U128(~std::uint64_t{0}));
+static_assert((two_64 >> 1).limb(0) == std::uint64_t{1} << 63);
+static_assert(U128(-1) == ~U128(0), "Negative integers wrap modulo 2^Bits");
+static_assert(U128(0) - 1 == ~U128(0));
+static_assert(WideUint<65>(-1).bit_width() == 65);
+static_assert((WideUint<65>(1) << 65) == 0, "Shifts of Bits or more give 0");
+static_assert((WideUint<65>(1) << 64) + (WideUint<65>(1) << 64) == 0);
+static_assert(U128(~std::uint64_t{0}) * U128(~std::uint64_t{0}) ==
+              (two_64 - 2) * two_64 + 1);
+static_assert(multiply_wide<128>(~std::uint64_t{0}, ~std::uint64_t{0}) ==
+              ~U128(0) - 2 * two_64 + 2);
+static_assert(((two_64 * 12345 + 678) / 1000) * 1000 +
+                  (two_64 * 12345 + 678) % 1000 ==
+              two_64 * 12345 + 678);
+static_assert(U200(U128(-1)) == (U200(1) << 128) - 1,
+              "Widening keeps the value");
+static_assert(U128(U200(-1)) == U128(-1), "Narrowing keeps the low bits");
+static_assert(static_cast<std::uint32_t>(two_64 + 7) == 7);
+static_assert(static_cast<bool>(two_64) && !static_cast<bool>(U128(0)));
+static_assert(U128(3) < two_64 && two_64 > U128(~std::uint64_t{0}));
+static_assert(U200(0).bit_width() == 0 && (U200(1) << 199).bit_width() == 200);
+
+// fp64 with guard bits: 56-bit significands, 112-bit products
+using fp64_traits =
+    detail::arithmetic_traits<fp64_e11m52, RNE,
+                              denormal_policies::DefaultDenormalPolicy>;
+static_assert(fp64_traits::product_bits == 112);
+#if !defined(__clang__)
+static_assert(is_wide_uint<fp64_traits::product_type>);
+#endif
+
+// A quotient, product and remainder identity over random operands
+template <typename Wide> Wide random_wide(std::mt19937_64 &rng, int bits) {
+  Wide value = 0;
+  for (int i = 0; i < Wide::limb_count; ++i) {
+    value = (value << 64) | Wide(rng());
+  }
+  return value >> (Wide::bits - bits);
+}
+
+bool test_wide_arithmetic() {
+  std::mt19937_64 rng(7);
+  for (int i = 0; i < 20000; ++i) {
+    const auto a = random_wide<U200>(rng, 1 + static_cast<int>(rng() % 200));
+    const auto b = random_wide<U200>(rng, 1 + static_cast<int>(rng() % 200));
+    if (b == 0) {
+      continue;
+    }
+    const U200 quotient = a / b;
+    const U200 remainder = a % b;
+    if (quotient * b + remainder != a || remainder >= b) {
+      return false;
+    }
+    if ((a + b) - b != a || (a ^ b) != ((a | b) & ~(a & b))) {
+      return false;
+    }
+    const int shift = static_cast<int>(rng() % 200);
+    if (((a << shift) >> shift) != (a & ((U200(1) << (200 - shift)) - 1))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if defined(__SIZEOF_INT128__)
+__extension__ using native_u128 = unsigned __int128;
+
+// Every operation against the native 128-bit integer
+bool test_against_int128() {
+  std::mt19937_64 rng(11);
+  auto wide = [](native_u128 x) {
+    return (U128(static_cast<std::uint64_t>(x >> 64)) << 64) |
+           U128(static_cast<std::uint64_t>(x));
+  };
+  for (int i = 0; i < 20000; ++i) {
+    const native_u128 a = (native_u128{rng()} << 64) | rng();
+    const native_u128 b = (native_u128{rng()} << 64 | rng()) >>
+                          (rng() % 128);
+    const int shift = static_cast<int>(rng() % 128);
+    bool ok = wide(a + b) == wide(a) + wide(b) &&
+              wide(a - b) == wide(a) - wide(b) &&
+              wide(a * b) == wide(a) * wide(b) &&
+              wide(a << shift) == wide(a) << shift &&
+              wide(a >> shift) == wide(a) >> shift &&
+              (a < b) == (wide(a) < wide(b));
+    if (b != 0) {
+      ok &= wide(a / b) == wide(a) / wide(b) &&
+            wide(a % b) == wide(a) % wide(b);
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+
+// fp64 add, subtract, multiply, divide and fma against the host's binary64,
+// rounding to nearest even: random encodings (specials, denormals, overflow)
+// and nearby operands (rounding, cancellation)
+bool test_fp64_arithmetic() {
+  using F = fp64_e11m52;
+  auto up = [](double x) {
+    return unpack<F, RNE>(
+        static_cast<F::storage_type>(std::bit_cast<std::uint64_t>(x)));
+  };
+  auto same = [](double expected, auto result) {
+    const auto bits = static_cast<std::uint64_t>(pack<F, RNE>(result));
+    return std::isnan(expected)
+               ? std::isnan(std::bit_cast<double>(bits))
+               : bits == std::bit_cast<std::uint64_t>(expected);
+  };
+
+  std::mt19937_64 rng(3);
+  std::uniform_real_distribution<double> unit(-4.0, 4.0);
+  for (int i = 0; i < 100000; ++i) {
+    double a = std::bit_cast<double>(rng());
+    double b = std::bit_cast<double>(rng());
+    double c = std::bit_cast<double>(rng());
+    if (i % 2 != 0) {
+      a = unit(rng);
+      b = unit(rng);
+      c = i % 4 == 1 ? -a * b * (1 + unit(rng) * 1e-15)
+                     : std::ldexp(unit(rng), -1000 - static_cast<int>(i % 70));
+    }
+    if (!same(a + b, add(up(a), up(b))) ||
+        !same(a - b, subtract(up(a), up(b))) ||
+        !same(a * b, multiply(up(a), up(b))) ||
+        !same(a / b, divide(up(a), up(b))) ||
+        !same(std::fma(a, b, c), fma(up(a), up(b), up(c)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if defined(__SIZEOF_FLOAT128__) && defined(__SIZEOF_INT128__)
+__extension__ using native_f128 = __float128;
+
+// binary128: 113-bit significands and four-limb products, against the
+// compiler's software binary128
+bool test_binary128_arithmetic() {
+  using F = IEEE_Format<15, 112>;
+  using storage_type = F::storage_type;
+  auto encode = [](native_f128 x) {
+    native_u128 bits = 0;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (storage_type(static_cast<std::uint64_t>(bits >> 64)) << 64) |
+           storage_type(static_cast<std::uint64_t>(bits));
+  };
+
+  std::mt19937_64 rng(5);
+  auto ratio = [&] {
+    const auto numerator = static_cast<std::int64_t>(rng());
+    const auto denominator = static_cast<std::int64_t>(rng() | 1);
+    return static_cast<native_f128>(numerator) /
+           static_cast<native_f128>(denominator);
+  };
+  for (int i = 0; i < 5000; ++i) {
+    const native_f128 a = ratio();
+    const native_f128 b = ratio();
+    const auto ua = unpack<F, RNE>(encode(a));
+    const auto ub = unpack<F, RNE>(encode(b));
+    if (pack<F, RNE>(add(ua, ub)) != encode(a + b) ||
+        pack<F, RNE>(multiply(ua, ub)) != encode(a * b) ||
+        pack<F, RNE>(divide(ua, ub)) != encode(a / b)) {
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+
+int main() {
+  printf("=== OPINE Wide Integer Tests ===\n\n");
+
+  bool ok = true;
+  auto report = [&](const char *name, bool result) {
+    printf("%s: %s\n", name, result ? "PASS" : "FAIL");
+    ok &= result;
+  };
+
+  report("200-bit arithmetic identities", test_wide_arithmetic());
+#if defined(__SIZEOF_INT128__)
+  report("128-bit operations against __int128", test_against_int128());
+#endif
+  report("fp64 arithmetic against binary64", test_fp64_arithmetic());
+#if defined(__SIZEOF_FLOAT128__) && defined(__SIZEOF_INT128__)
+  report("binary128 arithmetic against __float128",
+         test_binary128_arithmetic());
+#endif
+
+  if (!ok) {
+    return 1;
+  }
+
+  printf("\n=== All tests passed! ===\n");
+  return 0;
+}